@@ -96,6 +96,18 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
                                                                                    "\t1: check hash in SEI messages if available in the bitstream\n"
                                                                                    "\t0: ignore SEI message")
   ("SEINoDisplay",              m_decodedNoDisplaySEIEnabled,          true,       "Control handling of decoded no display SEI messages")
+#if SUBSTREAM_PARALLEL_DEC
+  ("NumSubstreamThreads",       m_numSubstreamThreads,                 1,          "Number of threads decoding the substreams (wavefront CTU rows, tiles) of a slice segment in parallel, 1: sequential")
+#endif
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  ("NumLoopFilterThreads",      m_numLoopFilterThreads,                1,          "Number of threads deblocking and applying SAO to the CTU rows of a picture in parallel, 1: sequential")
+#endif
+#if NH_MV_LAYER_PARALLEL_DEC
+  ("NumLayerThreads",           m_numLayerThreads,                     1,          "Number of threads decoding the layers of an access unit in a pipeline, 1: sequential")
+#endif
+#if PIC_HASH_PARALLEL_DEC
+  ("NumHashThreads",            m_numHashThreads,                      1,          "Number of threads verifying the decoded picture hash SEI messages in the background, 1: by the decoding thread")
+#endif
   ("TarDecLayerIdSetFile,l",    cfg_TargetDecLayerIdSetFile,           string(""), "targetDecLayerIdSet file name. The file should include white space separated LayerId values to be decoded. Omitting the option or a value of -1 in the file decodes all layers.")
   ("RespectDefDispWindow,w",    m_respectDefDispWindow,                0,          "Only output content inside the default display window\n")
 #if NH_MV
@@ -157,6 +169,35 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
     return false;
   }
 
+#if SUBSTREAM_PARALLEL_DEC
+  if (m_numSubstreamThreads < 1)
+  {
+    fprintf(stderr, "NumSubstreamThreads must be at least 1, aborting\n");
+    return false;
+  }
+#endif
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  if (m_numLoopFilterThreads < 1)
+  {
+    fprintf(stderr, "NumLoopFilterThreads must be at least 1, aborting\n");
+    return false;
+  }
+#endif
+#if NH_MV_LAYER_PARALLEL_DEC
+  if (m_numLayerThreads < 1)
+  {
+    fprintf(stderr, "NumLayerThreads must be at least 1, aborting\n");
+    return false;
+  }
+#endif
+#if PIC_HASH_PARALLEL_DEC
+  if (m_numHashThreads < 1)
+  {
+    fprintf(stderr, "NumHashThreads must be at least 1, aborting\n");
+    return false;
+  }
+#endif
+
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
 #if NH_MV
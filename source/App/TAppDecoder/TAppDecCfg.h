@@ -68,6 +68,18 @@ protected:
   Int           m_iMaxTemporalLayer;                  ///< maximum temporal layer to be decoded
   Int           m_decodedPictureHashSEIEnabled;       ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   Bool          m_decodedNoDisplaySEIEnabled;         ///< Enable(true)/disable(false) writing only pictures that get displayed based on the no display SEI message
+#if SUBSTREAM_PARALLEL_DEC
+  Int           m_numSubstreamThreads;                ///< number of threads decoding the substreams of a slice segment in parallel
+#endif
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  Int           m_numLoopFilterThreads;               ///< number of threads deblocking and applying SAO to the CTU rows of a picture in parallel
+#endif
+#if NH_MV_LAYER_PARALLEL_DEC
+  Int           m_numLayerThreads;                    ///< number of threads decoding the layers of an access unit in a pipeline
+#endif
+#if PIC_HASH_PARALLEL_DEC
+  Int           m_numHashThreads;                     ///< number of threads verifying the decoded picture hash SEI messages
+#endif
   std::string   m_colourRemapSEIFileName;             ///< output Colour Remapping file name
   std::vector<Int> m_targetDecLayerIdSet;             ///< set of LayerIds to be included in the sub-bitstream extraction process.
 
@@ -113,6 +125,18 @@ public:
   , m_iMaxTemporalLayer(-1)
   , m_decodedPictureHashSEIEnabled(0)
   , m_decodedNoDisplaySEIEnabled(false)
+#if SUBSTREAM_PARALLEL_DEC
+  , m_numSubstreamThreads(1)
+#endif
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  , m_numLoopFilterThreads(1)
+#endif
+#if NH_MV_LAYER_PARALLEL_DEC
+  , m_numLayerThreads(1)
+#endif
+#if PIC_HASH_PARALLEL_DEC
+  , m_numHashThreads(1)
+#endif
   , m_colourRemapSEIFileName()
   , m_targetDecLayerIdSet()
   , m_respectDefDispWindow(0)
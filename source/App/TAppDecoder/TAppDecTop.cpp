@@ -162,12 +162,13 @@ Void TAppDecTop::decode( Int num )
 
   InputByteStream bytestream(m_bitstreamFile);
 
-  while ( m_bitstreamFile )
+  Bool bEndOfFile = false;
+  while ( !bEndOfFile )
   {
     AnnexBStats stats = AnnexBStats();
     InputNALUnit nalu;
 
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    bEndOfFile = byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
 
     if (nalu.getBitstream().getFifo().empty())
     {
@@ -256,8 +257,9 @@ Void TAppDecTop::decode( )
   // main decoder loop
   Bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
   Bool loopFiltered = false;
+  Bool bEndOfFile = false;
 
-  while (!!bitstreamFile)
+  while (!bEndOfFile)
   {
     /* location serves to work around a design fault in the decoder, whereby
      * the process of reading a new slice that is the first slice of a new frame
@@ -265,14 +267,12 @@ Void TAppDecTop::decode( )
      * nal unit. */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::TComCodingStatisticsData backupStats(TComCodingStatistics::GetStatistics());
-    streampos location = bitstreamFile.tellg() - streampos(bytestream.GetNumBufferedBytes());
-#else
-    streampos location = bitstreamFile.tellg();
 #endif
+    streamoff location = bytestream.getPosition();
     AnnexBStats stats = AnnexBStats();
 
     InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    bEndOfFile = byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
 
     // call actual decoding function
     Bool bNewPicture = false;
@@ -298,29 +298,21 @@ Void TAppDecTop::decode( )
         bNewPicture = m_cTDecTop.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
         if (bNewPicture)
         {
-          bitstreamFile.clear();
-          /* location points to the current nalunit payload[1] due to the
-           * need for the annexB parser to read three extra bytes.
-           * [1] except for the first NAL unit in the file
-           *     (but bNewPicture doesn't happen then) */
+          bytestream.setPosition(location);
+          bEndOfFile = false;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-          bitstreamFile.seekg(location);
-          bytestream.reset();
           TComCodingStatistics::SetStatistics(backupStats);
-#else
-          bitstreamFile.seekg(location-streamoff(3));
-          bytestream.reset();
 #endif
         }
       }
     }
 
-    if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS) &&
+    if ( (bNewPicture || bEndOfFile || nalu.m_nalUnitType == NAL_UNIT_EOS) &&
 
       !m_cTDecTop.getFirstSliceInSequence () )
 
     {
-      if (!loopFiltered || bitstreamFile)
+      if (!loopFiltered || !bEndOfFile)
       {
         m_cTDecTop.executeLoopFilters(poc, pcListPic);
       }
@@ -330,7 +322,7 @@ Void TAppDecTop::decode( )
         m_cTDecTop.setFirstSliceInSequence(true);
       }
     }
-    else if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
+    else if ( (bNewPicture || bEndOfFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
               m_cTDecTop.getFirstSliceInSequence () )
     {
       m_cTDecTop.setFirstSliceInPicture (true);
@@ -415,7 +407,13 @@ Void TAppDecTop::xCreateDecLib()
 
 Void TAppDecTop::xDestroyDecLib()
 {
+#if PIC_HASH_PARALLEL_DEC
+  m_cPicHashPool.destroy();
+#endif
 #if NH_MV
+#if NH_MV_LAYER_PARALLEL_DEC
+  m_cLayerThreadPool.destroy();
+#endif
   // destroy ROM
   destroyROM();
 
@@ -467,12 +465,40 @@ Void TAppDecTop::xInitDecLib()
 #if NH_3D
   m_cCamParsCollector.setCodeScaleOffsetFile( m_pScaleOffsetFile );
 #endif
+#if PIC_HASH_PARALLEL_DEC
+  if ( m_numHashThreads > 1 && m_decodedPictureHashSEIEnabled && !m_cPicHashPool.isParallel() )
+  {
+    m_cPicHashPool.create( m_numHashThreads );
+#if NH_MV
+    // pictures removed from the DPB are deleted at the end of the access unit, once their hashes have been verified
+    m_dpb.setDeferPicDeletion( true );
+#endif
+  }
+#endif
 #if NH_MV
   m_dpb.setPrintPicOutput(m_printPicOutput);
+#if NH_MV_LAYER_PARALLEL_DEC
+  // tracing and bit statistics require the CTUs to be processed in decoding order
+  if ( m_numLayerThreads > 1 && !( ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS ) && !m_cLayerThreadPool.isParallel() )
+  {
+    m_cLayerThreadPool.create( m_numLayerThreads );
+    // pictures removed from the DPB may still be read by the pipeline until the end of the access unit
+    m_dpb.setDeferPicDeletion( true );
+  }
+#endif
 #else
   // initialize decoder class
   m_cTDecTop.init();
   m_cTDecTop.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+#if SUBSTREAM_PARALLEL_DEC
+  m_cTDecTop.setNumSubstreamThreads(m_numSubstreamThreads);
+#endif
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  m_cTDecTop.setNumLoopFilterThreads(m_numLoopFilterThreads);
+#endif
+#if PIC_HASH_PARALLEL_DEC
+  m_cTDecTop.setPicHashPool( m_cPicHashPool.isParallel() ? &m_cPicHashPool : NULL );
+#endif
 #if O0043_BEST_EFFORT_DECODING
   m_cTDecTop.setForceDecodeBitDepth(m_forceDecodeBitDepth);
 #endif
@@ -676,6 +702,10 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
   {
     return;
   }
+#if PIC_HASH_PARALLEL_DEC
+  // the flushed pictures are deleted
+  m_cPicHashPool.waitAll();
+#endif
   TComList<TComPic*>::iterator iterPic   = pcListPic->begin();
 
   iterPic   = pcListPic->begin();
@@ -1046,6 +1076,13 @@ Bool TAppDecTop::xIsSkipVclNalu( InputNALUnit& nalu, Bool isFirstSliceOfPic )
 
 Void TAppDecTop::xProcessNonVclNalu( InputNALUnit nalu )
 {
+#if NH_MV_LAYER_PARALLEL_DEC
+  // parameter sets are parsed with the entropy decoder of a layer and may replace the ones used by the pipeline
+  if ( nalu.m_nalUnitType == NAL_UNIT_VPS || nalu.m_nalUnitType == NAL_UNIT_SPS || nalu.m_nalUnitType == NAL_UNIT_PPS )
+  {
+    xFinishPipelinedPics();
+  }
+#endif
   xGetDecoder(nalu)->decodeNonVclNalu( nalu );
 
   if (  nalu.m_nalUnitType == NAL_UNIT_EOS )
@@ -1066,6 +1103,10 @@ Void TAppDecTop::xTerminateDecoding()
 #endif
    xFlushOutput(); 
    m_dpb.emptyAllSubDpbs();
+#if PIC_HASH_PARALLEL_DEC
+   // the checksum errors are complete when decode() returns
+   m_cPicHashPool.waitAll();
+#endif
 }
 
 
@@ -1111,6 +1152,19 @@ Void TAppDecTop::xDecodeFirstSliceOfPicture( InputNALUnit nalu, Bool sliceIsFirs
   m_curPic->setIsPocResettingPic            ( m_newPicIsPocResettingPic );
   m_curPic->setActivatesNewVps              ( m_newVpsActivatedbyCurPic );
 
+#if NH_MV_LAYER_PARALLEL_DEC
+  // the partition tables of the ROM, read by the layer pipeline, are re-initialized for a new CTU configuration
+  for ( TComList<TComPic*>::iterator it = m_curAu.begin(); it != m_curAu.end(); it++ )
+  {
+    const TComSPS& sps = (*it)->getPicSym()->getSPS();
+    if ( sps.getMaxCUWidth() != m_sps->getMaxCUWidth() || sps.getMaxCUHeight() != m_sps->getMaxCUHeight() || sps.getMaxTotalCUDepth() != m_sps->getMaxTotalCUDepth() )
+    {
+      xFinishPipelinedPics();
+      break;
+    }
+  }
+#endif
+
   dec     ->activatePSsAndInitPicOrSlice( m_curPic );
 
   m_decodingOrder[ nalu.m_nuhLayerId ]++;
@@ -1120,6 +1174,14 @@ Void TAppDecTop::xDecodeFirstSliceOfPicture( InputNALUnit nalu, Bool sliceIsFirs
   //   picture only after it is inserted to the DBP )
   m_curAu.addPic(  m_curPic, true );
 
+#if NH_MV_LAYER_PARALLEL_DEC
+  // the POC derivation of a POC resetting picture decrements the POCs of the pictures in the DPB
+  if ( m_newPicIsPocResettingPic || m_newPicIsFstPicOfAllLayOfPocResetPer )
+  {
+    xFinishPipelinedPics();
+  }
+#endif
+
   // Invoke Claus 8 and Annex F decoding process for a picture (only parts before POC derivation ).
   xPicDecoding( START_PIC, sliceIsFirstOfNewAu );
 
@@ -1178,6 +1240,10 @@ Void TAppDecTop::xFinalizePreviousPictures( Bool sliceIsFirstOfNewAU )
     }
 
     m_tDecTop[ xGetDecoderIdx( m_curPic->getLayerId() )]->finalizePic();
+#if NH_MV_LAYER_PARALLEL_DEC
+    // the borders of pictures decoded by the pipeline are extended CTU row by CTU row
+    if ( !m_cLayerThreadPool.isParallel() || m_curPic->getHasGeneratedRefPics() || m_curPic->getIsGenerated() )
+#endif
     m_curPic->getPicYuvRec()->extendPicBorder(); 
     m_newVpsActivatedbyCurPic = false;
   }
@@ -1198,6 +1264,12 @@ Void TAppDecTop::xFinalizePic(Bool curPicIsLastInAu )
   if ( m_curPic != NULL )
   {
     m_tDecTop[ xGetDecoderIdx(m_curPic->getLayerId() ) ]->executeLoopFilters( ); // 8.7
+#if NH_MV_LAYER_PARALLEL_DEC
+    if ( m_cLayerThreadPool.isParallel() )
+    {
+      m_pipelinedDecoders.push_back( m_tDecTop[ xGetDecoderIdx(m_curPic->getLayerId() ) ] );
+    }
+#endif
 
     // Invoke Claus 8 and F.8 decoding process for a picture (only parts after POC derivation )
     xPicDecoding(FINALIZE_PIC, curPicIsLastInAu );
@@ -1215,6 +1287,9 @@ Void TAppDecTop::xFinalizePic(Bool curPicIsLastInAu )
 
 Void TAppDecTop::xFinalizeAU()
 {
+#if NH_MV_LAYER_PARALLEL_DEC
+  xFinishPipelinedPics();
+#endif
 #if NH_3D
   if ( !m_curAu.empty())
   {
@@ -1228,8 +1303,31 @@ Void TAppDecTop::xFinalizeAU()
     }
   }
 #endif
+#if PIC_HASH_PARALLEL_DEC
+  const std::vector<TComPic*>& removedPics = m_dpb.getRemovedPics();
+  for ( size_t i = 0; i < removedPics.size(); i++ )
+  {
+    m_cPicHashPool.waitForPic( removedPics[i] );
+  }
+#endif
+#if NH_MV_LAYER_PARALLEL_DEC || PIC_HASH_PARALLEL_DEC
+  m_dpb.deleteRemovedPics();
+#endif
 }
 
+#if NH_MV_LAYER_PARALLEL_DEC
+/** Wait for the pictures in the layer pipeline and print their status in decoding order.
+ */
+Void TAppDecTop::xFinishPipelinedPics()
+{
+  for ( size_t i = 0; i < m_pipelinedDecoders.size(); i++ )
+  {
+    m_pipelinedDecoders[i]->finishPipelinedPic();
+  }
+  m_pipelinedDecoders.clear();
+}
+#endif
+
 
 Void TAppDecTop::xF811GeneralDecProc( InputNALUnit nalu )
 {
@@ -2672,6 +2770,18 @@ Int TAppDecTop::xGetDecoderIdx( Int layerId, Bool createFlag /*= false */ )
     m_tDecTop[ decIdx ]->init( );
     m_tDecTop[ decIdx ]->setLayerId( layerId );
     m_tDecTop[ decIdx ]->setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+#if SUBSTREAM_PARALLEL_DEC
+    m_tDecTop[ decIdx ]->setNumSubstreamThreads(m_numSubstreamThreads);
+#endif
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+    m_tDecTop[ decIdx ]->setNumLoopFilterThreads(m_numLoopFilterThreads);
+#endif
+#if NH_MV_LAYER_PARALLEL_DEC
+    m_tDecTop[ decIdx ]->setLayerThreadPool( m_cLayerThreadPool.isParallel() ? &m_cLayerThreadPool : NULL );
+#endif
+#if PIC_HASH_PARALLEL_DEC
+    m_tDecTop[ decIdx ]->setPicHashPool( m_cPicHashPool.isParallel() ? &m_cPicHashPool : NULL );
+#endif
     m_tDecTop[ decIdx ]->setDpb( &m_dpb );
     m_tDecTop[ decIdx ]->setTargetOlsIdx( m_targetOptLayerSetIdx );
     m_tDecTop[ decIdx ]->setFirstPicInLayerDecodedFlag( m_firstPicInLayerDecodedFlag );
@@ -2989,6 +3099,11 @@ Void TAppDecTop::xCropAndOutput( TComPic* curPic )
   assert( !curPic->getHasGeneratedRefPics() );
   assert( !curPic->getIsGenerated()         );
 
+#if NH_MV_LAYER_PARALLEL_DEC
+  // the picture may still be decoded by the layer pipeline
+  curPic->waitForReconstruction();
+#endif
+
   Int decIdx = xGetDecoderIdx( curPic->getLayerId() );
 
   if (!m_reconOpen[ decIdx ])
@@ -69,6 +69,10 @@ private:
 
   TComPic*                        m_curPic;                                    ///< currently decoded picture
   TComAu                          m_curAu;                                     ///< currently decoded Au
+#if NH_MV_LAYER_PARALLEL_DEC
+  TComThreadPool                  m_cLayerThreadPool;                          ///< threads decoding the layers of an access unit in a pipeline
+  std::vector<TDecTop*>           m_pipelinedDecoders;                         ///< decoders with a picture in the pipeline, in decoding order
+#endif
  
   // Random access related 
   Bool                            m_handleCraAsBlaFlag; 
@@ -125,6 +129,9 @@ private:
   TVideoIOYuv                     m_cTVideoIOYuvReconFile;        ///< reconstruction YUV class
   // for output control
   Int                             m_iPOCLastDisplay;              ///< last POC in display order
+#endif
+#if PIC_HASH_PARALLEL_DEC
+  TDecPicHashPool                 m_cPicHashPool;                 ///< threads verifying the decoded picture hash SEI messages
 #endif
   std::ofstream                   m_seiMessageFileStream;         ///< Used for outputing SEI messages.  
 
@@ -173,6 +180,9 @@ protected:
   Void xFinalizePreviousPictures           ( Bool sliceIsFirstOfNewAU );
   Void xFinalizePic                        ( Bool curPicIsLastInAu );
   Void xFinalizeAU                         ( );
+#if NH_MV_LAYER_PARALLEL_DEC
+  Void xFinishPipelinedPics                ( );
+#endif
   Void xPicDecoding                        ( DecProcPart curPart, Bool picPosInAuIndication ); 
 
   // Clause 8
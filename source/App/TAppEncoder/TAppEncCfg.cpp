@@ -837,6 +837,12 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   // Layer dependencies
   ("DirectRefLayers_%d"            , m_directRefLayers             , IntAry1d(0,0), MAX_NUM_LAYERS,                  "LayerIdx in VPS of direct reference layers")
   ("DependencyTypes_%d"            , m_dependencyTypes             , IntAry1d(0,0), MAX_NUM_LAYERS,                  "Dependency types of direct reference layers, 0: Sample 1: Motion 2: Sample+Motion")
+#if NH_MV_LAYER_PARALLEL_ENC
+  ("NumLayerThreads"               , m_numLayerThreads             , 1,                                             "Number of threads encoding the layers of an access unit in parallel, 1: sequential")
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+  ("FrameParallelEncoding"         , m_frameParallelEncoding       , false,                                         "Overlap the access units of a GOP in the layer threads (NumLayerThreads > 1), pictures wait for the access units of their reference pictures")
+#endif
 #endif
   ("SourceWidth,-wdt",                                m_iSourceWidth,                                       0, "Source picture width")
   ("SourceHeight,-hgt",                               m_iSourceHeight,                                      0, "Source picture height")
@@ -875,11 +881,17 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("FrameRate,-fr",                                   m_iFrameRate,                                         0, "Frame rate")
   ("FrameSkip,-fs",                                   m_FrameSkip,                                         0u, "Number of frames to skip at start of input YUV")
   ("FramesToBeEncoded,f",                             m_framesToBeEncoded,                                  0, "Number of frames to be encoded (default=all)")
+#if YUV_INPUT_PREFETCH
+  ("InputPrefetchFrames",                             m_inputPrefetchFrames,                                0, "Number of frames of each input file read ahead in a separate thread, 0: read when needed")
+#endif
   ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
+#if PIC_METRICS_PARALLEL_ENC
+  ("NumMetricsThreads",                               m_numMetricsThreads,                                  1, "Number of threads computing PSNR, MSE and decoded picture hash of the coded pictures in the background, 1: computed by the encoding thread")
+#endif
 
   //Field coding parameters
   ("FieldCoding",                                     m_isField,                                        false, "Signals if it's a field based coding")
@@ -999,6 +1011,9 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("LoopFilterBetaOffset_div2",                       m_loopFilterBetaOffsetDiv2,                           0)
   ("LoopFilterTcOffset_div2",                         m_loopFilterTcOffsetDiv2,                             0)
   ("DeblockingFilterMetric",                          m_DeblockingFilterMetric,                         false)
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  ("NumLoopFilterThreads",                            m_numLoopFilterThreads,                               1, "Number of threads deblocking and applying SAO to the CTU rows of a picture in parallel, 1: sequential")
+#endif
 
   // Coding tools
   ("AMP",                                             m_enableAMP,                                       true, "Enable asymmetric motion partitions")
@@ -1064,6 +1079,9 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("TileRowHeightArray",                              cfg_RowHeight,                            cfg_RowHeight, "Array containing tile row height values in units of CTU")
   ("LFCrossTileBoundaryFlag",                         m_bLFCrossTileBoundaryFlag,                        true, "1: cross-tile-boundary loop filtering. 0:non-cross-tile-boundary loop filtering")
   ("WaveFrontSynchro",                                m_entropyCodingSyncEnabledFlag,                   false, "0: entropy coding sync disabled; 1 entropy coding sync enabled")
+#if WPP_PARALLEL_ENC
+  ("NumWppThreads",                                   m_numWppThreads,                                      1, "Number of threads compressing the CTU rows of a wavefront slice in parallel, 1: sequential")
+#endif
   ("ScalingList",                                     m_useScalingListId,                    SCALING_LIST_OFF, "0/off: no scaling list, 1/default: default scaling lists, 2/file: scaling lists specified in ScalingListFile")
   ("ScalingListFile",                                 m_scalingListFileName,                       string(""), "Scaling list file name. Use an empty string to produce help.")
   ("SignHideFlag,-SBH",                               m_signHideFlag,                                    true)
@@ -1299,6 +1317,9 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
                                                                                                               
   ("UseEstimatedVSD",                                 m_bUseEstimatedVSD        , true                          ,"Model based VSD estimation instead of rendering based for some encoder decisions" )      
   ("VSOEarlySkip",                                    m_bVSOEarlySkip           , true                          ,"Early skip of VSO computation if synthesis error assumed to be zero" )      
+#if H_3D_VSO_PARALLEL_MODELS
+  ("NumVSOThreads",                                   m_numVSOThreads           , 1                             ,"Number of threads evaluating the render models of the VSO in parallel, 1: sequential" )
+#endif
                                                                                                                
   ("WVSO",                                            m_bUseWVSO                , true                          ,"Use depth fidelity term for VSO" )
   ("VSOWeight",                                       m_iVSOWeight              , 10                            ,"Synthesized View Distortion Change weight" )
@@ -2256,8 +2277,29 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_InputChromaFormatIDC >= NUM_CHROMA_FORMAT,                                "InputChromaFormatIDC must be either 400, 420, 422 or 444" );
   xConfirmPara( m_iFrameRate <= 0,                                                          "Frame rate must be more than 1" );
   xConfirmPara( m_framesToBeEncoded <= 0,                                                   "Total Number Of Frames encoded must be more than 0" );
+#if YUV_INPUT_PREFETCH
+  xConfirmPara( m_inputPrefetchFrames < 0,                                                  "InputPrefetchFrames must be greater than or equal to 0" );
+#endif
 #if NH_MV
   xConfirmPara( m_numberOfLayers > MAX_NUM_LAYER_IDS ,                                      "NumberOfLayers must be less than or equal to MAX_NUM_LAYER_IDS");
+#if NH_MV_LAYER_PARALLEL_ENC
+  xConfirmPara( m_numLayerThreads < 1 ,                                                     "NumLayerThreads must be greater than or equal to 1");
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+  // the access units overlap in the layer threads, which trace output keeps sequential
+  if( m_frameParallelEncoding && ( ENC_DEC_TRACE || std::min( m_numLayerThreads, m_numberOfLayers ) < 2 ) )
+  {
+    printf("Warning: FrameParallelEncoding is set to false because the layers are encoded sequentially.\n");
+    m_frameParallelEncoding = false;
+  }
+#if NH_3D
+  if( m_frameParallelEncoding && m_cCameraData.getVaryingCameraParameters() )
+  {
+    printf("Warning: FrameParallelEncoding is set to false because the camera parameters vary over time and are updated per access unit.\n");
+    m_frameParallelEncoding = false;
+  }
+#endif
+#endif
 
 
   xConfirmPara( m_layerIdInNuh[0] != 0      , "LayerIdInNuh must be 0 for the first layer. ");
@@ -2606,6 +2648,15 @@ Void TAppEncCfg::xCheckParameter()
   {
     xConfirmPara( tileFlag && m_entropyCodingSyncEnabledFlag, "Tiles and entropy-coding-sync (Wavefronts) can not be applied together, except in the High Throughput Intra 4:4:4 16 profile");
   }
+#if WPP_PARALLEL_ENC
+  xConfirmPara( m_numWppThreads < 1,                                                        "NumWppThreads must be greater than or equal to 1");
+#endif
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  xConfirmPara( m_numLoopFilterThreads < 1,                                                 "NumLoopFilterThreads must be greater than or equal to 1");
+#endif
+#if PIC_METRICS_PARALLEL_ENC
+  xConfirmPara( m_numMetricsThreads < 1,                                                    "NumMetricsThreads must be greater than or equal to 1");
+#endif
 
   xConfirmPara( m_iSourceWidth  % TComSPS::getWinUnitX(m_chromaFormatIDC) != 0, "Picture width must be an integer multiple of the specified chroma subsampling");
   xConfirmPara( m_iSourceHeight % TComSPS::getWinUnitY(m_chromaFormatIDC) != 0, "Picture height must be an integer multiple of the specified chroma subsampling");
@@ -2637,6 +2688,9 @@ Void TAppEncCfg::xCheckParameter()
     {
       xConfirmPara(   m_pchVSOConfig            == 0                             ,   "VSO Setup string must be given");
       xConfirmPara( m_uiVSOMode > 4 ,                                                "VSO Mode must be less than 5");
+#if H_3D_VSO_PARALLEL_MODELS
+      xConfirmPara( m_numVSOThreads < 1 ,                                            "NumVSOThreads must be greater than or equal to 1");
+#endif
     }
 #endif
   // max CU width and height should be power of 2
@@ -3420,6 +3474,9 @@ Void TAppEncCfg::xPrintParameter()
     printf("Frame/Field                       : Frame based coding\n");
     printf("Frame index                       : %u - %d (%d frames)\n", m_FrameSkip, m_FrameSkip+m_framesToBeEncoded-1, m_framesToBeEncoded );
   }
+#if YUV_INPUT_PREFETCH
+  printf("Input prefetch                    : %d frames\n", m_inputPrefetchFrames );
+#endif
 #if NH_MV
   printf("Profile                           :");
   for (Int i = 0; i < m_profiles.size(); i++)
@@ -3608,6 +3665,9 @@ Void TAppEncCfg::xPrintParameter()
     printf("VSO LS Table                      : %d\n",    m_bVSOLSTable ? 1 : 0);
     printf("VSO Estimated VSD                 : %d\n",    m_bUseEstimatedVSD ? 1 : 0);
     printf("VSO Early Skip                    : %d\n",    m_bVSOEarlySkip ? 1 : 0);   
+#if H_3D_VSO_PARALLEL_MODELS
+    printf("VSO Threads                       : %d\n",    m_numVSOThreads   );
+#endif
     if ( m_bUseWVSO )
     {
       printf("Dist. Weights (VSO/VSD/SAD)       : %d/%d/%d\n ", m_iVSOWeight, m_iVSDWeight, m_iDWeight );    
@@ -3668,6 +3728,12 @@ Void TAppEncCfg::xPrintParameter()
   printf("PME:%d ", m_log2ParallelMergeLevel);
   const Int iWaveFrontSubstreams = m_entropyCodingSyncEnabledFlag ? (m_iSourceHeight + m_uiMaxCUHeight - 1) / m_uiMaxCUHeight : 1;
   printf(" WaveFrontSynchro:%d WaveFrontSubstreams:%d", m_entropyCodingSyncEnabledFlag?1:0, iWaveFrontSubstreams);
+#if WPP_PARALLEL_ENC
+  printf(" WppThreads:%d", m_numWppThreads );
+#endif
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  printf(" LoopFilterThreads:%d", m_numLoopFilterThreads );
+#endif
   printf(" ScalingList:%d ", m_useScalingListId );
   printf("TMVPMode:%d ", m_TMVPModeId     );
 #if ADAPTIVE_QP_SELECTION
@@ -3676,6 +3742,15 @@ Void TAppEncCfg::xPrintParameter()
 
   printf(" SignBitHidingFlag:%d ", m_signHideFlag);
   printf("RecalQP:%d", m_recalculateQPAccordingToLambda ? 1 : 0 );
+#if NH_MV_LAYER_PARALLEL_ENC
+  printf(" LayerThreads:%d", m_numLayerThreads );
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+  printf(" FrameParallel:%d", m_frameParallelEncoding ? 1 : 0 );
+#endif
+#if PIC_METRICS_PARALLEL_ENC
+  printf(" MetricsThreads:%d", m_numMetricsThreads );
+#endif
 #if NH_3D_VSO
   printf(" VSO:%d ", m_bUseVSO   );
   printf("WVSO:%d ", m_bUseWVSO );  
@@ -103,6 +103,12 @@ protected:
   // Dependencies
   IntAry2d m_directRefLayers;          ///< LayerIds of direct reference layers
   IntAry2d m_dependencyTypes;          ///< Dependency types of direct reference layers
+#if NH_MV_LAYER_PARALLEL_ENC
+  Int      m_numLayerThreads;          ///< number of threads encoding the layers of an access unit in parallel
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+  Bool     m_frameParallelEncoding;    ///< overlap the access units of a GOP in the layer threads
+#endif
 
   // VPS VUI
   Bool m_vpsVuiPresentFlag;
@@ -143,6 +149,9 @@ protected:
   // source specification
   Int       m_iFrameRate;                                     ///< source frame-rates (Hz)
   UInt      m_FrameSkip;                                   ///< number of skipped frames from the beginning
+#if YUV_INPUT_PREFETCH
+  Int       m_inputPrefetchFrames;                         ///< number of frames of each input file read ahead in a separate thread
+#endif
   Int       m_iSourceWidth;                                   ///< source width in pixel
   Int       m_iSourceHeight;                                  ///< source height in pixel (when interlaced = field height)
 
@@ -321,6 +330,9 @@ protected:
   Int       m_loopFilterBetaOffsetDiv2;                     ///< beta offset for deblocking filter
   Int       m_loopFilterTcOffsetDiv2;                       ///< tc offset for deblocking filter
   Bool      m_DeblockingFilterMetric;                         ///< blockiness metric in encoder
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  Int       m_numLoopFilterThreads;                           ///< number of threads deblocking and applying SAO to the CTU rows of a picture
+#endif
 
   // coding tools (PCM)
   Bool      m_usePCM;                                         ///< flag for using IPCM
@@ -368,6 +380,9 @@ protected:
   std::vector<Int> m_tileColumnWidth;
   std::vector<Int> m_tileRowHeight;
   Bool      m_entropyCodingSyncEnabledFlag;
+#if WPP_PARALLEL_ENC
+  Int       m_numWppThreads;                                  ///< number of threads compressing the CTU rows of a wavefront slice
+#endif
 
   Bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
   Bool      m_bFastUDIUseMPMEnabled;
@@ -521,6 +536,9 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+#if PIC_METRICS_PARALLEL_ENC
+  Int         m_numMetricsThreads;                            ///< number of threads computing PSNR and decoded picture hash of the coded pictures
+#endif
 #if NH_MV
   Bool              m_outputVpsInfo;
   TChar*            m_pchBaseViewCameraNumbers;
@@ -539,6 +557,9 @@ protected:
   Bool      m_bUseVSO;                                        ///< flag for using View Synthesis Optimization
   Bool      m_bVSOLSTable;                                    ///< Depth QP dependent Lagrange parameter optimization (m23714)
   Bool      m_bVSOEarlySkip;                                  ///< Early skip of VSO computation (JCT3V-A0093 modification 4)
+#if H_3D_VSO_PARALLEL_MODELS
+  Int       m_numVSOThreads;                                  ///< number of threads evaluating the render models in parallel
+#endif
                                                               
   //// Used for development by GT, might be removed later     
   Double    m_dLambdaScaleVSO;                                ///< Scaling factor for Lambda in VSO mode
@@ -415,6 +415,9 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setLoopFilterBetaOffset                              ( m_loopFilterBetaOffsetDiv2  );
   m_cTEncTop.setLoopFilterTcOffset                                ( m_loopFilterTcOffsetDiv2    );
   m_cTEncTop.setDeblockingFilterMetric                            ( m_DeblockingFilterMetric );
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  m_cTEncTop.setNumLoopFilterThreads                              ( m_numLoopFilterThreads );
+#endif
 
   //====== Motion search ========
   m_cTEncTop.setDisableIntraPUsInInterSlices                      ( m_bDisableIntraPUsInInterSlices );
@@ -646,6 +649,9 @@ Void TAppEncTop::xInitLibCfg()
   }
   m_cTEncTop.setLFCrossTileBoundaryFlag                           ( m_bLFCrossTileBoundaryFlag );
   m_cTEncTop.setEntropyCodingSyncEnabledFlag                      ( m_entropyCodingSyncEnabledFlag );
+#if WPP_PARALLEL_ENC
+  m_cTEncTop.setNumWppThreads                                     ( m_numWppThreads );
+#endif
   m_cTEncTop.setTMVPModeId                                        ( m_TMVPModeId );
   m_cTEncTop.setUseScalingListId                                  ( m_useScalingListId  );
   m_cTEncTop.setScalingListFileName                               ( m_scalingListFileName );
@@ -819,6 +825,9 @@ Void TAppEncTop::xInitLibCfg()
           m_cRendererModel  .createSingleModel   ( iViewNum, iContent, iModelNum, iLeftViewNum, iRightViewNum, (iOrgRefNum != -1), iBlendMode );
         }            
       }
+#if H_3D_VSO_PARALLEL_MODELS
+      m_cRendererModel.createThreadPool( m_numVSOThreads );
+#endif
     }
     else
     {
@@ -848,6 +857,33 @@ Void TAppEncTop::xCreateLib()
     }
     m_acTEncTopList[layer]->create();
   }
+#if NH_MV_LAYER_PARALLEL_ENC
+  // trace output of all layers goes to the same file, keep the layers sequential in this case
+  m_cLayerThreadPool.create( ENC_DEC_TRACE ? 1 : std::min( m_numLayerThreads, m_numberOfLayers ) );
+#if NH_MV_FRAME_PARALLEL_ENC
+  // cleared by TAppEncCfg::xCheckParameter() otherwise
+  assert( !m_frameParallelEncoding || m_cLayerThreadPool.isParallel() );
+  m_numFinishedAus        = 0;
+  m_gopAuIdx              = 0;
+#endif
+  m_layerJobs.resize( m_iGOPSize * m_numberOfLayers );
+  m_numAus = 0;
+  for( Int layer=0; layer < m_numberOfLayers; layer++)
+  {
+    m_layerProgress.push_back( new TComProgress );
+    m_acTEncTopList[layer]->setLayerOutputMutex( m_cLayerThreadPool.isParallel() ? &m_layerOutputMutex : NULL );
+#if NH_MV_FRAME_PARALLEL_ENC
+    m_acTEncTopList[layer]->setRefMarkingMutex( m_frameParallelEncoding ? &m_refMarkingMutex : NULL );
+#endif
+  }
+#endif
+#if PIC_METRICS_PARALLEL_ENC
+  m_cPicMetricsPool.create( m_numMetricsThreads );
+  for( Int layer=0; layer < m_numberOfLayers; layer++)
+  {
+    m_acTEncTopList[layer]->setPicMetricsPool( &m_cPicMetricsPool );
+  }
+#endif
 #else
   // Video I/O
   m_cTVideoIOYuvInputFile.open( m_inputFileName,     false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
@@ -860,12 +896,24 @@ Void TAppEncTop::xCreateLib()
 
   // Neo Decoder
   m_cTEncTop.create();
+#if PIC_METRICS_PARALLEL_ENC
+  m_cPicMetricsPool.create( m_numMetricsThreads );
+  m_cTEncTop.setPicMetricsPool( &m_cPicMetricsPool );
+#endif
 #endif
 }
 
 Void TAppEncTop::xDestroyLib()
 {
 #if NH_MV
+#if NH_MV_LAYER_PARALLEL_ENC
+  m_cLayerThreadPool.destroy();
+  for( Int layer=0; layer < m_layerProgress.size(); layer++)
+  {
+    delete m_layerProgress[layer];
+  }
+  m_layerProgress.clear();
+#endif
   // destroy ROM
   destroyROM();
 
@@ -892,6 +940,9 @@ Void TAppEncTop::xDestroyLib()
   // Neo Decoder
   m_cTEncTop.destroy();
 #endif
+#if PIC_METRICS_PARALLEL_ENC
+  m_cPicMetricsPool.destroy();
+#endif
 }
 
 Void TAppEncTop::xInitLib(Bool isFieldCoding)
@@ -943,6 +994,9 @@ Void TAppEncTop::encode()
 
   printChromaFormat();
 
+#if NH_MV_LAYER_PARALLEL_ENC
+  xSetLayerJobDependencies();
+#endif
   // main encoder loop
 #if NH_MV
   Bool  allEos = false;
@@ -991,6 +1045,23 @@ Void TAppEncTop::encode()
     cPicYuvTrueOrg.create(m_iSourceWidth, m_iSourceHeight, m_chromaFormatIDC, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth, true );
   }
 #endif
+#if YUV_INPUT_PREFETCH
+  // read ahead, so that the encoder does not wait for the input files at the start of a GOP
+#if NH_MV
+  for(Int layer=0; layer < m_numberOfLayers; layer++ )
+  {
+#if NH_3D
+    TComPicYuv* pcPicYuvOrg = picYuvOrg[ m_depthFlag[layer] ];
+#endif
+    if (xLayerIdInTargetEncLayerIdList( m_vps->getLayerIdInNuh( layer ) ))
+    {
+      m_acTVideoIOYuvInputFileList[layer]->startPrefetch( m_inputPrefetchFrames, m_framesToBeEncoded, pcPicYuvOrg, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth, ipCSC, m_aiPad, m_InputChromaFormatIDC );
+    }
+  }
+#else
+  m_cTVideoIOYuvInputFile.startPrefetch( m_inputPrefetchFrames, m_isField ? ( m_framesToBeEncoded >> 1 ) : m_framesToBeEncoded, pcPicYuvOrg, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+#endif
+#endif
 #if NH_MV
   while ( (m_targetEncLayerIdList.size() != 0 ) && !allEos )
   {
@@ -1041,6 +1112,17 @@ Void TAppEncTop::encode()
       {
         m_cCameraData.update( iNextPoc );
       }
+#endif
+#if NH_MV_LAYER_PARALLEL_ENC
+      if ( m_cLayerThreadPool.isParallel() )
+      {
+#if NH_3D
+        xEncodeLayersParallel( bitstreamFile, eos, flush, picYuvOrg, picYuvTrueOrg, snrCSC, gopId, gopSize );
+#else
+        xEncodeLayersParallel( bitstreamFile, eos, flush, &pcPicYuvOrg, &cPicYuvTrueOrg, snrCSC, gopId, gopSize );
+#endif
+        continue;
+      }
 #endif
       for(Int layer=0; layer < m_numberOfLayers; layer++ )
       {
@@ -1173,6 +1255,229 @@ Void TAppEncTop::encode()
 // Protected member functions
 // ====================================================================================================================
 
+#if NH_MV_LAYER_PARALLEL_ENC
+/**
+ - a layer waits for its direct reference layers
+ - layers using VSO share the renderer model and read reconstructed pictures of other layers,
+   they wait for all preceding layers and use the renderer model in coding order
+ .
+ */
+Void TAppEncTop::xSetLayerJobDependencies()
+{
+  for( Int jobIdx = 0; jobIdx < (Int) m_layerJobs.size(); jobIdx++ )
+  {
+    Int       layer = jobIdx % m_numberOfLayers;
+    LayerJob& job   = m_layerJobs[ jobIdx ];
+    job.pcApp     = this;
+    job.layer     = layer;
+    job.auIdx     = 0;
+    job.waitLayers.clear();
+    job.waitLayersPrevAu.clear();
+
+    Bool waitForAll = false;
+#if NH_3D_VSO
+    waitForAll = m_acTEncTopList[ layer ]->getUseVSO();
+#endif
+    if ( waitForAll )
+    {
+      for( Int refLayer = 0; refLayer < layer; refLayer++ )
+      {
+        job.waitLayers.push_back( refLayer );
+      }
+#if NH_3D_VSO
+      for( Int vsoLayer = layer + 1; vsoLayer < m_numberOfLayers; vsoLayer++ )
+      {
+        if ( m_acTEncTopList[ vsoLayer ]->getUseVSO() )
+        {
+          job.waitLayersPrevAu.push_back( vsoLayer );
+        }
+      }
+#endif
+    }
+    else
+    {
+      for( Int i = 0; i < (Int) m_directRefLayers[ layer ].size(); i++ )
+      {
+        job.waitLayers.push_back( m_directRefLayers[ layer ][ i ] );
+      }
+    }
+  }
+}
+
+Void TAppEncTop::xEncodeLayerJob( Void* param )
+{
+  LayerJob*   job = (LayerJob*) param;
+  TAppEncTop* app = job->pcApp;
+
+  // the pictures of a layer are coded one after the other
+  app->m_layerProgress[ job->layer ]->waitFor( job->auIdx );
+  for( Int i = 0; i < (Int) job->waitLayers.size(); i++ )
+  {
+    app->m_layerProgress[ job->waitLayers[ i ] ]->waitFor( job->auIdx + 1 );
+  }
+  for( Int i = 0; i < (Int) job->waitLayersPrevAu.size(); i++ )
+  {
+    app->m_layerProgress[ job->waitLayersPrevAu[ i ] ]->waitFor( job->auIdx );
+  }
+
+  TEncTop* encTop = app->m_acTEncTopList[ job->layer ];
+#if NH_3D_VSO
+  if ( job->setDispCoeff )
+  {
+    encTop->setDispCoeff( job->dispCoeff );
+  }
+#endif
+  const Int pocLastCoded = encTop->getGOPEncoder()->getPocLastCoded();
+  job->numEncoded = 0;
+  encTop->encode( job->eos, job->pcPicYuvOrg, job->pcPicYuvTrueOrg, job->snrCSC, *app->m_cListPicYuvRec[ job->layer ], job->accessUnits, job->numEncoded, job->gopId );
+
+  job->pcPic = NULL;
+  if ( encTop->getGOPEncoder()->getPocLastCoded() != pocLastCoded )
+  {
+    job->pcPic = encTop->getPic( encTop->getGOPEncoder()->getPocLastCoded() );
+    // Extend the border before other layers get access, otherwise concurrent users of the picture would extend it at the same time.
+    job->pcPic->getPicYuvRec()->extendPicBorder();
+  }
+  app->m_layerProgress[ job->layer ]->set( job->auIdx + 1 );
+#if NH_MV_FRAME_PARALLEL_ENC
+  if ( app->m_frameParallelEncoding )
+  {
+    app->xFinishAccessUnits();
+  }
+#endif
+}
+
+/**
+ - layers are submitted in coding order, a job only waits for jobs submitted before it
+ - with FrameParallelEncoding the access units of a GOP are submitted without waiting, a picture waits for the access units
+   of its temporal reference pictures (TEncGOP), so pictures of consecutive access units overlap in the layer threads
+ - access units are written in coding order when all layers are finished, the bitstream is identical to sequential coding
+ .
+ */
+Void TAppEncTop::xEncodeLayersParallel( std::ostream& bitstreamFile, std::vector<Bool>& eos, std::vector<Bool>& flush, TComPicYuv** picYuvOrg, TComPicYuv* picYuvTrueOrg, const InputColourSpaceConversion snrCSC, Int gopId, Int gopSize )
+{
+#if NH_3D_VSO
+  UInt iNextPoc = m_acTEncTopList[0] -> getFrameId( gopId );
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+  if ( gopId == 0 )
+  {
+    m_gopAuIdx = m_numAus;
+  }
+#endif
+  for( Int layer = 0; layer < m_numberOfLayers; layer++ )
+  {
+    LayerJob& job = m_layerJobs[ gopId * m_numberOfLayers + layer ];
+    job.auIdx = m_numAus;
+    job.pcPic = NULL;
+    if (!xLayerIdInTargetEncLayerIdList( m_vps->getLayerIdInNuh( layer ) ))
+    {
+      m_layerProgress[ layer ]->set( job.auIdx + 1 );
+      continue;
+    }
+#if NH_3D
+    Int orgIdx = m_depthFlag[ layer ];
+#else
+    Int orgIdx = 0;
+#endif
+#if NH_3D_VSO
+    // set by the job, the encoder of the layer may still code the previous access unit
+    job.setDispCoeff = m_bUseVSO && m_bUseEstimatedVSD && iNextPoc < m_framesToBeEncoded;
+    if( job.setDispCoeff )
+    {
+      m_cCameraData.setDispCoeff( iNextPoc, m_acTEncTopList[layer]->getViewIndex() );
+      job.dispCoeff = m_cCameraData.getDispCoeff();
+    }
+#endif
+    job.gopId           = gopId;
+    job.eos             = eos[ layer ];
+    job.pcPicYuvOrg     = flush[ layer ] ? 0 : picYuvOrg[ orgIdx ];
+    job.pcPicYuvTrueOrg = flush[ layer ] ? 0 : &picYuvTrueOrg[ orgIdx ];
+    job.snrCSC          = snrCSC;
+    m_cLayerThreadPool.addJob( xEncodeLayerJob, &job );
+  }
+  m_numAus++;
+
+  Int firstGopId = gopId;
+#if NH_MV_FRAME_PARALLEL_ENC
+  if ( m_frameParallelEncoding )
+  {
+    // skipped layers may complete the access unit
+    xFinishAccessUnits();
+    if ( gopId + 1 < gopSize )
+    {
+      return;
+    }
+    firstGopId = 0;
+  }
+#endif
+  m_cLayerThreadPool.waitAll();
+
+  for( Int id = firstGopId; id <= gopId; id++ )
+  {
+    for( Int layer = 0; layer < m_numberOfLayers; layer++ )
+    {
+      LayerJob& job = m_layerJobs[ id * m_numberOfLayers + layer ];
+      if (!xLayerIdInTargetEncLayerIdList( m_vps->getLayerIdInNuh( layer ) ))
+      {
+        continue;
+      }
+#if NH_MV_FRAME_PARALLEL_ENC
+      // with overlapped access units the marking is reverted by TEncGOP when the reference picture lists are set
+      if ( !m_frameParallelEncoding )
+#endif
+      m_acTEncTopList[ layer ]->getGOPEncoder()->markIvRefPicsAsShortTerm();
+      xWriteOutput( bitstreamFile, job.numEncoded, job.accessUnits, layer );
+      job.accessUnits.clear();
+    }
+  }
+}
+
+#if NH_MV_FRAME_PARALLEL_ENC
+/**
+ - an access unit is finished when all its layers are coded, the motion of its pictures is compressed then
+   (the sequential encoder compresses it when the layer codes its next picture)
+ - pictures of later access units referring to one of its pictures wait for this (TEncGOP::xWaitForRefPicAus)
+ .
+ */
+Void TAppEncTop::xFinishAccessUnits()
+{
+  std::lock_guard<std::mutex> lock( m_finishedAusMutex );
+  while ( true )
+  {
+    for( Int layer = 0; layer < m_numberOfLayers; layer++ )
+    {
+      if ( m_layerProgress[ layer ]->get() <= m_numFinishedAus )
+      {
+        return;
+      }
+    }
+    const Int gopId = m_numFinishedAus - m_gopAuIdx;
+#if NH_3D
+    for( Int layer = 0; layer < m_numberOfLayers; layer++ )
+    {
+      TComPic* pic = m_layerJobs[ gopId * m_numberOfLayers + layer ].pcPic;
+      if ( pic != NULL )
+      {
+        pic->compressMotion( 1 );
+      }
+    }
+#endif
+    // all pictures are compressed before the first waiting picture may read one of them
+    for( Int layer = 0; layer < m_numberOfLayers; layer++ )
+    {
+      TComPic* pic = m_layerJobs[ gopId * m_numberOfLayers + layer ].pcPic;
+      if ( pic != NULL )
+      {
+        pic->setAuFinished();
+      }
+    }
+    m_numFinishedAus++;
+  }
+}
+#endif
+#endif
+
 /**
  - application has picture buffer list with size of GOP
  - picture buffer list acts as ring buffer
@@ -49,6 +49,10 @@
 #include "../../Lib/TLibRenderer/TRenTop.h"
 #endif
 
+#if NH_MV_LAYER_PARALLEL_ENC
+#include "TLibCommon/TComThreadPool.h"
+#endif
+
 #if KWU_RC_MADPRED_E0227
 class TEncTop;
 #endif
@@ -99,6 +103,44 @@ private:
   TRenTop                     m_cRendererTop; 
   TRenModel                   m_cRendererModel;   
 #endif
+#if NH_MV_LAYER_PARALLEL_ENC
+  /// encoding of one layer of an access unit
+  struct LayerJob
+  {
+    TAppEncTop*                pcApp;
+    Int                        layer;
+    Int                        gopId;
+    Int                        auIdx;                       ///< index of the access unit, layer progress counters count finished access units
+    Bool                       eos;
+    TComPicYuv*                pcPicYuvOrg;
+    TComPicYuv*                pcPicYuvTrueOrg;
+    InputColourSpaceConversion snrCSC;
+    std::vector<Int>           waitLayers;                  ///< layers that must be coded before this layer starts
+    std::vector<Int>           waitLayersPrevAu;            ///< layers that must have finished the previous access unit before this layer starts
+#if NH_3D_VSO
+    Bool                       setDispCoeff;
+    Double                     dispCoeff;
+#endif
+    std::list<AccessUnit>      accessUnits;
+    Int                        numEncoded;
+    TComPic*                   pcPic;                       ///< coded picture, NULL if none
+  };
+
+  TComThreadPool             m_cLayerThreadPool;            ///< threads encoding the layers of an access unit
+  std::vector<TComProgress*> m_layerProgress;               ///< number of access units finished per layer
+  std::vector<LayerJob>      m_layerJobs;                   ///< jobs of the access units of a GOP, [gopId * m_numberOfLayers + layer]
+  std::mutex                 m_layerOutputMutex;            ///< serializes picture logging of the layers
+  Int                        m_numAus;                      ///< number of submitted access units
+#if NH_MV_FRAME_PARALLEL_ENC
+  std::mutex                 m_refMarkingMutex;             ///< serializes the reference picture marking of the layers
+  std::mutex                 m_finishedAusMutex;
+  Int                        m_numFinishedAus;              ///< number of access units of which all pictures are coded and motion compressed
+  Int                        m_gopAuIdx;                    ///< index of the first access unit of the current GOP
+#endif
+#endif
+#if PIC_METRICS_PARALLEL_ENC
+  TEncPicMetricsPool         m_cPicMetricsPool;             ///< threads computing PSNR and picture hash of all layers
+#endif
 protected:
   // initialization
   Void  xCreateLib        ();                               ///< create files & encoder class
@@ -147,6 +189,15 @@ protected:
   Void xSetCamPara                ( TComVPS& vps );
 #endif
   GOPEntry* xGetGopEntry( Int layerIdInVps, Int poc );
+#if NH_MV_LAYER_PARALLEL_ENC
+  Void xSetLayerJobDependencies   ();
+  static Void xEncodeLayerJob     ( Void* param );
+  Void xEncodeLayersParallel      ( std::ostream& bitstreamFile, std::vector<Bool>& eos, std::vector<Bool>& flush, TComPicYuv** picYuvOrg, TComPicYuv* picYuvTrueOrg,
+                                    const InputColourSpaceConversion snrCSC, Int gopId, Int gopSize );   ///< encode the layers of one access unit in parallel
+#if NH_MV_FRAME_PARALLEL_ENC
+  Void xFinishAccessUnits         ();
+#endif
+#endif
   Int  xGetMax( std::vector<Int>& vec);
   Bool xLayerIdInTargetEncLayerIdList( Int nuhLayerId );
 #endif
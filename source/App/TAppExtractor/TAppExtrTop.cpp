@@ -89,14 +89,13 @@ Void TAppExtrTop::extract()
   Bool bEndOfFile = false;
   while( !bEndOfFile )
   {
-    streampos location = inputBitstreamFile.tellg();
+    streamoff location = inputBytestream.getPosition();
     AnnexBStats stats = AnnexBStats();
-    vector<uint8_t> nalUnit;
     InputNALUnit nalu;
-    bEndOfFile = byteStreamNALUnit( inputBytestream, nalUnit, stats );
+    bEndOfFile = byteStreamNALUnit( inputBytestream, nalu.getBitstream().getFifo(), stats );
 
     // handle NAL unit
-    if( nalUnit.empty() )
+    if( nalu.getBitstream().getFifo().empty() )
     {
       /* this can happen if the following occur:
        *  - empty input file
@@ -112,15 +111,9 @@ Void TAppExtrTop::extract()
       // decide whether to extract packet or not
       if ( m_cTExtrTop.extract( nalu, m_suiExtractLayerIds ) && outputBitstreamFile.is_open() )
       {
-        inputBitstreamFile.clear();
-
-        streampos location2 = inputBitstreamFile.tellg();
-        inputBitstreamFile.seekg( location );
-
-        do
-        {
-          outputBitstreamFile.put( inputBitstreamFile.get() );
-        } while( inputBitstreamFile.tellg() != location2 );
+        // copy the NAL unit including its start code from the buffer of the byte stream
+        const streamoff location2 = inputBytestream.getPosition();
+        outputBitstreamFile.write( (const char*)inputBytestream.getBufferedBytes( location ), location2 - location );
       }
     }
   }
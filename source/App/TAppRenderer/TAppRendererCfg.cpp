@@ -167,7 +167,11 @@ Bool TAppRendererCfg::parseCfg( Int argc, TChar* argv[] )
     ("ShiftPrecision"    ,      m_iShiftPrecision     ,               2, "Shift Precision for Interpolation Mode 4"                )
     ("TemporalDepthFilter",     m_bTempDepthFilter    ,           false, "Temporal depth filtering"                                )
     ("RenderDirection"   ,      m_iRenderDirection    ,               0, "0: Interpolate, 1: Extrapolate from left, 2: Extrapolate from right")
-    ("UsedPelMapMarExt"  ,      m_iUsedPelMapMarExt   ,               0, "Margin Extension in Pels for used pels map generation"   );
+    ("UsedPelMapMarExt"  ,      m_iUsedPelMapMarExt   ,               0, "Margin Extension in Pels for used pels map generation"   )
+#if NH_3D_REN_PARALLEL_VIEWS
+    ("NumRenderThreads"  ,      m_iNumRenderThreads   ,               1, "Number of threads synthesizing the output views of a frame in parallel, 1: sequential" )
+#endif
+    ;
 
   po::setDefaults(opts);
   po::scanArgv(opts, argc, (const char**) argv);
@@ -303,6 +307,9 @@ Void TAppRendererCfg::xCheckParameter()
   xConfirmPara( m_iInterpolationMode  < 0 || m_iInterpolationMode  >  4, "InterpolationMode  must be more than or equal to 0 and less than 5"  );
   xConfirmPara( m_iHoleFillingMode    < 0 || m_iHoleFillingMode    >  1, "HoleFillingMode    must be more than or equal to 0 and less than 2"  );
   xConfirmPara( m_iPostProcMode       < 0 || m_iPostProcMode       >  2, "PostProcMode       must be more than or equal to 0 and less than 3"  );
+#if NH_3D_REN_PARALLEL_VIEWS
+  xConfirmPara( m_iNumRenderThreads   < 1,                               "NumRenderThreads   must be more than or equal to 1"  );
+#endif
 
   Int iNumNonNULL;
   for (iNumNonNULL = 0; (iNumNonNULL < m_iNumberOfInputViews)  && m_pchDepthInputFileList[iNumNonNULL]; iNumNonNULL++) {};  xConfirmPara( iNumNonNULL < m_iNumberOfInputViews,  "Number of DepthInputFiles  must be greater than or equal to number of BaseViewNumbers" );
@@ -376,6 +383,9 @@ Void TAppRendererCfg::xPrintParameter()
   printf("TemporalDepthFilter     : %d\n", m_bTempDepthFilter    );
   printf("RenderMode              : %d\n", m_iRenderMode         );
   printf("RendererDirection       : %d\n", m_iRenderDirection       );
+#if NH_3D_REN_PARALLEL_VIEWS
+  printf("NumRenderThreads        : %d\n", m_iNumRenderThreads   );
+#endif
 
   if (m_iRenderMode == 10 )
   {
@@ -115,6 +115,9 @@ protected:
   Int                 m_iRenderMode;                      ///< 0: use renderer
   Int                 m_iShiftPrecision;                ///< Precision used for Interpolation Mode 4
   Int                 m_iUsedPelMapMarExt;              ///< Used Pel map extra margin
+#if NH_3D_REN_PARALLEL_VIEWS
+  Int                 m_iNumRenderThreads;              ///< number of threads synthesizing the output views of a frame
+#endif
 
   Void xCheckParameter ();                              ///< check validity of configuration values
   Void xPrintParameter ();                              ///< print configuration values
@@ -37,6 +37,7 @@
 #include <fcntl.h>
 #include <assert.h>
 #include <math.h>
+#include <sstream>
 
 #include "TAppRendererTop.h"
 
@@ -108,7 +109,12 @@ Void TAppRendererTop::xDestroyLib()
 
 Void TAppRendererTop::xInitLib()
 {
-    m_pcRenTop->init(
+  xInitRenTop( m_pcRenTop );
+}
+
+Void TAppRendererTop::xInitRenTop( TRenTop* pcRenTop )
+{
+    pcRenTop->init(
     m_iSourceWidth,
     m_iSourceHeight,
     (m_iRenderDirection != 0),
@@ -134,40 +140,302 @@ Void TAppRendererTop::xInitLib()
 
 
 
+Bool TAppRendererTop::xReadBaseViews( Int iFrame, std::vector<TComPicYuv*>& rapcPicYuvBaseVideo, std::vector<TComPicYuv*>& rapcPicYuvBaseDepth, std::vector<TComPicYuv*>& rapcPicYuvLastBaseVideo, std::vector<TComPicYuv*>& rapcPicYuvLastBaseDepth, TComPicYuv* pcNewOrg )
+{
+  Int  aiPad[2] = { 0, 0 };
+  Bool bAnyEOS  = false;
+
+  // read in depth and video
+  for(Int iBaseViewIdx=0; iBaseViewIdx < m_iNumberOfInputViews; iBaseViewIdx++ )
+  {
+    m_apcTVideoIOYuvVideoInput[iBaseViewIdx]->read( rapcPicYuvBaseVideo[iBaseViewIdx],pcNewOrg, IPCOLOURSPACE_UNCHANGED, aiPad, CHROMA_420  ) ;
+
+    rapcPicYuvBaseVideo[iBaseViewIdx]->extendPicBorder();
+
+    bAnyEOS |= m_apcTVideoIOYuvVideoInput[iBaseViewIdx]->isEof();
+
+    m_apcTVideoIOYuvDepthInput[iBaseViewIdx]->read( rapcPicYuvBaseDepth[iBaseViewIdx],pcNewOrg, IPCOLOURSPACE_UNCHANGED, aiPad, CHROMA_420  ) ;
+    rapcPicYuvBaseDepth[iBaseViewIdx]->extendPicBorder();
+    bAnyEOS |= m_apcTVideoIOYuvDepthInput[iBaseViewIdx]->isEof();
+
+    if ( m_bTempDepthFilter && (iFrame >= m_iFrameSkip) )
+    {
+      m_pcRenTop->temporalFilterVSRS( rapcPicYuvBaseVideo[iBaseViewIdx], rapcPicYuvBaseDepth[iBaseViewIdx], rapcPicYuvLastBaseVideo[iBaseViewIdx], rapcPicYuvLastBaseDepth[iBaseViewIdx], ( iFrame == m_iFrameSkip) );
+    }
+  }
+
+  return bAnyEOS;
+}
+
+Void TAppRendererTop::xRenderView( TRenTop* pcRenTop, Int iFrame, Int iSynthViewIdx, std::vector<TComPicYuv*>& rapcPicYuvBaseVideo, std::vector<TComPicYuv*>& rapcPicYuvBaseDepth, TComPicYuv* pcPicYuvSynthOut, std::ostream& rcLog )
+{
+  Int  iLeftBaseViewIdx  = -1;
+  Int  iRightBaseViewIdx = -1;
+
+  Bool bIsBaseView = false;
+
+  Int iRelDistToLeft;
+  Bool bHasLRView = m_cCameraData.getLeftRightBaseView( iSynthViewIdx, iLeftBaseViewIdx, iRightBaseViewIdx, iRelDistToLeft, bIsBaseView );
+  Bool bHasLView = ( iLeftBaseViewIdx != -1 );
+  Bool bHasRView = ( iRightBaseViewIdx != -1 );
+  Bool bRender   = true;
+
+  Int  iBlendMode = m_iBlendMode;
+  Int  iSimEnhBaseView = 0;
+
+  switch( m_iRenderDirection )
+  {
+  /// INTERPOLATION
+  case 0:
+    AOF( bHasLRView || bIsBaseView );
+
+    if ( !bHasLRView && bIsBaseView && m_iBlendMode == 0 )
+    {
+      bRender = false;
+    }
+    else
+    {
+      if ( bIsBaseView )
+      {
+        AOF( iLeftBaseViewIdx == iRightBaseViewIdx );
+        Int iSortedBaseViewIdx = m_cCameraData.getBaseId2SortedId() [iLeftBaseViewIdx];
+
+        if ( m_iBlendMode == 1 )
+        {
+          if ( iSortedBaseViewIdx - 1 >= 0 )
+          {
+            iLeftBaseViewIdx = m_cCameraData.getBaseSortedId2Id()[ iSortedBaseViewIdx - 1];
+            bRender = true;
+          }
+          else
+          {
+            bRender = false;
+          }
+        }
+        else if ( m_iBlendMode == 2 )
+        {
+          if ( iSortedBaseViewIdx + 1 < m_iNumberOfInputViews )
+          {
+            iRightBaseViewIdx = m_cCameraData.getBaseSortedId2Id()[ iSortedBaseViewIdx + 1];
+            bRender = true;
+          }
+          else
+          {
+            bRender = false;
+          }
+        }
+      }
+
+      if ( m_iBlendMode == 3 )
+      {
+        if ( bIsBaseView && (iLeftBaseViewIdx == 0) )
+        {
+          bRender = false;
+        }
+        else
+        {
+          Int iDistLeft  = abs( m_cCameraData.getBaseId2SortedId()[0] - m_cCameraData.getBaseId2SortedId() [iLeftBaseViewIdx ]  );
+          Int iDistRight = abs( m_cCameraData.getBaseId2SortedId()[0] - m_cCameraData.getBaseId2SortedId() [iRightBaseViewIdx]  );
+
+          Int iFillViewIdx = iDistLeft > iDistRight ? iLeftBaseViewIdx : iRightBaseViewIdx;
+
+          if( m_cCameraData.getBaseId2SortedId()[0] < m_cCameraData.getBaseId2SortedId() [iFillViewIdx] )
+          {
+            iBlendMode        = 1;
+            iLeftBaseViewIdx  = 0;
+            iRightBaseViewIdx = iFillViewIdx;
+          }
+          else
+          {
+            iBlendMode        = 2;
+            iLeftBaseViewIdx  = iFillViewIdx;
+            iRightBaseViewIdx = 0;
+          }
+
+        }
+      }
+      else
+      {
+        iBlendMode = m_iBlendMode;
+      }
+    }
+
+    if ( m_bSimEnhance )
+    {
+      if ( m_iNumberOfInputViews == 3 && m_cCameraData.getRelSynthViewNumbers()[ iSynthViewIdx ] < VIEW_NUM_PREC  )
+      {
+        iSimEnhBaseView = 2; // Take middle view
+      }
+      else
+      {
+        iSimEnhBaseView = 1; // Take left view
+      }
+    }
+
+      if ( bRender )
+      {
+      rcLog << "Rendering Frame "    << iFrame
+                << " of View "           << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx    ] / VIEW_NUM_PREC
+                << "   Left BaseView: "  << (Double) m_cCameraData.getBaseViewNumbers() [iLeftBaseViewIdx ] / VIEW_NUM_PREC
+                << "   Right BaseView: " << (Double) m_cCameraData.getBaseViewNumbers() [iRightBaseViewIdx] / VIEW_NUM_PREC
+                << "   BlendMode: "      << iBlendMode
+                << std::endl;
+
+      pcRenTop->setShiftLUTs(
+        m_cCameraData.getSynthViewShiftLUTD()[iLeftBaseViewIdx ][iSynthViewIdx],
+        m_cCameraData.getSynthViewShiftLUTI()[iLeftBaseViewIdx ][iSynthViewIdx],
+        m_cCameraData.getBaseViewShiftLUTI ()[iLeftBaseViewIdx ][iRightBaseViewIdx],
+        m_cCameraData.getSynthViewShiftLUTD()[iRightBaseViewIdx][iSynthViewIdx],
+        m_cCameraData.getSynthViewShiftLUTI()[iRightBaseViewIdx][iSynthViewIdx],
+        m_cCameraData.getBaseViewShiftLUTI ()[iRightBaseViewIdx][iLeftBaseViewIdx ],
+
+        iRelDistToLeft
+      );
+
+      pcRenTop->interpolateView(
+        rapcPicYuvBaseVideo[iLeftBaseViewIdx ],
+        rapcPicYuvBaseDepth[iLeftBaseViewIdx ],
+        rapcPicYuvBaseVideo[iRightBaseViewIdx],
+        rapcPicYuvBaseDepth[iRightBaseViewIdx],
+        pcPicYuvSynthOut,
+        iBlendMode,
+        iSimEnhBaseView
+        );
+    }
+    else
+    {
+      AOT(iLeftBaseViewIdx != iRightBaseViewIdx );
+      rapcPicYuvBaseVideo[iLeftBaseViewIdx]->copyToPic( pcPicYuvSynthOut );
+      rcLog << "Copied    Frame " << iFrame
+                << " of View "        << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx] / VIEW_NUM_PREC
+                << "   (BaseView)  "    << std::endl;
+    }
+
+    break;
+  /// EXTRAPOLATION FROM LEFT
+  case 1:
+    if ( !bHasLView ) // View to render is BaseView
+    {
+      bRender = false;
+    }
+
+      if (  bIsBaseView )
+      {
+      AOF( iLeftBaseViewIdx == iRightBaseViewIdx );
+      Int iSortedBaseViewIdx = m_cCameraData.getBaseId2SortedId() [iLeftBaseViewIdx];
+      if ( iSortedBaseViewIdx - 1 >= 0 )
+      {
+        iLeftBaseViewIdx = m_cCameraData.getBaseSortedId2Id()[ iSortedBaseViewIdx - 1];
+      }
+      else
+      {
+        rcLog << "Copied    Frame " << iFrame << " of BaseView " << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx] / VIEW_NUM_PREC  << std::endl;
+        rapcPicYuvBaseVideo[iLeftBaseViewIdx]->copyToPic( pcPicYuvSynthOut ); // Copy Original
+        bRender = false;
+      }
+    }
+
+
+    if (bRender)
+    {
+      rcLog << "Rendering Frame " << iFrame << " of View " << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx] / VIEW_NUM_PREC  << std::endl;
+      pcRenTop->setShiftLUTs( m_cCameraData.getSynthViewShiftLUTD()[iLeftBaseViewIdx ][iSynthViewIdx],
+        m_cCameraData.getSynthViewShiftLUTI()[iLeftBaseViewIdx ][iSynthViewIdx], NULL, NULL, NULL, NULL, -1 );
+      pcRenTop->extrapolateView( rapcPicYuvBaseVideo[iLeftBaseViewIdx ], rapcPicYuvBaseDepth[iLeftBaseViewIdx ], pcPicYuvSynthOut, true );
+    }
+    break;
+  /// EXTRAPOLATION FROM RIGHT
+  case 2:            // extrapolation from right
+    if ( !bHasRView ) // View to render is BaseView
+    {
+      bRender = false;
+    }
+
+      if (  bIsBaseView )
+      {
+
+      AOF( iLeftBaseViewIdx == iRightBaseViewIdx );
+      Int iSortedBaseViewIdx = m_cCameraData.getBaseId2SortedId() [iLeftBaseViewIdx];
+      if ( iSortedBaseViewIdx + 1 < m_iNumberOfInputViews )
+      {
+        iRightBaseViewIdx = m_cCameraData.getBaseSortedId2Id()[ iSortedBaseViewIdx + 1];
+      }
+      else
+      {
+        rcLog << "Copied    Frame " << iFrame << " of BaseView " << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx] / VIEW_NUM_PREC  << std::endl;
+        rapcPicYuvBaseVideo[iLeftBaseViewIdx]->copyToPic( pcPicYuvSynthOut ); // Copy Original
+        bRender = false;
+      }
+    }
+
+    if ( bRender )
+    {
+      rcLog << "Rendering Frame " << iFrame << " of View " << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx] / VIEW_NUM_PREC  << std::endl;
+      pcRenTop->setShiftLUTs( NULL, NULL,NULL, m_cCameraData.getSynthViewShiftLUTD()[iRightBaseViewIdx ][iSynthViewIdx],
+        m_cCameraData.getSynthViewShiftLUTI()[iRightBaseViewIdx ][iSynthViewIdx],NULL, iRelDistToLeft);
+      pcRenTop->extrapolateView( rapcPicYuvBaseVideo[iRightBaseViewIdx ], rapcPicYuvBaseDepth[iRightBaseViewIdx ], pcPicYuvSynthOut, false);
+    }
+    break;
+  }
+}
+
+#if NH_3D_REN_PARALLEL_VIEWS
+Void TAppRendererTop::xRenderViewsJob( Void* pParam )
+{
+  RenderJob*       pcJob         = (RenderJob*) pParam;
+  TAppRendererTop* pcRendererTop = pcJob->pcRendererTop;
+  Int              iNumJobs      = (Int) pcRendererTop->m_acRenderJobs.size();
+
+  for( Int iSynthViewIdx = pcJob->iFirstSynthViewIdx; iSynthViewIdx < pcRendererTop->m_iNumberOfOutputViews; iSynthViewIdx += iNumJobs )
+  {
+    std::ostringstream cLog;
+    pcRendererTop->xRenderView( pcJob->pcRenTop, pcJob->iFrame, iSynthViewIdx, *pcJob->papcPicYuvBaseVideo, *pcJob->papcPicYuvBaseDepth, pcRendererTop->m_apcPicYuvSynthOut[iSynthViewIdx], cLog );
+    pcRendererTop->m_acRenderLog[iSynthViewIdx] = cLog.str();
+  }
+}
+#endif
+
 Void TAppRendererTop::render()
 {
   xCreateLib();
   xInitLib();
 
+#if NH_3D_REN_PARALLEL_VIEWS
+  const Int iNumBaseBuffers = 2;  // the next frame is read to the second buffer set, while the current frame is synthesized
+#else
+  const Int iNumBaseBuffers = 1;
+#endif
+
   // Create Buffers Input Views;
-  std::vector<TComPicYuv*> apcPicYuvBaseVideo;
-  std::vector<TComPicYuv*> apcPicYuvBaseDepth;
+  std::vector<TComPicYuv*> apcPicYuvBaseVideo[2];
+  std::vector<TComPicYuv*> apcPicYuvBaseDepth[2];
 
   // TemporalImprovement Filter
   std::vector<TComPicYuv*> apcPicYuvLastBaseVideo;
   std::vector<TComPicYuv*> apcPicYuvLastBaseDepth;
 
-  Int aiPad[2] = { 0, 0 };
-
   TComPicYuv* pcNewOrg = new TComPicYuv;
   pcNewOrg->create( m_iSourceWidth, m_iSourceHeight, CHROMA_420, 1, 1, 1, true );
 
   for ( UInt uiBaseView = 0; uiBaseView < m_iNumberOfInputViews; uiBaseView++ )
   {
-    TComPicYuv* pcNewVideoPic = new TComPicYuv;
-    TComPicYuv* pcNewDepthPic = new TComPicYuv;
+    for ( Int iBuf = 0; iBuf < iNumBaseBuffers; iBuf++ )
+    {
+      TComPicYuv* pcNewVideoPic = new TComPicYuv;
+      TComPicYuv* pcNewDepthPic = new TComPicYuv;
 
-    pcNewVideoPic->create( m_iSourceWidth, m_iSourceHeight, CHROMA_420, 1, 1, 1, true );
-    apcPicYuvBaseVideo.push_back(pcNewVideoPic);
+      pcNewVideoPic->create( m_iSourceWidth, m_iSourceHeight, CHROMA_420, 1, 1, 1, true );
+      apcPicYuvBaseVideo[iBuf].push_back(pcNewVideoPic);
 
-    pcNewDepthPic->create( m_iSourceWidth, m_iSourceHeight, CHROMA_420, 1, 1, 1, true);
-    apcPicYuvBaseDepth.push_back(pcNewDepthPic);
+      pcNewDepthPic->create( m_iSourceWidth, m_iSourceHeight, CHROMA_420, 1, 1, 1, true);
+      apcPicYuvBaseDepth[iBuf].push_back(pcNewDepthPic);
+    }
 
     //Temporal improvement Filter
     if ( m_bTempDepthFilter )
     {
-      pcNewVideoPic = new TComPicYuv;
-      pcNewDepthPic = new TComPicYuv;
+      TComPicYuv* pcNewVideoPic = new TComPicYuv;
+      TComPicYuv* pcNewDepthPic = new TComPicYuv;
 
       pcNewVideoPic->create( m_iSourceWidth, m_iSourceHeight, CHROMA_420, 1, 1, 1, true );
       apcPicYuvLastBaseVideo.push_back(pcNewVideoPic);
@@ -177,6 +445,85 @@ Void TAppRendererTop::render()
     }
   }
 
+#if NH_3D_REN_PARALLEL_VIEWS
+  // Create Jobs and Buffers for synthesized Views. Each job owns a renderer, the first one uses m_pcRenTop,
+  // which is shared with the temporal filter (temporalFilterVSRS only uses its own block buffer).
+  Int iNumJobs = std::min( m_iNumRenderThreads, m_iNumberOfOutputViews );
+
+  m_cThreadPool.create( iNumJobs );
+  m_acRenderJobs.resize( iNumJobs );
+
+  for ( Int iJob = 0; iJob < iNumJobs; iJob++ )
+  {
+    RenderJob& rcJob = m_acRenderJobs[iJob];
+
+    rcJob.pcRendererTop       = this;
+    rcJob.pcRenTop            = ( iJob == 0 ) ? m_pcRenTop : new TRenTop();
+    rcJob.iFirstSynthViewIdx  = iJob;
+    rcJob.iFrame              = -1;
+    rcJob.papcPicYuvBaseVideo = NULL;
+    rcJob.papcPicYuvBaseDepth = NULL;
+
+    if ( iJob > 0 )
+    {
+      xInitRenTop( rcJob.pcRenTop );
+    }
+  }
+
+  for ( Int iSynthViewIdx = 0; iSynthViewIdx < m_iNumberOfOutputViews; iSynthViewIdx++ )
+  {
+    TComPicYuv* pcPicYuvSynthOut = new TComPicYuv;
+    pcPicYuvSynthOut->create( m_iSourceWidth, m_iSourceHeight, CHROMA_420, 1, 1, 1, true );
+    m_apcPicYuvSynthOut.push_back( pcPicYuvSynthOut );
+  }
+  m_acRenderLog.resize( m_iNumberOfOutputViews );
+
+  Int iCurBuf              = 0;
+  Int iNumOfRenderedFrames = 0;
+  Int iFrame               = 0;
+
+  for ( ; iFrame < m_iFrameSkip; iFrame++ )
+  {
+    std::cout << "Skipping Frame " << iFrame << std::endl;
+  }
+
+  Bool bAnyEOS      = xReadBaseViews( iFrame, apcPicYuvBaseVideo[iCurBuf], apcPicYuvBaseDepth[iCurBuf], apcPicYuvLastBaseVideo, apcPicYuvLastBaseDepth, pcNewOrg );
+  Bool bRenderFrame = true;
+
+  while ( bRenderFrame )
+  {
+    m_cCameraData.update( (UInt)iFrame - m_iFrameSkip );
+
+    for ( Int iJob = 0; iJob < iNumJobs; iJob++ )
+    {
+      m_acRenderJobs[iJob].iFrame              = iFrame;
+      m_acRenderJobs[iJob].papcPicYuvBaseVideo = &apcPicYuvBaseVideo[iCurBuf];
+      m_acRenderJobs[iJob].papcPicYuvBaseDepth = &apcPicYuvBaseDepth[iCurBuf];
+      m_cThreadPool.addJob( xRenderViewsJob, &m_acRenderJobs[iJob] );
+    }
+    iNumOfRenderedFrames++;
+
+    // read next frame, while the views of the current frame are synthesized
+    bRenderFrame = ( ( iNumOfRenderedFrames < m_iFramesToBeRendered ) || ( m_iFramesToBeRendered == 0 ) ) && !bAnyEOS;
+
+    if ( bRenderFrame )
+    {
+      bAnyEOS = xReadBaseViews( iFrame + 1, apcPicYuvBaseVideo[1 - iCurBuf], apcPicYuvBaseDepth[1 - iCurBuf], apcPicYuvLastBaseVideo, apcPicYuvLastBaseDepth, pcNewOrg );
+    }
+
+    m_cThreadPool.waitAll();
+
+    // Write Output
+    for(Int iSynthViewIdx=0; iSynthViewIdx < m_iNumberOfOutputViews; iSynthViewIdx++ )
+    {
+      std::cout << m_acRenderLog[iSynthViewIdx];
+      m_apcTVideoIOYuvSynthOutput[m_bSweep ? 0 : iSynthViewIdx]->write( m_apcPicYuvSynthOut[iSynthViewIdx], IPCOLOURSPACE_UNCHANGED, 0, 0, 0, 0, CHROMA_420 );
+    }
+
+    iFrame++;
+    iCurBuf = 1 - iCurBuf;
+  }
+#else
   // Create Buffer for synthesized View
   TComPicYuv* pcPicYuvSynthOut = new TComPicYuv;
   pcPicYuvSynthOut->create( m_iSourceWidth, m_iSourceHeight, CHROMA_420, 1, 1, 1, true );
@@ -190,24 +537,7 @@ Void TAppRendererTop::render()
   {
     if ( iFrame >= m_iFrameSkip ) 
     {
-      // read in depth and video
-      for(Int iBaseViewIdx=0; iBaseViewIdx < m_iNumberOfInputViews; iBaseViewIdx++ )
-      {
-        m_apcTVideoIOYuvVideoInput[iBaseViewIdx]->read( apcPicYuvBaseVideo[iBaseViewIdx],pcNewOrg, IPCOLOURSPACE_UNCHANGED, aiPad, CHROMA_420  ) ;
-
-        apcPicYuvBaseVideo[iBaseViewIdx]->extendPicBorder();
-
-        bAnyEOS |= m_apcTVideoIOYuvVideoInput[iBaseViewIdx]->isEof();
-
-        m_apcTVideoIOYuvDepthInput[iBaseViewIdx]->read( apcPicYuvBaseDepth[iBaseViewIdx],pcNewOrg, IPCOLOURSPACE_UNCHANGED, aiPad, CHROMA_420  ) ;
-        apcPicYuvBaseDepth[iBaseViewIdx]->extendPicBorder();
-        bAnyEOS |= m_apcTVideoIOYuvDepthInput[iBaseViewIdx]->isEof();
-
-        if ( m_bTempDepthFilter && (iFrame >= m_iFrameSkip) )
-        {
-          m_pcRenTop->temporalFilterVSRS( apcPicYuvBaseVideo[iBaseViewIdx], apcPicYuvBaseDepth[iBaseViewIdx], apcPicYuvLastBaseVideo[iBaseViewIdx], apcPicYuvLastBaseDepth[iBaseViewIdx], ( iFrame == m_iFrameSkip) );
-        }
-      }
+      bAnyEOS = xReadBaseViews( iFrame, apcPicYuvBaseVideo[0], apcPicYuvBaseDepth[0], apcPicYuvLastBaseVideo, apcPicYuvLastBaseDepth, pcNewOrg );
     }
     else    
     {
@@ -221,214 +551,7 @@ Void TAppRendererTop::render()
 
     for(Int iSynthViewIdx=0; iSynthViewIdx < m_iNumberOfOutputViews; iSynthViewIdx++ )
     {
-      Int  iLeftBaseViewIdx  = -1;
-      Int  iRightBaseViewIdx = -1;
-
-      Bool bIsBaseView = false;
-
-      Int iRelDistToLeft;
-      Bool bHasLRView = m_cCameraData.getLeftRightBaseView( iSynthViewIdx, iLeftBaseViewIdx, iRightBaseViewIdx, iRelDistToLeft, bIsBaseView );
-      Bool bHasLView = ( iLeftBaseViewIdx != -1 );
-      Bool bHasRView = ( iRightBaseViewIdx != -1 );
-      Bool bRender   = true;
-
-      Int  iBlendMode = m_iBlendMode;
-      Int  iSimEnhBaseView = 0;
-
-      switch( m_iRenderDirection )
-      {
-      /// INTERPOLATION
-      case 0:
-        AOF( bHasLRView || bIsBaseView );
-
-        if ( !bHasLRView && bIsBaseView && m_iBlendMode == 0 )
-        {
-          bRender = false;
-        }
-        else
-        {
-          if ( bIsBaseView )
-          {
-            AOF( iLeftBaseViewIdx == iRightBaseViewIdx );
-            Int iSortedBaseViewIdx = m_cCameraData.getBaseId2SortedId() [iLeftBaseViewIdx];
-
-            if ( m_iBlendMode == 1 )
-            {
-              if ( iSortedBaseViewIdx - 1 >= 0 )
-              {
-                iLeftBaseViewIdx = m_cCameraData.getBaseSortedId2Id()[ iSortedBaseViewIdx - 1];
-                bRender = true;
-              }
-              else
-              {
-                bRender = false;
-              }
-            }
-            else if ( m_iBlendMode == 2 )
-            {
-              if ( iSortedBaseViewIdx + 1 < m_iNumberOfInputViews )
-              {
-                iRightBaseViewIdx = m_cCameraData.getBaseSortedId2Id()[ iSortedBaseViewIdx + 1];
-                bRender = true;
-              }
-              else
-              {
-                bRender = false;
-              }
-            }
-          }
-
-          if ( m_iBlendMode == 3 )
-          {
-            if ( bIsBaseView && (iLeftBaseViewIdx == 0) )
-            {
-              bRender = false;
-            }
-            else
-            {
-              Int iDistLeft  = abs( m_cCameraData.getBaseId2SortedId()[0] - m_cCameraData.getBaseId2SortedId() [iLeftBaseViewIdx ]  );
-              Int iDistRight = abs( m_cCameraData.getBaseId2SortedId()[0] - m_cCameraData.getBaseId2SortedId() [iRightBaseViewIdx]  );
-
-              Int iFillViewIdx = iDistLeft > iDistRight ? iLeftBaseViewIdx : iRightBaseViewIdx;
-
-              if( m_cCameraData.getBaseId2SortedId()[0] < m_cCameraData.getBaseId2SortedId() [iFillViewIdx] )
-              {
-                iBlendMode        = 1;
-                iLeftBaseViewIdx  = 0;
-                iRightBaseViewIdx = iFillViewIdx;
-              }
-              else
-              {
-                iBlendMode        = 2;
-                iLeftBaseViewIdx  = iFillViewIdx;
-                iRightBaseViewIdx = 0;
-              }
-
-            }
-          }
-          else
-          {
-            iBlendMode = m_iBlendMode;
-          }
-        }
-
-        if ( m_bSimEnhance )
-        {
-          if ( m_iNumberOfInputViews == 3 && m_cCameraData.getRelSynthViewNumbers()[ iSynthViewIdx ] < VIEW_NUM_PREC  )
-          {
-            iSimEnhBaseView = 2; // Take middle view
-          }
-          else
-          {
-            iSimEnhBaseView = 1; // Take left view
-          }
-        }
-
-          if ( bRender )
-          {
-          std::cout << "Rendering Frame "    << iFrame
-                    << " of View "           << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx    ] / VIEW_NUM_PREC
-                    << "   Left BaseView: "  << (Double) m_cCameraData.getBaseViewNumbers() [iLeftBaseViewIdx ] / VIEW_NUM_PREC
-                    << "   Right BaseView: " << (Double) m_cCameraData.getBaseViewNumbers() [iRightBaseViewIdx] / VIEW_NUM_PREC
-                    << "   BlendMode: "      << iBlendMode
-                    << std::endl;
-
-          m_pcRenTop->setShiftLUTs(
-            m_cCameraData.getSynthViewShiftLUTD()[iLeftBaseViewIdx ][iSynthViewIdx],
-            m_cCameraData.getSynthViewShiftLUTI()[iLeftBaseViewIdx ][iSynthViewIdx],
-            m_cCameraData.getBaseViewShiftLUTI ()[iLeftBaseViewIdx ][iRightBaseViewIdx],
-            m_cCameraData.getSynthViewShiftLUTD()[iRightBaseViewIdx][iSynthViewIdx],
-            m_cCameraData.getSynthViewShiftLUTI()[iRightBaseViewIdx][iSynthViewIdx],
-            m_cCameraData.getBaseViewShiftLUTI ()[iRightBaseViewIdx][iLeftBaseViewIdx ],
-
-            iRelDistToLeft
-          );
-
-          m_pcRenTop->interpolateView(
-            apcPicYuvBaseVideo[iLeftBaseViewIdx ],
-            apcPicYuvBaseDepth[iLeftBaseViewIdx ],
-            apcPicYuvBaseVideo[iRightBaseViewIdx],
-            apcPicYuvBaseDepth[iRightBaseViewIdx],
-            pcPicYuvSynthOut,
-            iBlendMode,
-            iSimEnhBaseView
-            );
-        }
-        else
-        {
-          AOT(iLeftBaseViewIdx != iRightBaseViewIdx );
-          apcPicYuvBaseVideo[iLeftBaseViewIdx]->copyToPic( pcPicYuvSynthOut );
-          std::cout << "Copied    Frame " << iFrame
-                    << " of View "        << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx] / VIEW_NUM_PREC
-                    << "   (BaseView)  "    << std::endl;
-        }
-
-        break;
-      /// EXTRAPOLATION FROM LEFT
-      case 1:
-        if ( !bHasLView ) // View to render is BaseView
-        {
-          bRender = false;
-        }
-
-          if (  bIsBaseView )
-          {
-          AOF( iLeftBaseViewIdx == iRightBaseViewIdx );
-          Int iSortedBaseViewIdx = m_cCameraData.getBaseId2SortedId() [iLeftBaseViewIdx];
-          if ( iSortedBaseViewIdx - 1 >= 0 )
-          {
-            iLeftBaseViewIdx = m_cCameraData.getBaseSortedId2Id()[ iSortedBaseViewIdx - 1];
-          }
-          else
-          {
-            std::cout << "Copied    Frame " << iFrame << " of BaseView " << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx] / VIEW_NUM_PREC  << std::endl;
-            apcPicYuvBaseVideo[iLeftBaseViewIdx]->copyToPic( pcPicYuvSynthOut ); // Copy Original
-            bRender = false;
-          }
-        }
-
-
-        if (bRender)
-        {
-          std::cout << "Rendering Frame " << iFrame << " of View " << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx] / VIEW_NUM_PREC  << std::endl;
-          m_pcRenTop->setShiftLUTs( m_cCameraData.getSynthViewShiftLUTD()[iLeftBaseViewIdx ][iSynthViewIdx],
-            m_cCameraData.getSynthViewShiftLUTI()[iLeftBaseViewIdx ][iSynthViewIdx], NULL, NULL, NULL, NULL, -1 );
-          m_pcRenTop->extrapolateView( apcPicYuvBaseVideo[iLeftBaseViewIdx ], apcPicYuvBaseDepth[iLeftBaseViewIdx ], pcPicYuvSynthOut, true );
-        }
-        break;
-      /// EXTRAPOLATION FROM RIGHT
-      case 2:            // extrapolation from right
-        if ( !bHasRView ) // View to render is BaseView
-        {
-          bRender = false;
-        }
-
-          if (  bIsBaseView )
-          {
-
-          AOF( iLeftBaseViewIdx == iRightBaseViewIdx );
-          Int iSortedBaseViewIdx = m_cCameraData.getBaseId2SortedId() [iLeftBaseViewIdx];
-          if ( iSortedBaseViewIdx + 1 < m_iNumberOfInputViews )
-          {
-            iRightBaseViewIdx = m_cCameraData.getBaseSortedId2Id()[ iSortedBaseViewIdx + 1];
-          }
-          else
-          {
-            std::cout << "Copied    Frame " << iFrame << " of BaseView " << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx] / VIEW_NUM_PREC  << std::endl;
-            apcPicYuvBaseVideo[iLeftBaseViewIdx]->copyToPic( pcPicYuvSynthOut ); // Copy Original
-            bRender = false;
-          }
-        }
-
-        if ( bRender )
-        {
-          std::cout << "Rendering Frame " << iFrame << " of View " << (Double) m_cCameraData.getSynthViewNumbers()[iSynthViewIdx] / VIEW_NUM_PREC  << std::endl;
-          m_pcRenTop->setShiftLUTs( NULL, NULL,NULL, m_cCameraData.getSynthViewShiftLUTD()[iRightBaseViewIdx ][iSynthViewIdx],
-            m_cCameraData.getSynthViewShiftLUTI()[iRightBaseViewIdx ][iSynthViewIdx],NULL, iRelDistToLeft);
-          m_pcRenTop->extrapolateView( apcPicYuvBaseVideo[iRightBaseViewIdx ], apcPicYuvBaseDepth[iRightBaseViewIdx ], pcPicYuvSynthOut, false);
-        }
-        break;
-      }
+      xRenderView( m_pcRenTop, iFrame, iSynthViewIdx, apcPicYuvBaseVideo[0], apcPicYuvBaseDepth[0], pcPicYuvSynthOut, std::cout );
 
       // Write Output
 
@@ -437,6 +560,7 @@ Void TAppRendererTop::render()
     iFrame++;
     iNumOfRenderedFrames++;
   }
+#endif
 
   // Delete Buffers
   pcNewOrg->destroy(); 
@@ -444,11 +568,14 @@ Void TAppRendererTop::render()
 
   for ( UInt uiBaseView = 0; uiBaseView < m_iNumberOfInputViews; uiBaseView++ )
   {
-    apcPicYuvBaseVideo[uiBaseView]->destroy();
-    delete apcPicYuvBaseVideo[uiBaseView];
+    for ( Int iBuf = 0; iBuf < iNumBaseBuffers; iBuf++ )
+    {
+      apcPicYuvBaseVideo[iBuf][uiBaseView]->destroy();
+      delete apcPicYuvBaseVideo[iBuf][uiBaseView];
 
-    apcPicYuvBaseDepth[uiBaseView]->destroy();
-    delete apcPicYuvBaseDepth[uiBaseView];
+      apcPicYuvBaseDepth[iBuf][uiBaseView]->destroy();
+      delete apcPicYuvBaseDepth[iBuf][uiBaseView];
+    }
 
     // Temporal Filter
     if ( m_bTempDepthFilter )
@@ -461,8 +588,26 @@ Void TAppRendererTop::render()
     }
   }
 
+#if NH_3D_REN_PARALLEL_VIEWS
+  m_cThreadPool.destroy();
+
+  for ( Int iJob = 1; iJob < iNumJobs; iJob++ )
+  {
+    delete m_acRenderJobs[iJob].pcRenTop;
+  }
+  m_acRenderJobs.clear();
+
+  for ( Int iSynthViewIdx = 0; iSynthViewIdx < m_iNumberOfOutputViews; iSynthViewIdx++ )
+  {
+    m_apcPicYuvSynthOut[iSynthViewIdx]->destroy();
+    delete m_apcPicYuvSynthOut[iSynthViewIdx];
+  }
+  m_apcPicYuvSynthOut.clear();
+  m_acRenderLog.clear();
+#else
   pcPicYuvSynthOut->destroy();
   delete pcPicYuvSynthOut;
+#endif
 
   xDestroyLib();
 
@@ -45,6 +45,9 @@
 #include "TAppRendererCfg.h"
 #include "TAppRendererTop.h"
 #include "../../Lib/TLibRenderer/TRenModel.h"
+#if NH_3D_REN_PARALLEL_VIEWS
+#include "../../Lib/TLibCommon/TComThreadPool.h"
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -62,11 +65,38 @@ private:
   // RendererInterface
   TRenTop*                     m_pcRenTop;
 
+#if NH_3D_REN_PARALLEL_VIEWS
+  // Parallel view synthesis
+  struct RenderJob
+  {
+    TAppRendererTop*           pcRendererTop;
+    TRenTop*                   pcRenTop;                    ///< renderer owned by the job
+    Int                        iFirstSynthViewIdx;          ///< job synthesizes views iFirstSynthViewIdx + k * number of jobs
+    Int                        iFrame;
+    std::vector<TComPicYuv*>*  papcPicYuvBaseVideo;
+    std::vector<TComPicYuv*>*  papcPicYuvBaseDepth;
+  };
+
+  TComThreadPool               m_cThreadPool;
+  std::vector<RenderJob>       m_acRenderJobs;
+  std::vector<TComPicYuv*>     m_apcPicYuvSynthOut;         ///< synthesized views of the current frame
+  std::vector<std::string>     m_acRenderLog;               ///< console output of the synthesis of the views of the current frame
+
+  static Void xRenderViewsJob( Void* pParam );
+#endif
+
 protected:
   // initialization
   Void  xCreateLib        ();                               ///< create renderer class and video io
   Void  xInitLib          ();                               ///< initialize renderer class
+  Void  xInitRenTop       ( TRenTop* pcRenTop );            ///< initialize a renderer with the configuration
   Void  xDestroyLib       ();                               ///< destroy renderer class and video io
+
+  // rendering
+  Bool  xReadBaseViews    ( Int iFrame, std::vector<TComPicYuv*>& rapcPicYuvBaseVideo, std::vector<TComPicYuv*>& rapcPicYuvBaseDepth,
+                            std::vector<TComPicYuv*>& rapcPicYuvLastBaseVideo, std::vector<TComPicYuv*>& rapcPicYuvLastBaseDepth, TComPicYuv* pcNewOrg ); ///< read video and depth of all base views, returns true at end of any file
+  Void  xRenderView       ( TRenTop* pcRenTop, Int iFrame, Int iSynthViewIdx, std::vector<TComPicYuv*>& rapcPicYuvBaseVideo, std::vector<TComPicYuv*>& rapcPicYuvBaseDepth,
+                            TComPicYuv* pcPicYuvSynthOut, std::ostream& rcLog ); ///< synthesize one output view of a frame
 #if NH_3D_VSO
   Void  xRenderModelFromString();                           ///< render using model using setup string
   Void  xRenderModelFromNums();                             ///< render using model using synth view numbers
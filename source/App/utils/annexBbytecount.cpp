@@ -130,12 +130,15 @@ int main(int argc, char*argv[])
   unsigned numNALUnits = 0;
 
   cout << "NALUnits:" << endl;
-  while (!!in)
+  bool eof = false;
+  while (!eof)
   {
     AnnexBStats annexBStatsSingle = AnnexBStats();
-    vector<uint8_t> nalUnit;
+    const uint8_t* nalUnit;
+    size_t numBytesInNALUnit;
 
-    byteStreamNALUnit(bs, nalUnit, annexBStatsSingle);
+    eof = bs.readNALUnit(nalUnit, numBytesInNALUnit, annexBStatsSingle);
+    annexBStatsSingle.m_numBytesInNALUnit = unsigned(numBytesInNALUnit);
 
     int nal_unit_type = -1;
     if (annexBStatsSingle.m_numBytesInNALUnit)
@@ -0,0 +1,487 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     simdBenchmark.cpp
+    \brief    throughput of the vectorized kernels of TLibCommon compared to the scalar ones
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <limits>
+
+#include "TLibCommon/TComInterpolationFilter.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TLibCommon/TComChromaFormat.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComSampleAdaptiveOffset.h"
+
+#if SIMD_X86
+
+#include "TLibCommon/TComSimd.h"
+
+static const Int  s_samplesPerRun = 1 << 24;                ///< number of filtered or transformed samples per measurement
+
+static const TChar* s_extensionNames[] = { "scalar", "SSE4.1", "AVX2" };
+
+#if INTERPOLATION_SIMD
+
+static const Int  s_stride       = MAX_CU_SIZE + 32;
+static const Int  s_bufferSize   = s_stride * ( MAX_CU_SIZE + 32 );
+static const Int  s_margin       = 16 * s_stride + 16;
+
+static Pel s_src[ s_bufferSize ];
+static Pel s_tmp[ s_bufferSize ];
+static Pel s_dst[ SIMD_AVX2 + 1 ][ s_bufferSize ];
+
+enum FilterMode
+{
+  FILTER_HOR = 0,   ///< horizontal filter of uni-prediction
+  FILTER_VER,       ///< vertical filter of uni-prediction
+  FILTER_HOR_VER,   ///< horizontal and vertical filters of uni-prediction
+  NUMBER_OF_FILTER_MODES
+};
+
+static const TChar* s_filterModeNames[] = { "H", "V", "HV" };
+
+/**
+ * \brief Filter a block repeatedly like TComPrediction::xPredInterBlk does and return the time in seconds
+ */
+static Double xRunInterpolation(TComInterpolationFilter& filter, ComponentID compID, FilterMode mode, Int width, Int height, Pel* dst, Int iterations)
+{
+  const Int     bitDepth    = 8;
+  const Int     filterSize  = isLuma( compID ) ? NTAPS_LUMA : NTAPS_CHROMA;
+  const Int     halfSize    = filterSize >> 1;
+  const Int     numFracs    = isLuma( compID ) ? 3 : 7;
+  Pel*          src         = s_src + s_margin;
+  const clock_t before      = clock();
+
+  for ( Int i = 0; i < iterations; i++ )
+  {
+    const Int frac = 1 + i % numFracs;
+    switch ( mode )
+    {
+    case FILTER_HOR:
+      filter.filterHor( compID, src, s_stride, dst, s_stride, width, height, frac, true, CHROMA_420, bitDepth );
+      break;
+    case FILTER_VER:
+      filter.filterVer( compID, src, s_stride, dst, s_stride, width, height, frac, true, true, CHROMA_420, bitDepth );
+      break;
+    default:
+      filter.filterHor( compID, src - ( halfSize - 1 ) * s_stride, s_stride, s_tmp, s_stride, width, height + filterSize - 1, frac, false, CHROMA_420, bitDepth );
+      filter.filterVer( compID, s_tmp + ( halfSize - 1 ) * s_stride, s_stride, dst, s_stride, width, height, frac, false, true, CHROMA_420, bitDepth );
+      break;
+    }
+  }
+
+  return Double( clock() - before ) / CLOCKS_PER_SEC;
+}
+
+static Void xBenchmarkInterpolation()
+{
+  static const struct { ComponentID compID; Int width; Int height; } blocks[] =
+  {
+    { COMPONENT_Y,   8,  4 }, { COMPONENT_Y,   8,  8 }, { COMPONENT_Y,  12, 16 }, { COMPONENT_Y,  16, 16 },
+    { COMPONENT_Y,  24, 32 }, { COMPONENT_Y,  32, 32 }, { COMPONENT_Y,  64, 64 },
+    { COMPONENT_Cb,  2,  4 }, { COMPONENT_Cb,  4,  4 }, { COMPONENT_Cb,  6,  8 }, { COMPONENT_Cb,  8,  8 },
+    { COMPONENT_Cb, 16, 16 }, { COMPONENT_Cb, 32, 32 }
+  };
+  const Int numBlocks = sizeof( blocks ) / sizeof( blocks[0] );
+  const Int maxExtension = getSimdExtension();
+
+  for ( Int i = 0; i < s_bufferSize; i++ )
+  {
+    s_src[i] = Pel( ( i * 7919 + ( i >> 5 ) * 104729 ) & 0xff );
+  }
+
+  TComInterpolationFilter filters[ SIMD_AVX2 + 1 ];
+  for ( Int extension = SIMD_NONE; extension <= maxExtension; extension++ )
+  {
+    filters[extension].setSimdExtension( SimdExtension( extension ) );
+  }
+
+  printf( "\nInterpolation filters (Msamples/s, speed-up over the scalar filters)\n" );
+  printf( "%-8s %-4s %7s", "block", "dir", s_extensionNames[SIMD_NONE] );
+  for ( Int extension = SIMD_SSE41; extension <= maxExtension; extension++ )
+  {
+    printf( " %16s", s_extensionNames[extension] );
+  }
+  printf( "\n" );
+
+  for ( Int b = 0; b < numBlocks; b++ )
+  {
+    for ( Int mode = 0; mode < NUMBER_OF_FILTER_MODES; mode++ )
+    {
+      const Int iterations = std::max<Int>( 1, s_samplesPerRun / ( blocks[b].width * blocks[b].height ) );
+      Double    msamples[ SIMD_AVX2 + 1 ] = { 0 };
+
+      for ( Int extension = SIMD_NONE; extension <= maxExtension; extension++ )
+      {
+        memset( s_dst[extension], 0, sizeof( s_dst[extension] ) );
+        const Double seconds = xRunInterpolation( filters[extension], blocks[b].compID, FilterMode( mode ), blocks[b].width, blocks[b].height, s_dst[extension] + s_margin, iterations );
+        msamples[extension] = Double( iterations ) * blocks[b].width * blocks[b].height / std::max<Double>( seconds, 1e-6 ) / 1e6;
+      }
+
+      printf( "%-2s %2dx%-2d %-4s %7.1f", isLuma( blocks[b].compID ) ? "Y" : "C", blocks[b].width, blocks[b].height, s_filterModeNames[mode], msamples[SIMD_NONE] );
+      for ( Int extension = SIMD_SSE41; extension <= maxExtension; extension++ )
+      {
+        printf( " %7.1f (%5.2fx)", msamples[extension], msamples[extension] / msamples[SIMD_NONE] );
+        if ( memcmp( s_dst[extension], s_dst[SIMD_NONE], sizeof( s_dst[extension] ) ) )
+        {
+          printf( " MISMATCH" );
+        }
+      }
+      printf( "\n" );
+    }
+  }
+}
+
+#endif // INTERPOLATION_SIMD
+
+#if TRANSFORM_SIMD
+
+static TCoeff s_residual[ MAX_TU_SIZE * MAX_TU_SIZE ];
+static TCoeff s_coeff   [ MAX_TU_SIZE * MAX_TU_SIZE ];
+static TCoeff s_trTmp   [ MAX_TU_SIZE * MAX_TU_SIZE ];
+static TCoeff s_trDst   [ SIMD_AVX2 + 1 ][ MAX_TU_SIZE * MAX_TU_SIZE ];
+
+/**
+ * \brief Transform a square block repeatedly with the two partial butterfly passes of xTrMxN or xITrMxN and return the time in seconds
+ */
+static Double xRunTransform(const TComTrQuant& trQuant, Bool bInverse, Int log2Size, TCoeff* dst, Int iterations)
+{
+  const Int     bitDepth              = 8;
+  const Int     maxLog2TrDynamicRange = 15;
+  const Int     size                  = 1 << log2Size;
+  const clock_t before                = clock();
+
+  if ( bInverse )
+  {
+    const FpPartialButterflyInverse partialButterflyInverse = trQuant.getPartialButterflyInverse( log2Size );
+    const Int shift_1st = g_transformMatrixShift[TRANSFORM_INVERSE] + 1;
+    const Int shift_2nd = ( g_transformMatrixShift[TRANSFORM_INVERSE] + maxLog2TrDynamicRange - 1 ) - bitDepth;
+    for ( Int i = 0; i < iterations; i++ )
+    {
+      partialButterflyInverse( s_coeff, s_trTmp, shift_1st, size, -( 1 << maxLog2TrDynamicRange ), ( 1 << maxLog2TrDynamicRange ) - 1 );
+      partialButterflyInverse( s_trTmp, dst,     shift_2nd, size, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() );
+    }
+  }
+  else
+  {
+    const FpPartialButterfly partialButterfly = trQuant.getPartialButterfly( log2Size );
+    const Int shift_1st = ( log2Size + bitDepth + g_transformMatrixShift[TRANSFORM_FORWARD] ) - maxLog2TrDynamicRange;
+    const Int shift_2nd = log2Size + g_transformMatrixShift[TRANSFORM_FORWARD];
+    for ( Int i = 0; i < iterations; i++ )
+    {
+      partialButterfly( s_residual, s_trTmp, shift_1st, size );
+      partialButterfly( s_trTmp,    dst,     shift_2nd, size );
+    }
+  }
+
+  return Double( clock() - before ) / CLOCKS_PER_SEC;
+}
+
+static Void xBenchmarkTransforms()
+{
+  const Int maxExtension = getSimdExtension();
+
+  for ( Int i = 0; i < MAX_TU_SIZE * MAX_TU_SIZE; i++ )
+  {
+    s_residual[i] = TCoeff( ( i * 7919 + ( i >> 5 ) * 104729 ) & 0x1ff ) - 256;
+    s_coeff   [i] = ( i % 5 ) ? 0 : TCoeff( ( i * 104729 ) & 0x3ff ) - 512;
+  }
+
+  TComTrQuant trQuants[ SIMD_AVX2 + 1 ];
+  for ( Int extension = SIMD_NONE; extension <= maxExtension; extension++ )
+  {
+    trQuants[extension].setSimdExtension( SimdExtension( extension ) );
+  }
+
+  printf( "\nPartial butterfly transforms, 2D (Msamples/s, speed-up over the scalar transforms)\n" );
+  printf( "%-8s %-4s %7s", "block", "dir", s_extensionNames[SIMD_NONE] );
+  for ( Int extension = SIMD_SSE41; extension <= maxExtension; extension++ )
+  {
+    printf( " %16s", s_extensionNames[extension] );
+  }
+  printf( "\n" );
+
+  for ( Int log2Size = 2; log2Size <= 5; log2Size++ )
+  {
+    for ( Int inverse = 0; inverse < 2; inverse++ )
+    {
+      const Int size       = 1 << log2Size;
+      const Int iterations = s_samplesPerRun / ( size * size );
+      Double    msamples[ SIMD_AVX2 + 1 ] = { 0 };
+
+      for ( Int extension = SIMD_NONE; extension <= maxExtension; extension++ )
+      {
+        memset( s_trDst[extension], 0, sizeof( s_trDst[extension] ) );
+        const Double seconds = xRunTransform( trQuants[extension], inverse != 0, log2Size, s_trDst[extension], iterations );
+        msamples[extension] = Double( iterations ) * size * size / std::max<Double>( seconds, 1e-6 ) / 1e6;
+      }
+
+      printf( "   %2dx%-2d %-4s %7.1f", size, size, inverse ? "inv" : "fwd", msamples[SIMD_NONE] );
+      for ( Int extension = SIMD_SSE41; extension <= maxExtension; extension++ )
+      {
+        printf( " %7.1f (%5.2fx)", msamples[extension], msamples[extension] / msamples[SIMD_NONE] );
+        if ( memcmp( s_trDst[extension], s_trDst[SIMD_NONE], sizeof( s_trDst[extension] ) ) )
+        {
+          printf( " MISMATCH" );
+        }
+      }
+      printf( "\n" );
+    }
+  }
+}
+
+#endif // TRANSFORM_SIMD
+
+#if DEBLOCKING_SIMD
+
+static const Int  s_lfSize   = 64;
+static const Int  s_lfStride = s_lfSize + 16;
+
+static Pel s_lfSrc[ s_lfStride * s_lfStride ];
+static Pel s_lfDst[ SIMD_AVX2 + 1 ][ s_lfStride * s_lfStride ];
+
+/**
+ * \brief Filter all luma edge segments of one direction of a 64x64 block on the 8x8 grid repeatedly and return the time in seconds
+ */
+static Double xRunDeblocking(const TComLoopFilter& loopFilter, DeblockEdgeDir edgeDir, Bool sw, Pel* dst, Int iterations)
+{
+  const Int                 bitDepth  = 8;
+  const Int                 tc        = 6;
+  const FpFilterLumaSegment filter    = loopFilter.getFilterLumaSegment( edgeDir );
+  const Int                 iOffset   = edgeDir == EDGE_VER ? 1 : s_lfStride;
+  const Int                 iSrcStep  = edgeDir == EDGE_VER ? s_lfStride : 1;
+  Pel*                      piBlock   = dst + 8 * s_lfStride + 8;
+  const clock_t             before    = clock();
+
+  for ( Int i = 0; i < iterations; i++ )
+  {
+    for ( Int edge = DEBLOCK_SMALLEST_BLOCK; edge < s_lfSize; edge += DEBLOCK_SMALLEST_BLOCK )
+    {
+      for ( Int line = 0; line < s_lfSize; line += DEBLOCK_SMALLEST_BLOCK/2 )
+      {
+        filter( piBlock + edge * iOffset + line * iSrcStep, iOffset, iSrcStep, tc, sw, false, false, tc * 10, true, true, bitDepth );
+      }
+    }
+  }
+
+  return Double( clock() - before ) / CLOCKS_PER_SEC;
+}
+
+static Void xBenchmarkDeblocking()
+{
+  const Int maxExtension = std::min<Int>( getSimdExtension(), SIMD_SSE41 );
+  const Int numSegments  = ( s_lfSize / DEBLOCK_SMALLEST_BLOCK - 1 ) * ( s_lfSize / ( DEBLOCK_SMALLEST_BLOCK/2 ) );
+  const Int iterations   = s_samplesPerRun / ( numSegments * DEBLOCK_SMALLEST_BLOCK * DEBLOCK_SMALLEST_BLOCK/2 );
+
+  for ( Int i = 0; i < s_lfStride * s_lfStride; i++ )
+  {
+    s_lfSrc[i] = Pel( 128 + ( ( i * 7919 + ( i >> 5 ) * 104729 ) & 0xf ) );
+  }
+
+  TComLoopFilter loopFilters[ SIMD_AVX2 + 1 ];
+  for ( Int extension = SIMD_NONE; extension <= maxExtension; extension++ )
+  {
+    loopFilters[extension].setSimdExtension( SimdExtension( extension ) );
+  }
+
+  printf( "\nLuma deblocking filters, segments of 4 lines (Msegments/s, speed-up over the scalar filters)\n" );
+  printf( "%-8s %-6s %7s", "edge", "filter", s_extensionNames[SIMD_NONE] );
+  for ( Int extension = SIMD_SSE41; extension <= maxExtension; extension++ )
+  {
+    printf( " %16s", s_extensionNames[extension] );
+  }
+  printf( "\n" );
+
+  for ( Int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
+  {
+    for ( Int strong = 0; strong < 2; strong++ )
+    {
+      Double msegments[ SIMD_AVX2 + 1 ] = { 0 };
+
+      for ( Int extension = SIMD_NONE; extension <= maxExtension; extension++ )
+      {
+        memcpy( s_lfDst[extension], s_lfSrc, sizeof( s_lfSrc ) );
+        const Double seconds = xRunDeblocking( loopFilters[extension], DeblockEdgeDir( edgeDir ), strong != 0, s_lfDst[extension], iterations );
+        msegments[extension] = Double( iterations ) * numSegments / std::max<Double>( seconds, 1e-6 ) / 1e6;
+      }
+
+      printf( "%-8s %-6s %7.1f", edgeDir == EDGE_VER ? "ver" : "hor", strong ? "strong" : "weak", msegments[SIMD_NONE] );
+      for ( Int extension = SIMD_SSE41; extension <= maxExtension; extension++ )
+      {
+        printf( " %7.1f (%5.2fx)", msegments[extension], msegments[extension] / msegments[SIMD_NONE] );
+        if ( memcmp( s_lfDst[extension], s_lfDst[SIMD_NONE], sizeof( s_lfDst[extension] ) ) )
+        {
+          printf( " MISMATCH" );
+        }
+      }
+      printf( "\n" );
+    }
+  }
+}
+
+#endif // DEBLOCKING_SIMD
+
+#if SAO_SIMD
+
+static const Int  s_saoSize   = 64;
+static const Int  s_saoStride = s_saoSize + 16;
+
+static Pel s_saoSrc[ s_saoStride * ( s_saoSize + 2 ) ];
+static Pel s_saoDst[ SIMD_AVX2 + 1 ][ s_saoStride * ( s_saoSize + 2 ) ];
+
+static const TChar* s_saoTypeNames[] = { "EO 0", "EO 90", "EO 135", "EO 45", "BO" };
+
+/**
+ * \brief Apply the offsets of one SAO type to a 64x64 block repeatedly and return the time in seconds
+ */
+static Double xRunSao(const TComSampleAdaptiveOffset& sao, Int typeIdx, Pel* dst, Int iterations)
+{
+  const Int     bitDepth = 8;
+  const Int     neighbors[SAO_TYPE_START_BO][2] = { { -1, 1 }, { -s_saoStride, s_saoStride }, { -s_saoStride - 1, s_saoStride + 1 }, { -s_saoStride + 1, s_saoStride - 1 } };
+  const Int     offset[NUM_SAO_BO_CLASSES] = { 3, 1, 0, -1, -3, 2, 1, -1, -2, 1, 2, 3, -3, -2, -1, 1,
+                                               2, -2, 3, 1, 0, -1, 2, -3, 1, 2, -1, 3, -2, 1, 0, -1 };
+  const Pel*    piSrc    = s_saoSrc + s_saoStride + 8;
+  Pel*          piDst    = dst + s_saoStride + 8;
+  const clock_t before   = clock();
+
+  for ( Int i = 0; i < iterations; i++ )
+  {
+    if ( typeIdx == SAO_TYPE_BO )
+    {
+      sao.getBandOffset()( piSrc, piDst, s_saoStride, s_saoStride, s_saoSize, s_saoSize, bitDepth - NUM_SAO_BO_CLASSES_LOG2, offset, ( 1 << bitDepth ) - 1 );
+    }
+    else
+    {
+      sao.getEdgeOffset()( piSrc, piDst, s_saoStride, s_saoStride, s_saoSize, s_saoSize, neighbors[typeIdx][0], neighbors[typeIdx][1], offset, ( 1 << bitDepth ) - 1 );
+    }
+  }
+
+  return Double( clock() - before ) / CLOCKS_PER_SEC;
+}
+
+static Void xBenchmarkSao()
+{
+  const Int maxExtension = getSimdExtension();
+  const Int iterations   = s_samplesPerRun / ( s_saoSize * s_saoSize );
+
+  for ( Int i = 0; i < s_saoStride * ( s_saoSize + 2 ); i++ )
+  {
+    s_saoSrc[i] = Pel( 128 + ( ( i * 7919 + ( i >> 5 ) * 104729 ) & 0xf ) );
+  }
+
+  TComSampleAdaptiveOffset saos[ SIMD_AVX2 + 1 ];
+  for ( Int extension = SIMD_NONE; extension <= maxExtension; extension++ )
+  {
+    saos[extension].setSimdExtension( SimdExtension( extension ) );
+  }
+
+  printf( "\nSAO edge and band offsets, 64x64 blocks (Msamples/s, speed-up over the scalar offsets)\n" );
+  printf( "%-8s %7s", "type", s_extensionNames[SIMD_NONE] );
+  for ( Int extension = SIMD_SSE41; extension <= maxExtension; extension++ )
+  {
+    printf( " %16s", s_extensionNames[extension] );
+  }
+  printf( "\n" );
+
+  for ( Int typeIdx = 0; typeIdx < NUM_SAO_NEW_TYPES; typeIdx++ )
+  {
+    Double msamples[ SIMD_AVX2 + 1 ] = { 0 };
+
+    for ( Int extension = SIMD_NONE; extension <= maxExtension; extension++ )
+    {
+      memset( s_saoDst[extension], 0, sizeof( s_saoDst[extension] ) );
+      const Double seconds = xRunSao( saos[extension], typeIdx, s_saoDst[extension], iterations );
+      msamples[extension] = Double( iterations ) * s_saoSize * s_saoSize / std::max<Double>( seconds, 1e-6 ) / 1e6;
+    }
+
+    printf( "%-8s %7.1f", s_saoTypeNames[typeIdx], msamples[SIMD_NONE] );
+    for ( Int extension = SIMD_SSE41; extension <= maxExtension; extension++ )
+    {
+      printf( " %7.1f (%5.2fx)", msamples[extension], msamples[extension] / msamples[SIMD_NONE] );
+      if ( memcmp( s_saoDst[extension], s_saoDst[SIMD_NONE], sizeof( s_saoDst[extension] ) ) )
+      {
+        printf( " MISMATCH" );
+      }
+    }
+    printf( "\n" );
+  }
+}
+
+#endif // SAO_SIMD
+
+/// usage: simdBenchmark [interpolation|transform|deblocking|sao], all kernels are measured without an argument
+int main(int argc, char* argv[])
+{
+  const TChar* kernels = ( argc > 1 ) ? argv[1] : "";
+
+  printf( "SIMD extension of the CPU: %s\n", s_extensionNames[getSimdExtension()] );
+#if INTERPOLATION_SIMD
+  if ( !kernels[0] || !strcmp( kernels, "interpolation" ) )
+  {
+    xBenchmarkInterpolation();
+  }
+#endif
+#if TRANSFORM_SIMD
+  if ( !kernels[0] || !strcmp( kernels, "transform" ) )
+  {
+    xBenchmarkTransforms();
+  }
+#endif
+#if DEBLOCKING_SIMD
+  if ( !kernels[0] || !strcmp( kernels, "deblocking" ) )
+  {
+    xBenchmarkDeblocking();
+  }
+#endif
+#if SAO_SIMD
+  if ( !kernels[0] || !strcmp( kernels, "sao" ) )
+  {
+    xBenchmarkSao();
+  }
+#endif
+  return 0;
+}
+
+#else
+
+int main()
+{
+  printf( "The SIMD kernels are not compiled in this build\n" );
+  return 1;
+}
+
+#endif
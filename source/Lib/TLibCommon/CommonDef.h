@@ -455,6 +455,7 @@ static const std::string NALU_TYPE_STR[] = {
 #define REN_USED_PEL       ( (1 << REN_BIT_DEPTH) - 1 )
 #define REN_UNUSED_PEL     0
 #define REN_IS_HOLE        0
+#define REN_MIN_PARALLEL_BLOCK_SIZE 1024   ///< minimal number of samples of a block for which the render models are evaluated in parallel threads
 #if NH_3D_VSO
 #define ENC_INTERNAL_BIT_DEPTH  REN_BIT_DEPTH // consider making this a variable
 #endif
@@ -38,6 +38,7 @@
 #include "Debug.h"
 #include <algorithm>
 #include <math.h>
+#include <stdarg.h>
 #include "TComDataCU.h"
 #include "TComPic.h"
 #include "TComYuv.h"
@@ -417,6 +418,17 @@ std::string indentNewLines(const std::string &input, const UInt indentBy)
 }
 
 
+Void appendFormat(std::string &rStr, const TChar *format, ...)
+{
+  TChar buffer[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  rStr += buffer;
+}
+
+
 // --------------------------------------------------------------------------------------------------------------------- //
 
 
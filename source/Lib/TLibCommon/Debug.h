@@ -266,6 +266,10 @@ std::string lineWrap(const std::string &input, const UInt maximumLineLength);
 
 std::string indentNewLines(const std::string &input, const UInt indentBy);
 
+//append printf-style formatted text (truncated to 255 characters) to a string
+
+Void appendFormat(std::string &rStr, const TChar *format, ...);
+
 // ---------------------------------------------------------------------------------------------- //
 
 #if DEBUG_STRING
@@ -4621,7 +4621,12 @@ Bool TComDataCU::xAddMVPCandWithScaling( AMVPInfo &info, const RefPicList eRefPi
 
   const Int  currPOC            = m_pcSlice->getPOC();
   const Int  currRefPOC         = m_pcSlice->getRefPic( eRefPicList, iRefIdx)->getPOC();
+#if NH_MV_LAYER_PARALLEL_DEC
+  // the marking of a picture as long-term reference may change while a slice referring to it is decoded in another thread
+  const Bool bIsCurrRefLongTerm = m_pcSlice->getIsUsedAsLongTerm( eRefPicList, iRefIdx );
+#else
   const Bool bIsCurrRefLongTerm = m_pcSlice->getRefPic( eRefPicList, iRefIdx)->getIsLongTerm();
+#endif
   const Int  neibPOC            = currPOC;
 
   for(Int predictorSource=0; predictorSource<2; predictorSource++) // examine the indicated reference picture list, then if not available, examine the other list.
@@ -4630,7 +4635,11 @@ Bool TComDataCU::xAddMVPCandWithScaling( AMVPInfo &info, const RefPicList eRefPi
     const Int        neibRefIdx       = neibCU->getCUMvField(eRefPicListIndex)->getRefIdx(neibPUPartIdx);
     if( neibRefIdx >= 0)
     {
+#if NH_MV_LAYER_PARALLEL_DEC
+      const Bool bIsNeibRefLongTerm = neibCU->getSlice()->getIsUsedAsLongTerm( eRefPicListIndex, neibRefIdx );
+#else
       const Bool bIsNeibRefLongTerm = neibCU->getSlice()->getRefPic( eRefPicListIndex, neibRefIdx )->getIsLongTerm();
+#endif
 
       if ( bIsCurrRefLongTerm == bIsNeibRefLongTerm )
       {
@@ -4697,8 +4706,12 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
     }
   }
 
-#if NH_3D_TMVP
+#if NH_3D_TMVP && NH_MV_LAYER_PARALLEL_DEC
+  Bool bIsCurrRefLongTerm = m_pcSlice->getIsUsedAsLongTerm(eRefPicList, refIdx);
+#elif NH_3D_TMVP
   Bool bIsCurrRefLongTerm = m_pcSlice->getRefPic(eRefPicList, refIdx)->getIsLongTerm();
+#elif NH_MV_LAYER_PARALLEL_DEC
+  const Bool bIsCurrRefLongTerm = m_pcSlice->getIsUsedAsLongTerm(eRefPicList, refIdx);
 #else
   const Bool bIsCurrRefLongTerm = m_pcSlice->getRefPic(eRefPicList, refIdx)->getIsLongTerm();
 #endif
@@ -4711,7 +4724,11 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
     if(bMRG && iAlterRefIdx > 0)
     {
       refIdx = iAlterRefIdx;
+#if NH_MV_LAYER_PARALLEL_DEC
+      bIsCurrRefLongTerm = m_pcSlice->getIsUsedAsLongTerm(eRefPicList, refIdx);
+#else
       bIsCurrRefLongTerm = m_pcSlice->getRefPic(eRefPicList, refIdx)->getIsLongTerm();
+#endif
       assert(bIsCurrRefLongTerm == bIsColRefLongTerm);
     }
     else
@@ -6097,20 +6114,35 @@ Void TComDataCU::xSetMvFieldForVSP( TComDataCU *cu, TComPicYuv *picRefDepth, TCo
 
   for( Int y=0; y<height; y+=subBlockH, partAddrRasterSubPULine+=numPartsInSubPUH )
   {
+#if NH_3D_VSP_BLOCK_MC
+    // maxima of the top and bottom sample rows of the sub-block row in one pass, the sub-block maximum is the one of its first and last column
+    const Pel* refDepthTop    = refDepth + refDepStride * y;
+    const Pel* refDepthBottom = refDepthTop + refDepStride * (subBlockH - 1);
+    Pel        colMaxDepth[MAX_CU_SIZE];
+    for( Int x=0; x<width; x++ )
+    {
+      colMaxDepth[x] = std::max( refDepthTop[x], refDepthBottom[x] );
+    }
+#else
     Pel *refDepthTmp[4];
     refDepthTmp[0] = refDepth + refDepStride * y;
     refDepthTmp[1] = refDepthTmp[0] + subBlockW - 1;
     refDepthTmp[2] = refDepthTmp[0] + refDepStride * (subBlockH - 1);
     refDepthTmp[3] = refDepthTmp[2] + subBlockW - 1;
+#endif
 
     Int partAddrRasterSubPU = partAddrRasterSubPULine;
     for( Int x=0; x<width; x+=subBlockW, partAddrRasterSubPU+=numPartsInSubPUW )
     {
       Pel  maxDepthVal;
+#if NH_3D_VSP_BLOCK_MC
+      maxDepthVal = std::max( colMaxDepth[x], colMaxDepth[x + subBlockW - 1] );
+#else
       maxDepthVal = refDepthTmp[0][x];
       maxDepthVal = std::max( maxDepthVal, refDepthTmp[1][x]);
       maxDepthVal = std::max( maxDepthVal, refDepthTmp[2][x]);
       maxDepthVal = std::max( maxDepthVal, refDepthTmp[3][x]);
+#endif
       tmpMv.setHor( (Short) shiftLUT[ maxDepthVal ] );
 
       Int partAddrRasterPartLine = partAddrRasterSubPU;
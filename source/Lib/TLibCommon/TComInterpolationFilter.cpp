@@ -278,67 +278,62 @@ Void TComInterpolationFilter::filter(Int bitDepth, Pel const *src, Int srcStride
 }
 
 /**
- * \brief Filter a block of samples (horizontal)
+ * \brief Set the filter functions of a filter for all directions and stages
  *
  * \tparam N          Number of taps
- * \param  bitDepth   Bit depth of samples
- * \param  src        Pointer to source samples
- * \param  srcStride  Stride of source samples
- * \param  dst        Pointer to destination samples
- * \param  dstStride  Stride of destination samples
- * \param  width      Width of block
- * \param  height     Height of block
- * \param  isLast     Flag indicating whether it is the last filtering operation
- * \param  coeff      Pointer to filter taps
+ * \param  filterIdx  Index of the filter in m_afpFilter
  */
 template<Int N>
-Void TComInterpolationFilter::filterHor(Int bitDepth, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Bool isLast, TFilterCoeff const *coeff)
+Void TComInterpolationFilter::xInitFilters(Int filterIdx)
 {
-  if ( isLast )
-  {
-    filter<N, false, true, true>(bitDepth, src, srcStride, dst, dstStride, width, height, coeff);
-  }
-  else
+  m_afpFilter[filterIdx][0][0][0] = filter<N, false, false, false>;
+  m_afpFilter[filterIdx][0][0][1] = filter<N, false, false, true >;
+  m_afpFilter[filterIdx][0][1][0] = filter<N, false, true,  false>;
+  m_afpFilter[filterIdx][0][1][1] = filter<N, false, true,  true >;
+  m_afpFilter[filterIdx][1][0][0] = filter<N, true,  false, false>;
+  m_afpFilter[filterIdx][1][0][1] = filter<N, true,  false, true >;
+  m_afpFilter[filterIdx][1][1][0] = filter<N, true,  true,  false>;
+  m_afpFilter[filterIdx][1][1][1] = filter<N, true,  true,  true >;
+}
+
+// ====================================================================================================================
+// Constructor / destructor / initialization
+// ====================================================================================================================
+
+TComInterpolationFilter::TComInterpolationFilter()
+{
+  xInitFilters<NTAPS_LUMA  >(0);
+  xInitFilters<NTAPS_CHROMA>(1);
+#if NH_3D_ARP
+  xInitFilters<NTAPS_LUMA_ARP>(2);
+#endif
+
+#if INTERPOLATION_SIMD && SIMD_X86
+  // the vectorized filters are only installed if they give the same results as the scalar ones
+  static const Bool bSimdChecked = xCheckSimdFilters();
+  if ( bSimdChecked )
   {
-    filter<N, false, true, false>(bitDepth, src, srcStride, dst, dstStride, width, height, coeff);
+    xSetSimdFilters( getSimdExtension() );
   }
+#endif
 }
 
+#if INTERPOLATION_SIMD && SIMD_X86
 /**
- * \brief Filter a block of samples (vertical)
+ * \brief Use the filter functions of a SIMD extension
  *
- * \tparam N          Number of taps
- * \param  bitDepth   Bit depth
- * \param  src        Pointer to source samples
- * \param  srcStride  Stride of source samples
- * \param  dst        Pointer to destination samples
- * \param  dstStride  Stride of destination samples
- * \param  width      Width of block
- * \param  height     Height of block
- * \param  isFirst    Flag indicating whether it is the first filtering operation
- * \param  isLast     Flag indicating whether it is the last filtering operation
- * \param  coeff      Pointer to filter taps
+ * \param eExtension  SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE selects the scalar filters
  */
-template<Int N>
-Void TComInterpolationFilter::filterVer(Int bitDepth, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Bool isFirst, Bool isLast, TFilterCoeff const *coeff)
+Void TComInterpolationFilter::setSimdExtension(SimdExtension eExtension)
 {
-  if ( isFirst && isLast )
-  {
-    filter<N, true, true, true>(bitDepth, src, srcStride, dst, dstStride, width, height, coeff);
-  }
-  else if ( isFirst && !isLast )
-  {
-    filter<N, true, true, false>(bitDepth, src, srcStride, dst, dstStride, width, height, coeff);
-  }
-  else if ( !isFirst && isLast )
-  {
-    filter<N, true, false, true>(bitDepth, src, srcStride, dst, dstStride, width, height, coeff);
-  }
-  else
-  {
-    filter<N, true, false, false>(bitDepth, src, srcStride, dst, dstStride, width, height, coeff);
-  }
+  xInitFilters<NTAPS_LUMA  >(0);
+  xInitFilters<NTAPS_CHROMA>(1);
+#if NH_3D_ARP
+  xInitFilters<NTAPS_LUMA_ARP>(2);
+#endif
+  xSetSimdFilters( eExtension );
 }
+#endif
 
 // ====================================================================================================================
 // Public member functions
@@ -376,12 +371,12 @@ Void TComInterpolationFilter::filterHor(const ComponentID compID, Pel *src, Int
 #if NH_3D_ARP
     if(filterType)
     {
-      filterHor<NTAPS_LUMA_ARP>(bitDepth, src, srcStride, dst, dstStride, width, height, isLast, m_lumaFilterARP[frac]);
+      m_afpFilter[2][0][1][isLast](bitDepth, src, srcStride, dst, dstStride, width, height, m_lumaFilterARP[frac]);
     }
     else
     {
 #endif
-    filterHor<NTAPS_LUMA>(bitDepth, src, srcStride, dst, dstStride, width, height, isLast, m_lumaFilter[frac]);
+    m_afpFilter[0][0][1][isLast](bitDepth, src, srcStride, dst, dstStride, width, height, m_lumaFilter[frac]);
 #if NH_3D_ARP
     }
 #endif
@@ -394,12 +389,12 @@ Void TComInterpolationFilter::filterHor(const ComponentID compID, Pel *src, Int
 #if NH_3D_ARP
     if(filterType)
     {
-      filterHor<NTAPS_CHROMA_ARP>(bitDepth, src, srcStride, dst, dstStride, width, height, isLast, m_chromaFilterARP[frac]);
+      m_afpFilter[2][0][1][isLast](bitDepth, src, srcStride, dst, dstStride, width, height, m_chromaFilterARP[frac]);
     }
     else
     {
 #endif
-    filterHor<NTAPS_CHROMA>(bitDepth, src, srcStride, dst, dstStride, width, height, isLast, m_chromaFilter[frac<<(1-csx)]);
+    m_afpFilter[1][0][1][isLast](bitDepth, src, srcStride, dst, dstStride, width, height, m_chromaFilter[frac<<(1-csx)]);
 #if NH_3D_ARP
     }
 #endif
@@ -439,12 +434,12 @@ Void TComInterpolationFilter::filterVer(const ComponentID compID, Pel *src, Int
 #if NH_3D_ARP
     if(filterType)
     {
-      filterVer<NTAPS_LUMA_ARP>(bitDepth, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_lumaFilterARP[frac]);    
+      m_afpFilter[2][1][isFirst][isLast](bitDepth, src, srcStride, dst, dstStride, width, height, m_lumaFilterARP[frac]);    
     }
     else
     {
 #endif
-    filterVer<NTAPS_LUMA>(bitDepth, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_lumaFilter[frac]);
+    m_afpFilter[0][1][isFirst][isLast](bitDepth, src, srcStride, dst, dstStride, width, height, m_lumaFilter[frac]);
 #if NH_3D_ARP
     }
 #endif
@@ -457,12 +452,12 @@ Void TComInterpolationFilter::filterVer(const ComponentID compID, Pel *src, Int
 #if NH_3D_ARP
     if(filterType)
     {
-      filterVer<NTAPS_CHROMA_ARP>(bitDepth, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_chromaFilterARP[frac]);    
+      m_afpFilter[2][1][isFirst][isLast](bitDepth, src, srcStride, dst, dstStride, width, height, m_chromaFilterARP[frac]);    
     }
     else
     {
 #endif
-    filterVer<NTAPS_CHROMA>(bitDepth, src, srcStride, dst, dstStride, width, height, isFirst, isLast, m_chromaFilter[frac<<(1-csy)]);
+    m_afpFilter[1][1][isFirst][isLast](bitDepth, src, srcStride, dst, dstStride, width, height, m_chromaFilter[frac<<(1-csy)]);
 #if NH_3D_ARP
     }
 #endif
@@ -40,6 +40,9 @@
 #define __TCOMINTERPOLATIONFILTER__
 
 #include "CommonDef.h"
+#if INTERPOLATION_SIMD && SIMD_X86
+#include "TComSimd.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -67,20 +70,32 @@ class TComInterpolationFilter
   static const Short m_chromaFilterARP[8][NTAPS_CHROMA_ARP];   ///< Chroma filter taps for ARP
 #endif
 
+  typedef Void (*FpFilter) (Int bitDepth, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeff);
+
+  /// filter<N, isVertical, isFirst, isLast> functions, indexed by [filter][isVertical][isFirst][isLast] with filter 0 = luma, 1 = chroma, 2 = ARP
+  FpFilter m_afpFilter[3][2][2][2];
+
   static Void filterCopy(Int bitDepth, const Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Bool isFirst, Bool isLast);
 
   template<Int N, Bool isVertical, Bool isFirst, Bool isLast>
   static Void filter(Int bitDepth, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeff);
 
   template<Int N>
-  static Void filterHor(Int bitDepth, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height,               Bool isLast, TFilterCoeff const *coeff);
-  template<Int N>
-  static Void filterVer(Int bitDepth, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Bool isFirst, Bool isLast, TFilterCoeff const *coeff);
+  Void xInitFilters      ( Int filterIdx );
+
+#if INTERPOLATION_SIMD && SIMD_X86
+  Void xSetSimdFilters   ( SimdExtension eExtension );
+  Bool xCheckSimdFilters ( ) const;
+#endif
 
 public:
-  TComInterpolationFilter() {}
+  TComInterpolationFilter();
   ~TComInterpolationFilter() {}
 
+#if INTERPOLATION_SIMD && SIMD_X86
+  Void setSimdExtension(SimdExtension eExtension); ///< use the filters of an extension, SIMD_NONE for the scalar ones
+#endif
+
 #if NH_3D_ARP
   Void filterHor(const ComponentID compID, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Int frac,               Bool isLast, const ChromaFormat fmt, const Int bitDepth , Bool filterType = false );
 #else
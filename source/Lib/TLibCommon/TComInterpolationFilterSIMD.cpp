@@ -0,0 +1,365 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComInterpolationFilterSIMD.cpp
+    \brief    SSE4.1 and AVX2 implementations of the 8 tap luma and 4 tap chroma interpolation filters
+
+    The products are summed in 32 bit like TComInterpolationFilter::filter() does, and the result is truncated
+    to Pel before the clipping, so the filtered samples are identical to the scalar ones. Columns that do not
+    fill a vector are filtered with the scalar code.
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "TComInterpolationFilter.h"
+#include "TComChromaFormat.h"
+
+#if INTERPOLATION_SIMD && SIMD_X86
+
+#include <immintrin.h>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Helpers
+// ====================================================================================================================
+
+/// parameters of the rounding and clipping stage, computed like in TComInterpolationFilter::filter()
+template<Bool isFirst, Bool isLast>
+static inline Void xGetFilterRounding(Int bitDepth, Int& offset, Int& shift, Pel& maxVal)
+{
+  const Int headRoom = std::max<Int>(2, (IF_INTERNAL_PREC - bitDepth));
+  shift = IF_FILTER_PREC;
+  if ( isLast )
+  {
+    shift += (isFirst) ? 0 : headRoom;
+    offset = 1 << (shift - 1);
+    offset += (isFirst) ? 0 : IF_INTERNAL_OFFS << IF_FILTER_PREC;
+    maxVal = (1 << bitDepth) - 1;
+  }
+  else
+  {
+    shift -= (isFirst) ? headRoom : 0;
+    offset = (isFirst) ? -IF_INTERNAL_OFFS << shift : 0;
+    maxVal = 0;
+  }
+}
+
+/// filters the columns [col, width) of a row with the scalar code
+template<Int N, Bool isLast>
+static inline Void xFilterTail(Pel const *src, Int cStride, Pel *dst, Int col, Int width, TFilterCoeff const *coeff, Int offset, Int shift, Pel maxVal)
+{
+  for ( ; col < width; col++ )
+  {
+    Int sum = 0;
+    for ( Int k = 0; k < N; k++ )
+    {
+      sum += src[col + k * cStride] * coeff[k];
+    }
+    Pel val = ( sum + offset ) >> shift;
+    if ( isLast )
+    {
+      val = ( val < 0 ) ? 0 : val;
+      val = ( val > maxVal ) ? maxVal : val;
+    }
+    dst[col] = val;
+  }
+}
+
+/// (sum + offset) >> shift of 8 sums, truncated to Pel and clipped in the last stage
+template<Bool isLast>
+static inline SIMD_TARGET_SSE41 __m128i xFilterOutputSse41(__m128i sumLo, __m128i sumHi, __m128i shift, __m128i maxVal)
+{
+  sumLo = _mm_srai_epi32( _mm_slli_epi32( _mm_sra_epi32( sumLo, shift ), 16 ), 16 );
+  sumHi = _mm_srai_epi32( _mm_slli_epi32( _mm_sra_epi32( sumHi, shift ), 16 ), 16 );
+  __m128i val = _mm_packs_epi32( sumLo, sumHi );
+  if ( isLast )
+  {
+    val = _mm_min_epi16( _mm_max_epi16( val, _mm_setzero_si128() ), maxVal );
+  }
+  return val;
+}
+
+template<Bool isLast>
+static inline SIMD_TARGET_AVX2 __m256i xFilterOutputAvx2(__m256i sumLo, __m256i sumHi, __m128i shift, __m256i maxVal)
+{
+  sumLo = _mm256_srai_epi32( _mm256_slli_epi32( _mm256_sra_epi32( sumLo, shift ), 16 ), 16 );
+  sumHi = _mm256_srai_epi32( _mm256_slli_epi32( _mm256_sra_epi32( sumHi, shift ), 16 ), 16 );
+  __m256i val = _mm256_packs_epi32( sumLo, sumHi );
+  if ( isLast )
+  {
+    val = _mm256_min_epi16( _mm256_max_epi16( val, _mm256_setzero_si256() ), maxVal );
+  }
+  return val;
+}
+
+// ====================================================================================================================
+// Filters
+// ====================================================================================================================
+
+/**
+ * \brief Apply FIR filter to a block of samples, counterpart of TComInterpolationFilter::filter()
+ *
+ * Each pair of taps is applied with one multiply-add to the interleaved samples of the two source positions,
+ * 8 columns at a time. src and dst point to the block like in TComInterpolationFilter::filter().
+ */
+template<Int N, Bool isVertical, Bool isFirst, Bool isLast>
+static SIMD_TARGET_SSE41 Void xFilterSse41(Int bitDepth, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeff)
+{
+  const Int cStride = ( isVertical ) ? srcStride : 1;
+  src -= ( N/2 - 1 ) * cStride;
+
+  Int offset, shift;
+  Pel maxVal;
+  xGetFilterRounding<isFirst, isLast>( bitDepth, offset, shift, maxVal );
+
+  __m128i vCoeff[N/2];
+  for ( Int k = 0; k < N; k += 2 )
+  {
+    vCoeff[k/2] = _mm_unpacklo_epi16( _mm_set1_epi16( coeff[k] ), _mm_set1_epi16( coeff[k+1] ) );
+  }
+  const __m128i vOffset = _mm_set1_epi32( offset );
+  const __m128i vShift  = _mm_cvtsi32_si128( shift );
+  const __m128i vMaxVal = _mm_set1_epi16( maxVal );
+
+  for ( Int row = 0; row < height; row++ )
+  {
+    Int col = 0;
+    for ( ; col + 8 <= width; col += 8 )
+    {
+      __m128i vSumLo = vOffset;
+      __m128i vSumHi = vOffset;
+      for ( Int k = 0; k < N; k += 2 )
+      {
+        const __m128i vSrc0 = _mm_loadu_si128( (const __m128i*)&src[col +   k       * cStride] );
+        const __m128i vSrc1 = _mm_loadu_si128( (const __m128i*)&src[col + ( k + 1 ) * cStride] );
+        vSumLo = _mm_add_epi32( vSumLo, _mm_madd_epi16( _mm_unpacklo_epi16( vSrc0, vSrc1 ), vCoeff[k/2] ) );
+        vSumHi = _mm_add_epi32( vSumHi, _mm_madd_epi16( _mm_unpackhi_epi16( vSrc0, vSrc1 ), vCoeff[k/2] ) );
+      }
+      _mm_storeu_si128( (__m128i*)&dst[col], xFilterOutputSse41<isLast>( vSumLo, vSumHi, vShift, vMaxVal ) );
+    }
+    if ( col + 4 <= width )
+    {
+      __m128i vSum = vOffset;
+      for ( Int k = 0; k < N; k += 2 )
+      {
+        const __m128i vSrc0 = _mm_loadl_epi64( (const __m128i*)&src[col +   k       * cStride] );
+        const __m128i vSrc1 = _mm_loadl_epi64( (const __m128i*)&src[col + ( k + 1 ) * cStride] );
+        vSum = _mm_add_epi32( vSum, _mm_madd_epi16( _mm_unpacklo_epi16( vSrc0, vSrc1 ), vCoeff[k/2] ) );
+      }
+      _mm_storel_epi64( (__m128i*)&dst[col], xFilterOutputSse41<isLast>( vSum, vSum, vShift, vMaxVal ) );
+      col += 4;
+    }
+    xFilterTail<N, isLast>( src, cStride, dst, col, width, coeff, offset, shift, maxVal );
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+/// AVX2 version of xFilterSse41: 16 columns at a time, the remaining columns are filtered by xFilterSse41
+template<Int N, Bool isVertical, Bool isFirst, Bool isLast>
+static SIMD_TARGET_AVX2 Void xFilterAvx2(Int bitDepth, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeff)
+{
+  const Int width16 = width & ~15;
+  if ( width16 < width )
+  {
+    xFilterSse41<N, isVertical, isFirst, isLast>( bitDepth, src + width16, srcStride, dst + width16, dstStride, width - width16, height, coeff );
+  }
+  if ( width16 == 0 )
+  {
+    return;
+  }
+
+  const Int cStride = ( isVertical ) ? srcStride : 1;
+  src -= ( N/2 - 1 ) * cStride;
+
+  Int offset, shift;
+  Pel maxVal;
+  xGetFilterRounding<isFirst, isLast>( bitDepth, offset, shift, maxVal );
+
+  __m256i vCoeff[N/2];
+  for ( Int k = 0; k < N; k += 2 )
+  {
+    vCoeff[k/2] = _mm256_unpacklo_epi16( _mm256_set1_epi16( coeff[k] ), _mm256_set1_epi16( coeff[k+1] ) );
+  }
+  const __m256i vOffset = _mm256_set1_epi32( offset );
+  const __m128i vShift  = _mm_cvtsi32_si128( shift );
+  const __m256i vMaxVal = _mm256_set1_epi16( maxVal );
+
+  for ( Int row = 0; row < height; row++ )
+  {
+    for ( Int col = 0; col < width16; col += 16 )
+    {
+      // the interleaving works within the 128 bit lanes, the packing restores the order of the columns
+      __m256i vSumLo = vOffset;
+      __m256i vSumHi = vOffset;
+      for ( Int k = 0; k < N; k += 2 )
+      {
+        const __m256i vSrc0 = _mm256_loadu_si256( (const __m256i*)&src[col +   k       * cStride] );
+        const __m256i vSrc1 = _mm256_loadu_si256( (const __m256i*)&src[col + ( k + 1 ) * cStride] );
+        vSumLo = _mm256_add_epi32( vSumLo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vSrc0, vSrc1 ), vCoeff[k/2] ) );
+        vSumHi = _mm256_add_epi32( vSumHi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vSrc0, vSrc1 ), vCoeff[k/2] ) );
+      }
+      _mm256_storeu_si256( (__m256i*)&dst[col], xFilterOutputAvx2<isLast>( vSumLo, vSumHi, vShift, vMaxVal ) );
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+// ====================================================================================================================
+// Installation and self-test
+// ====================================================================================================================
+
+/**
+ * \brief Replace the luma and chroma filter functions with the vectorized ones of an extension
+ *
+ * \param eExtension  SIMD extension, at most the one returned by getSimdExtension()
+ */
+Void TComInterpolationFilter::xSetSimdFilters(SimdExtension eExtension)
+{
+  if ( eExtension >= SIMD_AVX2 )
+  {
+    m_afpFilter[0][0][0][0] = xFilterAvx2<NTAPS_LUMA,   false, false, false>;
+    m_afpFilter[0][0][0][1] = xFilterAvx2<NTAPS_LUMA,   false, false, true >;
+    m_afpFilter[0][0][1][0] = xFilterAvx2<NTAPS_LUMA,   false, true,  false>;
+    m_afpFilter[0][0][1][1] = xFilterAvx2<NTAPS_LUMA,   false, true,  true >;
+    m_afpFilter[0][1][0][0] = xFilterAvx2<NTAPS_LUMA,   true,  false, false>;
+    m_afpFilter[0][1][0][1] = xFilterAvx2<NTAPS_LUMA,   true,  false, true >;
+    m_afpFilter[0][1][1][0] = xFilterAvx2<NTAPS_LUMA,   true,  true,  false>;
+    m_afpFilter[0][1][1][1] = xFilterAvx2<NTAPS_LUMA,   true,  true,  true >;
+    m_afpFilter[1][0][0][0] = xFilterAvx2<NTAPS_CHROMA, false, false, false>;
+    m_afpFilter[1][0][0][1] = xFilterAvx2<NTAPS_CHROMA, false, false, true >;
+    m_afpFilter[1][0][1][0] = xFilterAvx2<NTAPS_CHROMA, false, true,  false>;
+    m_afpFilter[1][0][1][1] = xFilterAvx2<NTAPS_CHROMA, false, true,  true >;
+    m_afpFilter[1][1][0][0] = xFilterAvx2<NTAPS_CHROMA, true,  false, false>;
+    m_afpFilter[1][1][0][1] = xFilterAvx2<NTAPS_CHROMA, true,  false, true >;
+    m_afpFilter[1][1][1][0] = xFilterAvx2<NTAPS_CHROMA, true,  true,  false>;
+    m_afpFilter[1][1][1][1] = xFilterAvx2<NTAPS_CHROMA, true,  true,  true >;
+  }
+  else if ( eExtension >= SIMD_SSE41 )
+  {
+    m_afpFilter[0][0][0][0] = xFilterSse41<NTAPS_LUMA,   false, false, false>;
+    m_afpFilter[0][0][0][1] = xFilterSse41<NTAPS_LUMA,   false, false, true >;
+    m_afpFilter[0][0][1][0] = xFilterSse41<NTAPS_LUMA,   false, true,  false>;
+    m_afpFilter[0][0][1][1] = xFilterSse41<NTAPS_LUMA,   false, true,  true >;
+    m_afpFilter[0][1][0][0] = xFilterSse41<NTAPS_LUMA,   true,  false, false>;
+    m_afpFilter[0][1][0][1] = xFilterSse41<NTAPS_LUMA,   true,  false, true >;
+    m_afpFilter[0][1][1][0] = xFilterSse41<NTAPS_LUMA,   true,  true,  false>;
+    m_afpFilter[0][1][1][1] = xFilterSse41<NTAPS_LUMA,   true,  true,  true >;
+    m_afpFilter[1][0][0][0] = xFilterSse41<NTAPS_CHROMA, false, false, false>;
+    m_afpFilter[1][0][0][1] = xFilterSse41<NTAPS_CHROMA, false, false, true >;
+    m_afpFilter[1][0][1][0] = xFilterSse41<NTAPS_CHROMA, false, true,  false>;
+    m_afpFilter[1][0][1][1] = xFilterSse41<NTAPS_CHROMA, false, true,  true >;
+    m_afpFilter[1][1][0][0] = xFilterSse41<NTAPS_CHROMA, true,  false, false>;
+    m_afpFilter[1][1][0][1] = xFilterSse41<NTAPS_CHROMA, true,  false, true >;
+    m_afpFilter[1][1][1][0] = xFilterSse41<NTAPS_CHROMA, true,  true,  false>;
+    m_afpFilter[1][1][1][1] = xFilterSse41<NTAPS_CHROMA, true,  true,  true >;
+  }
+}
+
+static UInt xGetTestRand(UInt& ruiSeed)
+{
+  ruiSeed = ruiSeed * 1103515245 + 12345;
+  return ( ruiSeed >> 8 );
+}
+
+/**
+ * \brief Compare the vectorized filters of all extensions supported by the CPU with the scalar ones of this object
+ *
+ * The blocks have random sizes, fractional positions and samples, including intermediate samples for the second
+ * filtering stage. Returns true if all filtered samples are identical.
+ */
+Bool TComInterpolationFilter::xCheckSimdFilters() const
+{
+  const Int stride = MAX_CU_SIZE + 32;
+  const Int margin = 8 * stride + 8;
+  static Pel src   [ stride * ( MAX_CU_SIZE + 16 ) ];
+  static Pel dstRef[ stride * ( MAX_CU_SIZE + 16 ) ];
+  static Pel dstVec[ stride * ( MAX_CU_SIZE + 16 ) ];
+  UInt seed = 1;
+
+  for ( Int extension = SIMD_SSE41; extension <= getSimdExtension(); extension++ )
+  {
+    TComInterpolationFilter refFilter ( *this );
+    TComInterpolationFilter simdFilter( *this );
+    simdFilter.xSetSimdFilters( SimdExtension( extension ) );
+
+    for ( Int test = 0; test < 256; test++ )
+    {
+      const Int          bitDepth   = ( test & 1 ) ? 10 : 8;
+      const Bool         isVertical = ( test & 2 ) != 0;
+      const Bool         isFirst    = !isVertical || ( test & 4 ) != 0;
+      const Bool         isLast     = ( test & 8 ) != 0;
+      const ComponentID  compID     = ( test & 16 ) ? COMPONENT_Cb : COMPONENT_Y;
+      const ChromaFormat fmt        = ( test & 32 ) ? CHROMA_444 : CHROMA_420;
+      const Int          width      = 1 + xGetTestRand( seed ) % ( MAX_CU_SIZE + 1 );
+      const Int          height     = 1 + xGetTestRand( seed ) % 16;
+      const Int          frac       = 1 + xGetTestRand( seed ) % ( isLuma( compID ) || fmt == CHROMA_444 ? 3 : 7 );
+
+      // samples of the picture in the first stage, intermediate samples in the second one
+      for ( Int i = 0; i < stride * ( MAX_CU_SIZE + 16 ); i++ )
+      {
+        src[i] = isFirst ? Pel( xGetTestRand( seed ) % ( 1 << bitDepth ) ) : Pel( Int( xGetTestRand( seed ) % ( 1 << 15 ) ) - ( 1 << 14 ) );
+        dstRef[i] = dstVec[i] = 0;
+      }
+
+      if ( isVertical )
+      {
+        refFilter .filterVer( compID, src + margin, stride, dstRef + margin, stride, width, height, frac, isFirst, isLast, fmt, bitDepth );
+        simdFilter.filterVer( compID, src + margin, stride, dstVec + margin, stride, width, height, frac, isFirst, isLast, fmt, bitDepth );
+      }
+      else
+      {
+        refFilter .filterHor( compID, src + margin, stride, dstRef + margin, stride, width, height, frac, isLast, fmt, bitDepth );
+        simdFilter.filterHor( compID, src + margin, stride, dstVec + margin, stride, width, height, frac, isLast, fmt, bitDepth );
+      }
+
+      if ( memcmp( dstRef, dstVec, sizeof( dstRef ) ) )
+      {
+        printf( "\nWarning: vectorized interpolation filter differs from the scalar one (%dx%d, %s), the scalar filters are used\n", width, height, isVertical ? "vertical" : "horizontal" );
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+//! \}
+
+#endif // INTERPOLATION_SIMD && SIMD_X86
@@ -73,16 +73,36 @@ const UChar TComLoopFilter::sm_betaTable[MAX_QP + 1] =
 TComLoopFilter::TComLoopFilter()
 : m_uiNumPartitions(0)
 , m_bLFCrossTileBoundary(true)
+#if DEBLOCKING_PARALLEL
+, m_uiMaxCUDepth(0)
+#endif
 {
   for( Int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
   {
     m_aapucBS       [edgeDir] = NULL;
     m_aapbEdgeFilter[edgeDir] = NULL;
+    m_afpFilterLumaSegment[edgeDir] = xFilterLumaSegment;
   }
+#if DEBLOCKING_SIMD && SIMD_X86
+  // the vectorized luma filters are only installed if they give the same results as the scalar ones
+  static const Bool bSimdChecked = xCheckSimdFilterLumaSegment();
+  if ( bSimdChecked )
+  {
+    xSetSimdFilterLumaSegment( m_afpFilterLumaSegment, getSimdExtension() );
+  }
+#endif
 }
 
 TComLoopFilter::~TComLoopFilter()
 {
+#if DEBLOCKING_PARALLEL
+  m_cThreadPool.destroy();
+  for ( UInt i = 0; i < m_apcCtuRowFilters.size(); i++ )
+  {
+    delete m_apcCtuRowFilters[i];
+  }
+#endif
+  destroy();
 }
 
 // ====================================================================================================================
@@ -93,9 +113,45 @@ Void TComLoopFilter::setCfg( Bool bLFCrossTileBoundary )
   m_bLFCrossTileBoundary = bLFCrossTileBoundary;
 }
 
+#if DEBLOCKING_PARALLEL
+Void TComLoopFilter::createThreads( Int iNumThreads )
+{
+  m_cThreadPool.destroy();
+  m_cThreadPool.create( iNumThreads );
+}
+#endif
+
+#if DEBLOCKING_SIMD && SIMD_X86
+/**
+ * \brief Use the luma filters of a SIMD extension
+ *
+ * \param eExtension  SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE selects the scalar functions
+ */
+Void TComLoopFilter::setSimdExtension( SimdExtension eExtension )
+{
+  for( Int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
+  {
+    m_afpFilterLumaSegment[edgeDir] = xFilterLumaSegment;
+  }
+  xSetSimdFilterLumaSegment( m_afpFilterLumaSegment, eExtension );
+}
+#endif
+
 Void TComLoopFilter::create( UInt uiMaxCUDepth )
 {
   destroy();
+#if DEBLOCKING_PARALLEL
+  if ( uiMaxCUDepth != m_uiMaxCUDepth )
+  {
+    // the CTU row filters are created again with the new size by the next picture
+    for ( UInt i = 0; i < m_apcCtuRowFilters.size(); i++ )
+    {
+      delete m_apcCtuRowFilters[i];
+    }
+    m_apcCtuRowFilters.clear();
+  }
+  m_uiMaxCUDepth = uiMaxCUDepth;
+#endif
   m_uiNumPartitions = 1 << ( uiMaxCUDepth<<1 );
   for( Int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
   {
@@ -129,45 +185,128 @@ Void TComLoopFilter::destroy()
  */
 Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
 {
+#if DEBLOCKING_PARALLEL
+  if ( m_cThreadPool.isParallel() )
+  {
+    xLoopFilterPicParallel( pcPic );
+    return;
+  }
+#endif
   // Horizontal filtering
   for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
   {
-    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
-
-    ::memset( m_aapucBS       [EDGE_VER], 0, sizeof( UChar ) * m_uiNumPartitions );
-    ::memset( m_aapbEdgeFilter[EDGE_VER], 0, sizeof( Bool  ) * m_uiNumPartitions );
-
-    // CU-based deblocking
-    xDeblockCU( pCtu, 0, 0, EDGE_VER );
+    xDeblockCtu( pcPic->getCtu( ctuRsAddr ), EDGE_VER );
   }
 
   // Vertical filtering
   for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
   {
-    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
-
-    ::memset( m_aapucBS       [EDGE_HOR], 0, sizeof( UChar ) * m_uiNumPartitions );
-    ::memset( m_aapbEdgeFilter[EDGE_HOR], 0, sizeof( Bool  ) * m_uiNumPartitions );
-
-    // CU-based deblocking
-    xDeblockCU( pCtu, 0, 0, EDGE_HOR );
+    xDeblockCtu( pcPic->getCtu( ctuRsAddr ), EDGE_HOR );
   }
 }
 
+#if NH_MV_LAYER_PARALLEL_DEC
+/** Deblock the vertical and then the horizontal edges of a CTU row.
+ * The horizontal edges at the top of the row modify the bottom lines of the row above, the row below is not accessed.
+ * Filtering the rows in ascending order gives the same result as loopFilterPic().
+ * \param pcPic  picture
+ * \param ctuRow CTU row
+ */
+Void TComLoopFilter::loopFilterCtuRow( TComPic* pcPic, UInt ctuRow )
+{
+  xDeblockCtuRow( pcPic, ctuRow, EDGE_VER );
+  xDeblockCtuRow( pcPic, ctuRow, EDGE_HOR );
+}
+#endif
+
 
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
 
+#if DEBLOCKING_PARALLEL
+/** Deblock the vertical edges of all CTU rows in parallel, then the horizontal edges.
+ * The vertical edges of a row only modify the samples of the row. The horizontal edges at the top of a row modify at
+ * most 3 lines of the row above, which are not read by the other horizontal edges of that row, so the rows of one
+ * direction are independent. Each job derives the boundary strengths in its own row filter.
+ * \param pcPic  picture
+ */
+Void TComLoopFilter::xLoopFilterPicParallel( TComPic* pcPic )
+{
+  const UInt frameHeightInCtus = pcPic->getFrameHeightInCtus();
+
+  while ( m_apcCtuRowFilters.size() < frameHeightInCtus )
+  {
+    TComLoopFilter* pcCtuRowFilter = new TComLoopFilter;
+    pcCtuRowFilter->create( m_uiMaxCUDepth );
+    m_apcCtuRowFilters.push_back( pcCtuRowFilter );
+  }
+  m_acCtuRowJobs.resize( frameHeightInCtus );
+
+  for ( Int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
+  {
+    for ( UInt ctuRow = 0; ctuRow < frameHeightInCtus; ctuRow++ )
+    {
+      CtuRowJob& rcJob = m_acCtuRowJobs[ctuRow];
+      rcJob.pcLoopFilter = m_apcCtuRowFilters[ctuRow];
+      rcJob.pcPic        = pcPic;
+      rcJob.ctuRow       = ctuRow;
+      rcJob.edgeDir      = DeblockEdgeDir( edgeDir );
+      rcJob.pcLoopFilter->m_bLFCrossTileBoundary = m_bLFCrossTileBoundary;
+      memcpy( rcJob.pcLoopFilter->m_afpFilterLumaSegment, m_afpFilterLumaSegment, sizeof( m_afpFilterLumaSegment ) );
+      m_cThreadPool.addJob( xCtuRowJob, &rcJob );
+    }
+    m_cThreadPool.waitAll();
+  }
+}
+
+Void TComLoopFilter::xCtuRowJob( Void* pParam )
+{
+  CtuRowJob* pcJob = (CtuRowJob*)pParam;
+  pcJob->pcLoopFilter->xDeblockCtuRow( pcJob->pcPic, pcJob->ctuRow, pcJob->edgeDir );
+}
+#endif
+
+Void TComLoopFilter::xDeblockCtuRow( TComPic* pcPic, UInt ctuRow, DeblockEdgeDir edgeDir )
+{
+  const UInt frameWidthInCtus = pcPic->getFrameWidthInCtus();
+
+  for ( UInt ctuRsAddr = ctuRow * frameWidthInCtus; ctuRsAddr < ( ctuRow + 1 ) * frameWidthInCtus; ctuRsAddr++ )
+  {
+    xDeblockCtu( pcPic->getCtu( ctuRsAddr ), edgeDir );
+  }
+}
+
 /**
- Deblocking filter process in CU-based (the same function as conventional's)
+ Deblocking of the edges of one direction of a CTU. The boundary strengths only depend on the coding data, so they
+ are derived for all CUs of the CTU before its edges are filtered.
+
+ \param pCtu             Pointer to CTU structure
+ \param edgeDir          the direction of the edge in block boundary (horizontal/vertical)
+*/
+Void TComLoopFilter::xDeblockCtu( TComDataCU* pCtu, DeblockEdgeDir edgeDir )
+{
+  if(pCtu->getPic()==0||pCtu->getPartitionSize(0)==NUMBER_OF_PART_SIZES)
+  {
+    return;
+  }
+
+  ::memset( m_aapucBS       [edgeDir], 0, sizeof( UChar ) * m_uiNumPartitions );
+  ::memset( m_aapbEdgeFilter[edgeDir], 0, sizeof( Bool  ) * m_uiNumPartitions );
+
+  xSetBoundaryStrengthCU( pCtu, 0, 0, edgeDir );
+  xEdgeFilterCtu        ( pCtu, edgeDir );
+}
+
+/**
+ Derivation of the edge flags and boundary strengths of a CU (the same function as conventional's)
 
  \param pcCU             Pointer to CTU/CU structure
  \param uiAbsZorderIdx   Position in CU
  \param uiDepth          Depth in CU
  \param edgeDir          the direction of the edge in block boundary (horizontal/vertical), which is added newly
 */
-Void TComLoopFilter::xDeblockCU( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, DeblockEdgeDir edgeDir )
+Void TComLoopFilter::xSetBoundaryStrengthCU( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, DeblockEdgeDir edgeDir )
 {
   if(pcCU->getPic()==0||pcCU->getPartitionSize(uiAbsZorderIdx)==NUMBER_OF_PART_SIZES)
   {
@@ -186,7 +325,7 @@ Void TComLoopFilter::xDeblockCU( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiD
       UInt uiTPelY   = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[uiAbsZorderIdx] ];
       if( ( uiLPelX < sps.getPicWidthInLumaSamples() ) && ( uiTPelY < sps.getPicHeightInLumaSamples() ) )
       {
-        xDeblockCU( pcCU, uiAbsZorderIdx, uiDepth+1, edgeDir );
+        xSetBoundaryStrengthCU( pcCU, uiAbsZorderIdx, uiDepth+1, edgeDir );
       }
     }
     return;
@@ -216,24 +355,37 @@ Void TComLoopFilter::xDeblockCU( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiD
       xGetBoundaryStrengthSingle ( pcCU, edgeDir, uiPartIdx );
     }
   }
+}
+
+/**
+ Filtering of the edges of one direction of a CTU with the boundary strengths of xSetBoundaryStrengthCU()
+
+ \param pCtu             Pointer to CTU structure
+ \param edgeDir          the direction of the edge in block boundary (horizontal/vertical)
+*/
+Void TComLoopFilter::xEdgeFilterCtu( TComDataCU* pCtu, DeblockEdgeDir edgeDir )
+{
+  TComPic* pcPic     = pCtu->getPic();
+  const TComSPS &sps = *(pCtu->getSlice()->getSPS());
+  const UInt uiPelsInPart = sps.getMaxCUWidth() >> sps.getMaxTotalCUDepth();
 
   UInt PartIdxIncr = DEBLOCK_SMALLEST_BLOCK / uiPelsInPart ? DEBLOCK_SMALLEST_BLOCK / uiPelsInPart : 1 ;
 
-  UInt uiSizeInPU = pcPic->getNumPartInCtuWidth()>>(uiDepth);
+  UInt uiSizeInPU = pcPic->getNumPartInCtuWidth();
   const ChromaFormat chFmt=pcPic->getChromaFormat();
   const UInt shiftFactor  = edgeDir == EDGE_VER ? pcPic->getComponentScaleX(COMPONENT_Cb) : pcPic->getComponentScaleY(COMPONENT_Cb);
   const Bool bAlwaysDoChroma=chFmt==CHROMA_444;
 
   for ( Int iEdge = 0; iEdge < uiSizeInPU ; iEdge+=PartIdxIncr)
   {
-    xEdgeFilterLuma     ( pcCU, uiAbsZorderIdx, uiDepth, edgeDir, iEdge );
+    xEdgeFilterLuma     ( pCtu, 0, 0, edgeDir, iEdge );
     if ( chFmt!=CHROMA_400 && (bAlwaysDoChroma ||
                                (uiPelsInPart>DEBLOCK_SMALLEST_BLOCK) ||
                                (iEdge % ( (DEBLOCK_SMALLEST_BLOCK<<shiftFactor)/uiPelsInPart ) ) == 0
                               )
        )
     {
-      xEdgeFilterChroma   ( pcCU, uiAbsZorderIdx, uiDepth, edgeDir, iEdge );
+      xEdgeFilterChroma   ( pCtu, 0, 0, edgeDir, iEdge );
     }
   }
 }
@@ -662,10 +814,7 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* const pcCU, const UInt uiAbsZo
           Bool sw =  xUseStrongFiltering( iOffset, 2*d0, iBeta, iTc, piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0))
           && xUseStrongFiltering( iOffset, 2*d3, iBeta, iTc, piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3));
 
-          for ( Int i = 0; i < DEBLOCK_SMALLEST_BLOCK/2; i++)
-          {
-            xPelFilterLuma( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+i), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, bitDepthLuma);
-          }
+          m_afpFilterLumaSegment[edgeDir]( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4), iOffset, iSrcStep, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, bitDepthLuma);
         }
       }
     }
@@ -888,6 +1037,21 @@ __inline Void TComLoopFilter::xPelFilterLuma( Pel* piSrc, Int iOffset, Int tc, B
   }
 }
 
+/**
+ - Deblocking of the DEBLOCK_SMALLEST_BLOCK/2 lines of a luma edge segment with xPelFilterLuma()
+ .
+ \param piSrc           pointer to the first line of the segment
+ \param iOffset         offset value for picture data
+ \param iSrcStep        offset from a line to the next one
+ */
+Void TComLoopFilter::xFilterLumaSegment( Pel* piSrc, Int iOffset, Int iSrcStep, Int tc, Bool sw, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iThrCut, Bool bFilterSecondP, Bool bFilterSecondQ, Int bitDepthLuma )
+{
+  for ( Int i = 0; i < DEBLOCK_SMALLEST_BLOCK/2; i++)
+  {
+    xPelFilterLuma( piSrc+iSrcStep*i, iOffset, tc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterSecondP, bFilterSecondQ, bitDepthLuma);
+  }
+}
+
 /**
  - Deblocking of one line/column for the chrominance component
  .
@@ -40,12 +40,25 @@
 
 #include "CommonDef.h"
 #include "TComPic.h"
+#if DEBLOCKING_PARALLEL
+#include "TComThreadPool.h"
+#endif
+#if DEBLOCKING_SIMD && SIMD_X86
+#include "TComSimd.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
 
 #define DEBLOCK_SMALLEST_BLOCK  8
 
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// luma filter of the DEBLOCK_SMALLEST_BLOCK/2 lines of an edge segment, the lines are iSrcStep apart
+typedef Void (*FpFilterLumaSegment)( Pel* piSrc, Int iOffset, Int iSrcStep, Int tc, Bool sw, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iThrCut, Bool bFilterSecondP, Bool bFilterSecondQ, Int bitDepthLuma );
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -62,9 +75,35 @@ private:
 
   Bool      m_bLFCrossTileBoundary;
 
+  FpFilterLumaSegment m_afpFilterLumaSegment[NUM_EDGE_DIR]; ///< luma filters of the vertical and horizontal edges
+
+#if DEBLOCKING_PARALLEL
+  /// CTU row job of xLoopFilterPicParallel()
+  struct CtuRowJob
+  {
+    TComLoopFilter* pcLoopFilter;
+    TComPic*        pcPic;
+    UInt            ctuRow;
+    DeblockEdgeDir  edgeDir;
+  };
+
+  UInt                         m_uiMaxCUDepth;
+  TComThreadPool               m_cThreadPool;
+  std::vector<TComLoopFilter*> m_apcCtuRowFilters; ///< boundary strengths and edge flags of the CTU row jobs
+  std::vector<CtuRowJob>       m_acCtuRowJobs;
+#endif
+
 protected:
-  /// CU-level deblocking function
-  Void xDeblockCU                 ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, DeblockEdgeDir edgeDir );
+  /// CTU-level deblocking of the edges of one direction: boundary strengths of the whole CTU, then filtering
+  Void xDeblockCtu                ( TComDataCU* pCtu, DeblockEdgeDir edgeDir );
+  Void xDeblockCtuRow             ( TComPic* pcPic, UInt ctuRow, DeblockEdgeDir edgeDir );
+  /// CU-level derivation of the edge flags and boundary strengths
+  Void xSetBoundaryStrengthCU     ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, DeblockEdgeDir edgeDir );
+  Void xEdgeFilterCtu             ( TComDataCU* pCtu, DeblockEdgeDir edgeDir );
+#if DEBLOCKING_PARALLEL
+  Void xLoopFilterPicParallel     ( TComPic* pcPic );
+  static Void xCtuRowJob          ( Void* pParam );
+#endif
 
   // set / get functions
   Void xSetLoopfilterParam        ( TComDataCU* pcCU, UInt uiAbsZorderIdx );
@@ -107,7 +146,12 @@ protected:
   Void xEdgeFilterLuma            ( TComDataCU* const pcCU, const UInt uiAbsZorderIdx, const UInt uiDepth, const DeblockEdgeDir edgeDir, const Int iEdge );
   Void xEdgeFilterChroma          ( TComDataCU* const pcCU, const UInt uiAbsZorderIdx, const UInt uiDepth, const DeblockEdgeDir edgeDir, const Int iEdge );
 
-  __inline Void xPelFilterLuma( Pel* piSrc, Int iOffset, Int tc, Bool sw, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iThrCut, Bool bFilterSecondP, Bool bFilterSecondQ, const Int bitDepthLuma);
+  static __inline Void xPelFilterLuma( Pel* piSrc, Int iOffset, Int tc, Bool sw, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iThrCut, Bool bFilterSecondP, Bool bFilterSecondQ, const Int bitDepthLuma);
+  static Void xFilterLumaSegment( Pel* piSrc, Int iOffset, Int iSrcStep, Int tc, Bool sw, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iThrCut, Bool bFilterSecondP, Bool bFilterSecondQ, Int bitDepthLuma );
+#if DEBLOCKING_SIMD && SIMD_X86
+  static Void xSetSimdFilterLumaSegment  ( FpFilterLumaSegment* afpFilterLumaSegment, SimdExtension eExtension );
+  Bool        xCheckSimdFilterLumaSegment( ) const;
+#endif
   __inline Void xPelFilterChroma( Pel* piSrc, Int iOffset, Int tc, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthChroma);
 
 
@@ -127,9 +171,21 @@ public:
 
   /// set configuration
   Void setCfg( Bool bLFCrossTileBoundary );
+#if DEBLOCKING_PARALLEL
+  /// filter the CTU rows of loopFilterPic() in iNumThreads threads, 1 filters sequentially
+  Void createThreads( Int iNumThreads );
+#endif
+#if DEBLOCKING_SIMD && SIMD_X86
+  Void setSimdExtension( SimdExtension eExtension ); ///< use the luma filters of an extension, SIMD_NONE for the scalar ones
+#endif
+  FpFilterLumaSegment getFilterLumaSegment( DeblockEdgeDir edgeDir ) const { return m_afpFilterLumaSegment[edgeDir]; }
 
   /// picture-level deblocking filter
   Void loopFilterPic( TComPic* pcPic );
+#if NH_MV_LAYER_PARALLEL_DEC
+  /// deblocking filter of the edges of a CTU row, the rows above must have been filtered before
+  Void loopFilterCtuRow( TComPic* pcPic, UInt ctuRow );
+#endif
 
   static Int getBeta( Int qp )
   {
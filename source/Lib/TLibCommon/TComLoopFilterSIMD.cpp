@@ -0,0 +1,301 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComLoopFilterSIMD.cpp
+    \brief    SSE4.1 implementation of the strong and weak luma deblocking filters
+
+    A vector holds the same sample position p3..q3 of the 4 lines of an edge segment, so the strong filter, the weak
+    filter and the per line decision of the weak filter are computed for the whole segment at once. The samples of a
+    horizontal edge are loaded row by row, the ones of a vertical edge are transposed on load and on store. All sums
+    are computed in 32 bit like the scalar code, which makes the results identical.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "TComLoopFilter.h"
+
+#if DEBLOCKING_SIMD && SIMD_X86
+
+#include <immintrin.h>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// SSE4.1, 4 lines per vector
+// ====================================================================================================================
+
+static inline SIMD_TARGET_SSE41 __m128i xClip3Sse41( __m128i vMin, __m128i vMax, __m128i v )
+{
+  return _mm_min_epi32( _mm_max_epi32( v, vMin ), vMax );
+}
+
+/**
+ * filter of the samples m[0..7] = p3, p2, p1, p0, q0, q1, q2, q3 of 4 lines as xPelFilterLuma(), the filtered samples
+ * replace m[1..6]; the samples of a part which is not filtered are kept
+ */
+static inline SIMD_TARGET_SSE41 Void xFilterLumaSse41( __m128i* m, Int tc, Bool sw, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iThrCut, Bool bFilterSecondP, Bool bFilterSecondQ, Int bitDepthLuma )
+{
+  __m128i n[8];
+  for ( Int i = 1; i < 7; i++ )
+  {
+    n[i] = m[i];
+  }
+
+  if ( sw )
+  {
+    const __m128i vTc2   = _mm_set1_epi32( 2 * tc );
+    const __m128i vFour  = _mm_set1_epi32( 4 );
+    const __m128i vTwo   = _mm_set1_epi32( 2 );
+    const __m128i vSum34 = _mm_add_epi32( m[3], m[4] );
+    const __m128i vSum   = _mm_add_epi32( _mm_add_epi32( m[2], m[5] ), vSum34 );
+
+    // m1 + 2*m2 + 2*m3 + 2*m4 + m5 + 4 and m2 + 2*m3 + 2*m4 + 2*m5 + m6 + 4
+    const __m128i v3 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( vSum, 1 ), _mm_sub_epi32( m[1], m[5] ) ), vFour ), 3 );
+    const __m128i v4 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( vSum, 1 ), _mm_sub_epi32( m[6], m[2] ) ), vFour ), 3 );
+    // m1 + m2 + m3 + m4 + 2 and m3 + m4 + m5 + m6 + 2
+    const __m128i v2 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( m[1], m[2] ), vSum34 ), vTwo ), 2 );
+    const __m128i v5 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( m[5], m[6] ), vSum34 ), vTwo ), 2 );
+    // 2*m0 + 3*m1 + m2 + m3 + m4 + 4 and m3 + m4 + m5 + 3*m6 + 2*m7 + 4
+    const __m128i v1 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( m[0], m[1] ), 1 ), m[1] ), _mm_add_epi32( m[2], vSum34 ) ), vFour ), 3 );
+    const __m128i v6 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( m[7], m[6] ), 1 ), m[6] ), _mm_add_epi32( m[5], vSum34 ) ), vFour ), 3 );
+
+    n[1] = xClip3Sse41( _mm_sub_epi32( m[1], vTc2 ), _mm_add_epi32( m[1], vTc2 ), v1 );
+    n[2] = xClip3Sse41( _mm_sub_epi32( m[2], vTc2 ), _mm_add_epi32( m[2], vTc2 ), v2 );
+    n[3] = xClip3Sse41( _mm_sub_epi32( m[3], vTc2 ), _mm_add_epi32( m[3], vTc2 ), v3 );
+    n[4] = xClip3Sse41( _mm_sub_epi32( m[4], vTc2 ), _mm_add_epi32( m[4], vTc2 ), v4 );
+    n[5] = xClip3Sse41( _mm_sub_epi32( m[5], vTc2 ), _mm_add_epi32( m[5], vTc2 ), v5 );
+    n[6] = xClip3Sse41( _mm_sub_epi32( m[6], vTc2 ), _mm_add_epi32( m[6], vTc2 ), v6 );
+  }
+  else
+  {
+    const __m128i vZero   = _mm_setzero_si128();
+    const __m128i vMaxVal = _mm_set1_epi32( ( 1 << bitDepthLuma ) - 1 );
+    const __m128i vTc     = _mm_set1_epi32( tc );
+    const __m128i vTcNeg  = _mm_set1_epi32( -tc );
+
+    // (9*(m4-m3) - 3*(m5-m2) + 8) >> 4
+    const __m128i vD43  = _mm_sub_epi32( m[4], m[3] );
+    const __m128i vD52  = _mm_sub_epi32( m[5], m[2] );
+    __m128i       vDelta = _mm_sub_epi32( _mm_add_epi32( _mm_slli_epi32( vD43, 3 ), vD43 ), _mm_add_epi32( _mm_slli_epi32( vD52, 1 ), vD52 ) );
+    vDelta = _mm_srai_epi32( _mm_add_epi32( vDelta, _mm_set1_epi32( 8 ) ), 4 );
+
+    // lines with abs(delta) < iThrCut are filtered
+    const __m128i vFilter = _mm_cmpgt_epi32( _mm_set1_epi32( iThrCut ), _mm_abs_epi32( vDelta ) );
+
+    vDelta = xClip3Sse41( vTcNeg, vTc, vDelta );
+    n[3] = _mm_blendv_epi8( m[3], xClip3Sse41( vZero, vMaxVal, _mm_add_epi32( m[3], vDelta ) ), vFilter );
+    n[4] = _mm_blendv_epi8( m[4], xClip3Sse41( vZero, vMaxVal, _mm_sub_epi32( m[4], vDelta ) ), vFilter );
+
+    const __m128i vTc2    = _mm_set1_epi32( tc >> 1 );
+    const __m128i vTc2Neg = _mm_set1_epi32( -( tc >> 1 ) );
+    const __m128i vOne    = _mm_set1_epi32( 1 );
+    if ( bFilterSecondP )
+    {
+      __m128i vDelta1 = _mm_srai_epi32( _mm_add_epi32( m[1], _mm_add_epi32( m[3], vOne ) ), 1 );
+      vDelta1 = _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( vDelta1, m[2] ), vDelta ), 1 );
+      vDelta1 = xClip3Sse41( vTc2Neg, vTc2, vDelta1 );
+      n[2] = _mm_blendv_epi8( m[2], xClip3Sse41( vZero, vMaxVal, _mm_add_epi32( m[2], vDelta1 ) ), vFilter );
+    }
+    if ( bFilterSecondQ )
+    {
+      __m128i vDelta2 = _mm_srai_epi32( _mm_add_epi32( m[6], _mm_add_epi32( m[4], vOne ) ), 1 );
+      vDelta2 = _mm_srai_epi32( _mm_sub_epi32( _mm_sub_epi32( vDelta2, m[5] ), vDelta ), 1 );
+      vDelta2 = xClip3Sse41( vTc2Neg, vTc2, vDelta2 );
+      n[5] = _mm_blendv_epi8( m[5], xClip3Sse41( vZero, vMaxVal, _mm_add_epi32( m[5], vDelta2 ) ), vFilter );
+    }
+  }
+
+  if ( !bPartPNoFilter )
+  {
+    m[1] = n[1];
+    m[2] = n[2];
+    m[3] = n[3];
+  }
+  if ( !bPartQNoFilter )
+  {
+    m[4] = n[4];
+    m[5] = n[5];
+    m[6] = n[6];
+  }
+}
+
+/// segment of a horizontal edge: the lines are the 4 columns starting at piSrc, the samples of a line are iOffset apart
+static SIMD_TARGET_SSE41 Void xFilterLumaSegmentHorSse41( Pel* piSrc, Int iOffset, Int iSrcStep, Int tc, Bool sw, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iThrCut, Bool bFilterSecondP, Bool bFilterSecondQ, Int bitDepthLuma )
+{
+  __m128i m[8];
+  for ( Int i = 0; i < 8; i++ )
+  {
+    m[i] = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( piSrc + ( i - 4 ) * iOffset ) ) );
+  }
+
+  xFilterLumaSse41( m, tc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterSecondP, bFilterSecondQ, bitDepthLuma );
+
+  for ( Int i = bPartPNoFilter ? 4 : 1; i < ( bPartQNoFilter ? 4 : 7 ); i++ )
+  {
+    _mm_storel_epi64( ( __m128i* )( piSrc + ( i - 4 ) * iOffset ), _mm_packs_epi32( m[i], m[i] ) );
+  }
+}
+
+/// segment of a vertical edge: the lines are the 4 rows starting at piSrc, iSrcStep apart, the samples of a line are adjacent
+static SIMD_TARGET_SSE41 Void xFilterLumaSegmentVerSse41( Pel* piSrc, Int iOffset, Int iSrcStep, Int tc, Bool sw, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iThrCut, Bool bFilterSecondP, Bool bFilterSecondQ, Int bitDepthLuma )
+{
+  // rows a, b, c, d of p3..q3 to the vectors of the sample positions
+  const __m128i a  = _mm_loadu_si128( ( const __m128i* )( piSrc                - 4 ) );
+  const __m128i b  = _mm_loadu_si128( ( const __m128i* )( piSrc +     iSrcStep - 4 ) );
+  const __m128i c  = _mm_loadu_si128( ( const __m128i* )( piSrc + 2 * iSrcStep - 4 ) );
+  const __m128i d  = _mm_loadu_si128( ( const __m128i* )( piSrc + 3 * iSrcStep - 4 ) );
+  const __m128i t0 = _mm_unpacklo_epi16( a, b );  // a0 b0 a1 b1 a2 b2 a3 b3
+  const __m128i t1 = _mm_unpackhi_epi16( a, b );  // a4 b4 ... a7 b7
+  const __m128i t2 = _mm_unpacklo_epi16( c, d );  // c0 d0 ... c3 d3
+  const __m128i t3 = _mm_unpackhi_epi16( c, d );  // c4 d4 ... c7 d7
+  const __m128i u0 = _mm_unpacklo_epi32( t0, t2 ); // a0 b0 c0 d0 a1 b1 c1 d1
+  const __m128i u1 = _mm_unpackhi_epi32( t0, t2 ); // a2 b2 c2 d2 a3 b3 c3 d3
+  const __m128i u2 = _mm_unpacklo_epi32( t1, t3 ); // a4 b4 c4 d4 a5 b5 c5 d5
+  const __m128i u3 = _mm_unpackhi_epi32( t1, t3 ); // a6 b6 c6 d6 a7 b7 c7 d7
+
+  __m128i m[8];
+  m[0] = _mm_cvtepi16_epi32( u0 );
+  m[1] = _mm_cvtepi16_epi32( _mm_srli_si128( u0, 8 ) );
+  m[2] = _mm_cvtepi16_epi32( u1 );
+  m[3] = _mm_cvtepi16_epi32( _mm_srli_si128( u1, 8 ) );
+  m[4] = _mm_cvtepi16_epi32( u2 );
+  m[5] = _mm_cvtepi16_epi32( _mm_srli_si128( u2, 8 ) );
+  m[6] = _mm_cvtepi16_epi32( u3 );
+  m[7] = _mm_cvtepi16_epi32( _mm_srli_si128( u3, 8 ) );
+
+  xFilterLumaSse41( m, tc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterSecondP, bFilterSecondQ, bitDepthLuma );
+
+  // back to the rows
+  const __m128i B0 = _mm_packs_epi32( m[0], m[1] ); // a0 b0 c0 d0 a1 b1 c1 d1
+  const __m128i B1 = _mm_packs_epi32( m[2], m[3] );
+  const __m128i B2 = _mm_packs_epi32( m[4], m[5] );
+  const __m128i B3 = _mm_packs_epi32( m[6], m[7] );
+  const __m128i s0 = _mm_unpacklo_epi16( B0, B1 ); // a0 a2 b0 b2 c0 c2 d0 d2
+  const __m128i s1 = _mm_unpackhi_epi16( B0, B1 ); // a1 a3 b1 b3 c1 c3 d1 d3
+  const __m128i s2 = _mm_unpacklo_epi16( B2, B3 );
+  const __m128i s3 = _mm_unpackhi_epi16( B2, B3 );
+  const __m128i v0 = _mm_unpacklo_epi16( s0, s1 ); // a0 a1 a2 a3 b0 b1 b2 b3
+  const __m128i v1 = _mm_unpackhi_epi16( s0, s1 ); // c0 c1 c2 c3 d0 d1 d2 d3
+  const __m128i v2 = _mm_unpacklo_epi16( s2, s3 ); // a4 a5 a6 a7 b4 b5 b6 b7
+  const __m128i v3 = _mm_unpackhi_epi16( s2, s3 ); // c4 c5 c6 c7 d4 d5 d6 d7
+
+  _mm_storeu_si128( ( __m128i* )( piSrc                - 4 ), _mm_unpacklo_epi64( v0, v2 ) );
+  _mm_storeu_si128( ( __m128i* )( piSrc +     iSrcStep - 4 ), _mm_unpackhi_epi64( v0, v2 ) );
+  _mm_storeu_si128( ( __m128i* )( piSrc + 2 * iSrcStep - 4 ), _mm_unpacklo_epi64( v1, v3 ) );
+  _mm_storeu_si128( ( __m128i* )( piSrc + 3 * iSrcStep - 4 ), _mm_unpackhi_epi64( v1, v3 ) );
+}
+
+// ====================================================================================================================
+// Dispatch and self test
+// ====================================================================================================================
+
+/**
+ * \brief Replace the scalar luma filters of a dispatch table by the vectorized ones of an extension
+ *
+ * \param afpFilterLumaSegment  luma filters, indexed by the edge direction
+ * \param eExtension            SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE keeps the current functions
+ */
+Void TComLoopFilter::xSetSimdFilterLumaSegment( FpFilterLumaSegment* afpFilterLumaSegment, SimdExtension eExtension )
+{
+  // a segment of 4 lines fits in the SSE4.1 vectors, AVX2 would leave half of the lanes unused
+  if ( eExtension >= SIMD_SSE41 )
+  {
+    afpFilterLumaSegment[EDGE_VER] = xFilterLumaSegmentVerSse41;
+    afpFilterLumaSegment[EDGE_HOR] = xFilterLumaSegmentHorSse41;
+  }
+}
+
+static UInt xGetTestRand(UInt& ruiSeed)
+{
+  ruiSeed = ruiSeed * 1103515245 + 12345;
+  return ( ruiSeed >> 8 );
+}
+
+/**
+ * \brief Compare the vectorized luma filters with the scalar ones on random segments
+ *
+ * The samples are a random level with small random differences, so that both the strong and the weak filter and both
+ * outcomes of the decision of the weak filter are tested.
+ *
+ * \returns true if all results are identical
+ */
+Bool TComLoopFilter::xCheckSimdFilterLumaSegment() const
+{
+  const Int iStride = 16;
+  Pel       aiRef[ iStride * 16 ];
+  Pel       aiVec[ iStride * 16 ];
+  UInt      seed = 1;
+
+  FpFilterLumaSegment afpVec[NUM_EDGE_DIR];
+  memcpy( afpVec, m_afpFilterLumaSegment, sizeof( afpVec ) );
+  xSetSimdFilterLumaSegment( afpVec, getSimdExtension() );
+
+  for ( Int test = 0; test < 1024; test++ )
+  {
+    const DeblockEdgeDir edgeDir  = DeblockEdgeDir( test & 1 );
+    const Int            bitDepth = ( test & 2 ) ? 10 : 8;
+    const Int            level    = xGetTestRand( seed ) % ( 1 << bitDepth );
+    const Int            range    = 1 + xGetTestRand( seed ) % ( ( test & 4 ) ? 64 : 8 );
+    const Int            tc       = ( xGetTestRand( seed ) % 25 ) << ( bitDepth - 8 );
+    const Bool           sw       = ( test & 8 ) != 0;
+    const Bool           bNoP     = ( xGetTestRand( seed ) % 8 ) == 0;
+    const Bool           bNoQ     = ( xGetTestRand( seed ) % 8 ) == 0;
+    const Bool           bSecondP = ( test & 16 ) != 0;
+    const Bool           bSecondQ = ( test & 32 ) != 0;
+
+    for ( Int i = 0; i < iStride * 16; i++ )
+    {
+      aiRef[i] = aiVec[i] = ClipBD( Int( level + xGetTestRand( seed ) % ( 2 * range ) ) - range, bitDepth );
+    }
+
+    // a segment at the center of the block, the lines are iSrcStep apart
+    const Int iOffset  = edgeDir == EDGE_VER ? 1 : iStride;
+    const Int iSrcStep = edgeDir == EDGE_VER ? iStride : 1;
+    const Int iCenter  = 8 * iStride + 8 - 2 * iSrcStep;
+    m_afpFilterLumaSegment[edgeDir]( aiRef + iCenter, iOffset, iSrcStep, tc, sw, bNoP, bNoQ, tc * 10, bSecondP, bSecondQ, bitDepth );
+    afpVec[edgeDir]                ( aiVec + iCenter, iOffset, iSrcStep, tc, sw, bNoP, bNoQ, tc * 10, bSecondP, bSecondQ, bitDepth );
+
+    if ( memcmp( aiRef, aiVec, sizeof( aiRef ) ) )
+    {
+      printf( "\nWarning: vectorized luma deblocking filter differs from the scalar one (%s edge, %s filter), the scalar filters are used\n", edgeDir == EDGE_VER ? "vertical" : "horizontal", sw ? "strong" : "weak" );
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//! \}
+
+#endif // DEBLOCKING_SIMD && SIMD_X86
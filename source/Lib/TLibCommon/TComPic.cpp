@@ -92,6 +92,10 @@ TComPic::TComPic()
   m_isGeneratedCl833  = false; 
   m_activatesNewVps   = false; 
 #endif
+#if NH_MV_LAYER_PARALLEL_DEC
+  // only the decoding pipeline resets the progress, all other pictures are complete when they become visible
+  m_cCtuRowProgress.reset( MAX_INT );
+#endif
 }
 
 TComPic::~TComPic()
@@ -195,6 +199,33 @@ Void TComPic::compressMotion()
   }
 }
 
+#if NH_MV_LAYER_PARALLEL_DEC
+Void TComPic::waitForLumaLines( Int numLines )
+{
+  const Int ctuHeight  = getPicSym()->getSPS().getMaxCUHeight();
+  const Int numCtuRows = getPicSym()->getFrameHeightInCtus();
+  m_cCtuRowProgress.waitFor( numLines >= numCtuRows * ctuHeight ? numCtuRows : ( numLines + ctuHeight - 1 ) / ctuHeight );
+}
+
+#if NH_3D
+Void TComPic::compressMotionCtuRow( Int scale, UInt ctuRow )
+#else
+Void TComPic::compressMotionCtuRow( UInt ctuRow )
+#endif
+{
+  TComPicSym* pPicSym = getPicSym();
+  const UInt frameWidthInCtus = pPicSym->getFrameWidthInCtus();
+  for ( UInt uiCUAddr = ctuRow * frameWidthInCtus; uiCUAddr < ( ctuRow + 1 ) * frameWidthInCtus; uiCUAddr++ )
+  {
+#if NH_3D
+    pPicSym->getCtu(uiCUAddr)->compressMV(scale);
+#else
+    pPicSym->getCtu(uiCUAddr)->compressMV();
+#endif
+  }
+}
+#endif
+
 
 Bool  TComPic::getSAOMergeAvailability(Int currAddr, Int mergeAddr)
 {
@@ -700,6 +731,9 @@ Bool TComSubDpb::areAllPicsMarkedNotNeedForOutput()
 TComPicLists::~TComPicLists()
 {
   emptyAllSubDpbs();
+#if NH_MV_LAYER_PARALLEL_DEC || PIC_HASH_PARALLEL_DEC
+  deleteRemovedPics();
+#endif
   for(TComList<TComSubDpb*>::iterator itL = m_subDpbs.begin(); ( itL != m_subDpbs.end()); itL++)
   {      
     if ( (*itL) != NULL )
@@ -750,11 +784,30 @@ Void TComPicLists::removePic( TComPic* pic )
       std::cout << std::endl;
     }
 
+#if NH_MV_LAYER_PARALLEL_DEC || PIC_HASH_PARALLEL_DEC
+    if ( m_deferPicDeletion )
+    {
+      m_removedPics.push_back( pic );
+      return;
+    }
+#endif
     pic->destroy();
     delete pic; 
   }
 }
 
+#if NH_MV_LAYER_PARALLEL_DEC || PIC_HASH_PARALLEL_DEC
+Void TComPicLists::deleteRemovedPics( )
+{
+  for ( size_t i = 0; i < m_removedPics.size(); i++ )
+  {
+    m_removedPics[i]->destroy();
+    delete m_removedPics[i];
+  }
+  m_removedPics.clear();
+}
+#endif
+
 TComPic* TComPicLists::getPic( Int layerIdInNuh, Int poc )
 {
   TComPic* pcPic = NULL;
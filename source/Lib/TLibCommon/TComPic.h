@@ -43,6 +43,9 @@
 #include "TComPicSym.h"
 #include "TComPicYuv.h"
 #include "TComBitStream.h"
+#if NH_MV_LAYER_PARALLEL_DEC || NH_MV_FRAME_PARALLEL_ENC
+#include "TComThreadPool.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -153,6 +156,12 @@ private:
   Bool                  m_activatesNewVps;
   TComDecodedRps        m_decodedRps;
 #endif
+#if NH_MV_LAYER_PARALLEL_DEC
+  TComProgress          m_cCtuRowProgress;        ///< number of completely reconstructed (in-loop filtered, border extended) CTU rows
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+  TComProgress          m_cAuFinished;            ///< 1 when all pictures of the access unit are coded and their motion is compressed
+#endif
 #if NH_3D_VSO
   Int                   m_viewIndex;
   Bool                  m_isDepth;
@@ -190,7 +199,12 @@ public:
   TComPicSym*   getPicSym()           { return  &m_picSym;    }
   const TComPicSym* getPicSym() const { return  &m_picSym;    }
   TComSlice*    getSlice(Int i)       { return  m_picSym.getSlice(i);  }
+#if NH_MV_LAYER_PARALLEL_DEC
+  // all slices have the same POC, the current slice index may be changed by the thread decoding the picture
+  Int           getPOC() const        { return  m_picSym.getSlice(0)->getPOC();  }
+#else
   Int           getPOC() const        { return  m_picSym.getSlice(m_uiCurrSliceIdx)->getPOC();  }
+#endif
   TComDataCU*   getCtu( UInt ctuRsAddr )           { return  m_picSym.getCtu( ctuRsAddr ); }
   const TComDataCU* getCtu( UInt ctuRsAddr ) const { return  m_picSym.getCtu( ctuRsAddr ); }
 
@@ -310,6 +324,23 @@ public:
 
    Void          print( Int outputLevel );
 
+#if NH_MV_LAYER_PARALLEL_DEC
+   Void          resetCtuRowProgress   ()                 { m_cCtuRowProgress.reset( 0 );           }
+   Void          setCtuRowProgress     ( Int numCtuRows ) { m_cCtuRowProgress.set( numCtuRows );    }
+   Void          waitForLumaLines      ( Int numLines );  ///< block until the CTU rows covering the first numLines luma lines are reconstructed
+   Void          waitForReconstruction ()                 { waitForLumaLines( MAX_INT );            }
+#if NH_3D
+   Void          compressMotionCtuRow  ( Int scale, UInt ctuRow );
+#else
+   Void          compressMotionCtuRow  ( UInt ctuRow );
+#endif
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+   Void          resetAuFinished       ()                 { m_cAuFinished.reset( 0 );               }
+   Void          setAuFinished         ()                 { m_cAuFinished.set( 1 );                 }
+   Void          waitForAuFinished     ()                 { m_cAuFinished.waitFor( 1 );             }
+#endif
+
 #if NH_3D_VSO
    Void          setViewIndex          ( Int viewIndex )  { m_viewIndex = viewIndex;   }
    Int           getViewIndex          () const           { return m_viewIndex;     }
@@ -406,13 +437,26 @@ private:
 #if NH_3D_VSO
   const TComVPS*              m_vps; 
 #endif
+#if NH_MV_LAYER_PARALLEL_DEC || PIC_HASH_PARALLEL_DEC
+  Bool                        m_deferPicDeletion;        ///< removed pictures may still be read by decoding or hash verification threads
+  std::vector<TComPic*>       m_removedPics;             ///< removed pictures waiting for deleteRemovedPics()
+#endif
 public: 
+#if NH_MV_LAYER_PARALLEL_DEC || PIC_HASH_PARALLEL_DEC
+  TComPicLists() { m_printPicOutput = false; m_deferPicDeletion = false; };
+#else
   TComPicLists() { m_printPicOutput = false; };
+#endif
   ~TComPicLists();
 
   // Add and remove single pictures
   Void                   addNewPic( TComPic* pic );
   Void                   removePic( TComPic* pic );
+#if NH_MV_LAYER_PARALLEL_DEC || PIC_HASH_PARALLEL_DEC
+  Void                   setDeferPicDeletion( Bool deferPicDeletion ) { m_deferPicDeletion = deferPicDeletion; };
+  const std::vector<TComPic*>& getRemovedPics( ) const { return m_removedPics; };
+  Void                   deleteRemovedPics  ( );
+#endif
 
   // Get Pics
   TComPic*               getPic                         ( Int layerIdInNuh, Int poc );
@@ -290,6 +290,81 @@ Void TComPicYuv::extendPicBorder ()
   m_bIsBorderExtended = true;
 }
 
+#if NH_MV_LAYER_PARALLEL_DEC
+Void TComPicYuv::copyLinesToPic( TComPicYuv* pcPicYuvDst, Int firstLine, Int numLines ) const
+{
+  assert( m_chromaFormatIDC == pcPicYuvDst->getChromaFormat() );
+
+  for(Int comp=0; comp<getNumberValidComponents(); comp++)
+  {
+    const ComponentID compId=ComponentID(comp);
+    const Int csy       = getComponentScaleY(compId);
+    const Int firstY    = firstLine >> csy;
+    const Int endY      = std::min( ( firstLine + numLines ) >> csy, getHeight(compId) );
+    const Int width     = getWidth(compId);
+    const Int stride    = getStride(compId);
+    const Int dstStride = pcPicYuvDst->getStride(compId);
+    const Pel *pSrc     = getAddr(compId) + firstY * stride;
+          Pel *pDst     = pcPicYuvDst->getAddr(compId) + firstY * dstStride;
+
+    for (Int y = firstY; y < endY; y++, pSrc += stride, pDst += dstStride)
+    {
+      ::memcpy( pDst, pSrc, sizeof(Pel) * width );
+    }
+  }
+}
+
+Void TComPicYuv::extendPicBorderLines( Int firstLine, Int numLines )
+{
+  for(Int comp=0; comp<getNumberValidComponents(); comp++)
+  {
+    const ComponentID compId=ComponentID(comp);
+    const Int csy     = getComponentScaleY(compId);
+    const Int stride  = getStride(compId);
+    const Int width   = getWidth(compId);
+    const Int height  = getHeight(compId);
+    const Int marginX = getMarginX(compId);
+    const Int marginY = getMarginY(compId);
+    const Int firstY  = firstLine >> csy;
+    const Int endY    = std::min( ( firstLine + numLines ) >> csy, height );
+
+    // do left and right margins
+    Pel* pi = getAddr(compId) + firstY * stride;
+    for (Int y = firstY; y < endY; y++)
+    {
+      for (Int x = 0; x < marginX; x++ )
+      {
+        pi[ -marginX + x ] = pi[0];
+        pi[    width + x ] = pi[width-1];
+      }
+      pi += stride;
+    }
+
+    if ( firstY == 0 && endY > 0 )
+    {
+      pi = getAddr(compId) - marginX;
+      for (Int y = 0; y < marginY; y++ )
+      {
+        ::memcpy( pi - (y+1)*stride, pi, sizeof(Pel)*(width + (marginX<<1)) );
+      }
+    }
+    if ( endY == height && firstY < endY )
+    {
+      pi = getAddr(compId) + (height-1) * stride - marginX;
+      for (Int y = 0; y < marginY; y++ )
+      {
+        ::memcpy( pi + (y+1)*stride, pi, sizeof(Pel)*(width + (marginX<<1)) );
+      }
+    }
+  }
+
+  if ( firstLine + numLines >= getHeight(COMPONENT_Y) )
+  {
+    m_bIsBorderExtended = true;
+  }
+}
+#endif
+
 
 
 // NOTE: This function is never called, but may be useful for developers.
@@ -173,6 +173,11 @@ public:
 
   //  Extend function of picture buffer
   Void          extendPicBorder   ();
+#if NH_MV_LAYER_PARALLEL_DEC
+  //  Copy and extend functions for a range of luma lines (and the corresponding chroma lines) of a picture
+  Void          copyLinesToPic    ( TComPicYuv*  pcPicYuvDst, Int firstLine, Int numLines ) const ;
+  Void          extendPicBorderLines( Int firstLine, Int numLines );   ///< the top and bottom margins are extended with the first and last line of the picture
+#endif
 
   //  Dump picture
   Void          dump              (const std::string &fileName, const BitDepths &bitDepths, const Bool bAppend=false, const Bool bForceTo8Bit=false) const ;
@@ -88,6 +88,9 @@ TComPrediction::TComPrediction()
       printf("ERROR: UKTGHU, No memory allocated.\n");
   }
 #endif
+#if NH_3D_IC_PARAM_CACHE
+  resetICParamCache();
+#endif
 
 }
 
@@ -596,6 +599,17 @@ Void TComPrediction::xGetSubPUAddrAndMerge(TComDataCU* pcCU, UInt uiPartAddr, In
   }
 #endif
 
+#if NH_3D_SPIVMP_MERGED_MC
+#if NH_3D_IC
+  // the chroma IC depends on the block width, keep the blocks of the row-wise merge below
+  if( !pcCU->getICFlag( uiPartAddr ) )
+#endif
+  {
+    xGetSubPURects( pcCU, REF_PIC_LIST_X, uiSPAddr, iNumSPInOneLine, iNumSP, iSPWidth, iSPHeight, uiMergedSPW, uiMergedSPH );
+    return;
+  }
+#endif
+
   // horizontal sub-PU merge
   for (Int i=0; i<iNumSP; i++)
   {
@@ -668,6 +682,60 @@ Bool TComPrediction::xCheckTwoSPMotion ( TComDataCU* pcCU, UInt PartAddr0, UInt
 }
 #endif
 
+#if NH_3D_SPIVMP_MERGED_MC || NH_3D_VSP_BLOCK_MC
+Bool TComPrediction::xCheckSubPUMotion( TComDataCU* pcCU, RefPicList eRefPicList, UInt uiPartAddr0, UInt uiPartAddr1 )
+{
+#if NH_3D_SPIVMP
+  if( eRefPicList == REF_PIC_LIST_X )
+  {
+    return xCheckTwoSPMotion( pcCU, uiPartAddr0, uiPartAddr1 );
+  }
+#endif
+  const TComCUMvField* pcMvField = pcCU->getCUMvField( eRefPicList );
+  return pcMvField->getRefIdx( uiPartAddr0 ) == pcMvField->getRefIdx( uiPartAddr1 ) && pcMvField->getMv( uiPartAddr0 ) == pcMvField->getMv( uiPartAddr1 );
+}
+
+Void TComPrediction::xGetSubPURects( TComDataCU* pcCU, RefPicList eRefPicList, const UInt* puiSPAddr, Int iNumSPInOneLine, Int iNumSP, Int iSPWidth, Int iSPHeight, UInt* puiRectW, UInt* puiRectH )
+{
+  // cover the sub-PUs in raster order, widest run of the sub-PUs not covered yet first, then as many rows as possible
+  Bool abCovered[256];
+  memset( abCovered, 0, iNumSP * sizeof( Bool ) );
+  for (Int i = 0; i < iNumSP; i++)
+  {
+    if (abCovered[i])
+    {
+      puiRectW[i] = puiRectH[i] = 0;
+      continue;
+    }
+    Int iNumSPRight = iNumSPInOneLine - i % iNumSPInOneLine;
+    Int iRectW      = 1;
+    while (iRectW < iNumSPRight && !abCovered[i+iRectW] && xCheckSubPUMotion(pcCU, eRefPicList, puiSPAddr[i], puiSPAddr[i+iRectW]))
+    {
+      iRectW++;
+    }
+    Int iRectH = 1;
+    for (Int iRow = i + iNumSPInOneLine; iRow < iNumSP; iRow += iNumSPInOneLine, iRectH++)
+    {
+      Int k = 0;
+      while (k < iRectW && !abCovered[iRow+k] && xCheckSubPUMotion(pcCU, eRefPicList, puiSPAddr[i], puiSPAddr[iRow+k]))
+      {
+        k++;
+      }
+      if (k < iRectW)
+      {
+        break;
+      }
+    }
+    for (Int iRow = 0; iRow < iRectH; iRow++)
+    {
+      memset( abCovered + i + iRow * iNumSPInOneLine, 1, iRectW * sizeof( Bool ) );
+    }
+    puiRectW[i] = iRectW * iSPWidth;
+    puiRectH[i] = iRectH * iSPHeight;
+  }
+}
+#endif
+
 #if NH_3D_DBBP
 PartSize TComPrediction::getPartitionSizeFromDepth(Pel* pDepthPels, UInt uiDepthStride, UInt uiSize, TComDataCU*& pcCU)
 {
@@ -1374,6 +1442,42 @@ Void TComPrediction::xPredInterUniVSP( TComDataCU* pcCU, UInt uiPartAddr, Int iW
 
 Void TComPrediction::xPredInterUniSubPU( TComDataCU* pcCU, UInt uiPartAddr, Int iWidth, Int iHeight, RefPicList eRefPicList, TComYuv*& rpcYuvPred, Bool bi, Int widthSubPU, Int heightSubPU )
 {
+#if NH_3D_VSP_BLOCK_MC
+  // the disparities of neighbouring sub-blocks are mostly equal, compensate the rectangles of equal disparity in one call each
+  const Int iNumSPInOneLine = iWidth  / widthSubPU;
+  const Int iNumSP          = iNumSPInOneLine * ( iHeight / heightSubPU );
+  const Int iMaxNumSP       = ( MAX_CU_SIZE / 4 ) * ( MAX_CU_SIZE / 8 ); // 8x4 or 4x8 sub-blocks
+  assert( iNumSP <= iMaxNumSP );
+  UInt uiW[iMaxNumSP], uiH[iMaxNumSP];
+  UInt uiSPAddr[iMaxNumSP] = {};
+
+  UInt numPartsInLine     = pcCU->getPic()->getNumPartInCtuWidth();
+  UInt partAddrRasterLine = g_auiZscanToRaster[ uiPartAddr ];
+  for (Int i = 0; i < iNumSP; i += iNumSPInOneLine, partAddrRasterLine += (heightSubPU >> 2) * numPartsInLine)
+  {
+    for (Int j = 0; j < iNumSPInOneLine; j++)
+    {
+      uiSPAddr[i+j] = g_auiRasterToZscan[ partAddrRasterLine + j * (widthSubPU >> 2) ];
+    }
+  }
+  xGetSubPURects( pcCU, eRefPicList, uiSPAddr, iNumSPInOneLine, iNumSP, widthSubPU, heightSubPU, uiW, uiH );
+
+  for (Int i = 0; i < iNumSP; i++)
+  {
+    if (uiW[i]==0 || uiH[i]==0)
+    {
+      continue;
+    }
+    Int     refIdx    = pcCU->getCUMvField( eRefPicList )->getRefIdx( uiSPAddr[i] );           assert (refIdx >= 0);
+    TComMv  cMv       = pcCU->getCUMvField( eRefPicList )->getMv( uiSPAddr[i] );
+    TComPicYuv* pcRef = pcCU->getSlice()->getRefPic( eRefPicList, refIdx )->getPicYuvRec();
+    pcCU->clipMv(cMv);
+
+    xPredInterBlk( COMPONENT_Y,  pcCU, pcRef, uiSPAddr[i], &cMv, uiW[i], uiH[i], rpcYuvPred, bi, pcCU->getSlice()->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA) );
+    xPredInterBlk( COMPONENT_Cb, pcCU, pcRef, uiSPAddr[i], &cMv, uiW[i], uiH[i], rpcYuvPred, bi, pcCU->getSlice()->getSPS()->getBitDepth(CHANNEL_TYPE_CHROMA) );
+    xPredInterBlk( COMPONENT_Cr, pcCU, pcRef, uiSPAddr[i], &cMv, uiW[i], uiH[i], rpcYuvPred, bi, pcCU->getSlice()->getSPS()->getBitDepth(CHANNEL_TYPE_CHROMA) );
+  }
+#else
   UInt numPartsInLine       = pcCU->getPic()->getNumPartInCtuWidth();
   UInt horiNumPartsInSubPU  = widthSubPU >> 2;
   UInt vertNumPartsInSubPU  = (heightSubPU >> 2) * numPartsInLine;
@@ -1395,6 +1499,7 @@ Void TComPrediction::xPredInterUniSubPU( TComDataCU* pcCU, UInt uiPartAddr, Int
       xPredInterBlk( COMPONENT_Cr, pcCU, pcCU->getSlice()->getRefPic( eRefPicList, refIdx )->getPicYuvRec(), partAddrSubPU, &cMv, widthSubPU, heightSubPU, rpcYuvPred, bi, pcCU->getSlice()->getSPS()->getBitDepth(CHANNEL_TYPE_CHROMA) );
     }
   }
+#endif
 }
 #endif
 
@@ -2135,12 +2240,7 @@ Int GetMSB( UInt x )
  */
 Void TComPrediction::xGetLLSICPrediction( const ComponentID compID, TComDataCU* pcCU, TComMv *pMv, TComPicYuv *pRefPic, Int &a, Int &b, const Int bitDepth )
 {
-  TComPicYuv *pRecPic = pcCU->getPic()->getPicYuvRec();
-  Pel *pRec = NULL, *pRef = NULL;
-  UInt uiWidth, uiHeight, uiTmpPartIdx;
-  Int iRecStride = pRecPic->getStride(compID);
-  Int iRefStride = pRefPic->getStride(compID);
-  Int iRefOffset, iHor, iVer;
+  Int iHor, iVer;
   iHor = pcCU->getSlice()->getIsDepth() ? pMv->getHor() : ( ( pMv->getHor() + 2 ) >> 2 );
   iVer = pcCU->getSlice()->getIsDepth() ? pMv->getVer() : ( ( pMv->getVer() + 2 ) >> 2 );
   if( !isLuma(compID) )
@@ -2148,6 +2248,60 @@ Void TComPrediction::xGetLLSICPrediction( const ComponentID compID, TComDataCU*
     iHor = pcCU->getSlice()->getIsDepth() ? ( ( pMv->getHor() + 1 ) >> 1 ) : ( ( pMv->getHor() + 4 ) >> 3 );
     iVer = pcCU->getSlice()->getIsDepth() ? ( ( pMv->getVer() + 1 ) >> 1 ) : ( ( pMv->getVer() + 4 ) >> 3 );
   }
+
+#if NH_3D_IC_PARAM_CACHE
+  // the parameters only depend on the neighbouring samples of the CU in the reconstructed and the reference picture,
+  // the PUs and the prediction passes of a CU share them
+  const TComPicYuv* pcRecPic = pcCU->getPic()->getPicYuvRec();
+  if( pcRecPic != m_pcICCacheRecPic || pcCU->getCtuRsAddr() != m_uiICCacheCtuRsAddr || pcCU->getZorderIdxInCtu() != m_uiICCacheZorderIdx
+   || pcCU->getWidth( 0 ) != m_uiICCacheWidth || pcCU->getHeight( 0 ) != m_uiICCacheHeight )
+  {
+    resetICParamCache();
+    m_pcICCacheRecPic    = pcRecPic;
+    m_uiICCacheCtuRsAddr = pcCU->getCtuRsAddr();
+    m_uiICCacheZorderIdx = pcCU->getZorderIdxInCtu();
+    m_uiICCacheWidth     = pcCU->getWidth( 0 );
+    m_uiICCacheHeight    = pcCU->getHeight( 0 );
+  }
+
+  for( Int i = 0; i < m_iNumICParams; i++ )
+  {
+    const ICParams& rcParams = m_acICParams[i];
+    if( rcParams.pcRefPic == pRefPic && rcParams.compID == compID && rcParams.iHor == iHor && rcParams.iVer == iVer && rcParams.bitDepth == bitDepth )
+    {
+      a = rcParams.a;
+      b = rcParams.b;
+      return;
+    }
+  }
+
+  xDeriveLLSICParams( compID, pcCU, iHor, iVer, pRefPic, a, b, bitDepth );
+
+  ICParams& rcParams = m_acICParams[m_iNextICParams];
+  rcParams.pcRefPic  = pRefPic;
+  rcParams.compID    = compID;
+  rcParams.iHor      = iHor;
+  rcParams.iVer      = iVer;
+  rcParams.bitDepth  = bitDepth;
+  rcParams.a         = a;
+  rcParams.b         = b;
+  m_iNumICParams     = std::max( m_iNumICParams, m_iNextICParams + 1 );
+  m_iNextICParams    = ( m_iNextICParams + 1 ) % IC_PARAM_CACHE_SIZE;
+#else
+  xDeriveLLSICParams( compID, pcCU, iHor, iVer, pRefPic, a, b, bitDepth );
+#endif
+}
+
+/** LLS parameters of the illumination compensation from the samples above and left of the CU, (iHor, iVer) is the integer motion vector.
+ */
+Void TComPrediction::xDeriveLLSICParams( const ComponentID compID, TComDataCU* pcCU, Int iHor, Int iVer, TComPicYuv *pRefPic, Int &a, Int &b, const Int bitDepth )
+{
+  TComPicYuv *pRecPic = pcCU->getPic()->getPicYuvRec();
+  const Pel *pRec = NULL, *pRef = NULL;
+  UInt uiWidth, uiHeight, uiTmpPartIdx;
+  Int iRecStride = pRecPic->getStride(compID);
+  Int iRefStride = pRefPic->getStride(compID);
+  Int iRefOffset;
   uiWidth  = pcCU->getWidth( 0 ) >> pRefPic->getComponentScaleX(compID);
   uiHeight = pcCU->getHeight( 0 ) >> pRefPic->getComponentScaleY(compID);
 
@@ -2164,11 +2318,15 @@ Void TComPrediction::xGetLLSICPrediction( const ComponentID compID, TComDataCU*
     iRefOffset = iHor + iVer * iRefStride - iRefStride;
     pRef = pRefPic->getAddr(compID, pcCU->getCtuRsAddr(), pcCU->getZorderIdxInCtu() + partAddr ) + iRefOffset;
     pRec = pRecPic->getAddr(compID, pcCU->getCtuRsAddr(), pcCU->getZorderIdxInCtu() + partAddr ) - iRecStride;
+    // separate sum loops without the component test, they vectorise
     for( j = 0; j < uiWidth; j+=2 )
     {
       x += pRef[j];
       y += pRec[j];
-      if( isLuma(compID) )
+    }
+    if( isLuma(compID) )
+    {
+      for( j = 0; j < uiWidth; j+=2 )
       {
         xx += (pRef[j] * pRef[j])>>precShift;
         xy += (pRef[j] * pRec[j])>>precShift;
@@ -92,6 +92,27 @@ protected:
 #if NH_3D_IC
   UInt   m_uiaShift[ 64 ];       // Table for multiplication to substitue of division operation
 #endif
+#if NH_3D_IC_PARAM_CACHE
+  /// IC parameters of a reference block of the CU #m_pcICCacheRecPic/#m_uiICCacheCtuRsAddr/#m_uiICCacheZorderIdx
+  struct ICParams
+  {
+    const TComPicYuv* pcRefPic;
+    ComponentID       compID;
+    Int               iHor;      ///< integer motion vector
+    Int               iVer;
+    Int               bitDepth;
+    Int               a;
+    Int               b;
+  };
+  const TComPicYuv* m_pcICCacheRecPic;
+  UInt              m_uiICCacheCtuRsAddr;
+  UInt              m_uiICCacheZorderIdx;
+  UInt              m_uiICCacheWidth;
+  UInt              m_uiICCacheHeight;
+  ICParams          m_acICParams[IC_PARAM_CACHE_SIZE];
+  Int               m_iNumICParams;
+  Int               m_iNextICParams;   ///< entry replaced when the cache is full
+#endif
 
 #if NH_3D_VSP
   Int*    m_pDepthBlock;         ///< Store a depth block, local variable, to prevent memory allocation every time
@@ -135,6 +156,7 @@ protected:
   Void xGetLLSPrediction ( const Pel* pSrc0, Int iSrcStride, Pel* pDst0, Int iDstStride, UInt uiWidth, UInt uiHeight, UInt uiExt0, const ChromaFormat chFmt  DEBUG_STRING_FN_DECLARE(sDebug) );
 #if NH_3D_IC
   Void xGetLLSICPrediction( const ComponentID compID, TComDataCU* pcCU, TComMv *pMv, TComPicYuv *pRefPic, Int &a, Int &b, const Int bitDepth);
+  Void xDeriveLLSICParams ( const ComponentID compID, TComDataCU* pcCU, Int iHor, Int iVer, TComPicYuv *pRefPic, Int &a, Int &b, const Int bitDepth);
 #endif
   Void xDCPredFiltering( const Pel* pSrc, Int iSrcStride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight, ChannelType channelType );
   Bool xCheckIdenticalMotion    ( TComDataCU* pcCU, UInt PartAddr);
@@ -142,6 +164,12 @@ protected:
   Bool xCheckTwoSPMotion ( TComDataCU* pcCU, UInt PartAddr0, UInt PartAddr1 );
   Void xGetSubPUAddrAndMerge(TComDataCU* pcCU, UInt uiPartAddr, Int iSPWidth, Int iSPHeight, Int iNumSPInOneLine, Int iNumSP, UInt* uiMergedSPW, UInt* uiMergedSPH, UInt* uiSPAddr );
 #endif
+#if NH_3D_SPIVMP_MERGED_MC || NH_3D_VSP_BLOCK_MC
+  /// motion of list eRefPicList, or of both lists for REF_PIC_LIST_X, equal at two partitions
+  Bool xCheckSubPUMotion ( TComDataCU* pcCU, RefPicList eRefPicList, UInt uiPartAddr0, UInt uiPartAddr1 );
+  /// cover the sub-PUs with rectangles of equal motion, the size of a rectangle is set at its top left sub-PU, 0 at the others
+  Void xGetSubPURects    ( TComDataCU* pcCU, RefPicList eRefPicList, const UInt* puiSPAddr, Int iNumSPInOneLine, Int iNumSP, Int iSPWidth, Int iSPHeight, UInt* puiRectW, UInt* puiRectH );
+#endif
 
   Void destroy();
 
@@ -153,6 +181,11 @@ public:
 
   ChromaFormat getChromaFormat() const { return m_cYuvPredTemp.getChromaFormat(); }
 
+#if NH_3D_IC_PARAM_CACHE
+  /// forget the cached IC parameters, needed when the reconstruction around a CU position may have changed
+  Void resetICParamCache() { m_pcICCacheRecPic = NULL; m_iNumICParams = 0; m_iNextICParams = 0; }
+#endif
+
   // inter
   Void motionCompensation         ( TComDataCU*  pcCU, TComYuv* pcYuvPred, RefPicList eRefPicList = REF_PIC_LIST_X, Int iPartIdx = -1 );
 
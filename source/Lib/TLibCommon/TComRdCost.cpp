@@ -48,13 +48,13 @@
 //! \ingroup TLibCommon
 //! \{
 
-#if NH_3D_VSO
-// SAIT_VSO_EST_A0033
-Double TComRdCost::m_dDisparityCoeff = 1.0;
-#endif
 TComRdCost::TComRdCost()
 {
   init();
+#if NH_3D_VSO
+  // SAIT_VSO_EST_A0033
+  m_dDisparityCoeff = 1.0;
+#endif
 }
 
 TComRdCost::~TComRdCost()
@@ -182,6 +182,15 @@ Void TComRdCost::init()
   m_afpDistortFunc[DF_HADS64 ] = TComRdCost::xGetHADs;
   m_afpDistortFunc[DF_HADS16N] = TComRdCost::xGetHADs;
 
+#if RDCOST_SIMD && SIMD_X86
+  // the vectorized functions are only installed if they give the same results as the scalar ones
+  static const Bool bSimdChecked = xCheckSimdDistFuncs();
+  if( bSimdChecked )
+  {
+    xSetSimdDistFuncs( m_afpDistortFunc, getSimdExtension() );
+  }
+#endif
+
 #if NH_3D_VSO
   // SAIT_VSO_EST_A0033
   m_afpDistortFunc[29]  = TComRdCost::xGetVSD;
@@ -495,6 +504,7 @@ UInt TComRdCost::getDistPartVSD( TComDataCU* pcCU, UInt uiPartOffset, Int bitDep
   cDtParam.pVirRec    = piVirRec;
   cDtParam.pVirOrg    = piVirOrg;
   cDtParam.iStrideVir = iVirStride;
+  cDtParam.dDisparityCoeff = m_dDisparityCoeff;
   cDtParam.iStrideOrg = iOrgStride;
   cDtParam.iStrideCur = iCurStride;
   cDtParam.iStep      = 1;
@@ -650,7 +660,7 @@ UInt TComRdCost::xGetMaskedVSD( DistParam* pcDtParam )
       if( piOrg[x] != DBBP_INVALID_SHORT )
       {
         dDM = (Int) ( piOrg[x  ] - piCur[x  ] );
-        uiSum += getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
+        uiSum += getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
       }
     }
     piOrg += iStrideOrg;
@@ -2782,10 +2792,10 @@ Distortion TComRdCost::xGetSSE64( DistParam* pcDtParam )
 
 #if NH_3D_VSO
 //SAIT_VSO_EST_A0033
-UInt TComRdCost::getVSDEstimate( Int dDM, const Pel* pOrg, Int iOrgStride, const Pel* pVirRec, const Pel* pVirOrg, Int iVirStride, Int x, Int y )
+UInt TComRdCost::getVSDEstimate( Double dDisparityCoeff, Int dDM, const Pel* pOrg, Int iOrgStride, const Pel* pVirRec, const Pel* pVirOrg, Int iVirStride, Int x, Int y )
 { 
   // change to use bit depth from DistParam struct
-  Double  dD = ( (Double) ( dDM >> ( ENC_INTERNAL_BIT_DEPTH - 8 ) ) ) * m_dDisparityCoeff;
+  Double  dD = ( (Double) ( dDM >> ( ENC_INTERNAL_BIT_DEPTH - 8 ) ) ) * dDisparityCoeff;
 
   Double dDepthWeight = ( pOrg[x] >=  ( (1<<(REN_BIT_DEPTH - 3)) + (1<<(REN_BIT_DEPTH - 2)) ) ? 4 : pOrg[x] > ((1<<REN_BIT_DEPTH) >> 4) ? (Float)(pOrg[x] - ((1<<REN_BIT_DEPTH) >> 4))/(Float)((1<<REN_BIT_DEPTH) >> 3) + 1 : 1.0 );
 
@@ -2817,7 +2827,7 @@ UInt TComRdCost::xGetVSD( DistParam* pcDtParam )
     for (Int x = 0; x < iCols; x++ )
     {
       dDM = (Int) ( piOrg[x  ] - piCur[x  ] );
-      uiSum += getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
+      uiSum += getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
     }
     piOrg += iStrideOrg;
     piCur += iStrideCur; 
@@ -2844,10 +2854,10 @@ UInt TComRdCost::xGetVSD4( DistParam* pcDtParam )
 
   for ( Int y = 0 ; y < iRows ; y++ )
   {
-    dDM = (Int) ( piOrg[0] - piCur[0] );  uiSum += ( getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, 0, y ) ) >> uiShift;
-    dDM = (Int) ( piOrg[1] - piCur[1] );  uiSum += ( getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, 1, y ) ) >> uiShift;
-    dDM = (Int) ( piOrg[2] - piCur[2] );  uiSum += ( getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, 2, y ) ) >> uiShift;
-    dDM = (Int) ( piOrg[3] - piCur[3] );  uiSum += ( getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, 3, y ) ) >> uiShift;
+    dDM = (Int) ( piOrg[0] - piCur[0] );  uiSum += ( getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, 0, y ) ) >> uiShift;
+    dDM = (Int) ( piOrg[1] - piCur[1] );  uiSum += ( getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, 1, y ) ) >> uiShift;
+    dDM = (Int) ( piOrg[2] - piCur[2] );  uiSum += ( getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, 2, y ) ) >> uiShift;
+    dDM = (Int) ( piOrg[3] - piCur[3] );  uiSum += ( getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, 3, y ) ) >> uiShift;
 
     piOrg += iStrideOrg;
     piCur += iStrideCur;
@@ -2877,7 +2887,7 @@ UInt TComRdCost::xGetVSD8( DistParam* pcDtParam )
     for (Int x = 0; x < 8; x++ )
     {
       dDM = (Int) ( piOrg[x] - piCur[x] );
-      uiSum += getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
+      uiSum += getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
     }
     piOrg += iStrideOrg;
     piCur += iStrideCur;
@@ -2907,7 +2917,7 @@ UInt TComRdCost::xGetVSD16( DistParam* pcDtParam )
     for (Int x = 0; x < 16; x++ )
     {
       dDM = (Int) ( piOrg[x] - piCur[x] );
-      uiSum += getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
+      uiSum += getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
     }
     piOrg += iStrideOrg;
     piCur += iStrideCur;
@@ -2940,7 +2950,7 @@ UInt TComRdCost::xGetVSD16N( DistParam* pcDtParam )
       for ( Int k = 0 ; k < 16 ; k++ )
       {
         dDM = (Int) ( piOrg[x+k] - piCur[x+k] );
-        uiSum += getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x+k, y ) >> uiShift;
+        uiSum += getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x+k, y ) >> uiShift;
       }
     }
     piOrg += iStrideOrg;
@@ -2971,7 +2981,7 @@ UInt TComRdCost::xGetVSD32( DistParam* pcDtParam )
     for (Int x = 0; x < 32 ; x++ )
     {
       dDM = (Int) ( piOrg[x] - piCur[x] );
-      uiSum += getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
+      uiSum += getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
     }
     piOrg += iStrideOrg;
     piCur += iStrideCur;
@@ -3001,7 +3011,7 @@ UInt TComRdCost::xGetVSD64( DistParam* pcDtParam )
     for (Int x = 0; x < 64; x++ )
     {
       dDM = (Int) ( piOrg[x] - piCur[x] );
-      uiSum += getVSDEstimate( dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
+      uiSum += getVSDEstimate( pcDtParam->dDisparityCoeff, dDM, piOrg, iStrideOrg, piVirRec, piVirOrg, iStrideVir, x, y ) >> uiShift;
     }
     piOrg += iStrideOrg;
     piCur += iStrideCur;
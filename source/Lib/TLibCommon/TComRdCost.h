@@ -45,6 +45,9 @@
 
 #include "TComSlice.h"
 #include "TComRdCostWeightPrediction.h"
+#if RDCOST_SIMD && SIMD_X86
+#include "TComSimd.h"
+#endif
 #if NH_3D_VSO
 #include "../TLibRenderer/TRenModel.h"
 #include "TComYuv.h"
@@ -88,6 +91,7 @@ public:
   Pel*  pVirRec;
   Pel*  pVirOrg;
   Int   iStrideVir;
+  Double dDisparityCoeff;
 #endif
 #if NH_3D_IC
   Bool  bUseIC;
@@ -134,6 +138,7 @@ public:
     pVirRec = NULL;
     pVirOrg = NULL;
     iStrideVir = 0;
+    dDisparityCoeff = 1.0;
 #endif
 #if NH_3D_SDC_INTER
     bUseSDCMRSAD = false;
@@ -157,7 +162,7 @@ private:
   Double                  m_dFrameLambda;
 #if NH_3D_VSO
   // SAIT_VSO_EST_A0033
-  static Double           m_dDisparityCoeff;
+  Double                  m_dDisparityCoeff;
 #endif
 
   // for motion cost
@@ -293,6 +298,14 @@ private:
   static UInt xGetMaskedVSD     ( DistParam* pcDtParam );
 #endif
 
+#if RDCOST_SIMD && SIMD_X86
+  // vectorized Hadamard functions, the other vectorized distortion functions are local to TComRdCostSIMD.cpp
+  static Distortion xGetHADsSse41     ( DistParam* pcDtParam );
+  static Distortion xGetHADsAvx2      ( DistParam* pcDtParam );
+  static Void xSetSimdDistFuncs       ( FpDistFunc* afpDistortFunc, SimdExtension eExtension );
+  Bool        xCheckSimdDistFuncs     ( ) const;
+#endif
+
 
 public:
 
@@ -305,7 +318,7 @@ public:
 #if NH_3D_VSO
   // SAIT_VSO_EST_A0033
   UInt        getDistPartVSD( TComDataCU* pcCu, UInt uiPartOffset, Int bitDepth, Pel* piCur, Int iCurStride,  Pel* piOrg, Int iOrgStride, UInt uiBlkWidth, UInt uiBlkHeight, Bool bHad, DFunc eDFunc = DF_VSD); 
-  static UInt getVSDEstimate( Int dDM, const Pel* pOrg, Int iOrgStride,  const Pel* pVirRec, const Pel* pVirOrg, Int iVirStride, Int x, Int y );
+  static UInt getVSDEstimate( Double dDisparityCoeff, Int dDM, const Pel* pOrg, Int iOrgStride,  const Pel* pVirRec, const Pel* pVirOrg, Int iVirStride, Int x, Int y );
 
 private:
   Double                  m_dLambdaVSO;
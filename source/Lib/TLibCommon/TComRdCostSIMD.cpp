@@ -0,0 +1,875 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComRdCostSIMD.cpp
+    \brief    SSE4.1 and AVX2 implementations of the SAD, SSE and Hadamard distortion functions of TComRdCost
+
+    The samples are widened to 32 bit where the scalar functions compute with Int, so that the results are
+    identical for all sample values. TComRdCost::init() installs the functions of the highest extension
+    supported by the CPU, after comparing them with the scalar functions (xCheckSimdDistFuncs).
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "TComRdCost.h"
+
+#if RDCOST_SIMD && SIMD_X86
+
+#include <immintrin.h>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Helpers
+// ====================================================================================================================
+
+static inline SIMD_TARGET_SSE41 UInt xHorizontalSumSse41( __m128i vSum )
+{
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0x4e ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0xb1 ) );
+  return (UInt)_mm_cvtsi128_si32( vSum );
+}
+
+static inline SIMD_TARGET_AVX2 UInt xHorizontalSumAvx2( __m256i vSum )
+{
+  return xHorizontalSumSse41( _mm_add_epi32( _mm256_castsi256_si128( vSum ), _mm256_extracti128_si256( vSum, 1 ) ) );
+}
+
+/// |org - cur| of 8 samples: exact as unsigned 16 bit values
+static inline SIMD_TARGET_SSE41 __m128i xAbsDiffSse41( __m128i vOrg, __m128i vCur )
+{
+  return _mm_sub_epi16( _mm_max_epi16( vOrg, vCur ), _mm_min_epi16( vOrg, vCur ) );
+}
+
+/// adds 8 unsigned 16 bit values to 4 32 bit sums
+static inline SIMD_TARGET_SSE41 __m128i xAddU16Sse41( __m128i vSum, __m128i vVal )
+{
+  return _mm_add_epi32( vSum, _mm_add_epi32( _mm_and_si128( vVal, _mm_set1_epi32( 0xffff ) ), _mm_srli_epi32( vVal, 16 ) ) );
+}
+
+/// (org - cur)^2 >> shift of the 4 samples in the low half of the registers
+static inline SIMD_TARGET_SSE41 __m128i xSquaredDiffSse41( __m128i vOrg, __m128i vCur, __m128i vShift )
+{
+  const __m128i vDiff = _mm_sub_epi32( _mm_cvtepi16_epi32( vOrg ), _mm_cvtepi16_epi32( vCur ) );
+  return _mm_srl_epi32( _mm_mullo_epi32( vDiff, vDiff ), vShift );
+}
+
+/// |org - cur - delta| of the 4 samples in the low half of the registers
+static inline SIMD_TARGET_SSE41 __m128i xAbsDiffDeltaSse41( __m128i vOrg, __m128i vCur, __m128i vDelta )
+{
+  return _mm_abs_epi32( _mm_sub_epi32( _mm_sub_epi32( _mm_cvtepi16_epi32( vOrg ), _mm_cvtepi16_epi32( vCur ) ), vDelta ) );
+}
+
+static inline SIMD_TARGET_SSE41 __m128i xLoadDiff4Sse41( const Pel* piOrg, const Pel* piCur )
+{
+  return _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*)piOrg ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*)piCur ) ) );
+}
+
+static inline SIMD_TARGET_AVX2 __m256i xLoadDiff8Avx2( const Pel* piOrg, const Pel* piCur )
+{
+  return _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i*)piOrg ) ), _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i*)piCur ) ) );
+}
+
+// ====================================================================================================================
+// SAD
+// ====================================================================================================================
+
+/// SAD of a block whose width is a multiple of 4, every iSubStep-th row, strides include the row step
+static inline SIMD_TARGET_SSE41 UInt xGetSADBlockSse41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, Int iSubStep )
+{
+  __m128i vSum = _mm_setzero_si128();
+
+  for( ; iRows != 0; iRows -= iSubStep )
+  {
+    Int n = 0;
+    for( ; n + 8 <= iCols; n += 8 )
+    {
+      vSum = xAddU16Sse41( vSum, xAbsDiffSse41( _mm_loadu_si128( (const __m128i*)&piOrg[n] ), _mm_loadu_si128( (const __m128i*)&piCur[n] ) ) );
+    }
+    if( n < iCols )
+    {
+      vSum = xAddU16Sse41( vSum, xAbsDiffSse41( _mm_loadl_epi64( (const __m128i*)&piOrg[n] ), _mm_loadl_epi64( (const __m128i*)&piCur[n] ) ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return xHorizontalSumSse41( vSum );
+}
+
+static inline SIMD_TARGET_AVX2 UInt xGetSADBlockAvx2( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, Int iSubStep )
+{
+  __m256i vSum    = _mm256_setzero_si256();
+  __m128i vSum128 = _mm_setzero_si128();
+
+  for( ; iRows != 0; iRows -= iSubStep )
+  {
+    Int n = 0;
+    for( ; n + 16 <= iCols; n += 16 )
+    {
+      const __m256i vOrg = _mm256_loadu_si256( (const __m256i*)&piOrg[n] );
+      const __m256i vCur = _mm256_loadu_si256( (const __m256i*)&piCur[n] );
+      const __m256i vAbs = _mm256_sub_epi16( _mm256_max_epi16( vOrg, vCur ), _mm256_min_epi16( vOrg, vCur ) );
+      vSum = _mm256_add_epi32( vSum, _mm256_add_epi32( _mm256_and_si256( vAbs, _mm256_set1_epi32( 0xffff ) ), _mm256_srli_epi32( vAbs, 16 ) ) );
+    }
+    if( n + 8 <= iCols )
+    {
+      vSum128 = xAddU16Sse41( vSum128, xAbsDiffSse41( _mm_loadu_si128( (const __m128i*)&piOrg[n] ), _mm_loadu_si128( (const __m128i*)&piCur[n] ) ) );
+      n += 8;
+    }
+    if( n < iCols )
+    {
+      vSum128 = xAddU16Sse41( vSum128, xAbsDiffSse41( _mm_loadl_epi64( (const __m128i*)&piOrg[n] ), _mm_loadl_epi64( (const __m128i*)&piCur[n] ) ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return xHorizontalSumAvx2( vSum ) + xHorizontalSumSse41( vSum128 );
+}
+
+#if NH_3D_IC || NH_3D_SDC_INTER
+/// sums of the original and current samples of every iSubStep-th row, strides include the row step
+static inline SIMD_TARGET_SSE41 Void xGetSumsSse41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, Int iSubStep, Int& riSumOrg, Int& riSumCur, Int& riRowCnt )
+{
+  const __m128i vOne    = _mm_set1_epi16( 1 );
+  __m128i       vSumOrg = _mm_setzero_si128();
+  __m128i       vSumCur = _mm_setzero_si128();
+
+  riRowCnt = 0;
+  for( ; iRows != 0; iRows -= iSubStep )
+  {
+    Int n = 0;
+    for( ; n + 8 <= iCols; n += 8 )
+    {
+      vSumOrg = _mm_add_epi32( vSumOrg, _mm_madd_epi16( _mm_loadu_si128( (const __m128i*)&piOrg[n] ), vOne ) );
+      vSumCur = _mm_add_epi32( vSumCur, _mm_madd_epi16( _mm_loadu_si128( (const __m128i*)&piCur[n] ), vOne ) );
+    }
+    if( n < iCols )
+    {
+      vSumOrg = _mm_add_epi32( vSumOrg, _mm_madd_epi16( _mm_loadl_epi64( (const __m128i*)&piOrg[n] ), vOne ) );
+      vSumCur = _mm_add_epi32( vSumCur, _mm_madd_epi16( _mm_loadl_epi64( (const __m128i*)&piCur[n] ), vOne ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+    riRowCnt++;
+  }
+
+  riSumOrg = (Int)xHorizontalSumSse41( vSumOrg );
+  riSumCur = (Int)xHorizontalSumSse41( vSumCur );
+}
+
+/// SAD of the block after subtracting iDeltaC from the differences
+static inline SIMD_TARGET_SSE41 UInt xGetSADicBlockSse41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, Int iSubStep, Int iDeltaC )
+{
+  const __m128i vDelta = _mm_set1_epi32( iDeltaC );
+  __m128i       vSum   = _mm_setzero_si128();
+
+  for( ; iRows != 0; iRows -= iSubStep )
+  {
+    Int n = 0;
+    for( ; n + 8 <= iCols; n += 8 )
+    {
+      const __m128i vOrg = _mm_loadu_si128( (const __m128i*)&piOrg[n] );
+      const __m128i vCur = _mm_loadu_si128( (const __m128i*)&piCur[n] );
+      vSum = _mm_add_epi32( vSum, xAbsDiffDeltaSse41( vOrg, vCur, vDelta ) );
+      vSum = _mm_add_epi32( vSum, xAbsDiffDeltaSse41( _mm_unpackhi_epi64( vOrg, vOrg ), _mm_unpackhi_epi64( vCur, vCur ), vDelta ) );
+    }
+    if( n < iCols )
+    {
+      vSum = _mm_add_epi32( vSum, xAbsDiffDeltaSse41( _mm_loadl_epi64( (const __m128i*)&piOrg[n] ), _mm_loadl_epi64( (const __m128i*)&piCur[n] ), vDelta ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return xHorizontalSumSse41( vSum );
+}
+
+/// illumination compensated SAD, counterpart of TComRdCost::xGetSADic (iWidth 4 to 64) and xGetSAD16Nic (iWidth 0)
+template<Int iWidth>
+static SIMD_TARGET_SSE41 UInt xGetSADicSse41( DistParam* pcDtParam )
+{
+  if( iWidth != 0 && pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+  const Int iCols      = ( iWidth != 0 ? iWidth : ( ( pcDtParam->iCols + 15 ) & ~15 ) );
+  const Int iSubShift  = pcDtParam->iSubShift;
+  const Int iSubStep   = ( 1 << iSubShift );
+  const Int iStrideOrg = pcDtParam->iStrideOrg * iSubStep;
+  const Int iStrideCur = pcDtParam->iStrideCur * iSubStep;
+
+  Int iOrigAvg, iCurAvg, iRowCnt;
+  xGetSumsSse41( pcDtParam->pOrg, iStrideOrg, pcDtParam->pCur, iStrideCur, iCols, pcDtParam->iRows, iSubStep, iOrigAvg, iCurAvg, iRowCnt );
+
+  Int iDeltaC;
+  if( iWidth != 0 )
+  {
+    iDeltaC = iRowCnt ? ( ( iOrigAvg - iCurAvg ) / iRowCnt / iWidth ) : 0;
+  }
+  else
+  {
+    const Int iColCnt = ( pcDtParam->iCols - 1 ) / 16 + 1;
+    iDeltaC = ( iRowCnt && iColCnt ) ? ( ( iOrigAvg - iCurAvg ) / iRowCnt / iColCnt / 16 ) : 0;
+  }
+
+  UInt uiSum = xGetSADicBlockSse41( pcDtParam->pOrg, iStrideOrg, pcDtParam->pCur, iStrideCur, iCols, pcDtParam->iRows, iSubStep, iDeltaC );
+
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT( pcDtParam->bitDepth - 8 ) );
+}
+#endif
+
+/// counterpart of TComRdCost::xGetSAD4 to xGetSAD64 (iWidth 4 to 64) and xGetSAD16N (iWidth 0)
+template<Int iWidth>
+static SIMD_TARGET_SSE41 Distortion xGetSADSse41( DistParam* pcDtParam )
+{
+  if( iWidth != 0 && pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+#if NH_3D_IC
+  if( pcDtParam->bUseIC )
+  {
+    return xGetSADicSse41<iWidth>( pcDtParam );
+  }
+#endif
+#if NH_3D_SDC_INTER
+  if( pcDtParam->bUseSDCMRSAD )
+  {
+    return xGetSADicSse41<iWidth>( pcDtParam );
+  }
+#endif
+  const Int iSubShift = pcDtParam->iSubShift;
+  const Int iSubStep  = ( 1 << iSubShift );
+
+  Distortion uiSum = xGetSADBlockSse41( pcDtParam->pOrg, pcDtParam->iStrideOrg * iSubStep, pcDtParam->pCur, pcDtParam->iStrideCur * iSubStep,
+                                        ( iWidth != 0 ? iWidth : ( ( pcDtParam->iCols + 15 ) & ~15 ) ), pcDtParam->iRows, iSubStep );
+
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT( pcDtParam->bitDepth - 8 ) );
+}
+
+template<Int iWidth>
+static SIMD_TARGET_AVX2 Distortion xGetSADAvx2( DistParam* pcDtParam )
+{
+  if( iWidth != 0 && pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+#if NH_3D_IC
+  if( pcDtParam->bUseIC )
+  {
+    return xGetSADicSse41<iWidth>( pcDtParam );
+  }
+#endif
+#if NH_3D_SDC_INTER
+  if( pcDtParam->bUseSDCMRSAD )
+  {
+    return xGetSADicSse41<iWidth>( pcDtParam );
+  }
+#endif
+  const Int iSubShift = pcDtParam->iSubShift;
+  const Int iSubStep  = ( 1 << iSubShift );
+
+  Distortion uiSum = xGetSADBlockAvx2( pcDtParam->pOrg, pcDtParam->iStrideOrg * iSubStep, pcDtParam->pCur, pcDtParam->iStrideCur * iSubStep,
+                                       ( iWidth != 0 ? iWidth : ( ( pcDtParam->iCols + 15 ) & ~15 ) ), pcDtParam->iRows, iSubStep );
+
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT( pcDtParam->bitDepth - 8 ) );
+}
+
+// ====================================================================================================================
+// SSE
+// ====================================================================================================================
+
+/// counterpart of TComRdCost::xGetSSE4 to xGetSSE64 (iWidth 4 to 64) and xGetSSE16N (iWidth 0)
+template<Int iWidth>
+static SIMD_TARGET_SSE41 Distortion xGetSSESse41( DistParam* pcDtParam )
+{
+  if( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
+  }
+  const Pel*    piOrg      = pcDtParam->pOrg;
+  const Pel*    piCur      = pcDtParam->pCur;
+  const Int     iCols      = ( iWidth != 0 ? iWidth : ( ( pcDtParam->iCols + 15 ) & ~15 ) );
+  const Int     iStrideOrg = pcDtParam->iStrideOrg;
+  const Int     iStrideCur = pcDtParam->iStrideCur;
+  const __m128i vShift     = _mm_cvtsi32_si128( DISTORTION_PRECISION_ADJUSTMENT( ( pcDtParam->bitDepth - 8 ) << 1 ) );
+  __m128i       vSum       = _mm_setzero_si128();
+
+  for( Int iRows = pcDtParam->iRows; iRows != 0; iRows-- )
+  {
+    Int n = 0;
+    for( ; n + 8 <= iCols; n += 8 )
+    {
+      const __m128i vOrg = _mm_loadu_si128( (const __m128i*)&piOrg[n] );
+      const __m128i vCur = _mm_loadu_si128( (const __m128i*)&piCur[n] );
+      vSum = _mm_add_epi32( vSum, xSquaredDiffSse41( vOrg, vCur, vShift ) );
+      vSum = _mm_add_epi32( vSum, xSquaredDiffSse41( _mm_unpackhi_epi64( vOrg, vOrg ), _mm_unpackhi_epi64( vCur, vCur ), vShift ) );
+    }
+    if( n < iCols )
+    {
+      vSum = _mm_add_epi32( vSum, xSquaredDiffSse41( _mm_loadl_epi64( (const __m128i*)&piOrg[n] ), _mm_loadl_epi64( (const __m128i*)&piCur[n] ), vShift ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return xHorizontalSumSse41( vSum );
+}
+
+template<Int iWidth>
+static SIMD_TARGET_AVX2 Distortion xGetSSEAvx2( DistParam* pcDtParam )
+{
+  if( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
+  }
+  const Pel*    piOrg      = pcDtParam->pOrg;
+  const Pel*    piCur      = pcDtParam->pCur;
+  const Int     iCols      = ( iWidth != 0 ? iWidth : ( ( pcDtParam->iCols + 15 ) & ~15 ) );
+  const Int     iStrideOrg = pcDtParam->iStrideOrg;
+  const Int     iStrideCur = pcDtParam->iStrideCur;
+  const __m128i vShift     = _mm_cvtsi32_si128( DISTORTION_PRECISION_ADJUSTMENT( ( pcDtParam->bitDepth - 8 ) << 1 ) );
+  __m256i       vSum       = _mm256_setzero_si256();
+  __m128i       vSum128    = _mm_setzero_si128();
+
+  for( Int iRows = pcDtParam->iRows; iRows != 0; iRows-- )
+  {
+    Int n = 0;
+    for( ; n + 8 <= iCols; n += 8 )
+    {
+      const __m256i vDiff = xLoadDiff8Avx2( &piOrg[n], &piCur[n] );
+      vSum = _mm256_add_epi32( vSum, _mm256_srl_epi32( _mm256_mullo_epi32( vDiff, vDiff ), vShift ) );
+    }
+    if( n < iCols )
+    {
+      vSum128 = _mm_add_epi32( vSum128, xSquaredDiffSse41( _mm_loadl_epi64( (const __m128i*)&piOrg[n] ), _mm_loadl_epi64( (const __m128i*)&piCur[n] ), vShift ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return xHorizontalSumAvx2( vSum ) + xHorizontalSumSse41( vSum128 );
+}
+
+// ====================================================================================================================
+// Hadamard
+// ====================================================================================================================
+
+typedef Distortion (*FpHadFunc) ( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur );
+
+/// 4 point Hadamard transform across the registers
+static inline SIMD_TARGET_SSE41 Void xHadamard4Sse41( __m128i* pv )
+{
+  const __m128i v0 = _mm_add_epi32( pv[0], pv[1] );
+  const __m128i v1 = _mm_sub_epi32( pv[0], pv[1] );
+  const __m128i v2 = _mm_add_epi32( pv[2], pv[3] );
+  const __m128i v3 = _mm_sub_epi32( pv[2], pv[3] );
+  pv[0] = _mm_add_epi32( v0, v2 );
+  pv[1] = _mm_add_epi32( v1, v3 );
+  pv[2] = _mm_sub_epi32( v0, v2 );
+  pv[3] = _mm_sub_epi32( v1, v3 );
+}
+
+/// 8 point Hadamard transform across the registers
+static inline SIMD_TARGET_SSE41 Void xHadamard8Sse41( __m128i* pv )
+{
+  for( Int i = 0; i < 4; i++ )
+  {
+    const __m128i v = pv[i];
+    pv[i  ] = _mm_add_epi32( v, pv[i+4] );
+    pv[i+4] = _mm_sub_epi32( v, pv[i+4] );
+  }
+  xHadamard4Sse41( pv     );
+  xHadamard4Sse41( pv + 4 );
+}
+
+static inline SIMD_TARGET_SSE41 Void xTranspose4x4Sse41( __m128i* pv )
+{
+  const __m128i v0 = _mm_unpacklo_epi32( pv[0], pv[1] );
+  const __m128i v1 = _mm_unpacklo_epi32( pv[2], pv[3] );
+  const __m128i v2 = _mm_unpackhi_epi32( pv[0], pv[1] );
+  const __m128i v3 = _mm_unpackhi_epi32( pv[2], pv[3] );
+  pv[0] = _mm_unpacklo_epi64( v0, v1 );
+  pv[1] = _mm_unpackhi_epi64( v0, v1 );
+  pv[2] = _mm_unpacklo_epi64( v2, v3 );
+  pv[3] = _mm_unpackhi_epi64( v2, v3 );
+}
+
+static inline SIMD_TARGET_SSE41 __m128i xSumAbs4Sse41( const __m128i* pv )
+{
+  return _mm_add_epi32( _mm_add_epi32( _mm_abs_epi32( pv[0] ), _mm_abs_epi32( pv[1] ) ), _mm_add_epi32( _mm_abs_epi32( pv[2] ), _mm_abs_epi32( pv[3] ) ) );
+}
+
+/// counterpart of TComRdCost::xCalcHADs4x4
+static SIMD_TARGET_SSE41 Distortion xCalcHADs4x4Sse41( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m128i av[4];
+  for( Int k = 0; k < 4; k++ )
+  {
+    av[k] = xLoadDiff4Sse41( piOrg, piCur );
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  xHadamard4Sse41   ( av );
+  xTranspose4x4Sse41( av );
+  xHadamard4Sse41   ( av );
+
+  const Distortion satd = xHorizontalSumSse41( xSumAbs4Sse41( av ) );
+  return ( ( satd + 1 ) >> 1 );
+}
+
+/// counterpart of TComRdCost::xCalcHADs8x8, the rows are split in columns 0..3 (avLo) and 4..7 (avHi)
+static SIMD_TARGET_SSE41 Distortion xCalcHADs8x8Sse41( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m128i avLo[8], avHi[8];
+  for( Int k = 0; k < 8; k++ )
+  {
+    avLo[k] = xLoadDiff4Sse41( piOrg,     piCur     );
+    avHi[k] = xLoadDiff4Sse41( piOrg + 4, piCur + 4 );
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  // vertical
+  xHadamard8Sse41( avLo );
+  xHadamard8Sse41( avHi );
+
+  // transpose the 4x4 quadrants and swap the off-diagonal ones
+  __m128i avTLo[8], avTHi[8];
+  for( Int k = 0; k < 4; k++ )
+  {
+    avTLo[k  ] = avLo[k  ];
+    avTLo[k+4] = avHi[k  ];
+    avTHi[k  ] = avLo[k+4];
+    avTHi[k+4] = avHi[k+4];
+  }
+  xTranspose4x4Sse41( avTLo     );
+  xTranspose4x4Sse41( avTLo + 4 );
+  xTranspose4x4Sse41( avTHi     );
+  xTranspose4x4Sse41( avTHi + 4 );
+
+  // horizontal
+  xHadamard8Sse41( avTLo );
+  xHadamard8Sse41( avTHi );
+
+  const __m128i vSum = _mm_add_epi32( _mm_add_epi32( xSumAbs4Sse41( avTLo ), xSumAbs4Sse41( avTLo + 4 ) ),
+                                      _mm_add_epi32( xSumAbs4Sse41( avTHi ), xSumAbs4Sse41( avTHi + 4 ) ) );
+  const Distortion sad = xHorizontalSumSse41( vSum );
+  return ( ( sad + 2 ) >> 2 );
+}
+
+/// 8 point Hadamard transform across the registers
+static inline SIMD_TARGET_AVX2 Void xHadamard8Avx2( __m256i* pv )
+{
+  for( Int i = 0; i < 4; i++ )
+  {
+    const __m256i v = pv[i];
+    pv[i  ] = _mm256_add_epi32( v, pv[i+4] );
+    pv[i+4] = _mm256_sub_epi32( v, pv[i+4] );
+  }
+  for( Int i = 0; i < 8; i += 4 )
+  {
+    for( Int j = i; j < i + 2; j++ )
+    {
+      const __m256i v = pv[j];
+      pv[j  ] = _mm256_add_epi32( v, pv[j+2] );
+      pv[j+2] = _mm256_sub_epi32( v, pv[j+2] );
+    }
+  }
+  for( Int i = 0; i < 8; i += 2 )
+  {
+    const __m256i v = pv[i];
+    pv[i  ] = _mm256_add_epi32( v, pv[i+1] );
+    pv[i+1] = _mm256_sub_epi32( v, pv[i+1] );
+  }
+}
+
+static inline SIMD_TARGET_AVX2 Void xTranspose8x8Avx2( __m256i* pv )
+{
+  __m256i avT[8], avU[8];
+  for( Int i = 0; i < 8; i += 2 )
+  {
+    avT[i  ] = _mm256_unpacklo_epi32( pv[i], pv[i+1] );
+    avT[i+1] = _mm256_unpackhi_epi32( pv[i], pv[i+1] );
+  }
+  for( Int i = 0; i < 8; i += 4 )
+  {
+    avU[i  ] = _mm256_unpacklo_epi64( avT[i  ], avT[i+2] );
+    avU[i+1] = _mm256_unpackhi_epi64( avT[i  ], avT[i+2] );
+    avU[i+2] = _mm256_unpacklo_epi64( avT[i+1], avT[i+3] );
+    avU[i+3] = _mm256_unpackhi_epi64( avT[i+1], avT[i+3] );
+  }
+  for( Int i = 0; i < 4; i++ )
+  {
+    pv[i  ] = _mm256_permute2x128_si256( avU[i], avU[i+4], 0x20 );
+    pv[i+4] = _mm256_permute2x128_si256( avU[i], avU[i+4], 0x31 );
+  }
+}
+
+/// counterpart of TComRdCost::xCalcHADs8x8
+static SIMD_TARGET_AVX2 Distortion xCalcHADs8x8Avx2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m256i av[8];
+  for( Int k = 0; k < 8; k++ )
+  {
+    av[k] = xLoadDiff8Avx2( piOrg, piCur );
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  xHadamard8Avx2   ( av );
+  xTranspose8x8Avx2( av );
+  xHadamard8Avx2   ( av );
+
+  __m256i vSum = _mm256_abs_epi32( av[0] );
+  for( Int k = 1; k < 8; k++ )
+  {
+    vSum = _mm256_add_epi32( vSum, _mm256_abs_epi32( av[k] ) );
+  }
+  const Distortion sad = xHorizontalSumAvx2( vSum );
+  return ( ( sad + 2 ) >> 2 );
+}
+
+/// Hadamard cost of a block whose width and height are multiples of 4, as summed by TComRdCost::xGetHADs
+static Distortion xGetHADsBlock( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iStep, Int iCols, Int iRows, FpHadFunc fpHad8x8, FpHadFunc fpHad4x4 )
+{
+  Distortion uiSum = 0;
+
+  if( ( iRows % 8 == 0 ) && ( iCols % 8 == 0 ) )
+  {
+    for( Int y = 0; y < iRows; y += 8 )
+    {
+      for( Int x = 0; x < iCols; x += 8 )
+      {
+        uiSum += fpHad8x8( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg << 3;
+      piCur += iStrideCur << 3;
+    }
+  }
+  else
+  {
+    for( Int y = 0; y < iRows; y += 4 )
+    {
+      for( Int x = 0; x < iCols; x += 4 )
+      {
+        uiSum += fpHad4x4( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg << 2;
+      piCur += iStrideCur << 2;
+    }
+  }
+
+  return uiSum;
+}
+
+#if NH_3D_IC || NH_3D_SDC_INTER
+/// illumination compensated Hadamard cost of a block whose width and height are multiples of 4, counterpart of TComRdCost::xGetHADsic
+static SIMD_TARGET_SSE41 UInt xGetHADsicBlock( DistParam* pcDtParam, FpHadFunc fpHad8x8, FpHadFunc fpHad4x4 )
+{
+  const Int iRows      = pcDtParam->iRows;
+  const Int iCols      = pcDtParam->iCols;
+  const Int iStrideOrg = pcDtParam->iStrideOrg;
+
+  Int iOrigAvg, iCurAvg, iRowCnt;
+  xGetSumsSse41( pcDtParam->pOrg, iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur, iCols, iRows, 1, iOrigAvg, iCurAvg, iRowCnt );
+
+  const Int iDeltaC = ( iOrigAvg - iCurAvg ) / iRows / iCols;
+
+  // the original samples minus the DC offset, stored with the width of the block as stride
+  const Int orgMaxSize = MAX_CU_SIZE*MAX_CU_SIZE;
+  assert( iRows * iCols <= orgMaxSize );
+  Pel orgMinusDeltaDc[ orgMaxSize ];
+
+  const __m128i vDelta = _mm_set1_epi16( (Short)iDeltaC );
+  const Pel*    piOrg  = pcDtParam->pOrg;
+  Pel*          piDst  = orgMinusDeltaDc;
+  for( Int y = 0; y < iRows; y++ )
+  {
+    for( Int x = 0; x < iCols; x += 4 )
+    {
+      _mm_storel_epi64( (__m128i*)&piDst[x], _mm_sub_epi16( _mm_loadl_epi64( (const __m128i*)&piOrg[x] ), vDelta ) );
+    }
+    piOrg += iStrideOrg;
+    piDst += iCols;
+  }
+
+  const UInt uiSum = xGetHADsBlock( orgMinusDeltaDc, iCols, pcDtParam->pCur, pcDtParam->iStrideCur, pcDtParam->iStep, iCols, iRows, fpHad8x8, fpHad4x4 );
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT( pcDtParam->bitDepth - 8 ) );
+}
+#endif
+
+Distortion TComRdCost::xGetHADsSse41( DistParam* pcDtParam )
+{
+  if( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetHADsw( pcDtParam );
+  }
+  // blocks with a width or height that is not a multiple of 4 use the 2x2 transform of the scalar functions
+  const Bool bHad4 = ( pcDtParam->iRows % 4 == 0 ) && ( pcDtParam->iCols % 4 == 0 );
+#if NH_3D_IC
+  if( pcDtParam->bUseIC )
+  {
+    return ( bHad4 ? xGetHADsicBlock( pcDtParam, xCalcHADs8x8Sse41, xCalcHADs4x4Sse41 ) : xGetHADsic( pcDtParam ) );
+  }
+#endif
+#if NH_3D_SDC_INTER
+  if( pcDtParam->bUseSDCMRSAD )
+  {
+    return ( bHad4 ? xGetHADsicBlock( pcDtParam, xCalcHADs8x8Sse41, xCalcHADs4x4Sse41 ) : xGetHADsic( pcDtParam ) );
+  }
+#endif
+  if( !bHad4 )
+  {
+    return xGetHADs( pcDtParam );
+  }
+
+  const Distortion uiSum = xGetHADsBlock( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur, pcDtParam->iStep,
+                                          pcDtParam->iCols, pcDtParam->iRows, xCalcHADs8x8Sse41, xCalcHADs4x4Sse41 );
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT( pcDtParam->bitDepth - 8 ) );
+}
+
+Distortion TComRdCost::xGetHADsAvx2( DistParam* pcDtParam )
+{
+  if( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetHADsw( pcDtParam );
+  }
+  const Bool bHad4 = ( pcDtParam->iRows % 4 == 0 ) && ( pcDtParam->iCols % 4 == 0 );
+#if NH_3D_IC
+  if( pcDtParam->bUseIC )
+  {
+    return ( bHad4 ? xGetHADsicBlock( pcDtParam, xCalcHADs8x8Avx2, xCalcHADs4x4Sse41 ) : xGetHADsic( pcDtParam ) );
+  }
+#endif
+#if NH_3D_SDC_INTER
+  if( pcDtParam->bUseSDCMRSAD )
+  {
+    return ( bHad4 ? xGetHADsicBlock( pcDtParam, xCalcHADs8x8Avx2, xCalcHADs4x4Sse41 ) : xGetHADsic( pcDtParam ) );
+  }
+#endif
+  if( !bHad4 )
+  {
+    return xGetHADs( pcDtParam );
+  }
+
+  const Distortion uiSum = xGetHADsBlock( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur, pcDtParam->iStep,
+                                          pcDtParam->iCols, pcDtParam->iRows, xCalcHADs8x8Avx2, xCalcHADs4x4Sse41 );
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT( pcDtParam->bitDepth - 8 ) );
+}
+
+// ====================================================================================================================
+// Installation and self-test
+// ====================================================================================================================
+
+/** Replace the entries of the distortion function table that have a vectorized version for the extension.
+ * \param afpDistortFunc table indexed by DFunc, initialized with the scalar functions
+ * \param eExtension     SIMD extension, at most the one returned by getSimdExtension()
+ */
+Void TComRdCost::xSetSimdDistFuncs( FpDistFunc* afpDistortFunc, SimdExtension eExtension )
+{
+  if( eExtension >= SIMD_SSE41 )
+  {
+    afpDistortFunc[DF_SSE4   ] = xGetSSESse41<4>;
+    afpDistortFunc[DF_SSE8   ] = xGetSSESse41<8>;
+    afpDistortFunc[DF_SSE16  ] = xGetSSESse41<16>;
+    afpDistortFunc[DF_SSE32  ] = xGetSSESse41<32>;
+    afpDistortFunc[DF_SSE64  ] = xGetSSESse41<64>;
+    afpDistortFunc[DF_SSE16N ] = xGetSSESse41<0>;
+
+    afpDistortFunc[DF_SAD4   ] = xGetSADSse41<4>;
+    afpDistortFunc[DF_SAD8   ] = xGetSADSse41<8>;
+    afpDistortFunc[DF_SAD16  ] = xGetSADSse41<16>;
+    afpDistortFunc[DF_SAD32  ] = xGetSADSse41<32>;
+    afpDistortFunc[DF_SAD64  ] = xGetSADSse41<64>;
+    afpDistortFunc[DF_SAD16N ] = xGetSADSse41<0>;
+
+    afpDistortFunc[DF_SADS4  ] = xGetSADSse41<4>;
+    afpDistortFunc[DF_SADS8  ] = xGetSADSse41<8>;
+    afpDistortFunc[DF_SADS16 ] = xGetSADSse41<16>;
+    afpDistortFunc[DF_SADS32 ] = xGetSADSse41<32>;
+    afpDistortFunc[DF_SADS64 ] = xGetSADSse41<64>;
+    afpDistortFunc[DF_SADS16N] = xGetSADSse41<0>;
+
+    afpDistortFunc[DF_SAD12  ] = xGetSADSse41<12>;
+    afpDistortFunc[DF_SAD24  ] = xGetSADSse41<24>;
+    afpDistortFunc[DF_SAD48  ] = xGetSADSse41<48>;
+
+    afpDistortFunc[DF_SADS12 ] = xGetSADSse41<12>;
+    afpDistortFunc[DF_SADS24 ] = xGetSADSse41<24>;
+    afpDistortFunc[DF_SADS48 ] = xGetSADSse41<48>;
+
+    for( Int iFunc = DF_HADS; iFunc <= DF_HADS16N; iFunc++ )
+    {
+      afpDistortFunc[iFunc] = TComRdCost::xGetHADsSse41;
+    }
+  }
+
+  // narrower blocks keep the SSE4.1 functions
+  if( eExtension >= SIMD_AVX2 )
+  {
+    afpDistortFunc[DF_SSE8   ] = xGetSSEAvx2<8>;
+    afpDistortFunc[DF_SSE16  ] = xGetSSEAvx2<16>;
+    afpDistortFunc[DF_SSE32  ] = xGetSSEAvx2<32>;
+    afpDistortFunc[DF_SSE64  ] = xGetSSEAvx2<64>;
+    afpDistortFunc[DF_SSE16N ] = xGetSSEAvx2<0>;
+
+    afpDistortFunc[DF_SAD16  ] = xGetSADAvx2<16>;
+    afpDistortFunc[DF_SAD32  ] = xGetSADAvx2<32>;
+    afpDistortFunc[DF_SAD64  ] = xGetSADAvx2<64>;
+    afpDistortFunc[DF_SAD16N ] = xGetSADAvx2<0>;
+
+    afpDistortFunc[DF_SADS16 ] = xGetSADAvx2<16>;
+    afpDistortFunc[DF_SADS32 ] = xGetSADAvx2<32>;
+    afpDistortFunc[DF_SADS64 ] = xGetSADAvx2<64>;
+    afpDistortFunc[DF_SADS16N] = xGetSADAvx2<0>;
+
+    afpDistortFunc[DF_SAD24  ] = xGetSADAvx2<24>;
+    afpDistortFunc[DF_SAD48  ] = xGetSADAvx2<48>;
+    afpDistortFunc[DF_SADS24 ] = xGetSADAvx2<24>;
+    afpDistortFunc[DF_SADS48 ] = xGetSADAvx2<48>;
+
+    for( Int iFunc = DF_HADS; iFunc <= DF_HADS16N; iFunc++ )
+    {
+      afpDistortFunc[iFunc] = TComRdCost::xGetHADsAvx2;
+    }
+  }
+}
+
+static UInt xGetTestRand( UInt& ruiSeed )
+{
+  ruiSeed = ruiSeed * 1103515245 + 12345;
+  return ( ruiSeed >> 8 );
+}
+
+/** Compare the vectorized distortion functions of all extensions supported by the CPU with the scalar ones in
+ *  m_afpDistortFunc, on random blocks of samples with bit depths 8 to 12 and on signed residuals.
+ * \returns true if all results are identical
+ */
+Bool TComRdCost::xCheckSimdDistFuncs() const
+{
+  // TComRdCost::xGetHADsic stores the original block with its stride in a MAX_CU_SIZE x MAX_CU_SIZE buffer
+  const Int iStrideOrg = MAX_CU_SIZE;
+  const Int iStrideCur = MAX_CU_SIZE + 24;
+  static Pel aOrg[ iStrideOrg * MAX_CU_SIZE ];
+  static Pel aCur[ iStrideCur * MAX_CU_SIZE ];
+  UInt uiSeed = 1;
+
+  for( Int iExtension = SIMD_SSE41; iExtension <= getSimdExtension(); iExtension++ )
+  {
+    FpDistFunc afpSimdFunc[DF_TOTAL_FUNCTIONS];
+    memcpy( afpSimdFunc, m_afpDistortFunc, sizeof( afpSimdFunc ) );
+    xSetSimdDistFuncs( afpSimdFunc, SimdExtension( iExtension ) );
+
+    for( Int iFunc = 0; iFunc < DF_TOTAL_FUNCTIONS; iFunc++ )
+    {
+      if( afpSimdFunc[iFunc] == m_afpDistortFunc[iFunc] )
+      {
+        continue;
+      }
+      const Bool bSSE = ( iFunc >= DF_SSE && iFunc <= DF_SSE16N );
+      const Bool bHAD = ( iFunc >= DF_HADS && iFunc <= DF_HADS16N );
+
+      for( Int iTest = 0; iTest < 48; iTest++ )
+      {
+        const Int  iBitDepth = 8 + 2 * ( iTest % 3 );
+        const Bool bSigned   = ( iTest % 6 ) >= 3;
+        const Int  iMaxVal   = 1 << iBitDepth;
+        for( Int i = 0; i < iStrideOrg * MAX_CU_SIZE; i++ )
+        {
+          aOrg[i] = Pel( xGetTestRand( uiSeed ) % iMaxVal - ( bSigned ? iMaxVal / 2 : 0 ) );
+        }
+        for( Int i = 0; i < iStrideCur * MAX_CU_SIZE; i++ )
+        {
+          aCur[i] = Pel( xGetTestRand( uiSeed ) % iMaxVal - ( bSigned ? iMaxVal / 2 : 0 ) );
+        }
+
+        DistParam cDtParam;
+        cDtParam.pOrg       = aOrg;
+        cDtParam.pCur       = aCur;
+        cDtParam.iStrideOrg = iStrideOrg;
+        cDtParam.iStrideCur = iStrideCur;
+        cDtParam.iStep      = 1;
+        cDtParam.bitDepth   = iBitDepth;
+        cDtParam.iRows      = 4 * ( 1 + xGetTestRand( uiSeed ) % ( MAX_CU_SIZE / 4 ) );
+        cDtParam.iSubShift  = ( bSSE || bHAD ) ? 0 : ( iTest / 6 ) % 2;
+#if NH_3D_IC
+        cDtParam.bUseIC     = !bSSE && ( iTest / 12 ) % 2;
+#endif
+#if NH_3D_SDC_INTER
+        cDtParam.bUseSDCMRSAD = false;
+#endif
+        if( bHAD )
+        {
+          // also blocks that are not a multiple of 4 wide or high
+          cDtParam.iCols    = 2 * ( 1 + xGetTestRand( uiSeed ) % ( MAX_CU_SIZE / 2 ) );
+          cDtParam.iRows    = ( iTest % 4 ) ? cDtParam.iRows : 2 * ( 1 + xGetTestRand( uiSeed ) % ( MAX_CU_SIZE / 2 ) );
+        }
+        else if( iFunc == DF_SSE16N || iFunc == DF_SAD16N || iFunc == DF_SADS16N )
+        {
+          cDtParam.iCols    = 16 * ( 1 + xGetTestRand( uiSeed ) % ( MAX_CU_SIZE / 16 ) );
+        }
+        else if( iFunc >= DF_SAD12 )
+        {
+          cDtParam.iCols    = ( iFunc == DF_SAD12 || iFunc == DF_SADS12 ) ? 12 : ( ( iFunc == DF_SAD24 || iFunc == DF_SADS24 ) ? 24 : 48 );
+        }
+        else
+        {
+          cDtParam.iCols    = 4 << ( ( iFunc - DF_SSE4 ) % ( DF_SAD4 - DF_SSE4 ) );
+        }
+
+        const Distortion uiScalar = m_afpDistortFunc[iFunc]( &cDtParam );
+        const Distortion uiSimd   = afpSimdFunc   [iFunc]( &cDtParam );
+        if( uiScalar != uiSimd )
+        {
+          printf( "\nWarning: vectorized distortion function %d (%dx%d) differs from the scalar one, the scalar functions are used\n", iFunc, cDtParam.iCols, cDtParam.iRows );
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+//! \}
+
+#endif // RDCOST_SIMD && SIMD_X86
@@ -524,7 +524,6 @@ const WedgeResolution g_dmmWedgeResolution[6] =
 const UChar g_dmm1TabIdxBits[6] =
 { //2x2   4x4   8x8 16x16 32x32 64x64
      0,    7,   10,   9,    9,   13 };
-Bool g_wedgePattern[32*32];
 extern std::vector< std::vector<TComWedgelet> >   g_dmmWedgeLists;
 extern std::vector< std::vector<TComWedgeNode> >  g_dmmWedgeNodeLists;
 #endif
@@ -792,6 +791,29 @@ Void decIndent( Bool b )
 #if NH_3D_DMM
 std::vector< std::vector<TComWedgelet>  > g_dmmWedgeLists;
 std::vector< std::vector<TComWedgeNode> > g_dmmWedgeNodeLists;
+#if NH_3D_DMM_WEDGE_LIST_INDEX
+/** Add the pattern of a wedge reference as refinement of a wedge node unless it is the pattern of the node or already one of its refinements.
+ * \returns true if the refinement was added
+ */
+static Bool addWedgeNodeRefinement( TComWedgeNode& rcWedgeNode, TComWedgeRef& rcWedgeRef, UInt& ruiRefPos )
+{
+  if( rcWedgeRef.getRefIdx() == rcWedgeNode.getPatternIdx() )
+  {
+    return false;
+  }
+  for( UInt m = 0; m < ruiRefPos; m++ )
+  {
+    if( rcWedgeRef.getRefIdx() == rcWedgeNode.getRefineIdx( m ) )
+    {
+      return false;
+    }
+  }
+  rcWedgeNode.setRefineIdx( rcWedgeRef.getRefIdx(), ruiRefPos );
+  ruiRefPos++;
+  return true;
+}
+
+#endif
 Void initWedgeLists( Bool initNodeList )
 {
   if( !g_dmmWedgeLists.empty() ) return;
@@ -806,6 +828,14 @@ Void initWedgeLists( Bool initNodeList )
     {
       // create WedgeNodeList
       std::vector<TComWedgeNode> acWedgeNodeList;
+#if NH_3D_DMM_WEDGE_LIST_INDEX
+      // positions of the wedge references of each start and end position, in list order
+      std::map< UInt, std::vector<UInt> > cRefPosMap;
+      for( UInt k = 0; k < acWedgeRefList.size(); k++ )
+      {
+        cRefPosMap[ ( acWedgeRefList[k].getStartX() << 24 ) | ( acWedgeRefList[k].getStartY() << 16 ) | ( acWedgeRefList[k].getEndX() << 8 ) | acWedgeRefList[k].getEndY() ].push_back( k );
+      }
+#endif
       for( UInt uiPos = 0; uiPos < acWedgeList.size(); uiPos++ )
       {
         if( acWedgeList[uiPos].getIsCoarse() )
@@ -832,6 +862,24 @@ Void initWedgeLists( Bool initNodeList )
               case( 5 ): { iSy += iOffS; iEy += iOffE; } break;
               default: assert( 0 );
               }
+#if NH_3D_DMM_WEDGE_LIST_INDEX
+              if( ( iSx | iSy | iEx | iEy ) & ~0xFF ) // outside the UChar positions of the references
+              {
+                continue;
+              }
+              std::map< UInt, std::vector<UInt> >::iterator itRefPos = cRefPosMap.find( ( iSx << 24 ) | ( iSy << 16 ) | ( iEx << 8 ) | iEy );
+              if( itRefPos == cRefPosMap.end() )
+              {
+                continue;
+              }
+              for( UInt n = 0; n < itRefPos->second.size(); n++ )
+              {
+                if( addWedgeNodeRefinement( cWedgeNode, acWedgeRefList[ itRefPos->second[n] ], uiRefPos ) )
+                {
+                  break;
+                }
+              }
+#else
               for( UInt k = 0; k < acWedgeRefList.size(); k++ )
               {
                 if( iSx == (Int)acWedgeRefList[k].getStartX() && 
@@ -852,6 +900,7 @@ Void initWedgeLists( Bool initNodeList )
                   }
                 }
               }
+#endif
             }
           }
           acWedgeNodeList.push_back( cWedgeNode );
@@ -872,6 +921,9 @@ Void createWedgeList( UInt uiWidth, UInt uiHeight, std::vector<TComWedgelet> &ra
   case(   HALF_PEL ): { uiBlockSize = (uiWidth<<1); break; }
   }
   TComWedgelet cTempWedgelet( uiWidth, uiHeight );
+#if NH_3D_DMM_WEDGE_LIST_INDEX
+  WedgePatternMap cPatternMap;
+#endif
   for( UInt uiOri = 0; uiOri < 6; uiOri++ )
   {
     posEnd = (Int) racWedgeList.size();
@@ -886,7 +938,11 @@ Void createWedgeList( UInt uiWidth, UInt uiHeight, std::vector<TComWedgelet> &ra
         Int xE = (uiOri == 0) ? 0 : iL;
         Int yE = (uiOri == 0) ? iL : uiBlockSize - 1;
         cTempWedgelet.setWedgelet( xS, yS, xE, yE, uiOri, eWedgeRes, ((iL%2)==0 && (iK%2)==0) );
+#if NH_3D_DMM_WEDGE_LIST_INDEX
+        addWedgeletToList( cTempWedgelet, racWedgeList, racWedgeRefList, cPatternMap );
+#else
         addWedgeletToList( cTempWedgelet, racWedgeList, racWedgeRefList );
+#endif
       }
     }
     }
@@ -895,12 +951,58 @@ Void createWedgeList( UInt uiWidth, UInt uiHeight, std::vector<TComWedgelet> &ra
       for (Int pos = posStart; pos < posEnd; pos++)
       {
         cTempWedgelet.generateWedgePatternByRotate(racWedgeList[pos], uiOri);
+#if NH_3D_DMM_WEDGE_LIST_INDEX
+        addWedgeletToList( cTempWedgelet, racWedgeList, racWedgeRefList, cPatternMap );
+#else
         addWedgeletToList( cTempWedgelet, racWedgeList, racWedgeRefList );
+#endif
       }
     }
     posStart = posEnd;
   }
 }
+#if NH_3D_DMM_WEDGE_LIST_INDEX
+/** Add a wedgelet to a list unless its pattern or the inverted pattern is already in the list, and add the reference of its start and end positions to the pattern.
+ * \param racPatternMap index of the packed patterns in racWedgeList
+ */
+Void addWedgeletToList( TComWedgelet cWedgelet, std::vector<TComWedgelet> &racWedgeList, std::vector<TComWedgeRef> &racWedgeRefList, WedgePatternMap &racPatternMap )
+{
+  if( !cWedgelet.checkNotPlain() )
+  {
+    return;
+  }
+  const UInt64* puiRows   = cWedgelet.getPackedPattern();
+  const UInt64  uiRowMask = ( UInt64( 1 ) << cWedgelet.getWidth() ) - 1;
+  std::vector<UInt64> cPattern   ( puiRows, puiRows + cWedgelet.getHeight() );
+  std::vector<UInt64> cInvPattern( cPattern );
+  for( UInt y = 0; y < cInvPattern.size(); y++ )
+  {
+    cInvPattern[y] ^= uiRowMask;
+  }
+
+  // a pattern of the list is never the inverse of another one, so at most one of them is found
+  WedgePatternMap::iterator it = racPatternMap.find( cPattern );
+  if( it == racPatternMap.end() )
+  {
+    it = racPatternMap.find( cInvPattern );
+  }
+
+  UInt uiRefIdx;
+  if( it != racPatternMap.end() )
+  {
+    uiRefIdx = it->second;
+  }
+  else
+  {
+    uiRefIdx = (UInt)racWedgeList.size();
+    racWedgeList.push_back( cWedgelet );
+    racPatternMap[ cPattern ] = uiRefIdx;
+  }
+  TComWedgeRef cWedgeRef;
+  cWedgeRef.setWedgeRef( cWedgelet.getStartX(), cWedgelet.getStartY(), cWedgelet.getEndX(), cWedgelet.getEndY(), uiRefIdx );
+  racWedgeRefList.push_back( cWedgeRef );
+}
+#else
 Void addWedgeletToList( TComWedgelet cWedgelet, std::vector<TComWedgelet> &racWedgeList, std::vector<TComWedgeRef> &racWedgeRefList )
 {
   Bool bValid = cWedgelet.checkNotPlain();
@@ -940,6 +1042,7 @@ Void addWedgeletToList( TComWedgelet cWedgelet, std::vector<TComWedgelet> &racWe
     racWedgeRefList.push_back( cWedgeRef );
   }
 }
+#endif
 WedgeList* getWedgeListScaled( UInt blkSize ) 
 { 
   return &g_dmmWedgeLists[ g_aucConvertToBit[( 16 >= blkSize ) ? blkSize : 16] ]; 
@@ -104,27 +104,48 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 TComSampleAdaptiveOffset::TComSampleAdaptiveOffset()
 {
   m_tempPicYuv = NULL;
-  m_lineBufWidth = 0;
-  m_signLineBuf1 = NULL;
-  m_signLineBuf2 = NULL;
+  m_fpEdgeOffset = xEdgeOffset;
+  m_fpBandOffset = xBandOffset;
+#if SAO_SIMD && SIMD_X86
+  // the vectorized offsets are only installed if they give the same results as the scalar ones
+  static const Bool bSimdChecked = xCheckSimdOffsets();
+  if ( bSimdChecked )
+  {
+    xSetSimdOffsets( m_fpEdgeOffset, m_fpBandOffset, getSimdExtension() );
+  }
+#endif
 }
 
 
 TComSampleAdaptiveOffset::~TComSampleAdaptiveOffset()
 {
+#if SAO_PARALLEL
+  m_cThreadPool.destroy();
+#endif
   destroy();
+}
 
-  if (m_signLineBuf1)
-  {
-    delete[] m_signLineBuf1;
-    m_signLineBuf1 = NULL;
-  }
-  if (m_signLineBuf2)
-  {
-    delete[] m_signLineBuf2;
-    m_signLineBuf2 = NULL;
-  }
+#if SAO_PARALLEL
+Void TComSampleAdaptiveOffset::createThreads( Int iNumThreads )
+{
+  m_cThreadPool.destroy();
+  m_cThreadPool.create( iNumThreads );
 }
+#endif
+
+#if SAO_SIMD && SIMD_X86
+/**
+ * \brief Use the edge and band offset functions of a SIMD extension
+ *
+ * \param eExtension  SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE selects the scalar functions
+ */
+Void TComSampleAdaptiveOffset::setSimdExtension( SimdExtension eExtension )
+{
+  m_fpEdgeOffset = xEdgeOffset;
+  m_fpBandOffset = xBandOffset;
+  xSetSimdOffsets( m_fpEdgeOffset, m_fpBandOffset, eExtension );
+}
+#endif
 
 Void TComSampleAdaptiveOffset::create( Int picWidth, Int picHeight, ChromaFormat format, UInt maxCUWidth, UInt maxCUHeight, UInt maxCUDepth, UInt lumaBitShift, UInt chromaBitShift )
 {
@@ -310,236 +331,108 @@ Void TComSampleAdaptiveOffset::reconstructBlkSAOParams(TComPic* pic, SAOBlkParam
 }
 
 
-Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeIdx, Int* offset
-                                          , Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,  Int width, Int height
-                                          , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail)
+/** Edge offset of a block. The edge class of each sample is derived directly from the signs of the differences to its
+ * two neighbours, so that the rows and columns are independent and the loops have no branches.
+ */
+Void TComSampleAdaptiveOffset::xEdgeOffset(const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height
+                                          , Int neighborA, Int neighborB, const Int* offset, Int maxSampleValueIncl)
 {
-  if(m_lineBufWidth != m_maxCUWidth)
+  offset += 2;
+  for (Int y=0; y< height; y++)
   {
-    m_lineBufWidth = m_maxCUWidth;
-
-    if (m_signLineBuf1)
+    for (Int x=0; x< width; x++)
     {
-      delete[] m_signLineBuf1;
-      m_signLineBuf1 = NULL;
+      const Int edgeType = sgn(srcBlk[x] - srcBlk[x+ neighborA]) + sgn(srcBlk[x] - srcBlk[x+ neighborB]);
+      resBlk[x] = Clip3<Int>(0, maxSampleValueIncl, srcBlk[x] + offset[edgeType]);
     }
-    m_signLineBuf1 = new SChar[m_lineBufWidth+1];
+    srcBlk += srcStride;
+    resBlk += resStride;
+  }
+}
 
-    if (m_signLineBuf2)
+Void TComSampleAdaptiveOffset::xBandOffset(const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height
+                                          , Int shiftBits, const Int* offset, Int maxSampleValueIncl)
+{
+  for (Int y=0; y< height; y++)
+  {
+    for (Int x=0; x< width; x++)
     {
-      delete[] m_signLineBuf2;
-      m_signLineBuf2 = NULL;
+      resBlk[x] = Clip3<Int>(0, maxSampleValueIncl, srcBlk[x] + offset[srcBlk[x] >> shiftBits] );
     }
-    m_signLineBuf2 = new SChar[m_lineBufWidth+1];
+    srcBlk += srcStride;
+    resBlk += resStride;
   }
+}
 
+Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeIdx, Int* offset
+                                          , Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,  Int width, Int height
+                                          , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail)
+{
   const Int maxSampleValueIncl = (1<< channelBitDepth )-1;
 
-  Int x,y, startX, startY, endX, endY, edgeType;
+  Int startX, startY, endX, endY;
   Int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
-  SChar signLeft, signRight, signDown;
-
-  Pel* srcLine = srcBlk;
-  Pel* resLine = resBlk;
 
+  // the samples of an edge offset class form up to three rectangles (first line, middle lines, last line) whose
+  // neighbours are at the same pointer offsets
   switch(typeIdx)
   {
   case SAO_TYPE_EO_0:
     {
-      offset += 2;
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
-      for (y=0; y< height; y++)
-      {
-        signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-        for (x=startX; x< endX; x++)
-        {
-          signRight = (SChar)sgn(srcLine[x] - srcLine[x+1]);
-          edgeType =  signRight + signLeft;
-          signLeft  = -signRight;
-
-          resLine[x] = Clip3<Int>(0, maxSampleValueIncl, srcLine[x] + offset[edgeType]);
-        }
-        srcLine  += srcStride;
-        resLine += resStride;
-      }
-
+      xEdgeOffsetRect(srcBlk, resBlk, srcStride, resStride, startX, 0, endX, height, -1, 1, offset, maxSampleValueIncl);
     }
     break;
   case SAO_TYPE_EO_90:
     {
-      offset += 2;
-      SChar *signUpLine = m_signLineBuf1;
-
       startY = isAboveAvail ? 0 : 1;
       endY   = isBelowAvail ? height : height-1;
-      if (!isAboveAvail)
-      {
-        srcLine += srcStride;
-        resLine += resStride;
-      }
-
-      Pel* srcLineAbove= srcLine- srcStride;
-      for (x=0; x< width; x++)
-      {
-        signUpLine[x] = (SChar)sgn(srcLine[x] - srcLineAbove[x]);
-      }
-
-      Pel* srcLineBelow;
-      for (y=startY; y<endY; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=0; x< width; x++)
-        {
-          signDown  = (SChar)sgn(srcLine[x] - srcLineBelow[x]);
-          edgeType = signDown + signUpLine[x];
-          signUpLine[x]= -signDown;
-
-          resLine[x] = Clip3<Int>(0, maxSampleValueIncl, srcLine[x] + offset[edgeType]);
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
-
+      xEdgeOffsetRect(srcBlk, resBlk, srcStride, resStride, 0, startY, width, endY, -srcStride, srcStride, offset, maxSampleValueIncl);
     }
     break;
   case SAO_TYPE_EO_135:
     {
-      offset += 2;
-      SChar *signUpLine, *signDownLine, *signTmpLine;
-
-      signUpLine  = m_signLineBuf1;
-      signDownLine= m_signLineBuf2;
-
       startX = isLeftAvail ? 0 : 1 ;
       endX   = isRightAvail ? width : (width-1);
 
-      //prepare 2nd line's upper sign
-      Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX; x< endX+1; x++)
-      {
-        signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x- 1]);
-      }
-
       //1st line
-      Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveLeftAvail ? 0 : 1;
       firstLineEndX   = isAboveAvail? endX: 1;
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        edgeType  =  sgn(srcLine[x] - srcLineAbove[x- 1]) - signUpLine[x+1];
-
-        resLine[x] = Clip3<Int>(0, maxSampleValueIncl, srcLine[x] + offset[edgeType]);
-      }
-      srcLine  += srcStride;
-      resLine  += resStride;
-
+      xEdgeOffsetRect(srcBlk, resBlk, srcStride, resStride, firstLineStartX, 0, firstLineEndX, 1, -srcStride-1, srcStride+1, offset, maxSampleValueIncl);
 
       //middle lines
-      for (y= 1; y< height-1; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=startX; x<endX; x++)
-        {
-          signDown =  (SChar)sgn(srcLine[x] - srcLineBelow[x+ 1]);
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = Clip3<Int>(0, maxSampleValueIncl, srcLine[x] + offset[edgeType]);
-
-          signDownLine[x+1] = -signDown;
-        }
-        signDownLine[startX] = (SChar)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-        signTmpLine  = signUpLine;
-        signUpLine   = signDownLine;
-        signDownLine = signTmpLine;
-
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+      xEdgeOffsetRect(srcBlk, resBlk, srcStride, resStride, startX, 1, endX, height-1, -srcStride-1, srcStride+1, offset, maxSampleValueIncl);
 
       //last line
-      srcLineBelow= srcLine+ srcStride;
       lastLineStartX = isBelowAvail ? startX : (width -1);
       lastLineEndX   = isBelowRightAvail ? width : (width -1);
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        edgeType =  sgn(srcLine[x] - srcLineBelow[x+ 1]) + signUpLine[x];
-        resLine[x] = Clip3<Int>(0, maxSampleValueIncl, srcLine[x] + offset[edgeType]);
-
-      }
+      xEdgeOffsetRect(srcBlk, resBlk, srcStride, resStride, lastLineStartX, height-1, lastLineEndX, height, -srcStride-1, srcStride+1, offset, maxSampleValueIncl);
     }
     break;
   case SAO_TYPE_EO_45:
     {
-      offset += 2;
-      SChar *signUpLine = m_signLineBuf1+1;
-
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
 
-      //prepare 2nd line upper sign
-      Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX-1; x< endX; x++)
-      {
-        signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x+1]);
-      }
-
-
       //first line
-      Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveAvail ? startX : (width -1 );
       firstLineEndX   = isAboveRightAvail ? width : (width-1);
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) -signUpLine[x-1];
-        resLine[x] = Clip3<Int>(0, maxSampleValueIncl, srcLine[x] + offset[edgeType]);
-      }
-      srcLine += srcStride;
-      resLine += resStride;
+      xEdgeOffsetRect(srcBlk, resBlk, srcStride, resStride, firstLineStartX, 0, firstLineEndX, 1, -srcStride+1, srcStride-1, offset, maxSampleValueIncl);
 
       //middle lines
-      for (y= 1; y< height-1; y++)
-      {
-        srcLineBelow= srcLine+ srcStride;
-
-        for(x= startX; x< endX; x++)
-        {
-          signDown =  (SChar)sgn(srcLine[x] - srcLineBelow[x-1]);
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = Clip3<Int>(0, maxSampleValueIncl, srcLine[x] + offset[edgeType]);
-          signUpLine[x-1] = -signDown;
-        }
-        signUpLine[endX-1] = (SChar)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-        srcLine  += srcStride;
-        resLine += resStride;
-      }
+      xEdgeOffsetRect(srcBlk, resBlk, srcStride, resStride, startX, 1, endX, height-1, -srcStride+1, srcStride-1, offset, maxSampleValueIncl);
 
       //last line
-      srcLineBelow= srcLine+ srcStride;
       lastLineStartX = isBelowLeftAvail ? 0 : 1;
       lastLineEndX   = isBelowAvail ? endX : 1;
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + signUpLine[x];
-        resLine[x] = Clip3<Int>(0, maxSampleValueIncl, srcLine[x] + offset[edgeType]);
-
-      }
+      xEdgeOffsetRect(srcBlk, resBlk, srcStride, resStride, lastLineStartX, height-1, lastLineEndX, height, -srcStride+1, srcStride-1, offset, maxSampleValueIncl);
     }
     break;
   case SAO_TYPE_BO:
     {
       const Int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
-      for (y=0; y< height; y++)
-      {
-        for (x=0; x< width; x++)
-        {
-          resLine[x] = Clip3<Int>(0, maxSampleValueIncl, srcLine[x] + offset[srcLine[x] >> shiftBits] );
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
+      m_fpBandOffset(srcBlk, resBlk, srcStride, resStride, width, height, shiftBits, offset, maxSampleValueIncl);
     }
     break;
   default:
@@ -630,11 +523,83 @@ Void TComSampleAdaptiveOffset::SAOProcess(TComPic* pDecPic)
   TComPicYuv* resYuv = pDecPic->getPicYuvRec();
   TComPicYuv* srcYuv = m_tempPicYuv;
   resYuv->copyToPic(srcYuv);
+  offsetPicture(pDecPic, srcYuv, resYuv, pDecPic->getPicSym()->getSAOBlkParam());
+}
+
+/** Apply the offsets of all CTUs of a picture.
+ * The offsets only read the samples of srcYuv and only write the samples of the CTU in resYuv, so the CTU rows are
+ * independent and are processed in parallel if threads have been created.
+ * \param pPic         picture
+ * \param srcYuv       deblocked samples
+ * \param resYuv       offset samples
+ * \param saoBlkParams reconstructed SAO parameters of the CTUs
+ */
+Void TComSampleAdaptiveOffset::offsetPicture(TComPic* pPic, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* saoBlkParams)
+{
+#if SAO_PARALLEL
+  if ( m_cThreadPool.isParallel() )
+  {
+    m_acCtuRowJobs.resize( m_numCTUInHeight );
+    for ( Int ctuRow = 0; ctuRow < m_numCTUInHeight; ctuRow++ )
+    {
+      CtuRowJob& rcJob = m_acCtuRowJobs[ctuRow];
+      rcJob.pcSAO       = this;
+      rcJob.pcPic       = pPic;
+      rcJob.pcSrcYuv    = srcYuv;
+      rcJob.pcResYuv    = resYuv;
+      rcJob.pcBlkParams = saoBlkParams;
+      rcJob.ctuRow      = ctuRow;
+      m_cThreadPool.addJob( xOffsetCtuRowJob, &rcJob );
+    }
+    m_cThreadPool.waitAll();
+    return;
+  }
+#endif
   for(Int ctuRsAddr= 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
   {
-    offsetCTU(ctuRsAddr, srcYuv, resYuv, (pDecPic->getPicSym()->getSAOBlkParam())[ctuRsAddr], pDecPic);
+    offsetCTU(ctuRsAddr, srcYuv, resYuv, saoBlkParams[ctuRsAddr], pPic);
+  } //ctu
+}
+
+#if SAO_PARALLEL
+Void TComSampleAdaptiveOffset::xOffsetCtuRowJob(Void* pParam)
+{
+  CtuRowJob*                pcJob = (CtuRowJob*)pParam;
+  TComSampleAdaptiveOffset* pcSAO = pcJob->pcSAO;
+
+  for(Int ctuRsAddr = pcJob->ctuRow*pcSAO->m_numCTUInWidth; ctuRsAddr < (pcJob->ctuRow+1)*pcSAO->m_numCTUInWidth; ctuRsAddr++)
+  {
+    pcSAO->offsetCTU(ctuRsAddr, pcJob->pcSrcYuv, pcJob->pcResYuv, pcJob->pcBlkParams[ctuRsAddr], pcJob->pcPic);
+  }
+}
+#endif
+
+#if NH_MV_LAYER_PARALLEL_DEC
+/** SAO of a CTU row, including the reconstruction of its merged SAO parameters.
+ * The row and the row below have to be deblocked. Their samples are kept in the temporary picture,
+ * where the deblocked samples of the row above have been kept by the call for that row.
+ * Processing the rows in ascending order gives the same result as reconstructBlkSAOParams() and SAOProcess().
+ * \param pDecPic picture
+ * \param ctuRow  CTU row
+ */
+Void TComSampleAdaptiveOffset::SAOProcessCtuRow(TComPic* pDecPic, Int ctuRow)
+{
+  SAOBlkParam* saoBlkParams = pDecPic->getPicSym()->getSAOBlkParam();
+  TComPicYuv*  resYuv       = pDecPic->getPicYuvRec();
+  TComPicYuv*  srcYuv       = m_tempPicYuv;
+  resYuv->copyLinesToPic(srcYuv, ctuRow*m_maxCUHeight, 2*m_maxCUHeight);
+
+  for(Int ctuRsAddr = ctuRow*m_numCTUInWidth; ctuRsAddr < (ctuRow+1)*m_numCTUInWidth; ctuRsAddr++)
+  {
+    SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES] = { NULL };
+    getMergeList(pDecPic, ctuRsAddr, saoBlkParams, mergeList);
+
+    reconstructBlkSAOParam(saoBlkParams[ctuRsAddr], mergeList);
+
+    offsetCTU(ctuRsAddr, srcYuv, resYuv, saoBlkParams[ctuRsAddr], pDecPic);
   } //ctu
 }
+#endif
 
 
 /** PCM LF disable process.
@@ -665,6 +630,26 @@ Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic)
   }
 }
 
+#if NH_MV_LAYER_PARALLEL_DEC
+/** PCM LF disable process of a CTU row.
+ * \param pcPic  picture (TComPic) pointer
+ * \param ctuRow CTU row
+ */
+Void TComSampleAdaptiveOffset::PCMLFDisableProcessCtuRow (TComPic* pcPic, Int ctuRow)
+{
+  Bool  bPCMFilter = (pcPic->getSlice(0)->getSPS()->getUsePCM() && pcPic->getSlice(0)->getSPS()->getPCMFilterDisableFlag())? true : false;
+
+  if(bPCMFilter || pcPic->getSlice(0)->getPPS()->getTransquantBypassEnableFlag())
+  {
+    const UInt frameWidthInCtus = pcPic->getFrameWidthInCtus();
+    for( UInt ctuRsAddr = ctuRow * frameWidthInCtus; ctuRsAddr < ( ctuRow + 1 ) * frameWidthInCtus; ctuRsAddr++ )
+    {
+      xPCMCURestoration(pcPic->getCtu(ctuRsAddr), 0, 0);
+    }
+  }
+}
+#endif
+
 /** PCM CU restoration.
  * \param pcCU            pointer to current CU
  * \param uiAbsZorderIdx  part index
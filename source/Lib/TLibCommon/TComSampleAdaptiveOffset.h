@@ -40,6 +40,12 @@
 
 #include "CommonDef.h"
 #include "TComPic.h"
+#if SAO_PARALLEL
+#include "TComThreadPool.h"
+#endif
+#if SAO_SIMD && SIMD_X86
+#include "TComSimd.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -51,6 +57,15 @@
 
 #define MAX_SAO_TRUNCATED_BITDEPTH     10
 
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// edge offset of a block, the edge class of a sample is given by its neighbours at the pointer offsets neighborA and neighborB, offset[edgeType+2] is added
+typedef Void (*FpSaoEdgeOffset)( const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height, Int neighborA, Int neighborB, const Int* offset, Int maxSampleValueIncl );
+/// band offset of a block, offset[src >> shiftBits] is added
+typedef Void (*FpSaoBandOffset)( const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height, Int shiftBits, const Int* offset, Int maxSampleValueIncl );
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -70,7 +85,20 @@ public:
   Void destroy();
   Void reconstructBlkSAOParams(TComPic* pic, SAOBlkParam* saoBlkParams);
   Void PCMLFDisableProcess (TComPic* pcPic);
+#if NH_MV_LAYER_PARALLEL_DEC
+  Void SAOProcessCtuRow(TComPic* pDecPic, Int ctuRow);
+  Void PCMLFDisableProcessCtuRow (TComPic* pcPic, Int ctuRow);
+#endif
   static Int getMaxOffsetQVal(const Int channelBitDepth) { return (1<<(std::min<Int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
+#if SAO_PARALLEL
+  /// apply the offsets to the CTU rows of a picture in iNumThreads threads, 1 applies them sequentially
+  Void createThreads( Int iNumThreads );
+#endif
+#if SAO_SIMD && SIMD_X86
+  Void setSimdExtension( SimdExtension eExtension ); ///< use the offset functions of an extension, SIMD_NONE for the scalar ones
+#endif
+  FpSaoEdgeOffset getEdgeOffset() const { return m_fpEdgeOffset; }
+  FpSaoBandOffset getBandOffset() const { return m_fpBandOffset; }
 
 protected:
   Void offsetBlock(const Int channelBitDepth, Int typeIdx, Int* offset, Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,  Int width, Int height
@@ -79,6 +107,24 @@ protected:
   Void reconstructBlkSAOParam(SAOBlkParam& recParam, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   Int  getMergeList(TComPic* pic, Int ctuRsAddr, SAOBlkParam* blkParams, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   Void offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam& saoblkParam, TComPic* pPic);
+  Void offsetPicture(TComPic* pPic, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* saoBlkParams);
+  /// edge offset of the samples [startX, endX) x [startY, endY) of a block, nothing for an empty range
+  Void xEdgeOffsetRect(const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int startX, Int startY, Int endX, Int endY, Int neighborA, Int neighborB, const Int* offset, Int maxSampleValueIncl)
+  {
+    if (endX > startX && endY > startY)
+    {
+      m_fpEdgeOffset(srcBlk + startY*srcStride + startX, resBlk + startY*resStride + startX, srcStride, resStride, endX - startX, endY - startY, neighborA, neighborB, offset, maxSampleValueIncl);
+    }
+  }
+#if SAO_PARALLEL
+  static Void xOffsetCtuRowJob(Void* pParam);
+#endif
+  static Void xEdgeOffset(const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height, Int neighborA, Int neighborB, const Int* offset, Int maxSampleValueIncl);
+  static Void xBandOffset(const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height, Int shiftBits, const Int* offset, Int maxSampleValueIncl);
+#if SAO_SIMD && SIMD_X86
+  static Void xSetSimdOffsets  (FpSaoEdgeOffset& fpEdgeOffset, FpSaoBandOffset& fpBandOffset, SimdExtension eExtension);
+  Bool        xCheckSimdOffsets() const;
+#endif
   Void xPCMRestoration(TComPic* pcPic);
   Void xPCMCURestoration ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth );
   Void xPCMSampleRestoration (TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, const ComponentID compID);
@@ -93,11 +139,23 @@ protected:
   Int m_numCTUInHeight;
   Int m_numCTUsPic;
 
-
-  Int m_lineBufWidth;
-  SChar* m_signLineBuf1;
-  SChar* m_signLineBuf2;
   ChromaFormat m_chromaFormatIDC;
+
+  FpSaoEdgeOffset m_fpEdgeOffset;
+  FpSaoBandOffset m_fpBandOffset;
+#if SAO_PARALLEL
+  struct CtuRowJob
+  {
+    TComSampleAdaptiveOffset* pcSAO;
+    TComPic*                  pcPic;
+    TComPicYuv*               pcSrcYuv;
+    TComPicYuv*               pcResYuv;
+    SAOBlkParam*              pcBlkParams;
+    Int                       ctuRow;
+  };
+  TComThreadPool          m_cThreadPool;
+  std::vector<CtuRowJob>  m_acCtuRowJobs;
+#endif
 private:
   Bool m_picSAOEnabled[MAX_NUM_COMPONENT];
 };
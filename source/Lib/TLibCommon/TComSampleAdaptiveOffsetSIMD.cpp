@@ -0,0 +1,356 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TComSampleAdaptiveOffsetSIMD.cpp
+    \brief    SSE4.1 and AVX2 implementations of the SAO edge and band offsets
+
+    The edge class of 8 (16) samples is the sum of the two signs, each computed from the masks of two comparisons,
+    and the offsets of the classes or of 8 bands are looked up with a byte shuffle. Rows which are not a multiple of
+    the vector width are finished with an overlapping last vector, which writes the same results again; rows shorter
+    than a vector are offset with the scalar code.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "TComSampleAdaptiveOffset.h"
+
+#if SAO_SIMD && SIMD_X86
+
+#include <immintrin.h>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Helpers
+// ====================================================================================================================
+
+/// edge offset of the samples [0, width) of a row with the scalar code, offset points to the offset of edge class 0
+static inline Void xEdgeOffsetRow( const Pel* src, Pel* res, Int width, Int neighborA, Int neighborB, const Int* offset, Int maxSampleValueIncl )
+{
+  for ( Int x = 0; x < width; x++ )
+  {
+    const Int edgeType = sgn( src[x] - src[x + neighborA] ) + sgn( src[x] - src[x + neighborB] );
+    res[x] = Clip3<Int>( 0, maxSampleValueIncl, src[x] + offset[edgeType] );
+  }
+}
+
+/// 16 bit shuffle control selecting the 16 bit entry idx (0..7) of a table: bytes 2 * idx and 2 * idx + 1
+static inline SIMD_TARGET_SSE41 __m128i xShuffleCtrlSse41( __m128i vIdx )
+{
+  return _mm_add_epi16( _mm_mullo_epi16( vIdx, _mm_set1_epi16( 0x0202 ) ), _mm_set1_epi16( 0x0100 ) );
+}
+
+static inline SIMD_TARGET_AVX2 __m256i xShuffleCtrlAvx2( __m256i vIdx )
+{
+  return _mm256_add_epi16( _mm256_mullo_epi16( vIdx, _mm256_set1_epi16( 0x0202 ) ), _mm256_set1_epi16( 0x0100 ) );
+}
+
+/// edge class + 2 (0..4) of the samples vCur, sgn( cur - n ) is ( n > cur ) - ( cur > n ) with the masks of the comparisons
+static inline SIMD_TARGET_SSE41 __m128i xEdgeIdxSse41( __m128i vCur, const Pel* neighborA, const Pel* neighborB )
+{
+  const __m128i vA = _mm_loadu_si128( (const __m128i*)neighborA );
+  const __m128i vB = _mm_loadu_si128( (const __m128i*)neighborB );
+  const __m128i vSignA = _mm_sub_epi16( _mm_cmpgt_epi16( vA, vCur ), _mm_cmpgt_epi16( vCur, vA ) );
+  const __m128i vSignB = _mm_sub_epi16( _mm_cmpgt_epi16( vB, vCur ), _mm_cmpgt_epi16( vCur, vB ) );
+  return _mm_add_epi16( _mm_add_epi16( vSignA, vSignB ), _mm_set1_epi16( 2 ) );
+}
+
+static inline SIMD_TARGET_AVX2 __m256i xEdgeIdxAvx2( __m256i vCur, const Pel* neighborA, const Pel* neighborB )
+{
+  const __m256i vA = _mm256_loadu_si256( (const __m256i*)neighborA );
+  const __m256i vB = _mm256_loadu_si256( (const __m256i*)neighborB );
+  const __m256i vSignA = _mm256_sub_epi16( _mm256_cmpgt_epi16( vA, vCur ), _mm256_cmpgt_epi16( vCur, vA ) );
+  const __m256i vSignB = _mm256_sub_epi16( _mm256_cmpgt_epi16( vB, vCur ), _mm256_cmpgt_epi16( vCur, vB ) );
+  return _mm256_add_epi16( _mm256_add_epi16( vSignA, vSignB ), _mm256_set1_epi16( 2 ) );
+}
+
+// ====================================================================================================================
+// Edge offset
+// ====================================================================================================================
+
+/// counterpart of TComSampleAdaptiveOffset::xEdgeOffset(), srcBlk and resBlk must not overlap
+static SIMD_TARGET_SSE41 Void xEdgeOffsetSse41( const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height, Int neighborA, Int neighborB, const Int* offset, Int maxSampleValueIncl )
+{
+  if ( width < 8 )
+  {
+    for ( Int y = 0; y < height; y++, srcBlk += srcStride, resBlk += resStride )
+    {
+      xEdgeOffsetRow( srcBlk, resBlk, width, neighborA, neighborB, offset + 2, maxSampleValueIncl );
+    }
+    return;
+  }
+
+  const __m128i vTable = _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 );
+  const __m128i vMax   = _mm_set1_epi16( maxSampleValueIncl );
+  const __m128i vZero  = _mm_setzero_si128();
+
+  for ( Int y = 0; y < height; y++ )
+  {
+    for ( Int x = 0; x < width; x += 8 )
+    {
+      const Int     xv   = std::min( x, width - 8 );
+      const __m128i vCur = _mm_loadu_si128( (const __m128i*)( srcBlk + xv ) );
+      const __m128i vIdx = xEdgeIdxSse41( vCur, srcBlk + xv + neighborA, srcBlk + xv + neighborB );
+      const __m128i vOff = _mm_shuffle_epi8( vTable, xShuffleCtrlSse41( vIdx ) );
+      _mm_storeu_si128( (__m128i*)( resBlk + xv ), _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( vCur, vOff ), vZero ), vMax ) );
+    }
+    srcBlk += srcStride;
+    resBlk += resStride;
+  }
+}
+
+static SIMD_TARGET_AVX2 Void xEdgeOffsetAvx2( const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height, Int neighborA, Int neighborB, const Int* offset, Int maxSampleValueIncl )
+{
+  if ( width < 16 )
+  {
+    xEdgeOffsetSse41( srcBlk, resBlk, srcStride, resStride, width, height, neighborA, neighborB, offset, maxSampleValueIncl );
+    return;
+  }
+
+  // the shuffle works within the 128 bit lanes, so both lanes hold the table
+  const __m256i vTable = _mm256_broadcastsi128_si256( _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 ) );
+  const __m256i vMax   = _mm256_set1_epi16( maxSampleValueIncl );
+  const __m256i vZero  = _mm256_setzero_si256();
+
+  for ( Int y = 0; y < height; y++ )
+  {
+    for ( Int x = 0; x < width; x += 16 )
+    {
+      const Int     xv   = std::min( x, width - 16 );
+      const __m256i vCur = _mm256_loadu_si256( (const __m256i*)( srcBlk + xv ) );
+      const __m256i vIdx = xEdgeIdxAvx2( vCur, srcBlk + xv + neighborA, srcBlk + xv + neighborB );
+      const __m256i vOff = _mm256_shuffle_epi8( vTable, xShuffleCtrlAvx2( vIdx ) );
+      _mm256_storeu_si256( (__m256i*)( resBlk + xv ), _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( vCur, vOff ), vZero ), vMax ) );
+    }
+    srcBlk += srcStride;
+    resBlk += resStride;
+  }
+}
+
+// ====================================================================================================================
+// Band offset
+// ====================================================================================================================
+
+/**
+ * counterpart of TComSampleAdaptiveOffset::xBandOffset(), srcBlk and resBlk must not overlap
+ *
+ * The 32 band offsets are held in 4 tables of 8, the low 3 bits of the band select the entry and the high 2 bits
+ * the table.
+ */
+static SIMD_TARGET_SSE41 Void xBandOffsetSse41( const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height, Int shiftBits, const Int* offset, Int maxSampleValueIncl )
+{
+  if ( width < 8 )
+  {
+    for ( Int y = 0; y < height; y++, srcBlk += srcStride, resBlk += resStride )
+    {
+      for ( Int x = 0; x < width; x++ )
+      {
+        resBlk[x] = Clip3<Int>( 0, maxSampleValueIncl, srcBlk[x] + offset[srcBlk[x] >> shiftBits] );
+      }
+    }
+    return;
+  }
+
+  __m128i vTable[NUM_SAO_BO_CLASSES / 8];
+  for ( Int i = 0; i < NUM_SAO_BO_CLASSES / 8; i++ )
+  {
+    const Int* tab = offset + 8 * i;
+    vTable[i] = _mm_setr_epi16( tab[0], tab[1], tab[2], tab[3], tab[4], tab[5], tab[6], tab[7] );
+  }
+  const __m128i vShift = _mm_cvtsi32_si128( shiftBits );
+  const __m128i vSeven = _mm_set1_epi16( 7 );
+  const __m128i vMax   = _mm_set1_epi16( maxSampleValueIncl );
+  const __m128i vZero  = _mm_setzero_si128();
+
+  for ( Int y = 0; y < height; y++ )
+  {
+    for ( Int x = 0; x < width; x += 8 )
+    {
+      const Int     xv    = std::min( x, width - 8 );
+      const __m128i vCur  = _mm_loadu_si128( (const __m128i*)( srcBlk + xv ) );
+      const __m128i vBand = _mm_srl_epi16( vCur, vShift );
+      const __m128i vCtrl = xShuffleCtrlSse41( _mm_and_si128( vBand, vSeven ) );
+      const __m128i vHigh = _mm_srli_epi16( vBand, 3 );
+      __m128i       vOff  = _mm_shuffle_epi8( vTable[0], vCtrl );
+      vOff = _mm_blendv_epi8( vOff, _mm_shuffle_epi8( vTable[1], vCtrl ), _mm_cmpeq_epi16( vHigh, _mm_set1_epi16( 1 ) ) );
+      vOff = _mm_blendv_epi8( vOff, _mm_shuffle_epi8( vTable[2], vCtrl ), _mm_cmpeq_epi16( vHigh, _mm_set1_epi16( 2 ) ) );
+      vOff = _mm_blendv_epi8( vOff, _mm_shuffle_epi8( vTable[3], vCtrl ), _mm_cmpeq_epi16( vHigh, _mm_set1_epi16( 3 ) ) );
+      _mm_storeu_si128( (__m128i*)( resBlk + xv ), _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( vCur, vOff ), vZero ), vMax ) );
+    }
+    srcBlk += srcStride;
+    resBlk += resStride;
+  }
+}
+
+static SIMD_TARGET_AVX2 Void xBandOffsetAvx2( const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height, Int shiftBits, const Int* offset, Int maxSampleValueIncl )
+{
+  if ( width < 16 )
+  {
+    xBandOffsetSse41( srcBlk, resBlk, srcStride, resStride, width, height, shiftBits, offset, maxSampleValueIncl );
+    return;
+  }
+
+  __m256i vTable[NUM_SAO_BO_CLASSES / 8];
+  for ( Int i = 0; i < NUM_SAO_BO_CLASSES / 8; i++ )
+  {
+    const Int* tab = offset + 8 * i;
+    vTable[i] = _mm256_broadcastsi128_si256( _mm_setr_epi16( tab[0], tab[1], tab[2], tab[3], tab[4], tab[5], tab[6], tab[7] ) );
+  }
+  const __m128i vShift = _mm_cvtsi32_si128( shiftBits );
+  const __m256i vSeven = _mm256_set1_epi16( 7 );
+  const __m256i vMax   = _mm256_set1_epi16( maxSampleValueIncl );
+  const __m256i vZero  = _mm256_setzero_si256();
+
+  for ( Int y = 0; y < height; y++ )
+  {
+    for ( Int x = 0; x < width; x += 16 )
+    {
+      const Int     xv    = std::min( x, width - 16 );
+      const __m256i vCur  = _mm256_loadu_si256( (const __m256i*)( srcBlk + xv ) );
+      const __m256i vBand = _mm256_srl_epi16( vCur, vShift );
+      const __m256i vCtrl = xShuffleCtrlAvx2( _mm256_and_si256( vBand, vSeven ) );
+      const __m256i vHigh = _mm256_srli_epi16( vBand, 3 );
+      __m256i       vOff  = _mm256_shuffle_epi8( vTable[0], vCtrl );
+      vOff = _mm256_blendv_epi8( vOff, _mm256_shuffle_epi8( vTable[1], vCtrl ), _mm256_cmpeq_epi16( vHigh, _mm256_set1_epi16( 1 ) ) );
+      vOff = _mm256_blendv_epi8( vOff, _mm256_shuffle_epi8( vTable[2], vCtrl ), _mm256_cmpeq_epi16( vHigh, _mm256_set1_epi16( 2 ) ) );
+      vOff = _mm256_blendv_epi8( vOff, _mm256_shuffle_epi8( vTable[3], vCtrl ), _mm256_cmpeq_epi16( vHigh, _mm256_set1_epi16( 3 ) ) );
+      _mm256_storeu_si256( (__m256i*)( resBlk + xv ), _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( vCur, vOff ), vZero ), vMax ) );
+    }
+    srcBlk += srcStride;
+    resBlk += resStride;
+  }
+}
+
+// ====================================================================================================================
+// Selection and test
+// ====================================================================================================================
+
+/**
+ * \brief Select the offset functions of a SIMD extension
+ *
+ * \param fpEdgeOffset  edge offset function, kept for SIMD_NONE
+ * \param fpBandOffset  band offset function, kept for SIMD_NONE
+ * \param eExtension    SIMD extension, at most the one returned by getSimdExtension()
+ */
+Void TComSampleAdaptiveOffset::xSetSimdOffsets( FpSaoEdgeOffset& fpEdgeOffset, FpSaoBandOffset& fpBandOffset, SimdExtension eExtension )
+{
+  if ( eExtension >= SIMD_AVX2 )
+  {
+    fpEdgeOffset = xEdgeOffsetAvx2;
+    fpBandOffset = xBandOffsetAvx2;
+  }
+  else if ( eExtension >= SIMD_SSE41 )
+  {
+    fpEdgeOffset = xEdgeOffsetSse41;
+    fpBandOffset = xBandOffsetSse41;
+  }
+}
+
+static UInt xGetTestRand(UInt& ruiSeed)
+{
+  ruiSeed = ruiSeed * 1103515245 + 12345;
+  return ( ruiSeed >> 8 );
+}
+
+/**
+ * \brief Compare the vectorized offsets of all extensions supported by the CPU with the scalar ones
+ *
+ * The blocks have random sizes, offsets and samples around a random level, and the neighbours of all four edge
+ * offset directions. Returns true if all offset samples are identical.
+ */
+Bool TComSampleAdaptiveOffset::xCheckSimdOffsets() const
+{
+  const Int stride = MAX_CU_SIZE + 16;
+  const Int margin = stride + 8;
+  const Int size   = stride * ( MAX_CU_SIZE + 2 );
+  static Pel src   [ size ];
+  static Pel resRef[ size ];
+  static Pel resVec[ size ];
+  UInt seed = 1;
+
+  for ( Int extension = SIMD_SSE41; extension <= getSimdExtension(); extension++ )
+  {
+    FpSaoEdgeOffset fpEdgeOffset = xEdgeOffset;
+    FpSaoBandOffset fpBandOffset = xBandOffset;
+    xSetSimdOffsets( fpEdgeOffset, fpBandOffset, SimdExtension( extension ) );
+
+    for ( Int test = 0; test < 512; test++ )
+    {
+      const Int  bitDepth  = ( test & 1 ) ? 10 : 8;
+      const Bool isBand    = ( test & 2 ) != 0;
+      const Int  width     = 1 + xGetTestRand( seed ) % MAX_CU_SIZE;
+      const Int  height    = 1 + xGetTestRand( seed ) % 8;
+      const Int  maxVal    = ( 1 << bitDepth ) - 1;
+      const Int  level     = xGetTestRand( seed ) % ( 1 << bitDepth );
+      const Int  range     = 1 + xGetTestRand( seed ) % ( ( test & 4 ) ? ( 1 << bitDepth ) : 8 );
+      const Int  neighbors[4][2] = { { -1, 1 }, { -stride, stride }, { -stride - 1, stride + 1 }, { -stride + 1, stride - 1 } };
+      const Int* neighbor  = neighbors[( test >> 3 ) & 3];
+      Int        offset[NUM_SAO_BO_CLASSES];
+
+      for ( Int i = 0; i < NUM_SAO_BO_CLASSES; i++ )
+      {
+        offset[i] = Int( xGetTestRand( seed ) % 63 ) - 31;
+      }
+      for ( Int i = 0; i < size; i++ )
+      {
+        src[i] = Pel( Clip3<Int>( 0, maxVal, level + Int( xGetTestRand( seed ) % range ) - range / 2 ) );
+        resRef[i] = resVec[i] = 0;
+      }
+
+      if ( isBand )
+      {
+        xBandOffset ( src + margin, resRef + margin, stride, stride, width, height, bitDepth - NUM_SAO_BO_CLASSES_LOG2, offset, maxVal );
+        fpBandOffset( src + margin, resVec + margin, stride, stride, width, height, bitDepth - NUM_SAO_BO_CLASSES_LOG2, offset, maxVal );
+      }
+      else
+      {
+        xEdgeOffset ( src + margin, resRef + margin, stride, stride, width, height, neighbor[0], neighbor[1], offset, maxVal );
+        fpEdgeOffset( src + margin, resVec + margin, stride, stride, width, height, neighbor[0], neighbor[1], offset, maxVal );
+      }
+
+      if ( memcmp( resRef, resVec, sizeof( resRef ) ) )
+      {
+        printf( "\nWarning: vectorized SAO %s offset differs from the scalar one (%dx%d), the scalar offsets are used\n", isBand ? "band" : "edge", width, height );
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+//! \}
+
+#endif // SAO_SIMD && SIMD_X86
@@ -0,0 +1,129 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.cpp
+    \brief    run time detection of the x86 SIMD extensions
+*/
+
+#include "TComSimd.h"
+
+#if SIMD_X86
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Local functions
+// ====================================================================================================================
+
+static Void xGetCpuid( UInt auiRegs[4], UInt uiLeaf )
+{
+#if defined(_MSC_VER)
+  Int aiRegs[4];
+  __cpuidex( aiRegs, uiLeaf, 0 );
+  for( Int i = 0; i < 4; i++ )
+  {
+    auiRegs[i] = (UInt)aiRegs[i];
+  }
+#else
+  auiRegs[0] = auiRegs[1] = auiRegs[2] = auiRegs[3] = 0;
+  if( uiLeaf <= __get_cpuid_max( 0, NULL ) )
+  {
+    __cpuid_count( uiLeaf, 0, auiRegs[0], auiRegs[1], auiRegs[2], auiRegs[3] );
+  }
+#endif
+}
+
+/// register state enabled by the operating system (XCR0), requires OSXSAVE
+static UInt64 xGetXcr0()
+{
+#if defined(_MSC_VER)
+  return _xgetbv( 0 );
+#else
+  UInt uiEax, uiEdx;
+  __asm__ __volatile__( "xgetbv" : "=a"( uiEax ), "=d"( uiEdx ) : "c"( 0 ) );
+  return ( (UInt64)uiEdx << 32 ) | uiEax;
+#endif
+}
+
+static SimdExtension xDetectSimdExtension()
+{
+  UInt auiRegs[4];
+
+  xGetCpuid( auiRegs, 0 );
+  const UInt uiMaxLeaf = auiRegs[0];
+  if( uiMaxLeaf < 1 )
+  {
+    return SIMD_NONE;
+  }
+
+  xGetCpuid( auiRegs, 1 );
+  const Bool bSse41   = ( auiRegs[2] >> 19 ) & 1;
+  const Bool bOsxsave = ( auiRegs[2] >> 27 ) & 1;
+  const Bool bAvx     = ( auiRegs[2] >> 28 ) & 1;
+  if( !bSse41 )
+  {
+    return SIMD_NONE;
+  }
+
+  // AVX2 also requires the operating system to save the YMM registers
+  if( uiMaxLeaf >= 7 && bOsxsave && bAvx && ( xGetXcr0() & 0x6 ) == 0x6 )
+  {
+    xGetCpuid( auiRegs, 7 );
+    if( ( auiRegs[1] >> 5 ) & 1 )
+    {
+      return SIMD_AVX2;
+    }
+  }
+  return SIMD_SSE41;
+}
+
+// ====================================================================================================================
+// Public functions
+// ====================================================================================================================
+
+SimdExtension getSimdExtension()
+{
+  static const SimdExtension eExtension = xDetectSimdExtension();
+  return eExtension;
+}
+
+//! \}
+
+#endif // SIMD_X86
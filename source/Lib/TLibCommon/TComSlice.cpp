@@ -3719,7 +3719,12 @@ Void TComSlice::setARPStepNum( TComPicLists*ivPicLists )
       Bool bIsDepth = ( getVPS()->getDepthId  ( iLayerId ) == 1 );
       if( iViewIdx<getViewIndex() && !bIsDepth )
       {
+#if NH_MV_LAYER_PARALLEL_DEC
+        m_baseViewRefPicListCopy[ iViewIdx ] = *ivPicLists->getSubDpb( iLayerId, false );
+        setBaseViewRefPicList( &m_baseViewRefPicListCopy[ iViewIdx ], iViewIdx );
+#else
         setBaseViewRefPicList( ivPicLists->getSubDpb( iLayerId, false ), iViewIdx );
+#endif
       }
     }
   }
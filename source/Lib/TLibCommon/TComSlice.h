@@ -2736,6 +2736,9 @@ private:
 #if NH_3D_ARP
   Bool       m_arpRefPicAvailable[2][MAX_NUM_LAYERS];
   TComList<TComPic*> * m_pBaseViewRefPicList[MAX_NUM_LAYERS];
+#if NH_MV_LAYER_PARALLEL_DEC
+  TComList<TComPic*>   m_baseViewRefPicListCopy[MAX_NUM_LAYERS];  ///< sub-DPB lists as of the slice set-up, the sub-DPBs may change while the slice is decoded in another thread
+#endif
   UInt        m_nARPStepNum; 
   Int         m_aiFirstTRefIdx    [2];   
 #endif
@@ -0,0 +1,183 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.cpp
+    \brief    worker thread pool and progress counter
+*/
+
+#include "TComThreadPool.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// TComProgress
+// ====================================================================================================================
+
+Void TComProgress::reset( Int iValue )
+{
+  std::lock_guard<std::mutex> cLock( m_cMutex );
+  m_iValue = iValue;
+}
+
+Void TComProgress::set( Int iValue )
+{
+  {
+    std::lock_guard<std::mutex> cLock( m_cMutex );
+    if( iValue <= m_iValue )
+    {
+      return;
+    }
+    m_iValue = iValue;
+  }
+  m_cCond.notify_all();
+}
+
+Int TComProgress::get()
+{
+  std::lock_guard<std::mutex> cLock( m_cMutex );
+  return m_iValue;
+}
+
+Void TComProgress::waitFor( Int iValue )
+{
+  std::unique_lock<std::mutex> cLock( m_cMutex );
+  while( m_iValue < iValue )
+  {
+    m_cCond.wait( cLock );
+  }
+}
+
+// ====================================================================================================================
+// TComThreadPool
+// ====================================================================================================================
+
+TComThreadPool::TComThreadPool()
+: m_iNumPending( 0 )
+, m_bStop      ( false )
+{
+}
+
+TComThreadPool::~TComThreadPool()
+{
+  destroy();
+}
+
+Void TComThreadPool::create( Int iNumThreads )
+{
+  assert( m_acThreads.empty() );
+  m_bStop = false;
+  if( iNumThreads <= 1 )
+  {
+    return;
+  }
+  for( Int i = 0; i < iNumThreads; i++ )
+  {
+    m_acThreads.push_back( std::thread( xThreadMain, this ) );
+  }
+}
+
+Void TComThreadPool::destroy()
+{
+  if( m_acThreads.empty() )
+  {
+    return;
+  }
+  waitAll();
+  {
+    std::lock_guard<std::mutex> cLock( m_cMutex );
+    m_bStop = true;
+  }
+  m_cJobCond.notify_all();
+  for( UInt i = 0; i < m_acThreads.size(); i++ )
+  {
+    m_acThreads[i].join();
+  }
+  m_acThreads.clear();
+}
+
+Void TComThreadPool::addJob( FpJobFunc pfFunc, Void* pParam )
+{
+  if( m_acThreads.empty() )
+  {
+    pfFunc( pParam );
+    return;
+  }
+  Job cJob;
+  cJob.pfFunc = pfFunc;
+  cJob.pParam = pParam;
+  {
+    std::lock_guard<std::mutex> cLock( m_cMutex );
+    m_cJobs.push_back( cJob );
+    m_iNumPending++;
+  }
+  m_cJobCond.notify_one();
+}
+
+Void TComThreadPool::waitAll()
+{
+  std::unique_lock<std::mutex> cLock( m_cMutex );
+  while( m_iNumPending > 0 )
+  {
+    m_cDoneCond.wait( cLock );
+  }
+}
+
+Void TComThreadPool::xThreadMain( TComThreadPool* pcPool )
+{
+  std::unique_lock<std::mutex> cLock( pcPool->m_cMutex );
+  while( true )
+  {
+    while( pcPool->m_cJobs.empty() && !pcPool->m_bStop )
+    {
+      pcPool->m_cJobCond.wait( cLock );
+    }
+    if( pcPool->m_cJobs.empty() )
+    {
+      return;
+    }
+    Job cJob = pcPool->m_cJobs.front();
+    pcPool->m_cJobs.pop_front();
+
+    cLock.unlock();
+    cJob.pfFunc( cJob.pParam );
+    cLock.lock();
+
+    if( --pcPool->m_iNumPending == 0 )
+    {
+      pcPool->m_cDoneCond.notify_all();
+    }
+  }
+}
+
+//! \}
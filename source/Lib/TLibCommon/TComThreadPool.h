@@ -0,0 +1,117 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.h
+    \brief    worker thread pool and progress counter (header)
+*/
+
+#ifndef __TCOMTHREADPOOL__
+#define __TCOMTHREADPOOL__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "CommonDef.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// job function, called with the parameter passed to TComThreadPool::addJob()
+typedef Void (*FpJobFunc) ( Void* pParam );
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// monotonically increasing counter used to signal progress between threads (e.g. coded layers, CTU rows)
+class TComProgress
+{
+private:
+  Int                     m_iValue;
+  std::mutex              m_cMutex;
+  std::condition_variable m_cCond;
+
+public:
+  TComProgress() : m_iValue( 0 ) {}
+
+  Void reset  ( Int iValue = 0 );                 ///< set counter to iValue, must not be called while threads wait on it
+  Void set    ( Int iValue );                     ///< raise counter to iValue (never lowers it) and wake up waiting threads
+  Int  get    ();                                 ///< get current value
+  Void waitFor( Int iValue );                     ///< block until counter is at least iValue
+};
+
+/// pool of worker threads processing jobs in FIFO order
+class TComThreadPool
+{
+private:
+  struct Job
+  {
+    FpJobFunc pfFunc;
+    Void*     pParam;
+  };
+
+  std::vector<std::thread> m_acThreads;
+  std::deque<Job>          m_cJobs;
+  Int                      m_iNumPending;         ///< number of queued or running jobs
+  Bool                     m_bStop;
+  std::mutex               m_cMutex;
+  std::condition_variable  m_cJobCond;
+  std::condition_variable  m_cDoneCond;
+
+  static Void xThreadMain( TComThreadPool* pcPool );
+
+public:
+  TComThreadPool();
+  virtual ~TComThreadPool();
+
+  Void create         ( Int iNumThreads );        ///< start threads, for iNumThreads <= 1 jobs are executed by addJob() itself
+  Void destroy        ();                         ///< finish all jobs and join threads
+  Void addJob         ( FpJobFunc pfFunc, Void* pParam );
+  Void waitAll        ();                         ///< block until all added jobs are finished
+  Int  getNumThreads  ()  { return (Int)m_acThreads.size(); }
+  Bool isParallel     ()  { return !m_acThreads.empty(); }
+};
+
+//! \}
+
+#endif // __TCOMTHREADPOOL__
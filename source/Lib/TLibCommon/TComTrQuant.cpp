@@ -131,6 +131,16 @@ TComTrQuant::TComTrQuant()
   // allocate bit estimation class  (for RDOQ)
   m_pcEstBitsSbac = new estBitsSbacStruct;
   initScalingList();
+
+  xInitPartialButterflies();
+#if TRANSFORM_SIMD && SIMD_X86
+  // the vectorized partial butterflies are only installed if they give the same results as the scalar ones
+  static const Bool bSimdChecked = xCheckSimdPartialButterflies();
+  if ( bSimdChecked )
+  {
+    xSetSimdPartialButterflies( m_afpPartialButterfly, m_afpPartialButterflyInverse, getSimdExtension() );
+  }
+#endif
 }
 
 TComTrQuant::~TComTrQuant()
@@ -847,6 +857,33 @@ Void partialButterflyInverse32(TCoeff *src, TCoeff *dst, Int shift, Int line, co
   }
 }
 
+/// fill the dispatch tables of the partial butterflies with the scalar functions
+Void TComTrQuant::xInitPartialButterflies()
+{
+  m_afpPartialButterfly[0] = partialButterfly4;
+  m_afpPartialButterfly[1] = partialButterfly8;
+  m_afpPartialButterfly[2] = partialButterfly16;
+  m_afpPartialButterfly[3] = partialButterfly32;
+
+  m_afpPartialButterflyInverse[0] = partialButterflyInverse4;
+  m_afpPartialButterflyInverse[1] = partialButterflyInverse8;
+  m_afpPartialButterflyInverse[2] = partialButterflyInverse16;
+  m_afpPartialButterflyInverse[3] = partialButterflyInverse32;
+}
+
+#if TRANSFORM_SIMD && SIMD_X86
+/**
+ * \brief Use the partial butterflies of a SIMD extension
+ *
+ * \param eExtension  SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE selects the scalar functions
+ */
+Void TComTrQuant::setSimdExtension( SimdExtension eExtension )
+{
+  xInitPartialButterflies();
+  xSetSimdPartialButterflies( m_afpPartialButterfly, m_afpPartialButterflyInverse, eExtension );
+}
+#endif
+
 /** MxN forward transform (2D)
 *  \param bitDepth              [in]  bit depth
 *  \param block                 [in]  residual block
@@ -855,9 +892,10 @@ Void partialButterflyInverse32(TCoeff *src, TCoeff *dst, Int shift, Int line, co
 *  \param iHeight               [in]  height of transform
 *  \param useDST                [in]
 *  \param maxLog2TrDynamicRange [in]
+*  \param afpPartialButterfly   [in]  forward partial butterflies, indexed by log2(size) - 2
 
 */
-Void xTrMxN(Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange)
+Void xTrMxN(Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange, const FpPartialButterfly *afpPartialButterfly)
 {
   const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_FORWARD];
 
@@ -879,14 +917,14 @@ Void xTrMxN(Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight,
         }
         else
         {
-          partialButterfly4 ( block, tmp, shift_1st, iHeight );
+          afpPartialButterfly[0]( block, tmp, shift_1st, iHeight );
         }
       }
       break;
 
-    case 8:     partialButterfly8 ( block, tmp, shift_1st, iHeight );  break;
-    case 16:    partialButterfly16( block, tmp, shift_1st, iHeight );  break;
-    case 32:    partialButterfly32( block, tmp, shift_1st, iHeight );  break;
+    case 8:     afpPartialButterfly[1]( block, tmp, shift_1st, iHeight );  break;
+    case 16:    afpPartialButterfly[2]( block, tmp, shift_1st, iHeight );  break;
+    case 32:    afpPartialButterfly[3]( block, tmp, shift_1st, iHeight );  break;
     default:
       assert(0); exit (1); break;
   }
@@ -901,14 +939,14 @@ Void xTrMxN(Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight,
         }
         else
         {
-          partialButterfly4 ( tmp, coeff, shift_2nd, iWidth );
+          afpPartialButterfly[0]( tmp, coeff, shift_2nd, iWidth );
         }
       }
       break;
 
-    case 8:     partialButterfly8 ( tmp, coeff, shift_2nd, iWidth );    break;
-    case 16:    partialButterfly16( tmp, coeff, shift_2nd, iWidth );    break;
-    case 32:    partialButterfly32( tmp, coeff, shift_2nd, iWidth );    break;
+    case 8:     afpPartialButterfly[1]( tmp, coeff, shift_2nd, iWidth );    break;
+    case 16:    afpPartialButterfly[2]( tmp, coeff, shift_2nd, iWidth );    break;
+    case 32:    afpPartialButterfly[3]( tmp, coeff, shift_2nd, iWidth );    break;
     default:
       assert(0); exit (1); break;
   }
@@ -923,8 +961,9 @@ Void xTrMxN(Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight,
 *  \param iHeight               [in]  height of transform
 *  \param useDST                [in]
 *  \param maxLog2TrDynamicRange [in]
+*  \param afpPartialButterflyInverse [in] inverse partial butterflies, indexed by log2(size) - 2
 */
-Void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange)
+Void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange, const FpPartialButterflyInverse *afpPartialButterflyInverse)
 {
   const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_INVERSE];
 
@@ -948,14 +987,14 @@ Void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight
         }
         else
         {
-          partialButterflyInverse4 ( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum);
+          afpPartialButterflyInverse[0]( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum);
         }
       }
       break;
 
-    case  8: partialButterflyInverse8 ( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum); break;
-    case 16: partialButterflyInverse16( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum); break;
-    case 32: partialButterflyInverse32( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum); break;
+    case  8: afpPartialButterflyInverse[1]( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum); break;
+    case 16: afpPartialButterflyInverse[2]( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum); break;
+    case 32: afpPartialButterflyInverse[3]( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum); break;
 
     default:
       assert(0); exit (1); break;
@@ -972,14 +1011,14 @@ Void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight
         }
         else
         {
-          partialButterflyInverse4 ( tmp, block, shift_2nd, iHeight, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max());
+          afpPartialButterflyInverse[0]( tmp, block, shift_2nd, iHeight, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max());
         }
       }
       break;
 
-    case  8: partialButterflyInverse8 ( tmp, block, shift_2nd, iHeight, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max()); break;
-    case 16: partialButterflyInverse16( tmp, block, shift_2nd, iHeight, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max()); break;
-    case 32: partialButterflyInverse32( tmp, block, shift_2nd, iHeight, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max()); break;
+    case  8: afpPartialButterflyInverse[1]( tmp, block, shift_2nd, iHeight, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max()); break;
+    case 16: afpPartialButterflyInverse[2]( tmp, block, shift_2nd, iHeight, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max()); break;
+    case 32: afpPartialButterflyInverse[3]( tmp, block, shift_2nd, iHeight, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max()); break;
 
     default:
       assert(0); exit (1); break;
@@ -1970,7 +2009,7 @@ Void TComTrQuant::xT( const Int channelBitDepth, Bool useDST, Pel* piBlkResi, UI
     }
   }
 
-  xTrMxN( channelBitDepth, block, coeff, iWidth, iHeight, useDST, maxLog2TrDynamicRange );
+  xTrMxN( channelBitDepth, block, coeff, iWidth, iHeight, useDST, maxLog2TrDynamicRange, m_afpPartialButterfly );
 
   memcpy(psCoeff, coeff, (iWidth * iHeight * sizeof(TCoeff)));
 }
@@ -2000,7 +2039,7 @@ Void TComTrQuant::xIT( const Int channelBitDepth, Bool useDST, TCoeff* plCoef, P
 
   memcpy(coeff, plCoef, (iWidth * iHeight * sizeof(TCoeff)));
 
-  xITrMxN( channelBitDepth, coeff, block, iWidth, iHeight, useDST, maxLog2TrDynamicRange );
+  xITrMxN( channelBitDepth, coeff, block, iWidth, iHeight, useDST, maxLog2TrDynamicRange, m_afpPartialButterflyInverse );
 
   for (Int y = 0; y < iHeight; y++)
   {
@@ -43,6 +43,9 @@
 #include "TComDataCU.h"
 #include "TComChromaFormat.h"
 #include "ContextTables.h"
+#if TRANSFORM_SIMD && SIMD_X86
+#include "TComSimd.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -72,6 +75,11 @@ typedef struct
   Int golombRiceAdaptationStatistics[RExt__GOLOMB_RICE_ADAPTATION_STATISTICS_SETS];
 } estBitsSbacStruct;
 
+/// 1D forward partial butterfly: transforms the rows of src and writes them as the columns of dst
+typedef Void (*FpPartialButterfly)       ( TCoeff *src, TCoeff *dst, Int shift, Int line );
+/// 1D inverse partial butterfly: transforms the columns of src, writes them as the rows of dst and clips the results
+typedef Void (*FpPartialButterflyInverse)( TCoeff *src, TCoeff *dst, Int shift, Int line, const TCoeff outputMinimum, const TCoeff outputMaximum );
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -149,8 +157,10 @@ public:
 #if RDOQ_CHROMA_LAMBDA
   Void setLambdas(const Double lambdas[MAX_NUM_COMPONENT]) { for (UInt component = 0; component < MAX_NUM_COMPONENT; component++) m_lambdas[component] = lambdas[component]; }
   Void selectLambda(const ComponentID compIdx) { m_dLambda = m_lambdas[compIdx]; }
+  const Double* getLambdas() const { return m_lambdas; }
 #else
   Void setLambda(Double dLambda) { m_dLambda = dLambda;}
+  Double getLambda() const { return m_dLambda; }
 #endif
   Void setRDOQOffset( UInt uiRDOQOffset ) { m_uiRDOQOffset = uiRDOQOffset; }
 
@@ -200,6 +210,13 @@ public:
   Void transformSkipQuantOneSample(TComTU &rTu, const ComponentID compID, const TCoeff resiDiff, TCoeff* pcCoeff, const UInt uiPos, const QpParam &cQP, const Bool bUseHalfRoundingPoint);
   Void invTrSkipDeQuantOneSample(TComTU &rTu, ComponentID compID, TCoeff pcCoeff, Pel &reconSample, const QpParam &cQP, UInt uiPos );
 
+  // partial butterflies of the DCT, indexed by log2(size) - 2
+  FpPartialButterfly        getPartialButterfly       ( UInt uiLog2Size ) const { return m_afpPartialButterfly       [uiLog2Size - 2]; }
+  FpPartialButterflyInverse getPartialButterflyInverse( UInt uiLog2Size ) const { return m_afpPartialButterflyInverse[uiLog2Size - 2]; }
+#if TRANSFORM_SIMD && SIMD_X86
+  Void setSimdExtension( SimdExtension eExtension ); ///< use the partial butterflies of an extension, SIMD_NONE for the scalar ones
+#endif
+
 protected:
 #if ADAPTIVE_QP_SELECTION
   Int     m_qpDelta[MAX_QP+1];
@@ -208,6 +225,9 @@ protected:
 #endif
   TCoeff* m_plTempCoeff;
 
+  FpPartialButterfly        m_afpPartialButterfly       [4]; ///< forward partial butterflies of the sizes 4, 8, 16 and 32
+  FpPartialButterflyInverse m_afpPartialButterflyInverse[4]; ///< inverse partial butterflies of the sizes 4, 8, 16 and 32
+
 //  QpParam  m_cQP; - removed - placed on the stack.
 #if RDOQ_CHROMA_LAMBDA
   Double   m_lambdas[MAX_NUM_COMPONENT];
@@ -234,6 +254,12 @@ protected:
   Double    m_errScaleNoScalingList[SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
 
 private:
+  Void xInitPartialButterflies          ( );
+#if TRANSFORM_SIMD && SIMD_X86
+  static Void xSetSimdPartialButterflies( FpPartialButterfly* afpForward, FpPartialButterflyInverse* afpInverse, SimdExtension eExtension );
+  Bool xCheckSimdPartialButterflies     ( ) const;
+#endif
+
   // forward Transform
   Void xT   ( const Int channelBitDepth, Bool useDST, Pel* piBlkResi, UInt uiStride, TCoeff* psCoeff, Int iWidth, Int iHeight, const Int maxLog2TrDynamicRange );
 
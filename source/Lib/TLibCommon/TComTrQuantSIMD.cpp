@@ -0,0 +1,499 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComTrQuantSIMD.cpp
+    \brief    SSE4.1 and AVX2 implementations of the partial butterflies of the forward and inverse DCT
+
+    A vector holds the same sample of 4 (SSE4.1) or 8 (AVX2) lines, so the even/odd decomposition of the scalar
+    partial butterflies is applied to whole vectors. The lines are transposed on load (forward) or on store
+    (inverse). All sums are computed in 32 bit like the scalar code, which makes the results identical including
+    the rounding, the shift and the clipping to [outputMinimum, outputMaximum].
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "TComTrQuant.h"
+#include "TComRom.h"
+
+#if TRANSFORM_SIMD && SIMD_X86
+
+#include <immintrin.h>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Helpers
+// ====================================================================================================================
+
+/// transform matrix of size N, rows of coefficients
+template<Int N> static inline const TMatrixCoeff* xGetMatrix( Int direction );
+template<> inline const TMatrixCoeff* xGetMatrix< 4>( Int direction ) { return g_aiT4 [direction][0]; }
+template<> inline const TMatrixCoeff* xGetMatrix< 8>( Int direction ) { return g_aiT8 [direction][0]; }
+template<> inline const TMatrixCoeff* xGetMatrix<16>( Int direction ) { return g_aiT16[direction][0]; }
+template<> inline const TMatrixCoeff* xGetMatrix<32>( Int direction ) { return g_aiT32[direction][0]; }
+
+// ====================================================================================================================
+// SSE4.1, 4 lines per vector
+// ====================================================================================================================
+
+static inline SIMD_TARGET_SSE41 Void xTranspose4x4Sse41( __m128i* pv )
+{
+  const __m128i v0 = _mm_unpacklo_epi32( pv[0], pv[1] );
+  const __m128i v1 = _mm_unpacklo_epi32( pv[2], pv[3] );
+  const __m128i v2 = _mm_unpackhi_epi32( pv[0], pv[1] );
+  const __m128i v3 = _mm_unpackhi_epi32( pv[2], pv[3] );
+  pv[0] = _mm_unpacklo_epi64( v0, v1 );
+  pv[1] = _mm_unpackhi_epi64( v0, v1 );
+  pv[2] = _mm_unpacklo_epi64( v2, v3 );
+  pv[3] = _mm_unpackhi_epi64( v2, v3 );
+}
+
+/// sum over n < L of T[n] * pv[n * step]
+template<Int L>
+static inline SIMD_TARGET_SSE41 __m128i xDotSse41( const TMatrixCoeff* T, const __m128i* pv, Int step )
+{
+  __m128i vSum = _mm_mullo_epi32( _mm_set1_epi32( T[0] ), pv[0] );
+  for( Int n = 1; n < L; n++ )
+  {
+    vSum = _mm_add_epi32( vSum, _mm_mullo_epi32( _mm_set1_epi32( T[n] ), pv[n * step] ) );
+  }
+  return vSum;
+}
+
+/**
+ * forward butterfly of size N: y[k * yStep] = sum over n of T[k * rowStep][n] * x[n], with the rows of the
+ * matrix of size N * rowStep; the even outputs are the butterfly of size N / 2 of the sums E
+ */
+template<Int N>
+static inline SIMD_TARGET_SSE41 Void xForwardSse41( const __m128i* x, __m128i* y, Int yStep, const TMatrixCoeff* T, Int rowStep )
+{
+  const Int tStride = N * rowStep;
+  __m128i E[N / 2], O[N / 2];
+  for( Int n = 0; n < N / 2; n++ )
+  {
+    E[n] = _mm_add_epi32( x[n], x[N - 1 - n] );
+    O[n] = _mm_sub_epi32( x[n], x[N - 1 - n] );
+  }
+  for( Int k = 1; k < N; k += 2 )
+  {
+    y[k * yStep] = xDotSse41<N / 2>( T + k * rowStep * tStride, O, 1 );
+  }
+  xForwardSse41<N / 2>( E, y, 2 * yStep, T, 2 * rowStep );
+}
+
+template<>
+inline SIMD_TARGET_SSE41 Void xForwardSse41<2>( const __m128i* x, __m128i* y, Int yStep, const TMatrixCoeff* T, Int rowStep )
+{
+  const Int tStride = 2 * rowStep;
+  y[0]     = xDotSse41<2>( T,                     x, 1 );
+  y[yStep] = xDotSse41<2>( T + rowStep * tStride, x, 1 );
+}
+
+/**
+ * inverse butterfly of size N: y[n] = sum over k of T[k * rowStep][n] * x[k * xStep], with the rows of the
+ * matrix of size N * rowStep; E is the inverse butterfly of size N / 2 of the even inputs
+ */
+template<Int N>
+static inline SIMD_TARGET_SSE41 Void xInverseSse41( const __m128i* x, Int xStep, __m128i* y, const TMatrixCoeff* T, Int rowStep )
+{
+  const Int tStride = N * rowStep;
+  __m128i E[N / 2], O[N / 2];
+  for( Int n = 0; n < N / 2; n++ )
+  {
+    O[n] = _mm_mullo_epi32( _mm_set1_epi32( T[rowStep * tStride + n] ), x[xStep] );
+    for( Int k = 3; k < N; k += 2 )
+    {
+      O[n] = _mm_add_epi32( O[n], _mm_mullo_epi32( _mm_set1_epi32( T[k * rowStep * tStride + n] ), x[k * xStep] ) );
+    }
+  }
+  xInverseSse41<N / 2>( x, 2 * xStep, E, T, 2 * rowStep );
+  for( Int n = 0; n < N / 2; n++ )
+  {
+    y[n]         = _mm_add_epi32( E[n], O[n] );
+    y[N - 1 - n] = _mm_sub_epi32( E[n], O[n] );
+  }
+}
+
+template<>
+inline SIMD_TARGET_SSE41 Void xInverseSse41<2>( const __m128i* x, Int xStep, __m128i* y, const TMatrixCoeff* T, Int rowStep )
+{
+  const Int tStride = 2 * rowStep;
+  for( Int n = 0; n < 2; n++ )
+  {
+    y[n] = _mm_add_epi32( _mm_mullo_epi32( _mm_set1_epi32( T[n] ), x[0] ), _mm_mullo_epi32( _mm_set1_epi32( T[rowStep * tStride + n] ), x[xStep] ) );
+  }
+}
+
+/// counterpart of partialButterfly4/8/16/32
+template<Int N>
+static SIMD_TARGET_SSE41 Void xPartialButterflySse41( TCoeff *src, TCoeff *dst, Int shift, Int line )
+{
+  const TMatrixCoeff* T      = xGetMatrix<N>( TRANSFORM_FORWARD );
+  const __m128i       vAdd   = _mm_set1_epi32( ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0 );
+  const __m128i       vShift = _mm_cvtsi32_si128( shift );
+
+  for( Int j = 0; j < line; j += 4 )
+  {
+    __m128i x[N], y[N];
+    for( Int n = 0; n < N; n += 4 )
+    {
+      for( Int i = 0; i < 4; i++ )
+      {
+        x[n + i] = _mm_loadu_si128( ( const __m128i* )( src + ( j + i ) * N + n ) );
+      }
+      xTranspose4x4Sse41( x + n );
+    }
+
+    xForwardSse41<N>( x, y, 1, T, 1 );
+
+    for( Int k = 0; k < N; k++ )
+    {
+      _mm_storeu_si128( ( __m128i* )( dst + k * line + j ), _mm_sra_epi32( _mm_add_epi32( y[k], vAdd ), vShift ) );
+    }
+  }
+}
+
+/// counterpart of partialButterflyInverse4/8/16/32
+template<Int N>
+static SIMD_TARGET_SSE41 Void xPartialButterflyInverseSse41( TCoeff *src, TCoeff *dst, Int shift, Int line, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const TMatrixCoeff* T      = xGetMatrix<N>( TRANSFORM_INVERSE );
+  const __m128i       vAdd   = _mm_set1_epi32( ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0 );
+  const __m128i       vShift = _mm_cvtsi32_si128( shift );
+  const __m128i       vMin   = _mm_set1_epi32( outputMinimum );
+  const __m128i       vMax   = _mm_set1_epi32( outputMaximum );
+
+  for( Int j = 0; j < line; j += 4 )
+  {
+    __m128i x[N], y[N];
+    for( Int k = 0; k < N; k++ )
+    {
+      x[k] = _mm_loadu_si128( ( const __m128i* )( src + k * line + j ) );
+    }
+
+    xInverseSse41<N>( x, 1, y, T, 1 );
+
+    for( Int n = 0; n < N; n += 4 )
+    {
+      for( Int i = 0; i < 4; i++ )
+      {
+        y[n + i] = _mm_min_epi32( _mm_max_epi32( _mm_sra_epi32( _mm_add_epi32( y[n + i], vAdd ), vShift ), vMin ), vMax );
+      }
+      xTranspose4x4Sse41( y + n );
+      for( Int i = 0; i < 4; i++ )
+      {
+        _mm_storeu_si128( ( __m128i* )( dst + ( j + i ) * N + n ), y[n + i] );
+      }
+    }
+  }
+}
+
+// ====================================================================================================================
+// AVX2, 8 lines per vector
+// ====================================================================================================================
+
+static inline SIMD_TARGET_AVX2 Void xTranspose8x8Avx2( __m256i* pv )
+{
+  __m256i t[8], u[8];
+  for( Int i = 0; i < 8; i += 2 )
+  {
+    t[i]     = _mm256_unpacklo_epi32( pv[i], pv[i + 1] );
+    t[i + 1] = _mm256_unpackhi_epi32( pv[i], pv[i + 1] );
+  }
+  for( Int i = 0; i < 8; i += 4 )
+  {
+    u[i]     = _mm256_unpacklo_epi64( t[i],     t[i + 2] );
+    u[i + 1] = _mm256_unpackhi_epi64( t[i],     t[i + 2] );
+    u[i + 2] = _mm256_unpacklo_epi64( t[i + 1], t[i + 3] );
+    u[i + 3] = _mm256_unpackhi_epi64( t[i + 1], t[i + 3] );
+  }
+  for( Int i = 0; i < 4; i++ )
+  {
+    pv[i]     = _mm256_permute2x128_si256( u[i], u[i + 4], 0x20 );
+    pv[i + 4] = _mm256_permute2x128_si256( u[i], u[i + 4], 0x31 );
+  }
+}
+
+template<Int L>
+static inline SIMD_TARGET_AVX2 __m256i xDotAvx2( const TMatrixCoeff* T, const __m256i* pv, Int step )
+{
+  __m256i vSum = _mm256_mullo_epi32( _mm256_set1_epi32( T[0] ), pv[0] );
+  for( Int n = 1; n < L; n++ )
+  {
+    vSum = _mm256_add_epi32( vSum, _mm256_mullo_epi32( _mm256_set1_epi32( T[n] ), pv[n * step] ) );
+  }
+  return vSum;
+}
+
+/// counterpart of xForwardSse41
+template<Int N>
+static inline SIMD_TARGET_AVX2 Void xForwardAvx2( const __m256i* x, __m256i* y, Int yStep, const TMatrixCoeff* T, Int rowStep )
+{
+  const Int tStride = N * rowStep;
+  __m256i E[N / 2], O[N / 2];
+  for( Int n = 0; n < N / 2; n++ )
+  {
+    E[n] = _mm256_add_epi32( x[n], x[N - 1 - n] );
+    O[n] = _mm256_sub_epi32( x[n], x[N - 1 - n] );
+  }
+  for( Int k = 1; k < N; k += 2 )
+  {
+    y[k * yStep] = xDotAvx2<N / 2>( T + k * rowStep * tStride, O, 1 );
+  }
+  xForwardAvx2<N / 2>( E, y, 2 * yStep, T, 2 * rowStep );
+}
+
+template<>
+inline SIMD_TARGET_AVX2 Void xForwardAvx2<2>( const __m256i* x, __m256i* y, Int yStep, const TMatrixCoeff* T, Int rowStep )
+{
+  const Int tStride = 2 * rowStep;
+  y[0]     = xDotAvx2<2>( T,                     x, 1 );
+  y[yStep] = xDotAvx2<2>( T + rowStep * tStride, x, 1 );
+}
+
+/// counterpart of xInverseSse41
+template<Int N>
+static inline SIMD_TARGET_AVX2 Void xInverseAvx2( const __m256i* x, Int xStep, __m256i* y, const TMatrixCoeff* T, Int rowStep )
+{
+  const Int tStride = N * rowStep;
+  __m256i E[N / 2], O[N / 2];
+  for( Int n = 0; n < N / 2; n++ )
+  {
+    O[n] = _mm256_mullo_epi32( _mm256_set1_epi32( T[rowStep * tStride + n] ), x[xStep] );
+    for( Int k = 3; k < N; k += 2 )
+    {
+      O[n] = _mm256_add_epi32( O[n], _mm256_mullo_epi32( _mm256_set1_epi32( T[k * rowStep * tStride + n] ), x[k * xStep] ) );
+    }
+  }
+  xInverseAvx2<N / 2>( x, 2 * xStep, E, T, 2 * rowStep );
+  for( Int n = 0; n < N / 2; n++ )
+  {
+    y[n]         = _mm256_add_epi32( E[n], O[n] );
+    y[N - 1 - n] = _mm256_sub_epi32( E[n], O[n] );
+  }
+}
+
+template<>
+inline SIMD_TARGET_AVX2 Void xInverseAvx2<2>( const __m256i* x, Int xStep, __m256i* y, const TMatrixCoeff* T, Int rowStep )
+{
+  const Int tStride = 2 * rowStep;
+  for( Int n = 0; n < 2; n++ )
+  {
+    y[n] = _mm256_add_epi32( _mm256_mullo_epi32( _mm256_set1_epi32( T[n] ), x[0] ), _mm256_mullo_epi32( _mm256_set1_epi32( T[rowStep * tStride + n] ), x[xStep] ) );
+  }
+}
+
+/// counterpart of partialButterfly8/16/32, a number of lines that is not a multiple of 8 is left to SSE4.1
+template<Int N>
+static SIMD_TARGET_AVX2 Void xPartialButterflyAvx2( TCoeff *src, TCoeff *dst, Int shift, Int line )
+{
+  if( line & 7 )
+  {
+    xPartialButterflySse41<N>( src, dst, shift, line );
+    return;
+  }
+
+  const TMatrixCoeff* T      = xGetMatrix<N>( TRANSFORM_FORWARD );
+  const __m256i       vAdd   = _mm256_set1_epi32( ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0 );
+  const __m128i       vShift = _mm_cvtsi32_si128( shift );
+
+  for( Int j = 0; j < line; j += 8 )
+  {
+    __m256i x[N], y[N];
+    for( Int n = 0; n < N; n += 8 )
+    {
+      for( Int i = 0; i < 8; i++ )
+      {
+        x[n + i] = _mm256_loadu_si256( ( const __m256i* )( src + ( j + i ) * N + n ) );
+      }
+      xTranspose8x8Avx2( x + n );
+    }
+
+    xForwardAvx2<N>( x, y, 1, T, 1 );
+
+    for( Int k = 0; k < N; k++ )
+    {
+      _mm256_storeu_si256( ( __m256i* )( dst + k * line + j ), _mm256_sra_epi32( _mm256_add_epi32( y[k], vAdd ), vShift ) );
+    }
+  }
+}
+
+/// counterpart of partialButterflyInverse8/16/32, a number of lines that is not a multiple of 8 is left to SSE4.1
+template<Int N>
+static SIMD_TARGET_AVX2 Void xPartialButterflyInverseAvx2( TCoeff *src, TCoeff *dst, Int shift, Int line, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  if( line & 7 )
+  {
+    xPartialButterflyInverseSse41<N>( src, dst, shift, line, outputMinimum, outputMaximum );
+    return;
+  }
+
+  const TMatrixCoeff* T      = xGetMatrix<N>( TRANSFORM_INVERSE );
+  const __m256i       vAdd   = _mm256_set1_epi32( ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0 );
+  const __m128i       vShift = _mm_cvtsi32_si128( shift );
+  const __m256i       vMin   = _mm256_set1_epi32( outputMinimum );
+  const __m256i       vMax   = _mm256_set1_epi32( outputMaximum );
+
+  for( Int j = 0; j < line; j += 8 )
+  {
+    __m256i x[N], y[N];
+    for( Int k = 0; k < N; k++ )
+    {
+      x[k] = _mm256_loadu_si256( ( const __m256i* )( src + k * line + j ) );
+    }
+
+    xInverseAvx2<N>( x, 1, y, T, 1 );
+
+    for( Int n = 0; n < N; n += 8 )
+    {
+      for( Int i = 0; i < 8; i++ )
+      {
+        y[n + i] = _mm256_min_epi32( _mm256_max_epi32( _mm256_sra_epi32( _mm256_add_epi32( y[n + i], vAdd ), vShift ), vMin ), vMax );
+      }
+      xTranspose8x8Avx2( y + n );
+      for( Int i = 0; i < 8; i++ )
+      {
+        _mm256_storeu_si256( ( __m256i* )( dst + ( j + i ) * N + n ), y[n + i] );
+      }
+    }
+  }
+}
+
+// ====================================================================================================================
+// Dispatch and self test
+// ====================================================================================================================
+
+/**
+ * \brief Replace the scalar partial butterflies of a dispatch table by the vectorized ones of an extension
+ *
+ * \param afpForward  forward partial butterflies, indexed by log2(size) - 2
+ * \param afpInverse  inverse partial butterflies, indexed by log2(size) - 2
+ * \param eExtension  SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE keeps the current functions
+ */
+Void TComTrQuant::xSetSimdPartialButterflies( FpPartialButterfly* afpForward, FpPartialButterflyInverse* afpInverse, SimdExtension eExtension )
+{
+  if ( eExtension >= SIMD_SSE41 )
+  {
+    afpForward[0] = xPartialButterflySse41< 4>;
+    afpForward[1] = xPartialButterflySse41< 8>;
+    afpForward[2] = xPartialButterflySse41<16>;
+    afpForward[3] = xPartialButterflySse41<32>;
+
+    afpInverse[0] = xPartialButterflyInverseSse41< 4>;
+    afpInverse[1] = xPartialButterflyInverseSse41< 8>;
+    afpInverse[2] = xPartialButterflyInverseSse41<16>;
+    afpInverse[3] = xPartialButterflyInverseSse41<32>;
+  }
+  // a 4 point butterfly has too few outputs to gain from 8 lines per vector, the size 4 stays with SSE4.1
+  if ( eExtension >= SIMD_AVX2 )
+  {
+    afpForward[1] = xPartialButterflyAvx2< 8>;
+    afpForward[2] = xPartialButterflyAvx2<16>;
+    afpForward[3] = xPartialButterflyAvx2<32>;
+
+    afpInverse[1] = xPartialButterflyInverseAvx2< 8>;
+    afpInverse[2] = xPartialButterflyInverseAvx2<16>;
+    afpInverse[3] = xPartialButterflyInverseAvx2<32>;
+  }
+}
+
+static UInt xGetTestRand(UInt& ruiSeed)
+{
+  ruiSeed = ruiSeed * 1103515245 + 12345;
+  return ( ruiSeed >> 8 );
+}
+
+/**
+ * \brief Compare the vectorized partial butterflies of all extensions supported by the CPU with the scalar ones of this object
+ *
+ * All sizes and numbers of lines are tested with random inputs of up to 16 bit magnitude, shifts of 0 to 12 and
+ * clipping ranges that are narrower than the results. Returns true if all outputs are identical.
+ */
+Bool TComTrQuant::xCheckSimdPartialButterflies() const
+{
+  static TCoeff src   [ MAX_TU_SIZE * MAX_TU_SIZE ];
+  static TCoeff dstRef[ MAX_TU_SIZE * MAX_TU_SIZE ];
+  static TCoeff dstVec[ MAX_TU_SIZE * MAX_TU_SIZE ];
+  UInt seed = 1;
+
+  for ( Int extension = SIMD_SSE41; extension <= getSimdExtension(); extension++ )
+  {
+    FpPartialButterfly        afpVec   [4];
+    FpPartialButterflyInverse afpInvVec[4];
+    memcpy( afpVec,    m_afpPartialButterfly,        sizeof( afpVec    ) );
+    memcpy( afpInvVec, m_afpPartialButterflyInverse, sizeof( afpInvVec ) );
+    xSetSimdPartialButterflies( afpVec, afpInvVec, SimdExtension( extension ) );
+
+    for ( Int test = 0; test < 256; test++ )
+    {
+      const Int    sizeIdx  = test & 3;
+      const Int    size     = 4 << sizeIdx;
+      const Int    line     = 4 << ( ( test >> 2 ) & 3 );
+      const Bool   bInverse = ( test & 16 ) != 0;
+      const Int    shift    = xGetTestRand( seed ) % 13;
+      const Int    range    = ( test & 32 ) ? 1 << 15 : 1 << 9;
+      const TCoeff clipMax  = ( test & 64 ) ? ( 1 << 15 ) - 1 : ( 1 << 8 ) - 1;
+      const TCoeff clipMin  = -clipMax - 1;
+
+      for ( Int i = 0; i < MAX_TU_SIZE * MAX_TU_SIZE; i++ )
+      {
+        src[i] = TCoeff( xGetTestRand( seed ) % ( 2 * range ) ) - range;
+        dstRef[i] = dstVec[i] = 0;
+      }
+
+      if ( bInverse )
+      {
+        m_afpPartialButterflyInverse[sizeIdx]( src, dstRef, shift, line, clipMin, clipMax );
+        afpInvVec[sizeIdx]( src, dstVec, shift, line, clipMin, clipMax );
+      }
+      else
+      {
+        m_afpPartialButterfly[sizeIdx]( src, dstRef, shift, line );
+        afpVec[sizeIdx]( src, dstVec, shift, line );
+      }
+
+      if ( memcmp( dstRef, dstVec, sizeof( dstRef ) ) )
+      {
+        printf( "\nWarning: vectorized %s partial butterfly differs from the scalar one (size %d, %d lines), the scalar transforms are used\n", bInverse ? "inverse" : "forward", size, line );
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+//! \}
+
+#endif // TRANSFORM_SIMD && SIMD_X86
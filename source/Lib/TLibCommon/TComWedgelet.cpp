@@ -65,10 +65,12 @@ TComWedgelet::TComWedgelet( const TComWedgelet &rcWedge ) : m_uhXs     ( rcWedge
                                                             m_bIsCoarse( rcWedge.m_bIsCoarse ),
                                                             m_uiWidth  ( rcWedge.m_uiWidth   ),
                                                             m_uiHeight ( rcWedge.m_uiHeight  ),
-                                                            m_pbPattern( (Bool*)xMalloc( Bool, (m_uiWidth * m_uiHeight) ) ),
-                                                            m_pbScaledPattern( g_wedgePattern )
+                                                            m_pbPattern( (Bool*)xMalloc( Bool, (m_uiWidth * m_uiHeight) ) )
 {
   ::memcpy( m_pbPattern, rcWedge.m_pbPattern, sizeof(Bool) * (m_uiWidth * m_uiHeight));
+#if NH_3D_DMM_PACKED_PATTERNS
+  ::memcpy( m_auiPackedPattern, rcWedge.m_auiPackedPattern, sizeof(m_auiPackedPattern) );
+#endif
 }
 
 TComWedgelet::~TComWedgelet(void)
@@ -79,12 +81,15 @@ TComWedgelet::~TComWedgelet(void)
 Void TComWedgelet::create( UInt uiWidth, UInt uiHeight )
 {
   assert( uiWidth > 0 && uiHeight > 0 );
+#if NH_3D_DMM_PACKED_PATTERNS
+  assert( uiWidth <= DMM_MAX_WEDGE_SIZE && uiHeight <= DMM_MAX_WEDGE_SIZE );
+  ::memset( m_auiPackedPattern, 0, sizeof(m_auiPackedPattern) );
+#endif
 
   m_uiWidth   = uiWidth;
   m_uiHeight  = uiHeight;
 
   m_pbPattern = (Bool*)xMalloc( Bool, (m_uiWidth * m_uiHeight) );
-  m_pbScaledPattern = g_wedgePattern;
 }
 
 Void TComWedgelet::destroy()
@@ -95,6 +100,9 @@ Void TComWedgelet::destroy()
 Void TComWedgelet::clear()
 {
   ::memset( m_pbPattern, 0, (m_uiWidth * m_uiHeight) * sizeof(Bool) );
+#if NH_3D_DMM_PACKED_PATTERNS
+  ::memset( m_auiPackedPattern, 0, sizeof(m_auiPackedPattern) );
+#endif
 }
 
 Void TComWedgelet::setWedgelet( UChar uhXs, UChar uhYs, UChar uhXe, UChar uhYe, UChar uhOri, WedgeResolution eWedgeRes, Bool bIsCoarse )
@@ -176,6 +184,9 @@ Void TComWedgelet::generateWedgePatternByRotate(const TComWedgelet &rcWedge, Int
   m_bIsCoarse = rcWedge.m_bIsCoarse;
   m_uiWidth  = rcWedge.m_uiWidth;
   m_uiHeight = rcWedge.m_uiHeight;
+#if NH_3D_DMM_PACKED_PATTERNS
+  xPackPattern();
+#endif
 }
 
 Void TComWedgelet::xGenerateWedgePattern()
@@ -207,6 +218,9 @@ Void TComWedgelet::xGenerateWedgePattern()
   {
     m_pbPattern[k] = pbTempPattern[k];
   };
+#if NH_3D_DMM_PACKED_PATTERNS
+  xPackPattern();
+#endif
 
   if( pbTempPattern )
   {
@@ -263,7 +277,7 @@ Void TComWedgelet::xDrawEdgeLine( UChar uhXs, UChar uhYs, UChar uhXe, UChar uhYe
   }
 }
 
-Bool* TComWedgelet::getPatternScaled( UInt dstSize )
+Bool* TComWedgelet::getPatternScaled( UInt dstSize, Bool* pbScaledBuf )
 {
   Bool *pbSrcPat = this->getPattern();
   UInt uiSrcSize = this->getStride();
@@ -283,10 +297,10 @@ Bool* TComWedgelet::getPatternScaled( UInt dstSize )
       {
         Int srcX = x>>scale;
         Int srcY = y>>scale;
-        m_pbScaledPattern[y*dstSize + x] = pbSrcPat[ srcY*uiSrcSize + srcX ];
+        pbScaledBuf[y*dstSize + x] = pbSrcPat[ srcY*uiSrcSize + srcX ];
       }
     }
-    return m_pbScaledPattern;
+    return pbScaledBuf;
   }
 }
 
@@ -316,6 +330,55 @@ Void TComWedgelet::getPatternScaledCopy( UInt dstSize, Bool* dstBuf )
   }
 }
 
+#if NH_3D_DMM_PACKED_PATTERNS
+Void TComWedgelet::getPackedPatternScaled( UInt dstSize, UInt64* puiDstRows ) const
+{
+  if( 16 >= dstSize )
+  {
+    assert( dstSize == m_uiWidth );
+    ::memcpy( puiDstRows, m_auiPackedPattern, dstSize * sizeof(UInt64) );
+  }
+  else
+  {
+    assert( dstSize <= DMM_MAX_PACKED_SIZE );
+    Int scale = (g_aucConvertToBit[dstSize] - g_aucConvertToBit[m_uiWidth]);
+    assert(scale>=0);
+    const UInt64 uiRun = ( UInt64( 1 ) << ( 1 << scale ) ) - 1; // samples of one scaled pattern sample
+    for( UInt y = 0; y < m_uiHeight; y++ )
+    {
+      UInt64 uiSrcRow = m_auiPackedPattern[y];
+      UInt64 uiDstRow = 0;
+      for( UInt x = 0; uiSrcRow != 0; x++, uiSrcRow >>= 1 )
+      {
+        if( uiSrcRow & 1 )
+        {
+          uiDstRow |= uiRun << ( x << scale );
+        }
+      }
+      for( UInt k = 0; k < ( 1u << scale ); k++ )
+      {
+        puiDstRows[( y << scale ) + k] = uiDstRow;
+      }
+    }
+  }
+}
+
+Void TComWedgelet::xPackPattern()
+{
+  for( UInt y = 0; y < m_uiHeight; y++ )
+  {
+    UInt64 uiRow = 0;
+    for( UInt x = 0; x < m_uiWidth; x++ )
+    {
+      if( m_pbPattern[(y * m_uiWidth) + x] )
+      {
+        uiRow |= UInt64( 1 ) << x;
+      }
+    }
+    m_auiPackedPattern[y] = uiRow;
+  }
+}
+#endif
 
 TComWedgeNode::TComWedgeNode()
 {
@@ -41,6 +41,9 @@
 #include "CommonDef.h"
 
 #include <vector>
+#if NH_3D_DMM_WEDGE_LIST_INDEX
+#include <map>
+#endif
 
 #if NH_3D_DMM
 #define DMM_OFFSET     (NUM_INTRA_MODE+1) // offset for DMM and RBC mode numbers
@@ -66,6 +69,41 @@ __inline Bool isDmmMode( Int intraMode ) { return ((UInt)getDmmType( intraMode )
 // Wedgelets
 #define DMM_NO_WEDGE_IDX       MAX_UINT
 #define DMM_NUM_WEDGE_REFINES   8
+#if NH_3D_DMM_PACKED_PATTERNS
+#define DMM_MAX_WEDGE_SIZE     16  // max. size of the stored wedgelet patterns, larger blocks scale them
+#define DMM_MAX_PACKED_SIZE    64  // max. size of a packed pattern, one bit per sample in a UInt64 per row
+
+/// number of set bits of a packed pattern row
+__inline Int countPatternRowBits( UInt64 uiRow )
+{
+#if defined(__GNUC__)
+  return __builtin_popcountll( uiRow );
+#else
+  Int iCount = 0;
+  for( ; uiRow != 0; uiRow &= uiRow - 1 )
+  {
+    iCount++;
+  }
+  return iCount;
+#endif
+}
+
+/// position of the lowest set bit of a non-zero packed pattern row
+__inline Int getPatternRowFirstBit( UInt64 uiRow )
+{
+  assert( uiRow != 0 );
+#if defined(__GNUC__)
+  return __builtin_ctzll( uiRow );
+#else
+  Int iPos = 0;
+  for( ; ( uiRow & 1 ) == 0; uiRow >>= 1 )
+  {
+    iPos++;
+  }
+  return iPos;
+#endif
+}
+#endif
 
 enum WedgeResolution
 {
@@ -92,7 +130,11 @@ private:
   UInt  m_uiHeight;
 
   Bool* m_pbPattern;
-  Bool* m_pbScaledPattern;
+#if NH_3D_DMM_PACKED_PATTERNS
+  UInt64 m_auiPackedPattern[DMM_MAX_WEDGE_SIZE]; // bit x of row y is m_pbPattern[y*m_uiWidth+x]
+
+  Void  xPackPattern();
+#endif
 
   Void  xGenerateWedgePattern();
   Void  xDrawEdgeLine( UChar uhXs, UChar uhYs, UChar uhXe, UChar uhYe, Bool* pbPattern, Int iPatternStride );
@@ -125,13 +167,21 @@ public:
   Bool  checkIdentical( Bool* pbRefPattern );
   Bool  checkInvIdentical( Bool* pbRefPattern );
 
-  Bool* getPatternScaled    ( UInt dstSize );
+  Bool* getPatternScaled    ( UInt dstSize, Bool* pbScaledBuf ); ///< returns pattern, scaled into caller buffer if dstSize > 16
   Void  getPatternScaledCopy( UInt dstSize, Bool* dstBuf );
+#if NH_3D_DMM_PACKED_PATTERNS
+  const UInt64* getPackedPattern() const { return m_auiPackedPattern; }
+  Void  getPackedPatternScaled( UInt dstSize, UInt64* puiDstRows ) const; ///< dstSize rows of dstSize bits, dstSize <= DMM_MAX_PACKED_SIZE
+#endif
 
 };  // END CLASS DEFINITION TComWedgelet
 
 // type definition wedgelet pattern list
 typedef std::vector<TComWedgelet> WedgeList;
+#if NH_3D_DMM_WEDGE_LIST_INDEX
+// index of each packed pattern in a wedgelet pattern list
+typedef std::map< std::vector<UInt64>, UInt > WedgePatternMap;
+#endif
 
 // ====================================================================================================================
 // Class definition TComWedgeRef
@@ -79,6 +79,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////
 #if NH_MV
 #define NH_MV_ENC_DEC_TRAC                 1  //< CU/PU level tracking
+#define NH_MV_LAYER_PARALLEL_ENC           1  //< Encoding of the layers of an access unit in parallel threads, scheduled by the layer dependencies
+#define NH_MV_LAYER_PARALLEL_DEC           1  //< Decoding of the layers of an access unit in a pipeline of threads, synchronized by the reconstructed CTU rows of the reference pictures
+#define NH_MV_FRAME_PARALLEL_ENC           1  //< Encoding of the access units of a GOP overlapped in the layer threads, synchronized by the access units of the reference pictures (requires NH_MV_LAYER_PARALLEL_ENC)
 #if NH_3D
 #define NH_3D_INTEGER_MV_DEPTH            1
 #define NH_3D_ENC_DEPTH                   1   // Encoder optimizations for depth, incl.
@@ -299,12 +302,22 @@
 #if NH_3D
 #define NH_3D_OUTPUT_ACTIVE_TOOLS               0
 #define NH_3D_REN_MAX_DEV_OUT                   0
+#define NH_3D_REN_PARALLEL_VIEWS                1   // Renderer app: synthesis of the output views of a frame in parallel threads, next frame read meanwhile (option NumRenderThreads)
+#define NH_3D_DMM_PACKED_PATTERNS               1   // Wedgelet patterns also stored as bit masks of one word per row, DMM1 wedgelet search from row sums and segment DCs without prediction blocks
+#define NH_3D_DMM_WEDGE_LIST_INDEX              1   // Wedge lists built with maps of the packed patterns and of the reference start/end positions instead of linear searches
+#if NH_3D_DMM_WEDGE_LIST_INDEX && !NH_3D_DMM_PACKED_PATTERNS
+#error NH_3D_DMM_WEDGE_LIST_INDEX requires NH_3D_DMM_PACKED_PATTERNS
+#endif
+#define NH_3D_IC_PARAM_CACHE                    1   // IC parameters derived once per CU, reference picture, component and integer motion vector
+#define NH_3D_SPIVMP_MERGED_MC                  1   // Sub-PU motion compensation of SPIVMP and MPI candidates in maximal rectangles of identical motion
+#define NH_3D_VSP_BLOCK_MC                      1   // VSP disparities derived per sub-block row from the corner maxima, sub-blocks of equal disparity compensated as one block
 #endif
 ///// ***** VIEW SYNTHESIS OPTIMIZAION *********
 #if NH_3D_VSO
 #define H_3D_VSO_DIST_INT                 1   // Allow negative synthesized view distortion change
 #define H_3D_VSO_COLOR_PLANES             1   // Compute VSO distortion on color planes
 #define H_3D_VSO_EARLY_SKIP               1   // LGE_VSO_EARLY_SKIP_A0093, A0093 modification 4
+#define H_3D_VSO_PARALLEL_MODELS          1   // Evaluation of the render models of the VSO in parallel threads (encoder option NumVSOThreads)
 #define H_3D_VSO_RM_ASSERTIONS            0   // Output VSO assertions
 #define H_3D_VSO_SYNTH_DIST_OUT           0   // Output of synthesized view distortion instead of depth distortion in encoder output
 #endif
@@ -323,6 +336,9 @@
 #define IC_CONST_SHIFT                    5
 #define IC_SHIFT_DIFF                     12
 #define IC_LOW_LATENCY_ENCODING_THRESHOLD 0.1 // Threshold for low-latency IC encoding in JCT3V-H0086
+#if NH_3D_IC_PARAM_CACHE
+#define IC_PARAM_CACHE_SIZE               16  // IC parameter sets cached for the current CU
+#endif
 #endif
 ///// ***** DEPTH BASED BLOCK PARTITIONING *********
 #if NH_3D_DBBP
@@ -379,6 +395,21 @@
 #define O0043_BEST_EFFORT_DECODING                        0 ///< 0 (default) = disable code related to best effort decoding, 1 = enable code relating to best effort decoding [ decode-side only ].
 #define ME_ENABLE_ROUNDING_OF_MVS                         1 ///< 0 (default) = disables rounding of motion vectors when right shifted,  1 = enables rounding
 #define RDOQ_CHROMA_LAMBDA                                1 ///< F386: weighting of chroma for RDOQ
+#define WPP_PARALLEL_ENC                                  1 ///< encoder only: CTU rows of a wavefront slice are compressed in parallel threads
+#define SUBSTREAM_PARALLEL_DEC                            1 ///< decoder only: substreams (wavefront CTU rows, tiles) of a slice segment are decoded in parallel threads
+#define PIC_METRICS_PARALLEL_ENC                          1 ///< encoder only: PSNR, MSE and decoded picture hash of the coded pictures are computed in background threads (encoder option NumMetricsThreads)
+#define PIC_HASH_PARALLEL_DEC                             1 ///< decoder only: decoded picture hash SEI messages are verified in background threads (decoder option NumHashThreads)
+#define DEBLOCKING_PARALLEL                               1 ///< CTU rows of the vertical and then of the horizontal edges of a picture are deblocked in parallel threads (option NumLoopFilterThreads)
+#define SAO_PARALLEL                                      1 ///< CTU rows of the SAO statistics (encoder) and of the SAO application of a picture are processed in parallel threads (option NumLoopFilterThreads)
+#define YUV_INPUT_PREFETCH                                1 ///< TVideoIOYuv: frames of an input file are read ahead in a separate thread (encoder option InputPrefetchFrames)
+#define YUV_INPUT_MMAP                                    1 ///< TVideoIOYuv: input files are memory mapped where the OS supports it and converted directly from the mapping
+#define RDCOST_SIMD                                       1 ///< SSE4.1/AVX2 implementations of the SAD, SSE and Hadamard distortion functions, selected at run time
+#define INTERPOLATION_SIMD                                1 ///< SSE4.1/AVX2 implementations of the luma and chroma interpolation filters, selected at run time
+#define TRANSFORM_SIMD                                    1 ///< SSE4.1/AVX2 implementations of the partial butterflies of the forward and inverse DCT, selected at run time
+#define RENDERER_SIMD                                     1 ///< SSE4.1/AVX2 implementations of the row kernels of the pixel warping and horizontal up sampling in TRenTop, selected at run time
+#define YUV_IO_SIMD                                       1 ///< SSE4.1/AVX2 implementations of the sample conversion and bit depth scaling in TVideoIOYuv, selected at run time
+#define DEBLOCKING_SIMD                                   1 ///< SSE4.1 implementation of the strong and weak luma deblocking filters, selected at run time
+#define SAO_SIMD                                          1 ///< SSE4.1/AVX2 implementations of the SAO edge and band offsets and of the edge offset statistics of the encoder, selected at run time
 // This can be enabled by the makefile
 #ifndef RExt__HIGH_BIT_DEPTH_SUPPORT
 #define RExt__HIGH_BIT_DEPTH_SUPPORT                                           0 ///< 0 (default) use data type definitions for 8-10 bit video, 1 = use larger data types to allow for up to 16-bit video (originally developed as part of N0188)
@@ -394,6 +425,11 @@
 #define FULL_NBIT                                                              0 ///< When enabled, use distortion measure derived from all bits of source data, otherwise discard (bitDepth - 8) least-significant bits of distortion
 #define RExt__HIGH_PRECISION_FORWARD_TRANSFORM                                 0 ///< 0 (default) use original 6-bit transform matrices for both forward and inverse transform, 1 = use original matrices for inverse transform and high precision matrices for forward transform
 #endif
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT && ( defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) ) && ( !defined(_MSC_VER) || _MSC_VER >= 1800 )
+#define SIMD_X86                                                               1 ///< x86 SIMD kernels can be compiled: they operate on 16 bit Pel and are selected at run time
+#else
+#define SIMD_X86                                                               0
+#endif
 #if FULL_NBIT
 # define DISTORTION_PRECISION_ADJUSTMENT(x)  0
 #else
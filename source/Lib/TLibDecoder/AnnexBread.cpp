@@ -39,6 +39,7 @@
 
 #include <stdint.h>
 #include <cassert>
+#include <cstring>
 #include <vector>
 #include "AnnexBread.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -50,20 +51,138 @@ using namespace std;
 //! \ingroup TLibDecoder
 //! \{
 
+/** number of bytes requested from the input stream per read */
+static const size_t ANNEXB_READ_BLOCK_SIZE = 1 << 18;
+
 /**
- * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
- * while accumulating bytestream statistics into stats.
+ * Find the first byte-aligned three-byte sequence 0x000000, 0x000001
+ * or 0x000002 in [p, end).  Eight bytes are tested at once for a zero
+ * byte, without which no such sequence can start within them.
  *
- * If EOF occurs while trying to extract a NALunit, an exception
- * of std::ios_base::failure is thrown.  The contsnts of stats will
- * be correct at this point.
+ * Returns the position of the sequence, or end if there is none
+ * (NB, sequences starting at end-2 or end-1 are not detected).
  */
-static Void
-_byteStreamNALUnit(
-  InputByteStream& bs,
-  vector<uint8_t>& nalUnit,
-  AnnexBStats& stats)
+static const uint8_t* findNALUnitEnd(const uint8_t* p, const uint8_t* end)
+{
+  while (end - p >= 10)
+  {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    if (((word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL) == 0)
+    {
+      p += 8;
+      continue;
+    }
+    for (const uint8_t* wordEnd = p + 8; p < wordEnd; p++)
+    {
+      if (p[0] == 0 && p[1] == 0 && p[2] <= 2)
+      {
+        return p;
+      }
+    }
+  }
+  for (; end - p >= 3; p++)
+  {
+    if (p[0] == 0 && p[1] == 0 && p[2] <= 2)
+    {
+      return p;
+    }
+  }
+  return end;
+}
+
+InputByteStream::InputByteStream(std::istream& istream)
+: m_Input(istream)
+, m_bufferFill(0)
+, m_readPos(0)
+, m_keepPos(0)
+, m_bufferOffset(0)
+, m_inputEof(false)
+{
+}
+
+/**
+ * Read the next block of the input stream into the buffer.  The
+ * bytes preceding m_keepPos are discarded, the buffer grows if the
+ * remaining bytes do not leave space for a block.
+ *
+ * Returns false if no more bytes are available.
+ */
+Bool InputByteStream::xFillBuffer()
+{
+  if (m_inputEof)
+  {
+    return false;
+  }
+
+  if (m_keepPos > 0)
+  {
+    memmove(&m_buffer[0], &m_buffer[m_keepPos], m_bufferFill - m_keepPos);
+    m_bufferOffset += streamoff(m_keepPos);
+    m_bufferFill   -= m_keepPos;
+    m_readPos      -= m_keepPos;
+    m_keepPos       = 0;
+  }
+  if (m_buffer.size() - m_bufferFill < ANNEXB_READ_BLOCK_SIZE)
+  {
+    m_buffer.resize(m_bufferFill + ANNEXB_READ_BLOCK_SIZE);
+  }
+
+  m_Input.read((char*)&m_buffer[m_bufferFill], streamsize(m_buffer.size() - m_bufferFill));
+  const size_t numBytesRead = size_t(m_Input.gcount());
+  m_bufferFill += numBytesRead;
+  if (numBytesRead == 0)
+  {
+    m_inputEof = true;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * returns true if numBytes bytes are available from the current position,
+ * reading further blocks from the input stream as required.
+ */
+Bool InputByteStream::xAvailable(size_t numBytes)
+{
+  while (m_bufferFill - m_readPos < numBytes)
+  {
+    if (!xFillBuffer())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * returns true if the next bytes form the three-byte sequence 0x000001
+ * (numBytesStartCode = 3) or the four-byte sequence 0x00000001
+ * (numBytesStartCode = 4).
+ */
+Bool InputByteStream::xIsStartCode(size_t numBytesStartCode)
+{
+  if (!xAvailable(numBytesStartCode))
+  {
+    return false;
+  }
+  const uint8_t* p = &m_buffer[m_readPos];
+  for (size_t i = 0; i < numBytesStartCode - 1; i++)
+  {
+    if (p[i] != 0)
+    {
+      return false;
+    }
+  }
+  return p[numBytesStartCode - 1] == 1;
+}
+
+Bool InputByteStream::readNALUnit(const uint8_t*& rpNalUnit, size_t& rNumBytes, AnnexBStats& stats)
 {
+  rpNalUnit = NULL;
+  rNumBytes = 0;
+  m_keepPos = m_readPos;
+
   /* At the beginning of the decoding process, the decoder initialises its
    * current position in the byte stream to the beginning of the byte stream.
    * It then extracts and discards each leading_zero_8bits syntax element (if
@@ -72,17 +191,14 @@ _byteStreamNALUnit(
    * that the next four bytes in the bitstream form the four-byte sequence
    * 0x00000001.
    */
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  TComCodingStatistics::SStat &statBits=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_PACKING);
-#endif
-  while ((bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) != 0x000001)
-  &&     (bs.eofBeforeNBytes(32/8) || bs.peekBytes(32/8) != 0x00000001))
+  while (!xIsStartCode(3) && !xIsStartCode(4))
   {
-    uint8_t leading_zero_8bits = bs.readByte();
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    statBits.bits+=8; statBits.count++;
-#endif
-    assert(leading_zero_8bits == 0);
+    if (!xAvailable(1))
+    {
+      return true;
+    }
+    assert(m_buffer[m_readPos] == 0);
+    m_readPos++;
     stats.m_numLeadingZero8BitsBytes++;
   }
 
@@ -92,15 +208,9 @@ _byteStreamNALUnit(
    * the byte stream is set equal to the position of the byte following this
    * discarded byte.
    */
-  /* NB, the previous step guarantees this will succeed -- if EOF was
-   * encountered, an exception will stop execution getting this far */
-  if (bs.peekBytes(24/8) != 0x000001)
+  if (!xIsStartCode(3))
   {
-    uint8_t zero_byte = bs.readByte();
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    statBits.bits+=8; statBits.count++;
-#endif
-    assert(zero_byte == 0);
+    m_readPos++;
     stats.m_numZeroByteBytes++;
   }
 
@@ -109,12 +219,7 @@ _byteStreamNALUnit(
    * position in the byte stream is set equal to the position of the byte
    * following this three-byte sequence.
    */
-  /* NB, (1) guarantees that the next three bytes are 0x00 00 01 */
-  uint32_t start_code_prefix_one_3bytes = bs.readBytes(24/8);
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  statBits.bits+=24; statBits.count+=3;
-#endif
-  assert(start_code_prefix_one_3bytes == 0x000001);
+  m_readPos += 3;
   stats.m_numStartCodePrefixBytes += 3;
 
   /* 3. NumBytesInNALunit is set equal to the number of bytes starting with
@@ -125,24 +230,37 @@ _byteStreamNALUnit(
    *   b. A subsequent byte-aligned three-byte sequence equal to 0x000001, or
    *   c. The end of the byte stream, as determined by unspecified means.
    */
+  /* NB, the buffer is refilled until the end is found, indices relative to
+   * m_keepPos survive the refills. */
+  const size_t nalUnitStart = m_readPos - m_keepPos;
+  size_t scanPos = m_readPos;
+  Bool eof = false;
+  for (;;)
+  {
+    const uint8_t* pBuffer = m_buffer.empty() ? NULL : &m_buffer[0];
+    const uint8_t* pEnd    = findNALUnitEnd(pBuffer + scanPos, pBuffer + m_bufferFill);
+    if (pEnd != pBuffer + m_bufferFill)
+    {
+      m_readPos = size_t(pEnd - pBuffer);
+      break;
+    }
+    /* the last two bytes may start a sequence completed by the next block */
+    size_t numBytesScanned = max(scanPos, m_bufferFill > 2 ? m_bufferFill - 2 : 0) - m_keepPos;
+    if (!xFillBuffer())
+    {
+      m_readPos = m_bufferFill;
+      eof = true;
+      break;
+    }
+    scanPos = m_keepPos + numBytesScanned;
+  }
+
   /* 4. NumBytesInNALunit bytes are removed from the bitstream and the
    * current position in the byte stream is advanced by NumBytesInNALunit
    * bytes. This sequence of bytes is nal_unit( NumBytesInNALunit ) and is
    * decoded using the NAL unit decoding process
    */
-  /* NB, (unsigned)x > 2 implies n!=0 && n!=1 */
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  TComCodingStatistics::SStat &bodyStats=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
-#endif
-  while (bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) > 2)
-  {
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    uint8_t thebyte=bs.readByte();bodyStats.bits+=8;bodyStats.count++;
-    nalUnit.push_back(thebyte);
-#else
-    nalUnit.push_back(bs.readByte());
-#endif
-  }
+  rNumBytes = m_readPos - (m_keepPos + nalUnitStart);
 
   /* 5. When the current position in the byte stream is:
    *  - not at the end of the byte stream (as determined by unspecified means)
@@ -158,17 +276,47 @@ _byteStreamNALUnit(
    *  - the end of the byte stream has been encountered (as determined by
    *    unspecified means).
    */
-  /* NB, (3) guarantees there are at least three bytes available or none */
-  while ((bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) != 0x000001)
-  &&     (bs.eofBeforeNBytes(32/8) || bs.peekBytes(32/8) != 0x00000001))
+  while (!eof && !xIsStartCode(3) && !xIsStartCode(4))
   {
-    uint8_t trailing_zero_8bits = bs.readByte();
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    statBits.bits+=8; statBits.count++;
-#endif
-    assert(trailing_zero_8bits == 0);
+    if (!xAvailable(1))
+    {
+      eof = true;
+      break;
+    }
+    assert(m_buffer[m_readPos] == 0);
+    m_readPos++;
     stats.m_numTrailingZero8BitsBytes++;
   }
+
+  if (rNumBytes > 0)
+  {
+    rpNalUnit = &m_buffer[m_keepPos + nalUnitStart];
+  }
+  return eof;
+}
+
+Void InputByteStream::setPosition(std::streamoff pos)
+{
+  if (pos >= m_bufferOffset && pos <= m_bufferOffset + streamoff(m_bufferFill))
+  {
+    m_readPos = size_t(pos - m_bufferOffset);
+    m_keepPos = min(m_keepPos, m_readPos);
+    return;
+  }
+
+  m_Input.clear();
+  m_Input.seekg(pos);
+  m_bufferFill   = 0;
+  m_readPos      = 0;
+  m_keepPos      = 0;
+  m_bufferOffset = pos;
+  m_inputEof     = false;
+}
+
+const uint8_t* InputByteStream::getBufferedBytes(std::streamoff pos) const
+{
+  assert(pos >= m_bufferOffset + streamoff(m_keepPos) && pos <= m_bufferOffset + streamoff(m_bufferFill));
+  return m_buffer.empty() ? NULL : &m_buffer[0] + (pos - m_bufferOffset);
 }
 
 /**
@@ -184,15 +332,23 @@ byteStreamNALUnit(
   vector<uint8_t>& nalUnit,
   AnnexBStats& stats)
 {
-  Bool eof = false;
-  try
-  {
-    _byteStreamNALUnit(bs, nalUnit, stats);
-  }
-  catch (...)
-  {
-    eof = true;
-  }
+  const uint8_t* pNalUnit;
+  size_t numBytes;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  const AnnexBStats statsIn = stats;
+#endif
+  Bool eof = bs.readNALUnit(pNalUnit, numBytes, stats);
+  nalUnit.assign(pNalUnit, pNalUnit + numBytes);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  TComCodingStatistics::SStat &statBits=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_PACKING);
+  TComCodingStatistics::SStat &bodyStats=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
+  const UInt numPackingBytes = (stats.m_numLeadingZero8BitsBytes  - statsIn.m_numLeadingZero8BitsBytes)
+                             + (stats.m_numZeroByteBytes          - statsIn.m_numZeroByteBytes)
+                             + (stats.m_numStartCodePrefixBytes   - statsIn.m_numStartCodePrefixBytes)
+                             + (stats.m_numTrailingZero8BitsBytes - statsIn.m_numTrailingZero8BitsBytes);
+  statBits.bits+=8*numPackingBytes; statBits.count+=numPackingBytes;
+  bodyStats.bits+=8*UInt(numBytes); bodyStats.count+=UInt(numBytes);
+#endif
   stats.m_numBytesInNALUnit = UInt(nalUnit.size());
   return eof;
 }
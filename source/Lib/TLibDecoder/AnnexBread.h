@@ -50,146 +50,88 @@
 //! \ingroup TLibDecoder
 //! \{
 
+/**
+ * Statistics associated with AnnexB bytestreams
+ */
+struct AnnexBStats
+{
+  UInt m_numLeadingZero8BitsBytes;
+  UInt m_numZeroByteBytes;
+  UInt m_numStartCodePrefixBytes;
+  UInt m_numBytesInNALUnit;
+  UInt m_numTrailingZero8BitsBytes;
+
+  AnnexBStats& operator+=(const AnnexBStats& rhs)
+  {
+    this->m_numLeadingZero8BitsBytes += rhs.m_numLeadingZero8BitsBytes;
+    this->m_numZeroByteBytes += rhs.m_numZeroByteBytes;
+    this->m_numStartCodePrefixBytes += rhs.m_numStartCodePrefixBytes;
+    this->m_numBytesInNALUnit += rhs.m_numBytesInNALUnit;
+    this->m_numTrailingZero8BitsBytes += rhs.m_numTrailingZero8BitsBytes;
+    return *this;
+  }
+};
+
 class InputByteStream
 {
 public:
   /**
    * Create a bytestream reader that will extract bytes from
-   * istream.
+   * istream.  The input is read in large blocks into an internal
+   * buffer, in which the NAL units are located.
    *
    * NB, it isn't safe to access istream while in use by a
-   * InputByteStream.
-   *
-   * Side-effects: the exception mask of istream is set to eofbit
+   * InputByteStream, use getPosition() and setPosition() instead
+   * of tellg() and seekg().
    */
-  InputByteStream(std::istream& istream)
-  : m_NumFutureBytes(0)
-  , m_FutureBytes(0)
-  , m_Input(istream)
-  {
-    istream.exceptions(std::istream::eofbit | std::istream::badbit);
-  }
-
-  /**
-   * Reset the internal state.  Must be called if input stream is
-   * modified externally to this class
-   */
-  Void reset()
-  {
-    m_NumFutureBytes = 0;
-    m_FutureBytes = 0;
-  }
-
-  /**
-   * returns true if an EOF will be encountered within the next
-   * n bytes.
-   */
-  Bool eofBeforeNBytes(UInt n)
-  {
-    assert(n <= 4);
-    if (m_NumFutureBytes >= n)
-    {
-      return false;
-    }
-
-    n -= m_NumFutureBytes;
-    try
-    {
-      for (UInt i = 0; i < n; i++)
-      {
-        m_FutureBytes = (m_FutureBytes << 8) | m_Input.get();
-        m_NumFutureBytes++;
-      }
-    }
-    catch (...)
-    {
-      return true;
-    }
-    return false;
-  }
+  InputByteStream(std::istream& istream);
 
   /**
-   * return the next n bytes in the stream without advancing
-   * the stream pointer.
-   *
-   * Returns: an unsigned integer representing an n byte bigendian
-   * word.
+   * Parse the next NAL unit of the Annex B bytestream while
+   * accumulating bytestream statistics into stats.  The start codes
+   * are located a machine word at a time.
    *
-   * If an attempt is made to read past EOF, an n-byte word is
-   * returned, but the portion that required input bytes beyond EOF
-   * is undefined.
+   * On return, rpNalUnit points to the NumBytesInNALunit bytes of the
+   * NAL unit within the internal buffer.  The pointer stays valid
+   * until the next call of readNALUnit() or setPosition().
    *
+   * Returns true if EOF was reached (NB, nalunit data may be valid),
+   *         otherwise false.
    */
-  uint32_t peekBytes(UInt n)
-  {
-    eofBeforeNBytes(n);
-    return m_FutureBytes >> 8*(m_NumFutureBytes - n);
-  }
+  Bool readNALUnit(const uint8_t*& rpNalUnit, size_t& rNumBytes, AnnexBStats& stats);
 
   /**
-   * consume and return one byte from the input.
-   *
-   * If bytestream is already at EOF prior to a call to readByte(),
-   * an exception std::ios_base::failure is thrown.
+   * returns the position of the next byte to be parsed, counted from
+   * the position of the istream when the InputByteStream was created.
    */
-  uint8_t readByte()
-  {
-    if (!m_NumFutureBytes)
-    {
-      uint8_t byte = m_Input.get();
-      return byte;
-    }
-    m_NumFutureBytes--;
-    uint8_t wanted_byte = m_FutureBytes >> 8*m_NumFutureBytes;
-    m_FutureBytes &= ~(0xff << 8*m_NumFutureBytes);
-    return wanted_byte;
-  }
+  std::streamoff getPosition() const { return m_bufferOffset + std::streamoff(m_readPos); }
 
   /**
-   * consume and return n bytes from the input.  n bytes from
-   * bytestream are interpreted as bigendian when assembling
-   * the return value.
+   * Continue parsing at position pos.  Positions from the start of
+   * the NAL unit last returned by readNALUnit() on are served from
+   * the internal buffer, other positions require a seekable istream.
    */
-  uint32_t readBytes(UInt n)
-  {
-    uint32_t val = 0;
-    for (UInt i = 0; i < n; i++)
-    {
-      val = (val << 8) | readByte();
-    }
-    return val;
-  }
+  Void setPosition(std::streamoff pos);
 
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  UInt GetNumBufferedBytes() const { return m_NumFutureBytes; }
-#endif
+  /**
+   * returns the buffered bytes starting at position pos, which must
+   * not precede the start of the NAL unit last returned by
+   * readNALUnit().  The pointer is invalidated like the NAL unit.
+   */
+  const uint8_t* getBufferedBytes(std::streamoff pos) const;
 
 private:
-  UInt m_NumFutureBytes; /* number of valid bytes in m_FutureBytes */
-  uint32_t m_FutureBytes; /* bytes that have been peeked */
-  std::istream& m_Input; /* Input stream to read from */
-};
-
-/**
- * Statistics associated with AnnexB bytestreams
- */
-struct AnnexBStats
-{
-  UInt m_numLeadingZero8BitsBytes;
-  UInt m_numZeroByteBytes;
-  UInt m_numStartCodePrefixBytes;
-  UInt m_numBytesInNALUnit;
-  UInt m_numTrailingZero8BitsBytes;
-
-  AnnexBStats& operator+=(const AnnexBStats& rhs)
-  {
-    this->m_numLeadingZero8BitsBytes += rhs.m_numLeadingZero8BitsBytes;
-    this->m_numZeroByteBytes += rhs.m_numZeroByteBytes;
-    this->m_numStartCodePrefixBytes += rhs.m_numStartCodePrefixBytes;
-    this->m_numBytesInNALUnit += rhs.m_numBytesInNALUnit;
-    this->m_numTrailingZero8BitsBytes += rhs.m_numTrailingZero8BitsBytes;
-    return *this;
-  }
+  Bool xFillBuffer();
+  Bool xAvailable(size_t numBytes);
+  Bool xIsStartCode(size_t numBytesStartCode);
+
+  std::istream&        m_Input;        /* Input stream to read from */
+  std::vector<uint8_t> m_buffer;       /* bytes read from m_Input */
+  size_t               m_bufferFill;   /* number of valid bytes in m_buffer */
+  size_t               m_readPos;      /* index of the next byte to be parsed */
+  size_t               m_keepPos;      /* bytes from this index on are kept when refilling the buffer */
+  std::streamoff       m_bufferOffset; /* stream position of m_buffer[0] */
+  Bool                 m_inputEof;     /* all bytes of m_Input have been read */
 };
 
 Bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
@@ -109,6 +109,8 @@ Void TDecCu::create( UInt uiMaxDepth, UInt uiMaxWidth, UInt uiMaxHeight, ChromaF
   m_bDecodeDQP = false;
   m_IsChromaQpAdjCoded = false;
 
+  // the tables are initialized by TDecTop::xInitRomTables() when the layers are decoded in a pipeline
+#if !NH_MV_LAYER_PARALLEL_DEC
   // initialize partition order.
   UInt* piTmp = &g_auiZscanToRaster[0];
   initZscanToRaster(m_uiMaxDepth, 1, 0, piTmp);
@@ -116,6 +118,7 @@ Void TDecCu::create( UInt uiMaxDepth, UInt uiMaxWidth, UInt uiMaxHeight, ChromaF
 
   // initialize conversion matrix from partition index to pel
   initRasterToPelXY( uiMaxWidth, uiMaxHeight, m_uiMaxDepth );
+#endif
 }
 
 Void TDecCu::destroy()
@@ -158,6 +161,9 @@ Void TDecCu::decodeCtu( TComDataCU* pCtu, Bool& isLastCtuOfSliceSegment )
   {
     setIsChromaQpAdjCoded(true);
   }
+#if NH_3D_IC_PARAM_CACHE
+  m_pcPrediction->resetICParamCache();
+#endif
   
   // start from the top level CU
   xDecodeCU( pCtu, 0, 0, isLastCtuOfSliceSegment);
@@ -170,6 +176,9 @@ Void TDecCu::decodeCtu( TComDataCU* pCtu, Bool& isLastCtuOfSliceSegment )
 Void TDecCu::decompressCtu( TComDataCU* pCtu )
 {
 #if !NH_3D_IV_MERGE
+#if NH_3D_IC_PARAM_CACHE
+  m_pcPrediction->resetICParamCache();
+#endif
   xDecompressCU( pCtu, 0,  0 );
 #endif
 }
@@ -47,15 +47,109 @@
 
 //! \ingroup TLibDecoder
 //! \{
-static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, UInt &numChecksumErrors);
+static Bool calcAndAppendHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, std::string &rStatus);
+
+#if PIC_HASH_PARALLEL_DEC
+// ====================================================================================================================
+// Hash verification thread pool
+// ====================================================================================================================
+
+Void TDecPicHashPool::create( Int iNumThreads )
+{
+  m_cThreadPool.create( iNumThreads );
+  m_cNumPrinted.reset();
+  m_iNumAdded = 0;
+}
+
+Void TDecPicHashPool::destroy()
+{
+  waitAll();
+  m_cThreadPool.destroy();
+}
+
+Void TDecPicHashPool::addJob( PicHashStatus* pcJob )
+{
+  // the order is assigned under the same lock as the queue position, so a job only waits for jobs taken before it
+  std::unique_lock<std::mutex> cLock( m_cMutex );
+  xDeleteFinishedJobs();
+  pcJob->pcPool = this;
+  pcJob->iOrder = m_iNumAdded++;
+  m_apcJobs.push_back( pcJob );
+  m_cThreadPool.addJob( xPicHashJob, pcJob );
+}
+
+Void TDecPicHashPool::waitForPic( TComPic* pcPic )
+{
+  Int iLastOrder = -1;
+  {
+    std::unique_lock<std::mutex> cLock( m_cMutex );
+    for ( std::list<PicHashStatus*>::iterator it = m_apcJobs.begin(); it != m_apcJobs.end(); it++ )
+    {
+      if ( (*it)->pcPic == pcPic )
+      {
+        iLastOrder = std::max( iLastOrder, (*it)->iOrder );
+      }
+    }
+  }
+  if ( iLastOrder >= 0 )
+  {
+    m_cNumPrinted.waitFor( iLastOrder + 1 );
+  }
+}
+
+Void TDecPicHashPool::waitAll()
+{
+  m_cThreadPool.waitAll();
+  std::unique_lock<std::mutex> cLock( m_cMutex );
+  xDeleteFinishedJobs();
+  assert( m_apcJobs.empty() );
+}
+
+Void TDecPicHashPool::xDeleteFinishedJobs()
+{
+  // a job does not access its status after it has finished its turn
+  const Int iNumPrinted = m_cNumPrinted.get();
+  while ( !m_apcJobs.empty() && m_apcJobs.front()->iOrder < iNumPrinted )
+  {
+    delete m_apcJobs.front();
+    m_apcJobs.pop_front();
+  }
+}
+
+Void TDecPicHashPool::xPicHashJob( Void* pParam )
+{
+  PicHashStatus*   pcStatus = (PicHashStatus*)pParam;
+  TDecPicHashPool* pcPool   = pcStatus->pcPool;
+  const Int        iOrder   = pcStatus->iOrder;
+
+  const Bool bMismatch = calcAndAppendHashStatus( *pcStatus->pcPic->getPicYuvRec(), pcStatus->bHasHashSEI ? &pcStatus->cHashSEI : NULL, pcStatus->bitDepths, pcStatus->cLine );
+
+  // the status lines are printed and the errors are counted in decoding order
+  pcPool->m_cNumPrinted.waitFor( iOrder );
+  if ( bMismatch )
+  {
+    (*pcStatus->puiNumChecksumErrors)++;
+  }
+  printf( "%s\n", pcStatus->cLine.c_str() );
+  fflush( stdout );
+  pcPool->m_cNumPrinted.set( iOrder + 1 );
+}
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
 
 TDecGop::TDecGop()
  : m_numberOfChecksumErrorsDetected(0)
+#if PIC_HASH_PARALLEL_DEC
+ , m_pcPicHashPool(NULL)
+#endif
 {
   m_dDecTime = 0;
+#if NH_MV_LAYER_PARALLEL_DEC
+  m_dFilterTime = 0;
+#endif
 }
 
 TDecGop::~TDecGop()
@@ -176,49 +270,123 @@ Void TDecGop::filterPicture(TComPic* pcPic)
 #else
   pcPic->compressMotion();
 #endif
+  //-- For time output for each slice
+  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+  xPrintPictureStatus( pcPic, pcSlice->isReferenced() );
+#if !NH_MV
+  pcPic->setOutputMark(pcPic->getSlice(0)->getPicOutputFlag() ? true : false);
+  pcPic->setReconMark(true);
+#endif
+}
+
+#if NH_MV_LAYER_PARALLEL_DEC
+/** In-loop filter a picture CTU row by CTU row while the CTUs are decoded by another thread.
+ * The deblocking of a CTU row modifies the lowest lines of the row above and the SAO of a row reads the first line of the row below,
+ * so a row is complete once the row below it has been deblocked. Complete rows are published to the pictures referring to this one.
+ * \param pcPic picture
+ */
+Void TDecGop::filterPictureCtuRows( TComPic* pcPic )
+{
+  TComSlice*     pcSlice          = pcPic->getSlice(0);
+  TComProgress*  pcDecodedCtuRows = m_pcSliceDecoder->getDecodedCtuRows();
+  const Int      numCtuRows       = pcPic->getPicSym()->getFrameHeightInCtus();
+  const Int      ctuHeight        = pcSlice->getSPS()->getMaxCUHeight();
+  const Bool     bUseSAO          = pcSlice->getSPS()->getUseSAO();
+
+  clock_t iBeforeTime = clock();
+  m_pcLoopFilter->setCfg( pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag() );
+
+  for ( Int ctuRow = 0; ctuRow <= numCtuRows; ctuRow++ )
+  {
+    if ( ctuRow < numCtuRows )
+    {
+      // the intra prediction of the row below reads the unfiltered samples of this row
+      pcDecodedCtuRows->waitFor( std::min( ctuRow + 2, numCtuRows ) );
+      m_pcLoopFilter->loopFilterCtuRow( pcPic, ctuRow );
+    }
+    if ( ctuRow > 0 )
+    {
+      const Int finishedRow = ctuRow - 1;
+      if ( bUseSAO )
+      {
+        m_pcSAO->SAOProcessCtuRow( pcPic, finishedRow );
+        m_pcSAO->PCMLFDisableProcessCtuRow( pcPic, finishedRow );
+      }
+#if NH_3D
+      pcPic->compressMotionCtuRow( 2, finishedRow );
+#else
+      pcPic->compressMotionCtuRow( finishedRow );
+#endif
+      pcPic->getPicYuvRec()->extendPicBorderLines( finishedRow * ctuHeight, ctuHeight );
+      pcPic->setCtuRowProgress( ctuRow );
+    }
+  }
+  m_dFilterTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+}
+
+/** Print the status line of a picture filtered by filterPictureCtuRows(), after both its decoding and filtering have finished.
+ * \param pcPic        picture
+ * \param isReferenced the picture was marked as referenced when it was decoded
+ */
+Void TDecGop::printPictureStatus( TComPic* pcPic, Bool isReferenced )
+{
+  m_dDecTime   += m_dFilterTime;
+  m_dFilterTime = 0;
+  xPrintPictureStatus( pcPic, isReferenced );
+}
+#endif
+
+/** Print the status line of a decoded picture: slice type, reference pictures, decoding time and hash check.
+ * \param pcPic        picture
+ * \param isReferenced the picture is marked as referenced
+ */
+Void TDecGop::xPrintPictureStatus( TComPic* pcPic, Bool isReferenced )
+{
+  TComSlice*  pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  std::string cLine;
+
   TChar c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!pcSlice->isReferenced())
+  if (!isReferenced)
   {
     c += 32;
   }
 
   //-- For time output for each slice
 #if NH_MV
-  printf("Layer %2d   POC %4d TId: %1d ( %c-SLICE, QP%3d ) ", pcSlice->getLayerId(),
-                                                              pcSlice->getPOC(),
+  appendFormat(cLine, "Layer %2d   POC %4d TId: %1d ( %c-SLICE, QP%3d ) ", pcSlice->getLayerId(),
+                                                                          pcSlice->getPOC(),
+                                                                          pcSlice->getTLayer(),
+                                                                          c,
+                                                                          pcSlice->getSliceQp() );
+#else
+  appendFormat(cLine, "POC %4d TId: %1d ( %c-SLICE, QP%3d ) ", pcSlice->getPOC(),
                                                               pcSlice->getTLayer(),
                                                               c,
                                                               pcSlice->getSliceQp() );
-#else
-  printf("POC %4d TId: %1d ( %c-SLICE, QP%3d ) ", pcSlice->getPOC(),
-                                                  pcSlice->getTLayer(),
-                                                  c,
-                                                  pcSlice->getSliceQp() );
 #endif
 
-  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
-  printf ("[DT %6.3f] ", m_dDecTime );
+  appendFormat(cLine, "[DT %6.3f] ", m_dDecTime );
   m_dDecTime  = 0;
 
   for (Int iRefList = 0; iRefList < 2; iRefList++)
   {
-    printf ("[L%d ", iRefList);
+    appendFormat(cLine, "[L%d ", iRefList);
     for (Int iRefIndex = 0; iRefIndex < pcSlice->getNumRefIdx(RefPicList(iRefList)); iRefIndex++)
     {
 #if NH_MV
       if( pcSlice->getLayerId() != pcSlice->getRefLayerId( RefPicList(iRefList), iRefIndex ) )
       {
-        printf( "V%d ", pcSlice->getRefLayerId( RefPicList(iRefList), iRefIndex ) );
+        appendFormat(cLine, "V%d ", pcSlice->getRefLayerId( RefPicList(iRefList), iRefIndex ) );
       }
       else
       {
 #endif
-      printf ("%d ", pcSlice->getRefPOC(RefPicList(iRefList), iRefIndex));
+      appendFormat(cLine, "%d ", pcSlice->getRefPOC(RefPicList(iRefList), iRefIndex));
 #if NH_MV
       }
 #endif
     }
-    printf ("] ");
+    appendFormat(cLine, "] ");
   }
   if (m_decodedPictureHashSEIEnabled)
   {
@@ -226,21 +394,38 @@ Void TDecGop::filterPicture(TComPic* pcPic)
     const SEIDecodedPictureHash *hash = ( pictureHashes.size() > 0 ) ? (SEIDecodedPictureHash*) *(pictureHashes.begin()) : NULL;
     if (pictureHashes.size() > 1)
     {
-      printf ("Warning: Got multiple decoded picture hash SEI messages. Using first.");
+      appendFormat(cLine, "Warning: Got multiple decoded picture hash SEI messages. Using first.");
+    }
+#if PIC_HASH_PARALLEL_DEC
+    if ( m_pcPicHashPool != NULL && m_pcPicHashPool->isParallel() )
+    {
+      // the SEI messages of the picture may be released before the job has run
+      PicHashStatus* pcStatus        = new PicHashStatus;
+      pcStatus->pcPic                = pcPic;
+      pcStatus->bHasHashSEI          = ( hash != NULL );
+      if ( hash != NULL )
+      {
+        pcStatus->cHashSEI           = *hash;
+      }
+      pcStatus->bitDepths            = pcSlice->getSPS()->getBitDepths();
+      pcStatus->cLine                = cLine;
+      pcStatus->puiNumChecksumErrors = &m_numberOfChecksumErrorsDetected;
+      m_pcPicHashPool->addJob( pcStatus );
+      return;
+    }
+#endif
+    if ( calcAndAppendHashStatus(*(pcPic->getPicYuvRec()), hash, pcSlice->getSPS()->getBitDepths(), cLine) )
+    {
+      m_numberOfChecksumErrorsDetected++;
     }
-    calcAndPrintHashStatus(*(pcPic->getPicYuvRec()), hash, pcSlice->getSPS()->getBitDepths(), m_numberOfChecksumErrorsDetected);
   }
 
-  printf("\n");
-#if !NH_MV
-  pcPic->setOutputMark(pcPic->getSlice(0)->getPicOutputFlag() ? true : false);
-  pcPic->setReconMark(true);
-#endif
+  printf("%s\n", cLine.c_str());
 }
 
 /**
- * Calculate and print hash for pic, compare to picture_digest SEI if
- * present in seis.  seis may be NULL.  Hash is printed to stdout, in
+ * Calculate and append hash for pic to rStatus, compare to picture_digest SEI if
+ * present in seis.  seis may be NULL.  Hash is formatted in
  * a manner suitable for the status line. Theformat is:
  *  [Hash_type:xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx,(yyy)]
  * Where, x..x is the hash
@@ -248,8 +433,9 @@ Void TDecGop::filterPicture(TComPic* pcPic)
  *            OK          - calculated hash matches the SEI message
  *            ***ERROR*** - calculated hash does not match the SEI message
  *            unk         - no SEI message was available for comparison
+ * Returns true for a mismatch.
  */
-static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, UInt &numChecksumErrors)
+static Bool calcAndAppendHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, std::string &rStatus)
 {
   /* calculate MD5sum for entire reconstructed picture */
   TComPictureHash recon_digest;
@@ -300,12 +486,12 @@ static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash*
     }
   }
 
-  printf("[%s:%s,%s] ", hashType, hashToString(recon_digest, numChar).c_str(), ok);
+  appendFormat(rStatus, "[%s:%s,%s] ", hashType, hashToString(recon_digest, numChar).c_str(), ok);
 
   if (mismatch)
   {
-    numChecksumErrors++;
-    printf("[rx%s:%s] ", hashType, hashToString(pictureHashSEI->m_pictureHash, numChar).c_str());
+    appendFormat(rStatus, "[rx%s:%s] ", hashType, hashToString(pictureHashSEI->m_pictureHash, numChar).c_str());
   }
+  return mismatch;
 }
 //! \}
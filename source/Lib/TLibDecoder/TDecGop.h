@@ -49,6 +49,11 @@
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TLibCommon/SEI.h"
+#if PIC_HASH_PARALLEL_DEC
+#include "TLibCommon/TComThreadPool.h"
+#include <list>
+#endif
 
 #include "TDecEntropy.h"
 #include "TDecSlice.h"
@@ -65,6 +70,53 @@
 class TDecTop; 
 #endif
 
+#if PIC_HASH_PARALLEL_DEC
+class TDecPicHashPool;
+#endif
+
+/// decoded picture hash check of a picture and its status line
+struct PicHashStatus
+{
+#if PIC_HASH_PARALLEL_DEC
+  TDecPicHashPool*      pcPool;
+#endif
+  TComPic*              pcPic;
+  SEIDecodedPictureHash cHashSEI;
+  Bool                  bHasHashSEI;
+  BitDepths             bitDepths;
+  std::string           cLine;                     ///< status line up to the hash
+  UInt*                 puiNumChecksumErrors;      ///< error counter of the GOP decoder
+#if PIC_HASH_PARALLEL_DEC
+  Int                   iOrder;                    ///< position of the status line in the log output
+#endif
+};
+
+#if PIC_HASH_PARALLEL_DEC
+/// threads verifying the decoded picture hash SEI messages of decoded pictures, shared by the GOP decoders of all layers
+class TDecPicHashPool
+{
+private:
+  TComThreadPool          m_cThreadPool;
+  TComProgress            m_cNumPrinted;          ///< number of jobs that have printed their status line
+  Int                     m_iNumAdded;
+  std::list<PicHashStatus*> m_apcJobs;            ///< jobs that may not have finished yet
+  std::mutex              m_cMutex;
+
+  static Void xPicHashJob( Void* pParam );
+  Void xDeleteFinishedJobs();                     ///< m_cMutex must be locked
+
+public:
+  TDecPicHashPool() : m_iNumAdded( 0 ) {}
+
+  Void create     ( Int iNumThreads );            ///< for iNumThreads <= 1 the hashes are verified by the decoding thread
+  Void destroy    ();
+  Void addJob     ( PicHashStatus* pcJob );       ///< takes the ownership of pcJob
+  Void waitForPic ( TComPic* pcPic );             ///< block until the hash of pcPic has been verified, so that it can be deleted or reused
+  Void waitAll    ();
+  Bool isParallel ()                    { return m_cThreadPool.isParallel(); }
+};
+#endif
+
 
 /// GOP decoder class
 class TDecGop
@@ -85,8 +137,16 @@ private:
 
   TComSampleAdaptiveOffset*     m_pcSAO;
   Double                m_dDecTime;
+#if NH_MV_LAYER_PARALLEL_DEC
+  Double                m_dFilterTime;                   ///< in-loop filter time of the picture in the layer pipeline
+#endif
   Int                   m_decodedPictureHashSEIEnabled;  ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   UInt                  m_numberOfChecksumErrorsDetected;
+#if PIC_HASH_PARALLEL_DEC
+  TDecPicHashPool*      m_pcPicHashPool;
+#endif
+
+  Void  xPrintPictureStatus ( TComPic* pcPic, Bool isReferenced );
 
 public:
   TDecGop();
@@ -104,9 +164,17 @@ public:
   Void  destroy ();
   Void  decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic );
   Void  filterPicture  (TComPic* pcPic );
+#if NH_MV_LAYER_PARALLEL_DEC
+  Void  filterPictureCtuRows( TComPic* pcPic );                   ///< in-loop filter the CTU rows while they are decoded by another thread
+  Void  printPictureStatus  ( TComPic* pcPic, Bool isReferenced ); ///< print the status line of a picture filtered by filterPictureCtuRows()
+#endif
 
   Void setDecodedPictureHashSEIEnabled(Int enabled) { m_decodedPictureHashSEIEnabled = enabled; }
   UInt getNumberOfChecksumErrorsDetected() const { return m_numberOfChecksumErrorsDetected; }
+#if PIC_HASH_PARALLEL_DEC
+  Void setPicHashPool( TDecPicHashPool* pcPicHashPool ) { m_pcPicHashPool = pcPicHashPool; }
+  Void waitPicHash   ( TComPic* pcPic )                 { if ( m_pcPicHashPool != NULL ) { m_pcPicHashPool->waitForPic( pcPic ); } }
+#endif
 
 };
 
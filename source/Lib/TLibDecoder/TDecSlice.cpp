@@ -36,6 +36,7 @@
 */
 
 #include "TDecSlice.h"
+#include <algorithm>
 
 //! \ingroup TLibDecoder
 //! \{
@@ -44,7 +45,57 @@
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
+#if SUBSTREAM_PARALLEL_DEC
+TDecSubstreamDecoder::TDecSubstreamDecoder()
+: m_bCuDecoderCreated( false )
+, m_uiMaxTotalCUDepth( 0 )
+, m_uiMaxCUWidth     ( 0 )
+, m_uiMaxCUHeight    ( 0 )
+, m_chromaFormatIdc  ( CHROMA_420 )
+{
+  m_cSbacDecoder.init( (TDecBinIf*)&m_cBinCABAC );
+  m_cEntropyDecoder.init( &m_cPrediction );
+  m_cCuDecoder.init( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
+}
+
+TDecSubstreamDecoder::~TDecSubstreamDecoder()
+{
+}
+
+/** set up the decoding classes like the ones of the decoder, the CU decoder buffers are only reallocated if the SPS requires it
+ * \param rcSPS active SPS
+ */
+Void TDecSubstreamDecoder::create( const TComSPS& rcSPS )
+{
+  if ( !m_bCuDecoderCreated || m_uiMaxTotalCUDepth != rcSPS.getMaxTotalCUDepth() || m_uiMaxCUWidth != rcSPS.getMaxCUWidth()
+                            || m_uiMaxCUHeight != rcSPS.getMaxCUHeight() || m_chromaFormatIdc != rcSPS.getChromaFormatIdc() )
+  {
+    destroy();
+    m_uiMaxTotalCUDepth = rcSPS.getMaxTotalCUDepth();
+    m_uiMaxCUWidth      = rcSPS.getMaxCUWidth();
+    m_uiMaxCUHeight     = rcSPS.getMaxCUHeight();
+    m_chromaFormatIdc   = rcSPS.getChromaFormatIdc();
+    m_cCuDecoder.create( m_uiMaxTotalCUDepth, m_uiMaxCUWidth, m_uiMaxCUHeight, m_chromaFormatIdc );
+    m_bCuDecoderCreated = true;
+  }
+  m_cPrediction.initTempBuff( rcSPS.getChromaFormatIdc() );
+  m_cTrQuant.init( rcSPS.getMaxTrSize() );
+}
+
+Void TDecSubstreamDecoder::destroy()
+{
+  if ( m_bCuDecoderCreated )
+  {
+    m_cCuDecoder.destroy();
+    m_bCuDecoderCreated = false;
+  }
+}
+#endif
+
 TDecSlice::TDecSlice()
+#if NH_MV_LAYER_PARALLEL_DEC
+: m_uiNumDecodedCtuRows( 0 )
+#endif
 {
 }
 
@@ -58,6 +109,23 @@ Void TDecSlice::create()
 
 Void TDecSlice::destroy()
 {
+#if SUBSTREAM_PARALLEL_DEC
+  m_cSubstreamThreadPool.destroy();
+  for ( Int i = 0; i < (Int)m_apcSubstreamDecoders.size(); i++ )
+  {
+    m_apcSubstreamDecoders[i]->destroy();
+    delete m_apcSubstreamDecoders[i];
+  }
+  m_apcSubstreamDecoders.clear();
+  m_apcIdleSubstreamDecoders.clear();
+  for ( Int i = 0; i < (Int)m_apcSubstreamProgress.size(); i++ )
+  {
+    delete m_apcSubstreamProgress[i];
+    delete m_apcSubstreamSyncContextStates[i];
+  }
+  m_apcSubstreamProgress.clear();
+  m_apcSubstreamSyncContextStates.clear();
+#endif
 }
 
 Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder)
@@ -66,6 +134,404 @@ Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder)
   m_pcCuDecoder       = pcCuDecoder;
 }
 
+#if SUBSTREAM_PARALLEL_DEC
+/** Create the worker threads and their decoding classes used to decode the substreams of a slice segment in parallel.
+ * \param iNumThreads number of threads, 1: substreams are decoded sequentially
+ */
+Void TDecSlice::createSubstreamThreads( Int iNumThreads )
+{
+  // tracing and bit statistics require the CTUs to be processed in decoding order
+  const Int numThreads = ( ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS ) ? 1 : iNumThreads;
+  if ( numThreads <= 1 || !m_apcSubstreamDecoders.empty() )
+  {
+    return;
+  }
+
+  for ( Int i = 0; i < numThreads; i++ )
+  {
+    m_apcSubstreamDecoders.push_back( new TDecSubstreamDecoder );
+  }
+  m_apcIdleSubstreamDecoders = m_apcSubstreamDecoders;
+  m_cSubstreamThreadPool.create( numThreads );
+}
+
+/** Set up the decoding classes of the worker threads for the SPS of the current picture.
+ * \param rcSPS active SPS
+ */
+Void TDecSlice::createSubstreamDecoders( const TComSPS& rcSPS )
+{
+  for ( Int i = 0; i < (Int)m_apcSubstreamDecoders.size(); i++ )
+  {
+    m_apcSubstreamDecoders[i]->create( rcSPS );
+  }
+}
+
+Bool TDecSlice::xUseSubstreamThreads( TComSlice* pcSlice )
+{
+  return m_cSubstreamThreadPool.isParallel() && pcSlice->getNumberOfSubstreamSizes() > 0;
+}
+
+/** Decode the substreams (wavefront CTU rows or tiles) of a slice segment in parallel jobs.
+ * A wavefront CTU row starts decoding a CTU only once the row above has decoded the CTU above right of it.
+ * \param ppcSubstreams   substreams of the slice segment
+ * \param pcPic           picture
+ * \param pcSbacDecoder   SBAC decoder holding the contexts at the start of the slice segment, receives the contexts at its end
+ * \param uiNumSubstreams number of substreams of the slice segment
+ */
+Void TDecSlice::xDecompressSliceSubstreams( TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecSbac* pcSbacDecoder, const UInt uiNumSubstreams )
+{
+  TComSlice* pcSlice                 = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  const UInt startCtuTsAddr          = pcSlice->getSliceSegmentCurStartCtuTsAddr();
+  const UInt startCtuRsAddr          = pcPic->getPicSym()->getCtuTsToRsAddrMap(startCtuTsAddr);
+  const UInt numCtusInFrame          = pcPic->getNumberOfCtusInFrame();
+  const UInt frameWidthInCtus        = pcPic->getPicSym()->getFrameWidthInCtus();
+  const Bool wavefrontsEnabled       = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+  const UInt subStreamOffset         = pcPic->getSubstreamForCtuAddr(startCtuRsAddr, true, pcSlice);
+
+  while ( m_apcSubstreamProgress.size() < uiNumSubstreams )
+  {
+    m_apcSubstreamProgress         .push_back( new TComProgress );
+    m_apcSubstreamSyncContextStates.push_back( new TDecSbac );
+  }
+  m_cSubstreamJobs.resize( uiNumSubstreams );
+
+  // find the first CTU of each substream
+  UInt uiSubstream = 0;
+  for( UInt ctuTsAddr = startCtuTsAddr; uiSubstream < uiNumSubstreams && ctuTsAddr < numCtusInFrame; ctuTsAddr++)
+  {
+    const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
+    if ( pcPic->getSubstreamForCtuAddr(ctuRsAddr, true, pcSlice) - subStreamOffset != uiSubstream )
+    {
+      continue;
+    }
+    const TComTile &currentTile = *(pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(ctuRsAddr)));
+    const UInt firstCtuRsAddrOfTile = currentTile.getFirstCtuRsAddr();
+
+    SubstreamJob& rcJob           = m_cSubstreamJobs[uiSubstream];
+    rcJob.pcSliceDecoder          = this;
+    rcJob.pcSubstreamDecoder      = NULL;
+    rcJob.pcPic                   = pcPic;
+    rcJob.pcBitstream             = ppcSubstreams[uiSubstream];
+    rcJob.pcInitialState          = pcSbacDecoder;
+    rcJob.uiSubstream             = uiSubstream;
+    rcJob.uiStartCtuTsAddr        = ctuTsAddr;
+    rcJob.bRowAboveInSliceSegment = wavefrontsEnabled && uiSubstream > 0 && ctuRsAddr != firstCtuRsAddrOfTile;
+    rcJob.bLastCtuOfSliceSegment  = false;
+    rcJob.bSyncStateStored        = false;
+    m_apcSubstreamProgress[uiSubstream]->reset( ctuRsAddr % frameWidthInCtus - firstCtuRsAddrOfTile % frameWidthInCtus );
+    uiSubstream++;
+  }
+  assert( uiSubstream == uiNumSubstreams );
+
+  // Initialise the CTUs of all but the last substream up front: CTUs of other tiles are inspected (slice, address)
+  // by the availability checks of neighbouring CTUs and must not be initialised while another thread reads them.
+  // The extent of the last substream is only known after parsing it, but no other substream refers to it.
+  for ( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < m_cSubstreamJobs[uiNumSubstreams-1].uiStartCtuTsAddr; ctuTsAddr++ )
+  {
+    const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
+    pcPic->getCtu( ctuRsAddr )->initCtu( pcPic, ctuRsAddr );
+  }
+
+  for ( uiSubstream = 0; uiSubstream < uiNumSubstreams; uiSubstream++ )
+  {
+    m_cSubstreamThreadPool.addJob( xDecompressSubstreamJob, &m_cSubstreamJobs[uiSubstream] );
+  }
+  m_cSubstreamThreadPool.waitAll();
+
+  // the contexts of the last stored second CTU of a row are the ones the next slice segment may synchronize with
+  for ( uiSubstream = 0; uiSubstream < uiNumSubstreams; uiSubstream++ )
+  {
+    assert( m_cSubstreamJobs[uiSubstream].bLastCtuOfSliceSegment == ( uiSubstream+1 == uiNumSubstreams ) );
+    if ( m_cSubstreamJobs[uiSubstream].bSyncStateStored )
+    {
+      m_entropyCodingSyncContextState.loadContexts( m_apcSubstreamSyncContextStates[uiSubstream] );
+    }
+  }
+  pcSbacDecoder->loadContexts( m_cSubstreamJobs[uiNumSubstreams-1].pcSubstreamDecoder->getSbacDecoder() );
+}
+
+Void TDecSlice::xDecompressSubstreamJob( Void* pParam )
+{
+  SubstreamJob* pcJob = (SubstreamJob*)pParam;
+  pcJob->pcSliceDecoder->xDecompressSubstream( *pcJob );
+}
+
+/** Decode the CTUs of one substream with the decoding classes of a worker thread.
+ * \param rcJob substream job
+ */
+Void TDecSlice::xDecompressSubstream( SubstreamJob& rcJob )
+{
+  {
+    std::lock_guard<std::mutex> cLock( m_cSubstreamDecoderMutex );
+    assert( !m_apcIdleSubstreamDecoders.empty() );
+    rcJob.pcSubstreamDecoder = m_apcIdleSubstreamDecoders.back();
+    m_apcIdleSubstreamDecoders.pop_back();
+  }
+
+  TComPic*      pcPic             = rcJob.pcPic;
+  TComSlice*    pcSlice           = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  TDecCu*       pcCuDecoder       = rcJob.pcSubstreamDecoder->getCuDecoder();
+  TDecEntropy*  pcEntropyDecoder  = rcJob.pcSubstreamDecoder->getEntropyDecoder();
+  TDecSbac*     pcSbacDecoder     = rcJob.pcSubstreamDecoder->getSbacDecoder();
+  TComProgress* pcProgress        = m_apcSubstreamProgress[rcJob.uiSubstream];
+  TComProgress* pcProgressAbove   = rcJob.bRowAboveInSliceSegment ? m_apcSubstreamProgress[rcJob.uiSubstream-1] : NULL;
+  const UInt    numCtusInFrame    = pcPic->getNumberOfCtusInFrame();
+  const UInt    frameWidthInCtus  = pcPic->getPicSym()->getFrameWidthInCtus();
+  const Bool    wavefrontsEnabled = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+  const Bool    bLastSubstream    = ( rcJob.uiSubstream+1 == m_cSubstreamJobs.size() );    // CTUs of the other substreams are already initialised
+
+  pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder );
+  pcEntropyDecoder->setBitstream      ( rcJob.pcBitstream );
+  if ( rcJob.uiSubstream == 0 )
+  {
+    // the first substream has already been started by decompressSlice, possibly with the contexts of the previous slice segment
+    pcSbacDecoder->load( rcJob.pcInitialState );
+  }
+  else
+  {
+    pcEntropyDecoder->resetEntropy    ( pcSlice );
+  }
+
+  Bool isLastCtuOfSliceSegment = false;
+  UInt tileWidthInCtus         = 0;
+#if NH_MV_LAYER_PARALLEL_DEC
+  UInt numAvailCtuRows         = 0;
+#endif
+  for( UInt ctuTsAddr = rcJob.uiStartCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < numCtusInFrame; ctuTsAddr++)
+  {
+    const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
+    const TComTile &currentTile = *(pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(ctuRsAddr)));
+    const UInt firstCtuRsAddrOfTile = currentTile.getFirstCtuRsAddr();
+    const UInt tileXPosInCtus = firstCtuRsAddrOfTile % frameWidthInCtus;
+    const UInt tileYPosInCtus = firstCtuRsAddrOfTile / frameWidthInCtus;
+    const UInt ctuXPosInCtus  = ctuRsAddr % frameWidthInCtus;
+    const UInt ctuYPosInCtus  = ctuRsAddr / frameWidthInCtus;
+    tileWidthInCtus = currentTile.getTileWidthInCtus();
+
+    // the CTU above right has to be decoded before this one
+    if ( pcProgressAbove )
+    {
+      pcProgressAbove->waitFor( std::min( ctuXPosInCtus - tileXPosInCtus + 2, tileWidthInCtus ) );
+    }
+
+#if NH_MV_LAYER_PARALLEL_DEC
+    xWaitForRefPics( pcPic, ctuYPosInCtus, numAvailCtuRows );
+#endif
+
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+    if ( bLastSubstream )
+    {
+      pCtu->initCtu( pcPic, ctuRsAddr );
+    }
+
+    // set up CABAC contexts' state for this CTU, the entropy decoder has been reset at the start of the substream
+    if ( ctuRsAddr != firstCtuRsAddrOfTile && ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+    {
+      TComDataCU *pCtuUp = pCtu->getCtuAbove();
+      if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
+      {
+        TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+        if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+        {
+          // Top-right is available, so use it.
+          pcSbacDecoder->loadContexts( rcJob.bRowAboveInSliceSegment ? m_apcSubstreamSyncContextStates[rcJob.uiSubstream-1] : &m_entropyCodingSyncContextState );
+        }
+      }
+    }
+
+    if ( pcSlice->getSPS()->getUseSAO() )
+    {
+      xParseSAOBlkParam( pcPic, pcSlice, ctuRsAddr, pcSbacDecoder );
+    }
+
+    pcCuDecoder->decodeCtu     ( pCtu, isLastCtuOfSliceSegment );
+    pcCuDecoder->decompressCtu ( pCtu );
+
+    //Store probabilities of second CTU in line into buffer
+    if ( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled)
+    {
+      m_apcSubstreamSyncContextStates[rcJob.uiSubstream]->loadContexts( pcSbacDecoder );
+      rcJob.bSyncStateStored = true;
+    }
+    pcProgress->set( ctuXPosInCtus - tileXPosInCtus + 1 );
+
+    if (isLastCtuOfSliceSegment)
+    {
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+      pcSbacDecoder->parseRemainingBytes(false);
+#endif
+      if(!pcSlice->getDependentSliceSegmentFlag())
+      {
+        pcSlice->setSliceCurEndCtuTsAddr( ctuTsAddr+1 );
+      }
+      pcSlice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
+    }
+    else if (  ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus() &&
+             ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled)
+            )
+    {
+      // end of the substream (end of tile, end of wavefront-CTU-row)
+      UInt binVal;
+      pcSbacDecoder->parseTerminatingBit( binVal );
+      assert( binVal );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+      pcSbacDecoder->parseRemainingBytes(true);
+#endif
+      break;
+    }
+  }
+  pcProgress->set( tileWidthInCtus );
+  rcJob.bLastCtuOfSliceSegment = isLastCtuOfSliceSegment;
+
+  std::lock_guard<std::mutex> cLock( m_cSubstreamDecoderMutex );
+  m_apcIdleSubstreamDecoders.push_back( rcJob.pcSubstreamDecoder );
+}
+#endif
+
+#if NH_MV_LAYER_PARALLEL_DEC
+/// luma lines below the current CTU row an inter-layer reference is read from when inter_view_mv_vert_constraint_flag
+/// is set: vertical inter-layer motion vectors of up to 56 luma samples plus the interpolation filter taps
+static const Int INTER_VIEW_MV_VERT_REACH = 56 + 8;
+
+/** Collect the pictures the current slice segment may read from, in the layer pipeline they may still be decoded.
+ * \param pcPic   picture
+ * \param pcSlice current slice segment
+ */
+Void TDecSlice::xSetRefPics( TComPic* pcPic, TComSlice* pcSlice )
+{
+  std::vector<TComPic*> apcCandidates;
+  for ( Int iRefList = 0; iRefList < 2; iRefList++ )
+  {
+    for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( RefPicList( iRefList ) ); iRefIdx++ )
+    {
+      apcCandidates.push_back( pcSlice->getRefPic( RefPicList( iRefList ), iRefIdx ) );
+    }
+  }
+#if NH_3D_QTL
+  // texture and depth pictures of the same access unit used by the 3D coding tools
+  for ( Int iViewIdx = 0; iViewIdx <= pcSlice->getViewIndex(); iViewIdx++ )
+  {
+    apcCandidates.push_back( pcSlice->getIvPic( false, iViewIdx ) );
+    apcCandidates.push_back( pcSlice->getIvPic( true,  iViewIdx ) );
+  }
+#endif
+
+  m_apcRefPics   .clear();
+  m_aiRefPicReach.clear();
+  for ( size_t i = 0; i < apcCandidates.size(); i++ )
+  {
+    TComPic* pcRefPic = apcCandidates[i];
+    if ( pcRefPic == NULL || pcRefPic == pcPic || std::find( m_apcRefPics.begin(), m_apcRefPics.end(), pcRefPic ) != m_apcRefPics.end() )
+    {
+      continue;
+    }
+    // temporal references are complete, inter-layer references are only read close to the current CTU row if the motion is constrained
+    const Bool bConstrained = pcRefPic->getPOC() == pcSlice->getPOC() && pcSlice->getSPS()->getInterViewMvVertConstraintFlag();
+    m_apcRefPics   .push_back( pcRefPic );
+    m_aiRefPicReach.push_back( bConstrained ? INTER_VIEW_MV_VERT_REACH : MAX_INT );
+  }
+}
+
+/** Block until the reference pictures are reconstructed far enough to decode a CTU of the given CTU row.
+ * \param pcPic              picture
+ * \param uiCtuRow           CTU row of the CTU to be decoded
+ * \param ruiNumAvailCtuRows number of CTU rows for which the references have been waited for, updated
+ */
+Void TDecSlice::xWaitForRefPics( TComPic* pcPic, UInt uiCtuRow, UInt& ruiNumAvailCtuRows )
+{
+  if ( uiCtuRow < ruiNumAvailCtuRows )
+  {
+    return;
+  }
+  const Int ctuHeight = pcPic->getPicSym()->getSPS().getMaxCUHeight();
+  for ( size_t i = 0; i < m_apcRefPics.size(); i++ )
+  {
+    m_apcRefPics[i]->waitForLumaLines( m_aiRefPicReach[i] == MAX_INT ? MAX_INT : ( uiCtuRow + 1 ) * ctuHeight + m_aiRefPicReach[i] );
+  }
+  ruiNumAvailCtuRows = uiCtuRow + 1;
+}
+
+/** Start tracking the decoded CTU rows of a picture, the rows are read by the in-loop filter running concurrently.
+ * \param pcPic picture
+ */
+Void TDecSlice::initDecodedCtuRows( TComPic* pcPic )
+{
+  const UInt frameWidthInCtus  = pcPic->getPicSym()->getFrameWidthInCtus();
+  const UInt frameHeightInCtus = pcPic->getPicSym()->getFrameHeightInCtus();
+
+  // a CTU row is complete once all CTUs of it and of the rows above are decoded, i.e. the highest of their tile scan addresses
+  m_auiCtuRowEndTsAddr.resize( frameHeightInCtus );
+  UInt uiEndTsAddr = 0;
+  for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
+  {
+    uiEndTsAddr = std::max( uiEndTsAddr, pcPic->getPicSym()->getCtuRsToTsAddrMap( ctuRsAddr ) + 1 );
+    m_auiCtuRowEndTsAddr[ ctuRsAddr / frameWidthInCtus ] = uiEndTsAddr;
+  }
+  m_uiNumDecodedCtuRows = 0;
+  m_cDecodedCtuRows.reset( 0 );
+}
+
+/** Publish the CTU rows completed by the decoded CTUs.
+ * \param uiNumDecodedCtus number of decoded CTUs in tile scan
+ */
+Void TDecSlice::xSetDecodedCtus( UInt uiNumDecodedCtus )
+{
+  const UInt uiNumCtuRows = m_uiNumDecodedCtuRows;
+  while ( m_uiNumDecodedCtuRows < m_auiCtuRowEndTsAddr.size() && m_auiCtuRowEndTsAddr[m_uiNumDecodedCtuRows] <= uiNumDecodedCtus )
+  {
+    m_uiNumDecodedCtuRows++;
+  }
+  if ( m_uiNumDecodedCtuRows != uiNumCtuRows )
+  {
+    m_cDecodedCtuRows.set( m_uiNumDecodedCtuRows );
+  }
+}
+#endif
+
+/** parse the SAO parameters of a CTU
+ * \param pcPic         picture
+ * \param pcSlice       current slice
+ * \param ctuRsAddr     raster scan address of the CTU
+ * \param pcSbacDecoder SBAC decoder of the substream
+ */
+Void TDecSlice::xParseSAOBlkParam( TComPic* pcPic, TComSlice* pcSlice, const UInt ctuRsAddr, TDecSbac* pcSbacDecoder )
+{
+  const UInt frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+  SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
+  Bool bIsSAOSliceEnabled = false;
+  Bool sliceEnabled[MAX_NUM_COMPONENT];
+  for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    ComponentID compId=ComponentID(comp);
+    sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
+    if (sliceEnabled[compId])
+    {
+      bIsSAOSliceEnabled=true;
+    }
+    saoblkParam[compId].modeIdc = SAO_MODE_OFF;
+  }
+  if (bIsSAOSliceEnabled)
+  {
+    Bool leftMergeAvail = false;
+    Bool aboveMergeAvail= false;
+
+    //merge left condition
+    Int rx = (ctuRsAddr % frameWidthInCtus);
+    if(rx > 0)
+    {
+      leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
+    }
+    //merge up condition
+    Int ry = (ctuRsAddr / frameWidthInCtus);
+    if(ry > 0)
+    {
+      aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
+    }
+
+    pcSbacDecoder->parseSAOBlkParam( saoblkParam, sliceEnabled, leftMergeAvail, aboveMergeAvail, pcSlice->getSPS()->getBitDepths());
+  }
+}
+
 Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecSbac* pcSbacDecoder)
 {
   TComSlice* pcSlice                 = pcPic->getSlice(pcPic->getCurrSliceIdx());
@@ -139,6 +605,20 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
   // for every CTU in the slice segment...
 
   Bool isLastCtuOfSliceSegment = false;
+#if NH_MV_LAYER_PARALLEL_DEC
+  xSetRefPics( pcPic, pcSlice );
+  UInt numAvailCtuRows = 0;
+#endif
+#if SUBSTREAM_PARALLEL_DEC
+  if ( xUseSubstreamThreads( pcSlice ) )
+  {
+    xDecompressSliceSubstreams( ppcSubstreams, pcPic, pcSbacDecoder, pcSlice->getNumberOfSubstreamSizes()+1 );
+    isLastCtuOfSliceSegment = true;
+#if NH_MV_LAYER_PARALLEL_DEC
+    xSetDecodedCtus( pcSlice->getSliceSegmentCurEndCtuTsAddr() );
+#endif
+  }
+#endif
   for( UInt ctuTsAddr = startCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < numCtusInFrame; ctuTsAddr++)
   {
     const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
@@ -149,6 +629,9 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
     const UInt ctuXPosInCtus  = ctuRsAddr % frameWidthInCtus;
     const UInt ctuYPosInCtus  = ctuRsAddr / frameWidthInCtus;
     const UInt uiSubStrm=pcPic->getSubstreamForCtuAddr(ctuRsAddr, true, pcSlice)-subStreamOffset;
+#if NH_MV_LAYER_PARALLEL_DEC
+    xWaitForRefPics( pcPic, ctuYPosInCtus, numAvailCtuRows );
+#endif
     TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
     pCtu->initCtu( pcPic, ctuRsAddr );
 
@@ -187,39 +670,7 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
 
     if ( pcSlice->getSPS()->getUseSAO() )
     {
-      SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
-      Bool bIsSAOSliceEnabled = false;
-      Bool sliceEnabled[MAX_NUM_COMPONENT];
-      for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
-      {
-        ComponentID compId=ComponentID(comp);
-        sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
-        if (sliceEnabled[compId])
-        {
-          bIsSAOSliceEnabled=true;
-        }
-        saoblkParam[compId].modeIdc = SAO_MODE_OFF;
-      }
-      if (bIsSAOSliceEnabled)
-      {
-        Bool leftMergeAvail = false;
-        Bool aboveMergeAvail= false;
-
-        //merge left condition
-        Int rx = (ctuRsAddr % frameWidthInCtus);
-        if(rx > 0)
-        {
-          leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
-        }
-        //merge up condition
-        Int ry = (ctuRsAddr / frameWidthInCtus);
-        if(ry > 0)
-        {
-          aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
-        }
-
-        pcSbacDecoder->parseSAOBlkParam( saoblkParam, sliceEnabled, leftMergeAvail, aboveMergeAvail, pcSlice->getSPS()->getBitDepths());
-      }
+      xParseSAOBlkParam( pcPic, pcSlice, ctuRsAddr, pcSbacDecoder );
     }
 
     m_pcCuDecoder->decodeCtu     ( pCtu, isLastCtuOfSliceSegment );
@@ -234,6 +685,9 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
     {
       m_entropyCodingSyncContextState.loadContexts( pcSbacDecoder );
     }
+#if NH_MV_LAYER_PARALLEL_DEC
+    xSetDecodedCtus( ctuTsAddr+1 );
+#endif
 
     if (isLastCtuOfSliceSegment)
     {
@@ -49,6 +49,16 @@
 #include "TDecCu.h"
 #include "TDecSbac.h"
 #include "TDecBinCoderCABAC.h"
+#if SUBSTREAM_PARALLEL_DEC
+#include "TLibCommon/TComThreadPool.h"
+#include "TLibCommon/TComPrediction.h"
+#include "TLibCommon/TComTrQuant.h"
+#include <vector>
+#endif
+#if NH_MV_LAYER_PARALLEL_DEC && !SUBSTREAM_PARALLEL_DEC
+#include "TLibCommon/TComThreadPool.h"
+#include <vector>
+#endif
 
 //! \ingroup TLibDecoder
 //! \{
@@ -57,6 +67,38 @@
 // Class definition
 // ====================================================================================================================
 
+#if SUBSTREAM_PARALLEL_DEC
+/// CTU decoding classes of one substream worker thread (own CU decoder, prediction, transform and SBAC decoder)
+class TDecSubstreamDecoder
+{
+private:
+  TDecCu          m_cCuDecoder;
+  TComPrediction  m_cPrediction;
+  TComTrQuant     m_cTrQuant;
+  TDecEntropy     m_cEntropyDecoder;
+  TDecSbac        m_cSbacDecoder;
+  TDecBinCABAC    m_cBinCABAC;
+
+  Bool            m_bCuDecoderCreated;
+  UInt            m_uiMaxTotalCUDepth;                  ///< configuration of the CU decoder buffers
+  UInt            m_uiMaxCUWidth;
+  UInt            m_uiMaxCUHeight;
+  ChromaFormat    m_chromaFormatIdc;
+
+public:
+  TDecSubstreamDecoder();
+  virtual ~TDecSubstreamDecoder();
+
+  Void  create            ( const TComSPS& rcSPS );     ///< (re)allocate the buffers for the given SPS
+  Void  destroy           ();
+
+  TDecCu*         getCuDecoder      () { return &m_cCuDecoder;      }
+  TComTrQuant*    getTrQuant        () { return &m_cTrQuant;        }
+  TDecEntropy*    getEntropyDecoder () { return &m_cEntropyDecoder; }
+  TDecSbac*       getSbacDecoder    () { return &m_cSbacDecoder;    }
+};
+#endif
+
 /// slice decoder class
 class TDecSlice
 {
@@ -68,6 +110,48 @@ private:
   TDecSbac        m_lastSliceSegmentEndContextState;    ///< context storage for state at the end of the previous slice-segment (used for dependent slices only).
   TDecSbac        m_entropyCodingSyncContextState;      ///< context storate for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
 
+  Void  xParseSAOBlkParam           ( TComPic* pcPic, TComSlice* pcSlice, const UInt ctuRsAddr, TDecSbac* pcSbacDecoder );
+#if SUBSTREAM_PARALLEL_DEC
+  /// substream (wavefront CTU row or tile) of a slice segment, decoded by one job of the thread pool
+  struct SubstreamJob
+  {
+    TDecSlice*            pcSliceDecoder;
+    TDecSubstreamDecoder* pcSubstreamDecoder;           ///< decoding classes used by the job, taken when it starts
+    TComPic*              pcPic;
+    TComInputBitstream*   pcBitstream;
+    const TDecSbac*       pcInitialState;               ///< decoder state at the start of the slice segment (first substream only)
+    UInt                  uiSubstream;
+    UInt                  uiStartCtuTsAddr;             ///< first CTU of the substream within the slice segment
+    Bool                  bRowAboveInSliceSegment;      ///< the CTU row above is decoded by the previous job
+    Bool                  bLastCtuOfSliceSegment;       ///< the substream ended with the end of the slice segment
+    Bool                  bSyncStateStored;             ///< contexts after the second CTU of the row have been stored
+  };
+
+  std::vector<TDecSubstreamDecoder*> m_apcSubstreamDecoders; ///< decoding classes of the worker threads
+  std::vector<TDecSubstreamDecoder*> m_apcIdleSubstreamDecoders; ///< decoding classes not in use by a running job
+  std::mutex                         m_cSubstreamDecoderMutex;
+  std::vector<SubstreamJob>          m_cSubstreamJobs;
+  std::vector<TDecSbac*>             m_apcSubstreamSyncContextStates; ///< WPP context states after the second CTU of each substream
+  std::vector<TComProgress*>         m_apcSubstreamProgress;        ///< number of decoded CTUs of each substream, counted from the left tile boundary
+  TComThreadPool                     m_cSubstreamThreadPool;
+
+  Bool  xUseSubstreamThreads        ( TComSlice* pcSlice );
+  Void  xDecompressSliceSubstreams  ( TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecSbac* pcSbacDecoder, const UInt uiNumSubstreams );
+  Void  xDecompressSubstream        ( SubstreamJob& rcJob );
+  static Void xDecompressSubstreamJob ( Void* pParam );
+#endif
+#if NH_MV_LAYER_PARALLEL_DEC
+  std::vector<TComPic*>              m_apcRefPics;                  ///< reference pictures of the current slice segment, possibly still being decoded
+  std::vector<Int>                   m_aiRefPicReach;               ///< number of luma lines below the current CTU row read from each reference picture, MAX_INT: whole picture
+  std::vector<UInt>                  m_auiCtuRowEndTsAddr;          ///< one past the last CTU (tile scan) of each CTU row, empty: progress is not tracked
+  UInt                               m_uiNumDecodedCtuRows;
+  TComProgress                       m_cDecodedCtuRows;             ///< number of decoded (not yet filtered) CTU rows of the current picture
+
+  Void  xSetRefPics                 ( TComPic* pcPic, TComSlice* pcSlice );
+  Void  xWaitForRefPics             ( TComPic* pcPic, UInt uiCtuRow, UInt& ruiNumAvailCtuRows );
+  Void  xSetDecodedCtus             ( UInt uiNumDecodedCtus );
+#endif
+
 public:
   TDecSlice();
   virtual ~TDecSlice();
@@ -77,6 +161,17 @@ public:
   Void  destroy           ();
 
   Void  decompressSlice   ( TComInputBitstream** ppcSubstreams,   TComPic* pcPic, TDecSbac* pcSbacDecoder );
+#if SUBSTREAM_PARALLEL_DEC
+  Void  createSubstreamThreads  ( Int iNumThreads );                     ///< create the worker threads decoding the substreams of a slice segment
+  Void  createSubstreamDecoders ( const TComSPS& rcSPS );                ///< set up the buffers of the worker threads for the active SPS
+  Int   getNumSubstreamDecoders ()         { return (Int)m_apcSubstreamDecoders.size(); }
+  TDecSubstreamDecoder* getSubstreamDecoder( Int i ) { return m_apcSubstreamDecoders[i]; }
+#endif
+#if NH_MV_LAYER_PARALLEL_DEC
+  Void  initDecodedCtuRows      ( TComPic* pcPic );                    ///< start tracking the decoded CTU rows of a picture decoded in the pipeline
+  Void  setAllCtuRowsDecoded    ()         { m_cDecodedCtuRows.set( MAX_INT ); }
+  TComProgress* getDecodedCtuRows ()       { return &m_cDecodedCtuRows; }
+#endif
 };
 
 //! \}
@@ -39,6 +39,11 @@
 #if NH_MV
 ParameterSetManager TDecTop::m_parameterSetManager;
 #endif
+#if NH_MV_LAYER_PARALLEL_DEC
+UInt TDecTop::m_uiRomTablesMaxDepth  = 0;
+UInt TDecTop::m_uiRomTablesMaxWidth  = 0;
+UInt TDecTop::m_uiRomTablesMaxHeight = 0;
+#endif
 
 //! \ingroup TLibDecoder
 //! \{
@@ -412,6 +417,12 @@ TDecTop::TDecTop()
   m_prevStsaDecOrder              = MIN_INT;
   m_prevStsaTemporalId            = MIN_INT;
 #endif
+#if NH_MV_LAYER_PARALLEL_DEC
+  m_pcLayerThreadPool             = NULL;
+  m_iNumPipelinedPics             = 0;
+  m_bPipelinedPicPending          = false;
+  m_bPipelinedPicIsReferenced     = false;
+#endif
 }
 
 TDecTop::~TDecTop()
@@ -460,6 +471,21 @@ Void TDecTop::destroy()
   m_cSliceDecoder.destroy();
 }
 
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+/** Threads of the loop filters, the CTU rows of a picture are deblocked and their SAO is applied in numThreads threads.
+ * \param numThreads number of threads, 1 filters sequentially
+ */
+Void TDecTop::setNumLoopFilterThreads(Int numThreads)
+{
+#if DEBLOCKING_PARALLEL
+  m_cLoopFilter.createThreads(numThreads);
+#endif
+#if SAO_PARALLEL
+  m_cSAO.createThreads(numThreads);
+#endif
+}
+#endif
+
 Void TDecTop::init()
 {
   // initialize ROM
@@ -484,6 +510,9 @@ Void TDecTop::deletePicBuffer ( )
   for (Int i = 0; i < iSize; i++ )
   {
     TComPic* pcPic = *(iterPic++);
+#if PIC_HASH_PARALLEL_DEC
+    m_cGopDecoder.waitPicHash( pcPic );
+#endif
     pcPic->destroy();
 
     delete pcPic;
@@ -541,6 +570,10 @@ Void TDecTop::xGetNewPicBuffer ( const TComSPS &sps, const TComPPS &pps, TComPic
     rpcPic = new TComPic();
     m_cListPic.pushBack( rpcPic );
   }
+#if PIC_HASH_PARALLEL_DEC
+  // the hash of the picture previously decoded into the buffer may still be verified
+  m_cGopDecoder.waitPicHash( rpcPic );
+#endif
   rpcPic->destroy();
   rpcPic->create ( sps, pps, true);
 }
@@ -770,11 +803,17 @@ Void TDecTop::xActivateParameterSets()
     m_SEIs.clear();
 
     // Recursive structure
+#if NH_MV_LAYER_PARALLEL_DEC
+    xInitRomTables( sps );
+#endif
     m_cCuDecoder.create ( sps->getMaxTotalCUDepth(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getChromaFormatIdc() );
     m_cCuDecoder.init   ( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
     m_cTrQuant.init     ( sps->getMaxTrSize() );
 
     m_cSliceDecoder.create();
+#if SUBSTREAM_PARALLEL_DEC
+    m_cSliceDecoder.createSubstreamDecoders( *sps );
+#endif
   }
   else
   {
@@ -855,6 +894,10 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
 #else
 Void TDecTop::decodeSliceHeader(InputNALUnit &nalu )
 {
+#if NH_MV_LAYER_PARALLEL_DEC
+  // the entropy decoder and the slice objects may still be used by the previous picture
+  waitForPipeline();
+#endif
   // Initialize entropy decoder
   m_cEntropyDecoder.setEntropyDecoder (&m_cCavlcDecoder);
   m_cEntropyDecoder.setBitstream      (&(nalu.getBitstream()));
@@ -1163,34 +1206,20 @@ Void TDecTop::decodeSliceSegment(InputNALUnit &nalu )
     }
 
     m_pcPic->setCurrSliceIdx(m_uiSliceIdx);
-    if(pcSlice->getSPS()->getScalingListFlag())
+#if NH_MV_LAYER_PARALLEL_DEC
+    if ( m_pcLayerThreadPool == NULL )
     {
-      TComScalingList scalingList;
-      if(pcSlice->getPPS()->getScalingListPresentFlag())
-      {
-        scalingList = pcSlice->getPPS()->getScalingList();
-      }
-      else if (pcSlice->getSPS()->getScalingListPresentFlag())
-      {
-        scalingList = pcSlice->getSPS()->getScalingList();
-      }
-      else
-      {
-        scalingList.setDefaultScalingList();
-      }
-      m_cTrQuant.setScalingListDec(scalingList);
-      m_cTrQuant.setUseScalingList(true);
-    }
-    else
+#endif
+    xSetTrQuantScalingList( &m_cTrQuant, pcSlice );
+#if SUBSTREAM_PARALLEL_DEC
+    for ( Int i = 0; i < m_cSliceDecoder.getNumSubstreamDecoders(); i++ )
     {
-      const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE] =
-      {
-        pcSlice->getSPS()->getMaxLog2TrDynamicRange(CHANNEL_TYPE_LUMA),
-        pcSlice->getSPS()->getMaxLog2TrDynamicRange(CHANNEL_TYPE_CHROMA)
-      };
-      m_cTrQuant.setFlatScalingList(maxLog2TrDynamicRange, pcSlice->getSPS()->getBitDepths());
-      m_cTrQuant.setUseScalingList(false);
+      xSetTrQuantScalingList( m_cSliceDecoder.getSubstreamDecoder( i )->getTrQuant(), pcSlice );
+    }
+#endif
+#if NH_MV_LAYER_PARALLEL_DEC
     }
+#endif
 
 #if NH_3D
     if ( decProcAnnexI() )
@@ -1199,6 +1228,15 @@ Void TDecTop::decodeSliceSegment(InputNALUnit &nalu )
     }
 #endif
 
+#if NH_MV_LAYER_PARALLEL_DEC
+    if ( m_pcLayerThreadPool != NULL )
+    {
+      // the slice segments are decoded by the pipeline once the picture is complete
+      assert( m_apcPendingSliceBitstreams.size() == m_uiSliceIdx );
+      m_apcPendingSliceBitstreams.push_back( new TComInputBitstream( nalu.getBitstream() ) );
+    }
+    else
+#endif
     //  Decode a picture
     m_cGopDecoder.decompressSlice(&(nalu.getBitstream()), m_pcPic);
 
@@ -1222,6 +1260,42 @@ Void TDecTop::decodeSliceSegment(InputNALUnit &nalu )
 }
 
 
+/** Set the scaling list of the slice (or a flat one) to a transform & quantization class
+ * \param pcTrQuant transform & quantization class
+ * \param pcSlice   current slice
+ */
+Void TDecTop::xSetTrQuantScalingList( TComTrQuant* pcTrQuant, const TComSlice* pcSlice )
+{
+  if(pcSlice->getSPS()->getScalingListFlag())
+  {
+    TComScalingList scalingList;
+    if(pcSlice->getPPS()->getScalingListPresentFlag())
+    {
+      scalingList = pcSlice->getPPS()->getScalingList();
+    }
+    else if (pcSlice->getSPS()->getScalingListPresentFlag())
+    {
+      scalingList = pcSlice->getSPS()->getScalingList();
+    }
+    else
+    {
+      scalingList.setDefaultScalingList();
+    }
+    pcTrQuant->setScalingListDec(scalingList);
+    pcTrQuant->setUseScalingList(true);
+  }
+  else
+  {
+    const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE] =
+    {
+      pcSlice->getSPS()->getMaxLog2TrDynamicRange(CHANNEL_TYPE_LUMA),
+      pcSlice->getSPS()->getMaxLog2TrDynamicRange(CHANNEL_TYPE_CHROMA)
+    };
+    pcTrQuant->setFlatScalingList(maxLog2TrDynamicRange, pcSlice->getSPS()->getBitDepths());
+    pcTrQuant->setUseScalingList(false);
+  }
+}
+
 Void TDecTop::xDecodeVPS(const std::vector<UChar> &naluData)
 {
   TComVPS* vps = new TComVPS();
@@ -1782,11 +1856,112 @@ Void TDecTop::executeLoopFilters( )
   assert( m_pcPic != NULL );
   if ( !m_pcPic->getHasGeneratedRefPics() && !m_pcPic->getIsGenerated() )
   {
+#if NH_MV_LAYER_PARALLEL_DEC
+    if ( m_pcLayerThreadPool != NULL )
+    {
+      // Decode the slice segments in one job and in-loop filter the decoded CTU rows in another one. Pictures referring
+      // to this one wait for the filtered CTU rows they read. The CU decoder is destroyed by finishPipelinedPic().
+      m_pcPic->resetCtuRowProgress();
+      m_cSliceDecoder.initDecodedCtuRows( m_pcPic );
+      m_bPipelinedPicIsReferenced = m_pcPic->getSlice(m_pcPic->getCurrSliceIdx())->isReferenced();
+      m_bPipelinedPicPending      = true;
+      m_iNumPipelinedPics++;
+      m_pcLayerThreadPool->addJob( xDecodePipelinedPicJob, this );
+      m_pcLayerThreadPool->addJob( xFilterPipelinedPicJob, this );
+      return;
+    }
+#endif
     m_cGopDecoder.filterPicture( m_pcPic );
   }
   m_cCuDecoder.destroy();
 }
 
+#if NH_MV_LAYER_PARALLEL_DEC
+Void TDecTop::xDecodePipelinedPicJob( Void* pParam )
+{
+  ((TDecTop*)pParam)->xDecodePipelinedPic();
+}
+
+Void TDecTop::xFilterPipelinedPicJob( Void* pParam )
+{
+  ((TDecTop*)pParam)->xFilterPipelinedPic();
+}
+
+/** Decode the slice segments of the current picture, executed by a thread of the layer pipeline.
+ */
+Void TDecTop::xDecodePipelinedPic()
+{
+  for ( UInt uiSliceIdx = 0; uiSliceIdx < m_apcPendingSliceBitstreams.size(); uiSliceIdx++ )
+  {
+    TComSlice* pcSlice = m_pcPic->getPicSym()->getSlice( uiSliceIdx );
+    m_pcPic->setCurrSliceIdx( uiSliceIdx );
+    xSetTrQuantScalingList( &m_cTrQuant, pcSlice );
+#if SUBSTREAM_PARALLEL_DEC
+    for ( Int i = 0; i < m_cSliceDecoder.getNumSubstreamDecoders(); i++ )
+    {
+      xSetTrQuantScalingList( m_cSliceDecoder.getSubstreamDecoder( i )->getTrQuant(), pcSlice );
+    }
+#endif
+    m_cGopDecoder.decompressSlice( m_apcPendingSliceBitstreams[uiSliceIdx], m_pcPic );
+    delete m_apcPendingSliceBitstreams[uiSliceIdx];
+  }
+  m_apcPendingSliceBitstreams.clear();
+
+  // CTUs not covered by the received slice segments are never decoded
+  m_cSliceDecoder.setAllCtuRowsDecoded();
+  m_cDecodedPics.set( m_iNumPipelinedPics );
+}
+
+/** In-loop filter the current picture while it is decoded, executed by a thread of the layer pipeline.
+ */
+Void TDecTop::xFilterPipelinedPic()
+{
+  m_cGopDecoder.filterPictureCtuRows( m_pcPic );
+  m_cFilteredPics.set( m_iNumPipelinedPics );
+}
+
+Void TDecTop::waitForPipeline()
+{
+  m_cDecodedPics .waitFor( m_iNumPipelinedPics );
+  m_cFilteredPics.waitFor( m_iNumPipelinedPics );
+}
+
+Void TDecTop::finishPipelinedPic()
+{
+  if ( !m_bPipelinedPicPending )
+  {
+    return;
+  }
+  waitForPipeline();
+  m_cGopDecoder.printPictureStatus( m_pcPic, m_bPipelinedPicIsReferenced );
+  m_cCuDecoder.destroy();
+  m_bPipelinedPicPending = false;
+}
+
+/** Initialize the global partition tables for the CTU configuration of an SPS.
+ *  The tables are read by the pictures of other layers in the pipeline and are only rewritten for a new CTU configuration.
+ *  Called when the parameter sets are activated by the parsing thread.
+ */
+Void TDecTop::xInitRomTables( const TComSPS* sps )
+{
+  const UInt uiMaxDepth  = sps->getMaxTotalCUDepth() + 1;
+  const UInt uiMaxWidth  = sps->getMaxCUWidth();
+  const UInt uiMaxHeight = sps->getMaxCUHeight();
+  if ( uiMaxDepth == m_uiRomTablesMaxDepth && uiMaxWidth == m_uiRomTablesMaxWidth && uiMaxHeight == m_uiRomTablesMaxHeight )
+  {
+    return;
+  }
+  m_uiRomTablesMaxDepth  = uiMaxDepth;
+  m_uiRomTablesMaxWidth  = uiMaxWidth;
+  m_uiRomTablesMaxHeight = uiMaxHeight;
+
+  UInt* piTmp = &g_auiZscanToRaster[0];
+  initZscanToRaster( uiMaxDepth, 1, 0, piTmp );
+  initRasterToZscan( uiMaxWidth, uiMaxHeight, uiMaxDepth );
+  initRasterToPelXY( uiMaxWidth, uiMaxHeight, uiMaxDepth );
+}
+#endif
+
 Void TDecTop::finalizePic()
 {
   if( m_pcPic->isIrap() )
@@ -275,6 +275,26 @@ private:
   Int64                   m_prevStsaDecOrder;
   Int                     m_prevStsaTemporalId;
 #endif
+#if NH_MV_LAYER_PARALLEL_DEC
+  TComThreadPool*         m_pcLayerThreadPool;             ///< threads of the layer pipeline, NULL: slices are decoded when they are received
+  std::vector<TComInputBitstream*> m_apcPendingSliceBitstreams; ///< slice segment data of the current picture, decoded by the pipeline
+  Int                     m_iNumPipelinedPics;             ///< number of pictures submitted to the pipeline
+  TComProgress            m_cDecodedPics;                  ///< number of pictures decoded by the pipeline
+  TComProgress            m_cFilteredPics;                 ///< number of pictures in-loop filtered by the pipeline
+  Bool                    m_bPipelinedPicPending;          ///< the status of the last picture submitted to the pipeline has not been printed
+  Bool                    m_bPipelinedPicIsReferenced;     ///< reference marking of the last submitted picture, printed with its status
+
+  Void                    xDecodePipelinedPic   ( );
+  Void                    xFilterPipelinedPic   ( );
+  static Void             xDecodePipelinedPicJob( Void* pParam );
+  static Void             xFilterPipelinedPicJob( Void* pParam );
+
+  // CTU configuration of the global partition tables, shared by the decoders of all layers
+  static UInt             m_uiRomTablesMaxDepth;
+  static UInt             m_uiRomTablesMaxWidth;
+  static UInt             m_uiRomTablesMaxHeight;
+  static Void             xInitRomTables        ( const TComSPS* sps );
+#endif
 
   std::list<InputNALUnit*> m_prefixSEINALUs; /// Buffered up prefix SEI NAL Units.
 public:
@@ -285,6 +305,15 @@ public:
   Void  destroy ();
 
   Void setDecodedPictureHashSEIEnabled(Int enabled) { m_cGopDecoder.setDecodedPictureHashSEIEnabled(enabled); }
+#if SUBSTREAM_PARALLEL_DEC
+  Void setNumSubstreamThreads(Int numThreads)       { m_cSliceDecoder.createSubstreamThreads(numThreads); }
+#endif
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  Void setNumLoopFilterThreads(Int numThreads);
+#endif
+#if PIC_HASH_PARALLEL_DEC
+  Void setPicHashPool(TDecPicHashPool* pcPicHashPool) { m_cGopDecoder.setPicHashPool(pcPicHashPool); }
+#endif
 
   Void  init();
 #if !NH_MV
@@ -333,6 +362,12 @@ public:
   // End Picture decoding           
   Void       executeLoopFilters          ( );
   Void       finalizePic( );
+#if NH_MV_LAYER_PARALLEL_DEC
+  // Layer pipeline
+  Void       setLayerThreadPool          ( TComThreadPool* pcThreadPool ) { m_pcLayerThreadPool = pcThreadPool; }
+  Void       waitForPipeline             ( );                       ///< block until the pictures submitted to the pipeline are decoded and filtered
+  Void       finishPipelinedPic          ( );                       ///< wait for the last submitted picture and print its status
+#endif
   
   //////////////////////////
   // For access from slice 
@@ -396,6 +431,7 @@ protected:
   Bool      xDecodeSlice                   (InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisplay);
 #endif
 
+  Void      xSetTrQuantScalingList( TComTrQuant* pcTrQuant, const TComSlice* pcSlice );
   Void      xDecodeVPS(const std::vector<UChar> &naluData);
   Void      xDecodeSPS(const std::vector<UChar> &naluData);
   Void      xDecodePPS(const std::vector<UChar> &naluData);  
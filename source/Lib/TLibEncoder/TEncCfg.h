@@ -199,6 +199,9 @@ protected:
   Int       m_loopFilterBetaOffsetDiv2;
   Int       m_loopFilterTcOffsetDiv2;
   Bool      m_DeblockingFilterMetric;
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  Int       m_numLoopFilterThreads;                           ///< number of threads deblocking and applying SAO to the CTU rows of a picture
+#endif
   Bool      m_bUseSAO;
   Bool      m_bTestSAODisableAtPictureLevel;
   Double    m_saoEncodingRate;       // When non-0 SAO early picture termination is enabled for luma and chroma
@@ -294,6 +297,9 @@ protected:
   std::vector<Int> m_tileRowHeight;
 
   Bool      m_entropyCodingSyncEnabledFlag;
+#if WPP_PARALLEL_ENC
+  Int       m_numWppThreads;                                  ///< number of threads compressing the CTU rows of a wavefront slice
+#endif
 
   HashType  m_decodedPictureHashSEIType;
   Bool      m_bufferingPeriodSEIEnabled;
@@ -496,8 +502,15 @@ protected:
 #endif
 public:
   TEncCfg()
-  : m_tileColumnWidth()
+  :
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+    m_numLoopFilterThreads(1),
+#endif
+    m_tileColumnWidth()
   , m_tileRowHeight()
+#if WPP_PARALLEL_ENC
+  , m_numWppThreads(1)
+#endif
 #if NH_MV
   , m_layerId(-1)
   , m_layerIdInVps(-1)
@@ -590,6 +603,9 @@ public:
   Void      setMaxCUWidth                   ( UInt  u )      { m_maxCUWidth  = u; }
   Void      setMaxCUHeight                  ( UInt  u )      { m_maxCUHeight = u; }
   Void      setMaxTotalCUDepth              ( UInt  u )      { m_maxTotalCUDepth = u; }
+  UInt      getMaxCUWidth                   () const         { return m_maxCUWidth; }
+  UInt      getMaxCUHeight                  () const         { return m_maxCUHeight; }
+  UInt      getMaxTotalCUDepth              () const         { return m_maxTotalCUDepth; }
   Void      setLog2DiffMaxMinCodingBlockSize( UInt  u )      { m_log2DiffMaxMinCodingBlockSize = u; }
 #if NH_3D_IC
   Void       setUseIC                       ( Bool bVal )    { m_bUseIC = bVal; }
@@ -612,6 +628,9 @@ public:
   Void      setLoopFilterBetaOffset         ( Int   i )      { m_loopFilterBetaOffsetDiv2  = i; }
   Void      setLoopFilterTcOffset           ( Int   i )      { m_loopFilterTcOffsetDiv2    = i; }
   Void      setDeblockingFilterMetric       ( Bool  b )      { m_DeblockingFilterMetric = b; }
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  Void      setNumLoopFilterThreads         ( Int   i )      { m_numLoopFilterThreads = i; }
+#endif
 
   //====== Motion search ========
   Void      setDisableIntraPUsInInterSlices ( Bool  b )      { m_bDisableIntraPUsInInterSlices = b; }
@@ -695,11 +714,15 @@ public:
   Int       getLoopFilterBetaOffset         ()      { return m_loopFilterBetaOffsetDiv2; }
   Int       getLoopFilterTcOffset           ()      { return m_loopFilterTcOffsetDiv2; }
   Bool      getDeblockingFilterMetric       ()      { return m_DeblockingFilterMetric; }
+#if DEBLOCKING_PARALLEL || SAO_PARALLEL
+  Int       getNumLoopFilterThreads         () const { return m_numLoopFilterThreads; }
+#endif
 
   //==== Motion search ========
   Bool      getDisableIntraPUsInInterSlices () const { return m_bDisableIntraPUsInInterSlices; }
   MESearchMethod getMotionEstimationSearchMethod ( ) const { return m_motionEstimationSearchMethod; }
   Int       getSearchRange                  () const { return m_iSearchRange; }
+  Int       getBipredSearchRange            () const { return m_bipredSearchRange; }
   Bool      getClipForBiPredMeEnabled       () const { return m_bClipForBiPredMeEnabled; }
   Bool      getFastMEAssumingSmootherMVEnabled ( ) const { return m_bFastMEAssumingSmootherMVEnabled; }
   Int       getMinSearchWindow                 () const { return m_minSearchWindow; }
@@ -838,6 +861,10 @@ public:
   Void  xCheckGSParameters();
   Void  setEntropyCodingSyncEnabledFlag(Bool b)                      { m_entropyCodingSyncEnabledFlag = b; }
   Bool  getEntropyCodingSyncEnabledFlag() const                      { return m_entropyCodingSyncEnabledFlag; }
+#if WPP_PARALLEL_ENC
+  Void  setNumWppThreads(Int i)                                      { m_numWppThreads = i; }
+  Int   getNumWppThreads() const                                     { return m_numWppThreads; }
+#endif
   Void  setDecodedPictureHashSEIType(HashType m)                     { m_decodedPictureHashSEIType = m; }
   HashType getDecodedPictureHashSEIType() const                      { return m_decodedPictureHashSEIType; }
   Void  setBufferingPeriodSEIEnabled(Bool b)                         { m_bufferingPeriodSEIEnabled = b; }
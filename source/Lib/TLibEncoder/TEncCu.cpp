@@ -267,6 +267,31 @@ Void TEncCu::init( TEncTop* pcEncTop )
   m_pcRateCtrl         = pcEncTop->getRateCtrl();
 }
 
+#if WPP_PARALLEL_ENC
+/** \param    pcEncTop          pointer of encoder class
+    \param    pcPredSearch      encoder search class to be used
+    \param    pcTrQuant         transform & quantization class to be used
+    \param    pcRdCost          RD cost class to be used
+    \param    pcEntropyCoder    entropy encoder to be used
+    \param    pppcRDSbacCoder   SBAC coders for RD optimization to be used
+    \param    pcRDGoOnSbacCoder go-on SBAC coder to be used
+ */
+Void TEncCu::init( TEncTop* pcEncTop, TEncSearch* pcPredSearch, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost,
+                   TEncEntropy* pcEntropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder )
+{
+  init( pcEncTop );
+
+  m_pcPredSearch       = pcPredSearch;
+  m_pcTrQuant          = pcTrQuant;
+  m_pcRdCost           = pcRdCost;
+
+  m_pcEntropyCoder     = pcEntropyCoder;
+
+  m_pppcRDSbacCoder    = pppcRDSbacCoder;
+  m_pcRDGoOnSbacCoder  = pcRDGoOnSbacCoder;
+}
+#endif
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
@@ -279,6 +304,9 @@ Void TEncCu::compressCtu( TComDataCU* pCtu )
   // initialize CU data
   m_ppcBestCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
   m_ppcTempCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
+#if NH_3D_IC_PARAM_CACHE
+  m_pcPredSearch->resetICParamCache();
+#endif
 
 #if NH_3D_ARP
   m_ppcWeightedTempCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
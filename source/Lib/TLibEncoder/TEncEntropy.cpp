@@ -170,6 +170,13 @@ Void TEncEntropy::encodeICFlag( TComDataCU* pcCU, UInt uiAbsPartIdx, Bool bRD )
   }
   else
   {
+#if WPP_PARALLEL_ENC
+    // the statistics are shared by the CTU rows of a slice, which may be compressed in parallel
+    if ( m_pcICStatisticsMutex != NULL )
+    {
+      m_pcICStatisticsMutex->lock();
+    }
+#endif
     Int ICEnableCandidate = pcCU->getSlice()->getICEnableCandidate(pcCU->getSlice()->getDepth());
     Int ICEnableNum = pcCU->getSlice()->getICEnableNum(pcCU->getSlice()->getDepth());
     ICEnableCandidate++;
@@ -179,6 +186,12 @@ Void TEncEntropy::encodeICFlag( TComDataCU* pcCU, UInt uiAbsPartIdx, Bool bRD )
     }
     pcCU->getSlice()->setICEnableCandidate(pcCU->getSlice()->getDepth(), ICEnableCandidate);
     pcCU->getSlice()->setICEnableNum(pcCU->getSlice()->getDepth(), ICEnableNum);
+#if WPP_PARALLEL_ENC
+    if ( m_pcICStatisticsMutex != NULL )
+    {
+      m_pcICStatisticsMutex->unlock();
+    }
+#endif
   }
   if( pcCU->isICFlagRequired( uiAbsPartIdx ) )
   {
@@ -46,6 +46,9 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComSampleAdaptiveOffset.h"
 #include "TLibCommon/TComChromaFormat.h"
+#if NH_3D_IC && WPP_PARALLEL_ENC
+#include <mutex>
+#endif
 
 class TEncSbac;
 class TEncCavlc;
@@ -134,7 +137,17 @@ public:
 /// entropy encoder class
 class TEncEntropy
 {
+#if NH_3D_IC && WPP_PARALLEL_ENC
+private:
+  std::mutex*         m_pcICStatisticsMutex;                  ///< guards the IC flag statistics of the layer, NULL for none
+
+#endif
 public:
+#if NH_3D_IC && WPP_PARALLEL_ENC
+  TEncEntropy() : m_pcICStatisticsMutex( NULL ) {}
+
+  Void    setICStatisticsMutex      ( std::mutex* pcMutex )   { m_pcICStatisticsMutex = pcMutex; }
+#endif
   Void    setEntropyCoder           ( TEncEntropyIf* e );
   Void    setBitstream              ( TComBitIf* p )          { m_pcEntropyCoderIf->setBitstream(p);  }
   Void    resetBits                 ()                        { m_pcEntropyCoderIf->resetBits();      }
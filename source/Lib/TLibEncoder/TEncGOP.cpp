@@ -58,6 +58,32 @@ using namespace std;
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
+#if PIC_METRICS_PARALLEL_ENC
+// ====================================================================================================================
+// Metrics thread pool
+// ====================================================================================================================
+
+Void TEncPicMetricsPool::create( Int iNumThreads )
+{
+  m_cThreadPool.create( iNumThreads );
+  m_cNumPrinted.reset();
+  m_iNumAdded = 0;
+}
+
+Void TEncPicMetricsPool::destroy()
+{
+  m_cThreadPool.destroy();
+}
+
+Void TEncPicMetricsPool::addJob( FpJobFunc pfFunc, Void* pParam, Int& riOrder )
+{
+  // the order is assigned under the same lock as the queue position, so a job only waits for jobs taken before it
+  std::unique_lock<std::mutex> cLock( m_cMutex );
+  riOrder = m_iNumAdded++;
+  m_cThreadPool.addJob( pfFunc, pParam );
+}
+#endif
+
 Int getLSB(Int poc, Int maxLSB)
 {
   if (poc >= 0)
@@ -78,6 +104,7 @@ TEncGOP::TEncGOP()
   m_bFirst              = true;
   m_iLastRecoveryPicPOC = 0;
 
+  m_pcEncTop            = NULL;
   m_pcCfg               = NULL;
   m_pcSliceEncoder      = NULL;
   m_pcListPic           = NULL;
@@ -124,6 +151,9 @@ Void  TEncGOP::create()
 
 Void  TEncGOP::destroy()
 {
+#if PIC_METRICS_PARALLEL_ENC
+  waitPicMetrics();
+#endif
 }
 
 Void TEncGOP::init ( TEncTop* pcTEncTop )
@@ -1075,7 +1105,6 @@ static UInt calculateCollocatedFromL1Flag(TEncCfg *pCfg, const Int GOPid, const
   }
 }
 
-
 static Void
 printHash(const HashType hashType, const std::string &digestStr)
 {
@@ -1216,6 +1245,9 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     accessUnitsInGOP.push_back(AccessUnit());
     AccessUnit& accessUnit = accessUnitsInGOP.back();
     xGetBuffer( rcListPic, rcListPicYuvRecOut, iNumPicRcvd, iTimeOffset, pcPic, pcPicYuvRecOut, pocCurr, isField );
+#if NH_MV_FRAME_PARALLEL_ENC
+    pcPic->resetAuFinished();
+#endif
 
     //  Slice data initialization
     pcPic->clearSliceBuffer();
@@ -1314,6 +1346,14 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     pcSlice->setAssociatedIRAPType(m_associatedIRAPType);
     pcSlice->setAssociatedIRAPPOC(m_associatedIRAPPOC);
     }
+#if NH_MV_FRAME_PARALLEL_ENC
+    // Other access units may be coded in parallel, their pictures mark the pictures of this layer as inter-layer references.
+    std::mutex* pcRefMarkingMutex = m_pcEncTop->getRefMarkingMutex();
+    if ( pcRefMarkingMutex != NULL )
+    {
+      pcRefMarkingMutex->lock();
+    }
+#endif
     // Do decoding refresh marking if any
     pcSlice->decodingRefreshMarking(m_pocCRA, m_bRefreshPending, rcListPic, m_pcCfg->getEfficientFieldIRAPEnabled());
     m_pcEncTop->selectReferencePictureSet(pcSlice, pocCurr, iGOPid);
@@ -1503,6 +1543,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 #endif
 #endif
 
+#if NH_MV_FRAME_PARALLEL_ENC
+    if ( pcRefMarkingMutex != NULL )
+    {
+      xSaveIvRefPicMarking( pcSlice );
+    }
+#endif
     pcSlice->createInterLayerReferencePictureSet( m_ivPicLists, m_refPicSetInterLayer0, m_refPicSetInterLayer1 );
     pcSlice->setNumRefIdx(REF_PIC_LIST_0,min(gopEntry.m_numRefPicsActive,( pcSlice->getRPS()->getNumberOfPictures() + (Int) m_refPicSetInterLayer0.size() + (Int) m_refPicSetInterLayer1.size()) ) );
     pcSlice->setNumRefIdx(REF_PIC_LIST_1,min(gopEntry.m_numRefPicsActive,( pcSlice->getRPS()->getNumberOfPictures() + (Int) m_refPicSetInterLayer0.size() + (Int) m_refPicSetInterLayer1.size()) ) );
@@ -1837,6 +1883,16 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       {
         pcPic->checkTextureRef();
       }
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+    if ( pcRefMarkingMutex != NULL )
+    {
+      // The reference picture lists are set, the marking of the inter-layer reference pictures is reverted as
+      // their own layer may code a later access unit. Pictures of this layer stay marked until the end of the picture.
+      xRestoreIvRefPicMarking();
+      pcRefMarkingMutex->unlock();
+      xWaitForRefPicAus( pcSlice );
+    }
 #endif
     // Allocate some coders, now the number of tiles are known.
     const Int numSubstreamsColumns = (pcSlice->getPPS()->getNumTileColumnsMinus1() + 1);
@@ -1966,6 +2022,27 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       }
     }
 
+#if PIC_METRICS_PARALLEL_ENC
+    // The reconstruction is final: its hash and PSNR are computed by the metrics pool while the slices are written.
+    // The picture line is printed by the job once the bits are known, the hash SEI is appended at the end of the GOP.
+    PicMetrics*         pcMetrics     = NULL;
+    TEncPicMetricsPool* pcMetricsPool = m_pcEncTop->getPicMetricsPool();
+    if ( pcMetricsPool != NULL && pcMetricsPool->isParallel() && !isField && m_pcCfg->getSummaryVerboseness() == 0 )
+    {
+      pcMetrics = new PicMetrics;
+      xInitPicMetrics( *pcMetrics, pcPic, pcPic->getPicYuvRec(), snr_conversion, printFrameMSE );
+      if ( m_pcCfg->getDecodedPictureHashSEIType() != HASHTYPE_NONE )
+      {
+        pcMetrics->pcHashSEI = new SEIDecodedPictureHash();
+      }
+      pcMetrics->pcAccessUnit = &accessUnit;
+      pcMetrics->iTLayer      = pcSlice->getTLayer();
+      pcMetrics->pcSPS        = pcSlice->getSPS();
+      m_apcPicMetrics.push_back( pcMetrics );
+      pcMetricsPool->addJob( xPicMetricsJob, pcMetrics, pcMetrics->iOrder );
+    }
+#endif
+
     // pcSlice is currently slice 0.
     std::size_t binCountsInNalUnits   = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
     std::size_t numBytesInVclNalUnits = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
@@ -2098,7 +2175,11 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     Double dEncTime = (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
 
     std::string digestStr;
+#if PIC_METRICS_PARALLEL_ENC
+    if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE && pcMetrics == NULL)
+#else
     if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE)
+#endif
     {
       SEIDecodedPictureHash *decodedPictureHashSei = new SEIDecodedPictureHash();
       m_seiEncoder.initDecodedPictureHashSEI(decodedPictureHashSei, pcPic, digestStr, pcSlice->getSPS()->getBitDepths());
@@ -2108,9 +2189,27 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
     m_pcCfg->setEncodedFlag(iGOPid, true);
 
+#if NH_MV_LAYER_PARALLEL_ENC
+    std::mutex* pcOutputMutex = m_pcEncTop->getLayerOutputMutex();
+    if ( pcOutputMutex != NULL )
+    {
+      pcOutputMutex->lock();
+    }
+#endif
+#if PIC_METRICS_PARALLEL_ENC
+    if ( pcMetrics != NULL )
+    {
+      xSetPicMetricsInfo( *pcMetrics, accessUnit, dEncTime );
+    }
+    else
+    {
+#endif
     xCalculateAddPSNRs( isField, isTff, iGOPid, pcPic, accessUnit, rcListPic, dEncTime, snr_conversion, printFrameMSE );
 
     printHash(m_pcCfg->getDecodedPictureHashSEIType(), digestStr);
+#if PIC_METRICS_PARALLEL_ENC
+    }
+#endif
 
     if ( m_pcCfg->getUseRateCtrl() )
     {
@@ -2137,6 +2236,13 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       if (m_pcRateCtrl->getCpbSaturationEnabled())
       {
         m_pcRateCtrl->updateCpbState(actualTotalBits);
+#if PIC_METRICS_PARALLEL_ENC
+        if ( pcMetrics != NULL )
+        {
+          appendFormat(pcMetrics->cCpb, " [CPB %6d bits]", m_pcRateCtrl->getCpbState());
+        }
+        else
+#endif
         printf(" [CPB %6d bits]", m_pcRateCtrl->getCpbState());
       }
 #endif
@@ -2154,16 +2260,41 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
     pcPic->setReconMark   ( true );
 #if NH_MV
+#if NH_MV_LAYER_PARALLEL_ENC
+      // Layers coded in parallel may still use the inter-layer reference pictures, marking is done at the end of the access unit.
+      if ( pcOutputMutex == NULL )
+      {
+        TComSlice::markIvRefPicsAsShortTerm( m_refPicSetInterLayer0, m_refPicSetInterLayer1 );
+      }
+#else
       TComSlice::markIvRefPicsAsShortTerm( m_refPicSetInterLayer0, m_refPicSetInterLayer1 );
+#endif
       std::vector<Int> temp;
       TComSlice::markCurrPic( pcPic );
 #endif
     m_bFirst = false;
     m_iNumPicCoded++;
     m_totalCoded ++;
+#if PIC_METRICS_PARALLEL_ENC
+    if ( pcMetrics != NULL )
+    {
+      pcMetrics->cInfoReady.set( 1 );
+    }
+    else
+    {
+#endif
     /* logging: insert a newline at end of picture period */
     printf("\n");
     fflush(stdout);
+#if PIC_METRICS_PARALLEL_ENC
+    }
+#endif
+#if NH_MV_LAYER_PARALLEL_ENC
+    if ( pcOutputMutex != NULL )
+    {
+      pcOutputMutex->unlock();
+    }
+#endif
 
     if (m_pcCfg->getEfficientFieldIRAPEnabled())
     {
@@ -2171,6 +2302,9 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     }
   } // iGOPid-loop
 
+#if PIC_METRICS_PARALLEL_ENC
+  xWritePicMetricsHashSEIs();
+#endif
   delete pcBitstreamRedirect;
 
 #if !NH_MV
@@ -2178,8 +2312,74 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 #endif
 }
 
+#if PIC_METRICS_PARALLEL_ENC
+Void TEncGOP::waitPicMetrics()
+{
+  TEncPicMetricsPool* pcMetricsPool = m_pcEncTop != NULL ? m_pcEncTop->getPicMetricsPool() : NULL;
+  if ( pcMetricsPool != NULL )
+  {
+    // the pool is shared by all layers, this also completes the log output of the other layers
+    pcMetricsPool->waitAll();
+  }
+  for ( std::list<PicMetrics*>::iterator it = m_apcPicMetrics.begin(); it != m_apcPicMetrics.end(); it++ )
+  {
+    assert( (*it)->pcAccessUnit == NULL );
+    delete *it;
+  }
+  m_apcPicMetrics.clear();
+}
+
+Void TEncGOP::xPicMetricsJob( Void* pParam )
+{
+  PicMetrics*         pcMetrics     = (PicMetrics*)pParam;
+  TEncGOP*            pcGOP         = pcMetrics->pcGOP;
+  TEncPicMetricsPool* pcMetricsPool = pcGOP->m_pcEncTop->getPicMetricsPool();
+
+  if ( pcMetrics->pcHashSEI != NULL )
+  {
+    pcGOP->m_seiEncoder.initDecodedPictureHashSEI( pcMetrics->pcHashSEI, pcMetrics->pcPic, pcMetrics->cDigest, pcMetrics->pcSPS->getBitDepths() );
+  }
+  pcMetrics->cHashDone.set( 1 );
+
+  pcGOP->xCalculatePicMetrics( *pcMetrics );
+
+  pcMetrics->cInfoReady.waitFor( 1 );
+  pcMetricsPool->waitForTurn( pcMetrics->iOrder );
+  pcGOP->xAddPicMetrics( *pcMetrics );
+  printHash( pcGOP->m_pcCfg->getDecodedPictureHashSEIType(), pcMetrics->cDigest );
+  printf( "%s\n", pcMetrics->cCpb.c_str() );
+  fflush( stdout );
+  pcMetricsPool->finishTurn( pcMetrics->iOrder );
+}
+
+/** append the decoded picture hash SEIs of the pictures coded by the last call, the access units are not output before
+ */
+Void TEncGOP::xWritePicMetricsHashSEIs()
+{
+  for ( std::list<PicMetrics*>::iterator it = m_apcPicMetrics.begin(); it != m_apcPicMetrics.end(); it++ )
+  {
+    PicMetrics* pcMetrics = *it;
+    if ( pcMetrics->pcAccessUnit != NULL )
+    {
+      pcMetrics->cHashDone.waitFor( 1 );
+      SEIMessages trailingSeiMessages;
+      if ( pcMetrics->pcHashSEI != NULL )
+      {
+        trailingSeiMessages.push_back( pcMetrics->pcHashSEI );
+      }
+      xWriteTrailingSEIMessages( trailingSeiMessages, *pcMetrics->pcAccessUnit, pcMetrics->iTLayer, pcMetrics->pcSPS );
+      pcMetrics->pcHashSEI    = NULL;
+      pcMetrics->pcAccessUnit = NULL;
+    }
+  }
+}
+#endif
+
 Void TEncGOP::printOutSummary(UInt uiNumAllPicCoded, Bool isField, const Bool printMSEBasedSNR, const Bool printSequenceMSE, const BitDepths &bitDepths)
 {
+#if PIC_METRICS_PARALLEL_ENC
+  waitPicMetrics();
+#endif
   assert (uiNumAllPicCoded == m_gcAnalyzeAll.getNumPic());
 
 
@@ -2324,6 +2524,50 @@ Void TEncGOP::xGetBuffer( TComList<TComPic*>&      rcListPic,
   return;
 }
 
+#if NH_MV_FRAME_PARALLEL_ENC
+Void TEncGOP::xSaveIvRefPicMarking( TComSlice* pcSlice )
+{
+  m_ivRefPicMarkings.clear();
+  for( Int i = 0; i < pcSlice->getNumActiveRefLayerPics(); i++ )
+  {
+    IvRefPicMarking marking;
+    marking.pcPic         = m_ivPicLists->getPic( pcSlice->getRefPicLayerId( i ), pcSlice->getPOC() );
+    marking.bIsLongTerm   = marking.pcPic->getIsLongTerm();
+    marking.bIsReferenced = marking.pcPic->getSlice(0)->isReferenced();
+    m_ivRefPicMarkings.push_back( marking );
+  }
+}
+
+Void TEncGOP::xRestoreIvRefPicMarking()
+{
+  for( Int i = 0; i < (Int) m_ivRefPicMarkings.size(); i++ )
+  {
+    m_ivRefPicMarkings[i].pcPic->setIsLongTerm( m_ivRefPicMarkings[i].bIsLongTerm );
+    m_ivRefPicMarkings[i].pcPic->getSlice(0)->setReferenced( m_ivRefPicMarkings[i].bIsReferenced );
+  }
+  m_ivRefPicMarkings.clear();
+}
+
+/**
+ The temporal reference pictures belong to earlier access units. Their pictures of other layers are read by
+ inter-layer tools (e.g. ARP) and their motion is compressed only when the whole access unit is coded.
+ */
+Void TEncGOP::xWaitForRefPicAus( TComSlice* pcSlice )
+{
+  for( Int list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+  {
+    for( Int refIdx = 0; refIdx < pcSlice->getNumRefIdx( RefPicList( list ) ); refIdx++ )
+    {
+      TComPic* pcRefPic = pcSlice->getRefPic( RefPicList( list ), refIdx );
+      if ( pcRefPic->getPOC() != pcSlice->getPOC() )
+      {
+        pcRefPic->waitForAuFinished();
+      }
+    }
+  }
+}
+#endif
+
 #if NH_3D_VSO
 Dist64 TEncGOP::xFindDistortionFrame (TComPicYuv* pcPic0, TComPicYuv* pcPic1, const BitDepths &bitDepths)
 #else
@@ -2431,12 +2675,45 @@ Void TEncGOP::xCalculateAddPSNRs( const Bool isField, const Bool isFieldTopField
 
 Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit& accessUnit, Double dEncTime, const InputColourSpaceConversion conversion, const Bool printFrameMSE )
 {
-  Double  dPSNR[MAX_NUM_COMPONENT];
+  PicMetrics cMetrics;
+
+  xInitPicMetrics     ( cMetrics, pcPic, pcPicD, conversion, printFrameMSE );
+  xCalculatePicMetrics( cMetrics );
+  xSetPicMetricsInfo  ( cMetrics, accessUnit, dEncTime );
+  xAddPicMetrics      ( cMetrics );
+}
 
+Void TEncGOP::xInitPicMetrics( PicMetrics& rcMetrics, TComPic* pcPic, TComPicYuv* pcPicD, const InputColourSpaceConversion conversion, const Bool printFrameMSE )
+{
+  rcMetrics.pcGOP         = this;
+  rcMetrics.pcPic         = pcPic;
+  rcMetrics.pcPicD        = pcPicD;
+  rcMetrics.conversion    = conversion;
+  rcMetrics.printFrameMSE = printFrameMSE;
+  rcMetrics.uiBits        = 0;
+  rcMetrics.eSliceType    = pcPic->getSlice(0)->getSliceType();
+#if PIC_METRICS_PARALLEL_ENC
+  rcMetrics.iOrder        = 0;
+  rcMetrics.pcHashSEI     = NULL;
+  rcMetrics.pcAccessUnit  = NULL;
+  rcMetrics.iTLayer       = 0;
+  rcMetrics.pcSPS         = NULL;
+#endif
   for(Int i=0; i<MAX_NUM_COMPONENT; i++)
   {
-    dPSNR[i]=0.0;
+    rcMetrics.adPSNR[i] = 0.0;
+    rcMetrics.adMSE [i] = 0.0;
   }
+}
+
+/** compute PSNR and MSE of the reconstruction, only reads the picture buffers and may run in a metrics thread
+ */
+Void TEncGOP::xCalculatePicMetrics( PicMetrics& rcMetrics )
+{
+  TComPic*                         pcPic      = rcMetrics.pcPic;
+  TComPicYuv*                      pcPicD     = rcMetrics.pcPicD;
+  const InputColourSpaceConversion conversion = rcMetrics.conversion;
+  Double*                          dPSNR      = rcMetrics.adPSNR;
 
   TComPicYuv cscd;
   if (conversion!=IPCOLOURSPACE_UNCHANGED)
@@ -2447,7 +2724,7 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
   TComPicYuv &picd=(conversion==IPCOLOURSPACE_UNCHANGED)?*pcPicD : cscd;
 
   //===== calculate PSNR =====
-  Double MSEyuvframe[MAX_NUM_COMPONENT] = {0, 0, 0};
+  Double* MSEyuvframe = rcMetrics.adMSE;
 
   for(Int chan=0; chan<pcPicD->getNumberValidComponents(); chan++)
   {
@@ -2503,6 +2780,15 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
 }
 #endif
 #endif
+  cscd.destroy();
+}
+
+/** count the bits of the access unit and format the picture line, called by the encoding thread after the slices are written
+ */
+Void TEncGOP::xSetPicMetricsInfo( PicMetrics& rcMetrics, const AccessUnit& accessUnit, Double dEncTime )
+{
+  TComPic* pcPic = rcMetrics.pcPic;
+
   /* calculate the size of the access unit, excluding:
    *  - any AnnexB contributions (start_code_prefix, zero_byte, etc.,)
    *  - SEI NAL units
@@ -2522,34 +2808,20 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
   }
 
   UInt uibits = numRBSPBytes * 8;
-  m_vRVM_RP.push_back( uibits );
-
-  //===== add PSNR =====
-  m_gcAnalyzeAll.addResult (dPSNR, (Double)uibits, MSEyuvframe);
+  rcMetrics.uiBits = uibits;
 
   TComSlice*  pcSlice = pcPic->getSlice(0);
-  if (pcSlice->isIntra())
-  {
-    m_gcAnalyzeI.addResult (dPSNR, (Double)uibits, MSEyuvframe);
-  }
-  if (pcSlice->isInterP())
-  {
-    m_gcAnalyzeP.addResult (dPSNR, (Double)uibits, MSEyuvframe);
-  }
-  if (pcSlice->isInterB())
-  {
-    m_gcAnalyzeB.addResult (dPSNR, (Double)uibits, MSEyuvframe);
-  }
-
   TChar c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
   if (!pcSlice->isReferenced())
   {
     c += 32;
   }
 
+  std::string& rcLine = rcMetrics.cLine;
+  rcLine.clear();
 #if ADAPTIVE_QP_SELECTION
 #if NH_MV
-  printf("Layer %3d   POC %4d TId: %1d ( %c-SLICE, nQP %d QP %d ) %10d  bits",
+  appendFormat(rcLine, "Layer %3d   POC %4d TId: %1d ( %c-SLICE, nQP %d QP %d ) %10d  bits",
     pcSlice->getLayerId(),
     pcSlice->getPOC(),
     pcSlice->getTLayer(),
@@ -2558,7 +2830,7 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
     pcSlice->getSliceQp(),
     uibits );
 #else
-  printf("POC %4d TId: %1d ( %c-SLICE, nQP %d QP %d ) %10d bits",
+  appendFormat(rcLine, "POC %4d TId: %1d ( %c-SLICE, nQP %d QP %d ) %10d bits",
          pcSlice->getPOC(),
          pcSlice->getTLayer(),
          c,
@@ -2568,7 +2840,7 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
 #endif
 #else
 #if NH_MV
-  printf("Layer %3d   POC %4d TId: %1d ( %c-SLICE, QP %d ) %10d bits",
+  appendFormat(rcLine, "Layer %3d   POC %4d TId: %1d ( %c-SLICE, QP %d ) %10d bits",
     pcSlice->getLayerId(),
     pcSlice->getPOC()-pcSlice->getLastIDR(),
     pcSlice->getTLayer(),
@@ -2576,7 +2848,7 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
     pcSlice->getSliceQp(),
     uibits );
 #else
-  printf("POC %4d TId: %1d ( %c-SLICE, QP %d ) %10d bits",
+  appendFormat(rcLine, "POC %4d TId: %1d ( %c-SLICE, QP %d ) %10d bits",
          pcSlice->getPOC()-pcSlice->getLastIDR(),
          pcSlice->getTLayer(),
          c,
@@ -2584,41 +2856,72 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
          uibits );
 #endif
 #endif
-#if NH_MV
-  printf(" [Y %8.4lf dB    U %8.4lf dB    V %8.4lf dB]", dPSNR[COMPONENT_Y], dPSNR[COMPONENT_Cb], dPSNR[COMPONENT_Cr] );
-#else
-  printf(" [Y %6.4lf dB    U %6.4lf dB    V %6.4lf dB]", dPSNR[COMPONENT_Y], dPSNR[COMPONENT_Cb], dPSNR[COMPONENT_Cr] );
-#endif
-  if (printFrameMSE)
-  {
-    printf(" [Y MSE %6.4lf  U MSE %6.4lf  V MSE %6.4lf]", MSEyuvframe[COMPONENT_Y], MSEyuvframe[COMPONENT_Cb], MSEyuvframe[COMPONENT_Cr] );
-  }
-  printf(" [ET %5.0f ]", dEncTime );
+
+  std::string& rcTail = rcMetrics.cTail;
+  rcTail.clear();
+  appendFormat(rcTail, " [ET %5.0f ]", dEncTime );
 
   // printf(" [WP %d]", pcSlice->getUseWeightedPrediction());
 
   for (Int iRefList = 0; iRefList < 2; iRefList++)
   {
-    printf(" [L%d ", iRefList);
+    appendFormat(rcTail, " [L%d ", iRefList);
     for (Int iRefIndex = 0; iRefIndex < pcSlice->getNumRefIdx(RefPicList(iRefList)); iRefIndex++)
     {
 #if NH_MV
       if( pcSlice->getLayerId() != pcSlice->getRefLayerId( RefPicList(iRefList), iRefIndex ) )
       {
-        printf( "V%d ", pcSlice->getRefLayerId( RefPicList(iRefList), iRefIndex ) );
+        appendFormat(rcTail, "V%d ", pcSlice->getRefLayerId( RefPicList(iRefList), iRefIndex ) );
       }
       else
       {
 #endif
-      printf ("%d ", pcSlice->getRefPOC(RefPicList(iRefList), iRefIndex)-pcSlice->getLastIDR());
+      appendFormat(rcTail, "%d ", pcSlice->getRefPOC(RefPicList(iRefList), iRefIndex)-pcSlice->getLastIDR());
 #if NH_MV
       }
 #endif
     }
-    printf("]");
+    rcTail += "]";
   }
+}
 
-  cscd.destroy();
+/** add the picture to the summary and print its line, called in coding order
+ */
+Void TEncGOP::xAddPicMetrics( PicMetrics& rcMetrics )
+{
+  Double*       dPSNR       = rcMetrics.adPSNR;
+  const Double* MSEyuvframe = rcMetrics.adMSE;
+  const UInt    uibits      = rcMetrics.uiBits;
+
+  m_vRVM_RP.push_back( uibits );
+
+  //===== add PSNR =====
+  m_gcAnalyzeAll.addResult (dPSNR, (Double)uibits, MSEyuvframe);
+
+  if (rcMetrics.eSliceType == I_SLICE)
+  {
+    m_gcAnalyzeI.addResult (dPSNR, (Double)uibits, MSEyuvframe);
+  }
+  if (rcMetrics.eSliceType == P_SLICE)
+  {
+    m_gcAnalyzeP.addResult (dPSNR, (Double)uibits, MSEyuvframe);
+  }
+  if (rcMetrics.eSliceType == B_SLICE)
+  {
+    m_gcAnalyzeB.addResult (dPSNR, (Double)uibits, MSEyuvframe);
+  }
+
+  printf("%s", rcMetrics.cLine.c_str());
+#if NH_MV
+  printf(" [Y %8.4lf dB    U %8.4lf dB    V %8.4lf dB]", dPSNR[COMPONENT_Y], dPSNR[COMPONENT_Cb], dPSNR[COMPONENT_Cr] );
+#else
+  printf(" [Y %6.4lf dB    U %6.4lf dB    V %6.4lf dB]", dPSNR[COMPONENT_Y], dPSNR[COMPONENT_Cb], dPSNR[COMPONENT_Cr] );
+#endif
+  if (rcMetrics.printFrameMSE)
+  {
+    printf(" [Y MSE %6.4lf  U MSE %6.4lf  V MSE %6.4lf]", MSEyuvframe[COMPONENT_Y], MSEyuvframe[COMPONENT_Cb], MSEyuvframe[COMPONENT_Cr] );
+  }
+  printf("%s", rcMetrics.cTail.c_str());
 }
 
 Void TEncGOP::xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic* pcPicOrgSecondField,
@@ -47,6 +47,9 @@
 #include "TLibCommon/TComBitCounter.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/AccessUnit.h"
+#if PIC_METRICS_PARALLEL_ENC
+#include "TLibCommon/TComThreadPool.h"
+#endif
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncSlice.h"
 #include "TEncEntropy.h"
@@ -71,6 +74,29 @@ class TEncTop;
 // Class definition
 // ====================================================================================================================
 
+#if PIC_METRICS_PARALLEL_ENC
+/// threads computing the PSNR and decoded picture hash of coded pictures, shared by the GOP encoders of all layers
+class TEncPicMetricsPool
+{
+private:
+  TComThreadPool          m_cThreadPool;
+  TComProgress            m_cNumPrinted;          ///< number of jobs that have printed their picture line
+  Int                     m_iNumAdded;
+  std::mutex              m_cMutex;
+
+public:
+  TEncPicMetricsPool() : m_iNumAdded( 0 ) {}
+
+  Void create     ( Int iNumThreads );            ///< for iNumThreads <= 1 the metrics are computed by the encoding thread
+  Void destroy    ();
+  Void addJob     ( FpJobFunc pfFunc, Void* pParam, Int& riOrder ); ///< riOrder is the position of the job in the log output
+  Void waitAll    ()                    { m_cThreadPool.waitAll(); }
+  Void waitForTurn( Int iOrder )        { m_cNumPrinted.waitFor( iOrder ); }
+  Void finishTurn ( Int iOrder )        { m_cNumPrinted.set( iOrder + 1 ); }
+  Bool isParallel ()                    { return m_cThreadPool.isParallel(); }
+};
+#endif
+
 class TEncGOP
 {
   class DUData
@@ -84,6 +110,33 @@ class TEncGOP
     Int accumNalsDU;
   };
 
+  /// PSNR, MSE, bits and decoded picture hash of a coded picture
+  struct PicMetrics
+  {
+    TEncGOP*                   pcGOP;
+    TComPic*                   pcPic;
+    TComPicYuv*                pcPicD;
+    InputColourSpaceConversion conversion;
+    Bool                       printFrameMSE;
+    Double                     adPSNR[MAX_NUM_COMPONENT];
+    Double                     adMSE [MAX_NUM_COMPONENT];
+    UInt                       uiBits;
+    SliceType                  eSliceType;
+    std::string                cLine;             ///< picture line up to the PSNR values
+    std::string                cTail;             ///< encoding time and reference picture lists
+#if PIC_METRICS_PARALLEL_ENC
+    std::string                cCpb;              ///< CPB state of the rate control
+    Int                        iOrder;
+    TComProgress               cInfoReady;        ///< set to 1 when the bits and log line are known
+    SEIDecodedPictureHash*     pcHashSEI;
+    std::string                cDigest;
+    TComProgress               cHashDone;         ///< set to 1 when pcHashSEI is filled
+    AccessUnit*                pcAccessUnit;      ///< access unit the hash SEI is appended to, NULL when written
+    Int                        iTLayer;
+    const TComSPS*             pcSPS;
+#endif
+  };
+
 private:
 
   TEncAnalyze             m_gcAnalyzeAll;
@@ -122,6 +175,16 @@ private:
   TComPicLists*           m_ivPicLists;
   std::vector<TComPic*>   m_refPicSetInterLayer0; 
   std::vector<TComPic*>   m_refPicSetInterLayer1; 
+#if NH_MV_FRAME_PARALLEL_ENC
+  /// marking of an inter-layer reference picture before the current picture marked it
+  struct IvRefPicMarking
+  {
+    TComPic* pcPic;
+    Bool     bIsLongTerm;
+    Bool     bIsReferenced;
+  };
+  std::vector<IvRefPicMarking> m_ivRefPicMarkings;
+#endif
 
   Int                     m_pocLastCoded;
   Int                     m_layerId;  
@@ -152,6 +215,9 @@ private:
   UInt                    m_totalCoded;
   Bool                    m_bufferingPeriodSEIPresentInAU;
   SEIEncoder              m_seiEncoder;
+#if PIC_METRICS_PARALLEL_ENC
+  std::list<PicMetrics*>  m_apcPicMetrics;        ///< pictures handed to the metrics pool
+#endif
 
 public:
   TEncGOP();
@@ -172,6 +238,9 @@ public:
   Void  xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, TComOutputBitstream* pcBitstreamRedirect);
 
 #if NH_MV
+#if NH_MV_LAYER_PARALLEL_ENC
+  Void      markIvRefPicsAsShortTerm ()         { TComSlice::markIvRefPicsAsShortTerm( m_refPicSetInterLayer0, m_refPicSetInterLayer1 ); }
+#endif
   Int       getPocLastCoded  ()                 { return m_pocLastCoded; }  
   Int       getLayerId       ()                 { return m_layerId;    }  
   Int       getViewId        ()                 { return m_viewId;    }
@@ -185,6 +254,9 @@ public:
 
   TComList<TComPic*>*   getListPic()      { return m_pcListPic; }
   Void  printOutSummary      ( UInt uiNumAllPicCoded, Bool isField, const Bool printMSEBasedSNR, const Bool printSequenceMSE, const BitDepths &bitDepths );
+#if PIC_METRICS_PARALLEL_ENC
+  Void  waitPicMetrics       ();                  ///< finish the metrics of all coded pictures, required before a picture buffer is reused
+#endif
 #if NH_3D_VSO
   Void  preLoopFilterPicAll  ( TComPic* pcPic, Dist64& ruiDist);
 #else
@@ -206,9 +278,22 @@ protected:
 
   Void  xInitGOP          ( Int iPOCLast, Int iNumPicRcvd, Bool isField );
   Void  xGetBuffer        ( TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Int iNumPicRcvd, Int iTimeOffset, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut, Int pocCurr, Bool isField );
+#if NH_MV_FRAME_PARALLEL_ENC
+  Void  xSaveIvRefPicMarking    ( TComSlice* pcSlice );
+  Void  xRestoreIvRefPicMarking ();
+  Void  xWaitForRefPicAus       ( TComSlice* pcSlice );   ///< block until the access units of the temporal reference pictures are finished
+#endif
 
   Void  xCalculateAddPSNRs         ( const Bool isField, const Bool isFieldTopFieldFirst, const Int iGOPid, TComPic* pcPic, const AccessUnit&accessUnit, TComList<TComPic*> &rcListPic, Double dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE );
   Void  xCalculateAddPSNR          ( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit&, Double dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE );
+  Void  xInitPicMetrics            ( PicMetrics& rcMetrics, TComPic* pcPic, TComPicYuv* pcPicD, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE );
+  Void  xSetPicMetricsInfo         ( PicMetrics& rcMetrics, const AccessUnit& accessUnit, Double dEncTime );
+  Void  xCalculatePicMetrics       ( PicMetrics& rcMetrics );
+  Void  xAddPicMetrics             ( PicMetrics& rcMetrics );
+#if PIC_METRICS_PARALLEL_ENC
+  static Void xPicMetricsJob       ( Void* pParam );
+  Void  xWritePicMetricsHashSEIs   ();
+#endif
   Void  xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic* pcPicOrgSecondField,
                                      TComPicYuv* pcPicRecFirstField, TComPicYuv* pcPicRecSecondField,
                                      const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE );
@@ -64,6 +64,15 @@ TEncSampleAdaptiveOffset::TEncSampleAdaptiveOffset()
   m_pppcBinCoderCABAC = NULL;
   m_statData = NULL;
   m_preDBFstatData = NULL;
+  m_fpEdgeStatistics = xEdgeStatistics;
+#if SAO_SIMD && SIMD_X86
+  // the vectorized statistics are only installed if they give the same results as the scalar ones
+  static const Bool bSimdChecked = xCheckSimdEdgeStatistics();
+  if ( bSimdChecked )
+  {
+    xSetSimdEdgeStatistics( m_fpEdgeStatistics, getSimdExtension() );
+  }
+#endif
 }
 
 TEncSampleAdaptiveOffset::~TEncSampleAdaptiveOffset()
@@ -71,6 +80,20 @@ TEncSampleAdaptiveOffset::~TEncSampleAdaptiveOffset()
   destroyEncData();
 }
 
+#if SAO_SIMD && SIMD_X86
+/**
+ * \brief Use the offset and edge offset statistics functions of a SIMD extension
+ *
+ * \param eExtension  SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE selects the scalar functions
+ */
+Void TEncSampleAdaptiveOffset::setSimdExtension( SimdExtension eExtension )
+{
+  TComSampleAdaptiveOffset::setSimdExtension( eExtension );
+  m_fpEdgeStatistics = xEdgeStatistics;
+  xSetSimdEdgeStatistics( m_fpEdgeStatistics, eExtension );
+}
+#endif
+
 Void TEncSampleAdaptiveOffset::createEncData(Bool isPreDBFSamplesUsed)
 {
 
@@ -282,50 +305,92 @@ Void TEncSampleAdaptiveOffset::addPreDBFStatistics(SAOStatData*** blkStats)
   }
 }
 
+/** Statistics of all CTUs of a picture.
+ * The statistics of a CTU only depend on the samples, so the CTU rows are gathered in parallel if threads have been
+ * created.
+ */
 Void TEncSampleAdaptiveOffset::getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic, Bool isCalculatePreDeblockSamples)
+{
+#if SAO_PARALLEL
+  if ( m_cThreadPool.isParallel() )
+  {
+    m_acStatisticsRowJobs.resize( m_numCTUInHeight );
+    for ( Int ctuRow = 0; ctuRow < m_numCTUInHeight; ctuRow++ )
+    {
+      StatisticsRowJob& rcJob = m_acStatisticsRowJobs[ctuRow];
+      rcJob.pcEncSAO                     = this;
+      rcJob.pppcBlkStats                 = blkStats;
+      rcJob.pcOrgYuv                     = orgYuv;
+      rcJob.pcSrcYuv                     = srcYuv;
+      rcJob.pcPic                        = pPic;
+      rcJob.ctuRow                       = ctuRow;
+      rcJob.isCalculatePreDeblockSamples = isCalculatePreDeblockSamples;
+      m_cThreadPool.addJob( xStatisticsCtuRowJob, &rcJob );
+    }
+    m_cThreadPool.waitAll();
+    return;
+  }
+#endif
+  for(Int ctuRsAddr= 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
+  {
+    getCtuStatistics(blkStats, orgYuv, srcYuv, pPic, ctuRsAddr, isCalculatePreDeblockSamples);
+  }
+}
+
+#if SAO_PARALLEL
+Void TEncSampleAdaptiveOffset::xStatisticsCtuRowJob(Void* pParam)
+{
+  StatisticsRowJob*         pcJob    = (StatisticsRowJob*)pParam;
+  TEncSampleAdaptiveOffset* pcEncSAO = pcJob->pcEncSAO;
+
+  for(Int ctuRsAddr = pcJob->ctuRow*pcEncSAO->m_numCTUInWidth; ctuRsAddr < (pcJob->ctuRow+1)*pcEncSAO->m_numCTUInWidth; ctuRsAddr++)
+  {
+    pcEncSAO->getCtuStatistics(pcJob->pppcBlkStats, pcJob->pcOrgYuv, pcJob->pcSrcYuv, pcJob->pcPic, ctuRsAddr, pcJob->isCalculatePreDeblockSamples);
+  }
+}
+#endif
+
+Void TEncSampleAdaptiveOffset::getCtuStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic, Int ctuRsAddr, Bool isCalculatePreDeblockSamples)
 {
   Bool isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail;
 
   const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
 
-  for(Int ctuRsAddr= 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
-  {
-    Int yPos   = (ctuRsAddr / m_numCTUInWidth)*m_maxCUHeight;
-    Int xPos   = (ctuRsAddr % m_numCTUInWidth)*m_maxCUWidth;
-    Int height = (yPos + m_maxCUHeight > m_picHeight)?(m_picHeight- yPos):m_maxCUHeight;
-    Int width  = (xPos + m_maxCUWidth  > m_picWidth )?(m_picWidth - xPos):m_maxCUWidth;
+  Int yPos   = (ctuRsAddr / m_numCTUInWidth)*m_maxCUHeight;
+  Int xPos   = (ctuRsAddr % m_numCTUInWidth)*m_maxCUWidth;
+  Int height = (yPos + m_maxCUHeight > m_picHeight)?(m_picHeight- yPos):m_maxCUHeight;
+  Int width  = (xPos + m_maxCUWidth  > m_picWidth )?(m_picWidth - xPos):m_maxCUWidth;
 
-    pPic->getPicSym()->deriveLoopFilterBoundaryAvailibility(ctuRsAddr, isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
+  pPic->getPicSym()->deriveLoopFilterBoundaryAvailibility(ctuRsAddr, isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
 
-    //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
-    //For simplicity, here only picture boundaries are considered.
+  //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
+  //For simplicity, here only picture boundaries are considered.
 
-    isRightAvail      = (xPos + m_maxCUWidth  < m_picWidth );
-    isBelowAvail      = (yPos + m_maxCUHeight < m_picHeight);
-    isBelowRightAvail = (isRightAvail && isBelowAvail);
-    isBelowLeftAvail  = ((xPos > 0) && (isBelowAvail));
-    isAboveRightAvail = ((yPos > 0) && (isRightAvail));
+  isRightAvail      = (xPos + m_maxCUWidth  < m_picWidth );
+  isBelowAvail      = (yPos + m_maxCUHeight < m_picHeight);
+  isBelowRightAvail = (isRightAvail && isBelowAvail);
+  isBelowLeftAvail  = ((xPos > 0) && (isBelowAvail));
+  isAboveRightAvail = ((yPos > 0) && (isRightAvail));
 
-    for(Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
-    {
-      const ComponentID component = ComponentID(compIdx);
+  for(Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+  {
+    const ComponentID component = ComponentID(compIdx);
 
-      const UInt componentScaleX = getComponentScaleX(component, pPic->getChromaFormat());
-      const UInt componentScaleY = getComponentScaleY(component, pPic->getChromaFormat());
+    const UInt componentScaleX = getComponentScaleX(component, pPic->getChromaFormat());
+    const UInt componentScaleY = getComponentScaleY(component, pPic->getChromaFormat());
 
-      Int  srcStride  = srcYuv->getStride(component);
-      Pel* srcBlk     = srcYuv->getAddr(component) + ((yPos >> componentScaleY) * srcStride) + (xPos >> componentScaleX);
+    Int  srcStride  = srcYuv->getStride(component);
+    Pel* srcBlk     = srcYuv->getAddr(component) + ((yPos >> componentScaleY) * srcStride) + (xPos >> componentScaleX);
 
-      Int  orgStride  = orgYuv->getStride(component);
-      Pel* orgBlk     = orgYuv->getAddr(component) + ((yPos >> componentScaleY) * orgStride) + (xPos >> componentScaleX);
+    Int  orgStride  = orgYuv->getStride(component);
+    Pel* orgBlk     = orgYuv->getAddr(component) + ((yPos >> componentScaleY) * orgStride) + (xPos >> componentScaleX);
 
-      getBlkStats(component, pPic->getPicSym()->getSPS().getBitDepth(toChannelType(component)), blkStats[ctuRsAddr][component]
-                , srcBlk, orgBlk, srcStride, orgStride, (width  >> componentScaleX), (height >> componentScaleY)
-                , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
-                , isCalculatePreDeblockSamples
-                );
+    getBlkStats(component, pPic->getPicSym()->getSPS().getBitDepth(toChannelType(component)), blkStats[ctuRsAddr][component]
+              , srcBlk, orgBlk, srcStride, orgStride, (width  >> componentScaleX), (height >> componentScaleY)
+              , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
+              , isCalculatePreDeblockSamples
+              );
 
-    }
   }
 }
 
@@ -840,12 +905,17 @@ Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled,
 
     m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_NEXT ]);
 
-    //apply reconstructed offsets
+    //reconstructed offsets
     reconParams[ctuRsAddr] = codedParams[ctuRsAddr];
     reconstructBlkSAOParam(reconParams[ctuRsAddr], mergeList);
-    offsetCTU(ctuRsAddr, srcYuv, resYuv, reconParams[ctuRsAddr], pic);
   } //ctuRsAddr
 
+  //apply reconstructed offsets, the decisions above only use the statistics
+  if (!allBlksDisabled)
+  {
+    offsetPicture(pic, srcYuv, resYuv, reconParams);
+  }
+
   if (!allBlksDisabled && (totalCost >= 0) && bTestSAODisableAtPictureLevel) //SAO has not beneficial in this case - disable it
   {
     for(Int ctuRsAddr = 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
@@ -892,38 +962,40 @@ Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled,
 }
 
 
-Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int channelBitDepth, SAOStatData* statsDataTypes
-                        , Pel* srcBlk, Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height
-                        , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail
-                        , Bool isCalculatePreDeblockSamples
-                        )
+/** Edge offset statistics of a block, with the edge class of each sample derived directly from its two neighbours.
+ */
+Void TEncSampleAdaptiveOffset::xEdgeStatistics(const Pel* srcBlk, const Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height
+                                              , Int neighborA, Int neighborB, Int64* diff, Int64* count)
 {
-  if(m_lineBufWidth != m_maxCUWidth)
+  diff +=2;
+  count+=2;
+  for (Int y=0; y<height; y++)
   {
-    m_lineBufWidth = m_maxCUWidth;
-
-    if (m_signLineBuf1)
-    {
-      delete[] m_signLineBuf1;
-      m_signLineBuf1 = NULL;
-    }
-    m_signLineBuf1 = new SChar[m_lineBufWidth+1];
-
-    if (m_signLineBuf2)
+    for (Int x=0; x<width; x++)
     {
-      delete[] m_signLineBuf2;
-      m_signLineBuf2 = NULL;
+      const Int edgeType = sgn(srcBlk[x] - srcBlk[x+ neighborA]) + sgn(srcBlk[x] - srcBlk[x+ neighborB]);
+      diff [edgeType] += (orgBlk[x] - srcBlk[x]);
+      count[edgeType] ++;
     }
-    m_signLineBuf2 = new SChar[m_lineBufWidth+1];
+    srcBlk += srcStride;
+    orgBlk += orgStride;
   }
+}
 
-  Int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
-  SChar signLeft, signRight, signDown;
+Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int channelBitDepth, SAOStatData* statsDataTypes
+                        , Pel* srcBlk, Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height
+                        , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail
+                        , Bool isCalculatePreDeblockSamples
+                        )
+{
+  Int x,y, startX, startY, endX, endY, firstLineStartX, firstLineEndX;
   Int64 *diff, *count;
   Pel *srcLine, *orgLine;
   Int* skipLinesR = m_skipLinesR[compIdx];
   Int* skipLinesB = m_skipLinesB[compIdx];
 
+  // the samples of an edge offset class are gathered in rectangles (first line, middle lines, skipped lines below)
+  // whose neighbours are at the same pointer offsets
   for(Int typeIdx=0; typeIdx< NUM_SAO_NEW_TYPES; typeIdx++)
   {
     SAOStatData& statsData= statsDataTypes[typeIdx];
@@ -937,8 +1009,6 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
     {
     case SAO_TYPE_EO_0:
       {
-        diff +=2;
-        count+=2;
         endY   = (isBelowAvail) ? (height - skipLinesB[typeIdx]) : height;
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
@@ -946,53 +1016,20 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
         endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  : (isRightAvail ? width : (width - 1))
                                                  ;
-        for (y=0; y<endY; y++)
-        {
-          signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-          for (x=startX; x<endX; x++)
-          {
-            signRight =  (SChar)sgn(srcLine[x] - srcLine[x+1]);
-            edgeType  =  signRight + signLeft;
-            signLeft  = -signRight;
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
+        xEdgeStatisticsRect(srcBlk, orgBlk, srcStride, orgStride, startX, 0, endX, endY, -1, 1, statsData);
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
           {
             startX = isLeftAvail  ? 0 : 1;
             endX   = isRightAvail ? width : (width -1);
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-              for (x=startX; x<endX; x++)
-              {
-                signRight =  (SChar)sgn(srcLine[x] - srcLine[x+1]);
-                edgeType  =  signRight + signLeft;
-                signLeft  = -signRight;
-
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            xEdgeStatisticsRect(srcBlk, orgBlk, srcStride, orgStride, startX, endY, endX, endY + skipLinesB[typeIdx], -1, 1, statsData);
           }
         }
       }
       break;
     case SAO_TYPE_EO_90:
       {
-        diff +=2;
-        count+=2;
-        SChar *signUpLine = m_signLineBuf1;
-
         startX = (!isCalculatePreDeblockSamples) ? 0
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : width)
                                                  ;
@@ -1001,56 +1038,12 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
                                                  : width
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
-        if (!isAboveAvail)
-        {
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
-
-        Pel* srcLineAbove = srcLine - srcStride;
-        for (x=startX; x<endX; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLine[x] - srcLineAbove[x]);
-        }
-
-        Pel* srcLineBelow;
-        for (y=startY; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for (x=startX; x<endX; x++)
-          {
-            signDown  = (SChar)sgn(srcLine[x] - srcLineBelow[x]);
-            edgeType  = signDown + signUpLine[x];
-            signUpLine[x]= -signDown;
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
+        xEdgeStatisticsRect(srcBlk, orgBlk, srcStride, orgStride, startX, startY, endX, endY, -srcStride, srcStride, statsData);
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
           {
-            startX = 0;
-            endX   = width;
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x]) + sgn(srcLine[x] - srcLineAbove[x]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            xEdgeStatisticsRect(srcBlk, orgBlk, srcStride, orgStride, 0, endY, width, endY + skipLinesB[typeIdx], -srcStride, srcStride, statsData);
           }
         }
 
@@ -1058,13 +1051,6 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
       break;
     case SAO_TYPE_EO_135:
       {
-        diff +=2;
-        count+=2;
-        SChar *signUpLine, *signDownLine, *signTmpLine;
-
-        signUpLine  = m_signLineBuf1;
-        signDownLine= m_signLineBuf2;
-
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  ;
@@ -1074,81 +1060,26 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line's upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX; x<endX+1; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x-1]);
-        }
-
         //1st line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x-1]) - signUpLine[x+1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-        srcLine  += srcStride;
-        orgLine  += orgStride;
-
+        xEdgeStatisticsRect(srcBlk, orgBlk, srcStride, orgStride, firstLineStartX, 0, firstLineEndX, 1, -srcStride-1, srcStride+1, statsData);
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for (x=startX; x<endX; x++)
-          {
-            signDown = (SChar)sgn(srcLine[x] - srcLineBelow[x+1]);
-            edgeType = signDown + signUpLine[x];
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signDownLine[x+1] = -signDown;
-          }
-          signDownLine[startX] = (SChar)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-          signTmpLine  = signUpLine;
-          signUpLine   = signDownLine;
-          signDownLine = signTmpLine;
-
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
+        xEdgeStatisticsRect(srcBlk, orgBlk, srcStride, orgStride, startX, 1, endX, endY, -srcStride-1, srcStride+1, statsData);
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
           {
             startX = isLeftAvail  ? 0     : 1 ;
             endX   = isRightAvail ? width : (width -1);
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x< endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x+1]) + sgn(srcLine[x] - srcLineAbove[x-1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            xEdgeStatisticsRect(srcBlk, orgBlk, srcStride, orgStride, startX, endY, endX, endY + skipLinesB[typeIdx], -srcStride-1, srcStride+1, statsData);
           }
         }
       }
       break;
     case SAO_TYPE_EO_45:
       {
-        diff +=2;
-        count+=2;
-        SChar *signUpLine = m_signLineBuf1+1;
-
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  ;
@@ -1157,72 +1088,24 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX-1; x<endX; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x+1]);
-        }
-
-
         //first line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX)
                                                           : startX
                                                           ;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? ((!isRightAvail && isAboveRightAvail) ? width : endX)
                                                           : endX
                                                           ;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) - signUpLine[x-1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-
-        srcLine += srcStride;
-        orgLine += orgStride;
+        xEdgeStatisticsRect(srcBlk, orgBlk, srcStride, orgStride, firstLineStartX, 0, firstLineEndX, 1, -srcStride+1, srcStride-1, statsData);
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for(x=startX; x<endX; x++)
-          {
-            signDown = (SChar)sgn(srcLine[x] - srcLineBelow[x-1]);
-            edgeType = signDown + signUpLine[x];
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signUpLine[x-1] = -signDown;
-          }
-          signUpLine[endX-1] = (SChar)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
+        xEdgeStatisticsRect(srcBlk, orgBlk, srcStride, orgStride, startX, 1, endX, endY, -srcStride+1, srcStride-1, statsData);
         if(isCalculatePreDeblockSamples)
         {
           if(isBelowAvail)
           {
             startX = isLeftAvail  ? 0     : 1 ;
             endX   = isRightAvail ? width : (width -1);
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + sgn(srcLine[x] - srcLineAbove[x+1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
+            xEdgeStatisticsRect(srcBlk, orgBlk, srcStride, orgStride, startX, endY, endX, endY + skipLinesB[typeIdx], -srcStride+1, srcStride-1, statsData);
           }
         }
       }
@@ -49,6 +49,13 @@
 //! \ingroup TLibEncoder
 //! \{
 
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// edge offset statistics of a block, the difference org - src and the sample count of edge class edgeType are added to diff[edgeType+2] and count[edgeType+2]
+typedef Void (*FpSaoEdgeStatistics)( const Pel* srcBlk, const Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height, Int neighborA, Int neighborB, Int64* diff, Int64* count );
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -105,8 +112,16 @@ public:
   Void SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, Bool isPreDBFSamplesUsed);
 public: //methods
   Void getPreDBFStatistics(TComPic* pPic);
+#if SAO_SIMD && SIMD_X86
+  Void setSimdExtension( SimdExtension eExtension ); ///< use the offset and statistics functions of an extension, SIMD_NONE for the scalar ones
+#endif
+  FpSaoEdgeStatistics getEdgeStatistics() const { return m_fpEdgeStatistics; }
 private: //methods
   Void getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv,TComPic* pPic, Bool isCalculatePreDeblockSamples = false);
+  Void getCtuStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic, Int ctuRsAddr, Bool isCalculatePreDeblockSamples);
+#if SAO_PARALLEL
+  static Void xStatisticsCtuRowJob(Void* pParam);
+#endif
   Void decidePicParams(Bool* sliceEnabled, Int picTempLayer, const Double saoEncodingRate, const Double saoEncodingRateChroma);
   Void decideBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* reconParams, SAOBlkParam* codedParams, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma);
   Void getBlkStats(const ComponentID compIdx, const Int channelBitDepth, SAOStatData* statsDataTypes, Pel* srcBlk, Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height, Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isCalculatePreDeblockSamples);
@@ -117,6 +132,19 @@ private: //methods
   inline Int64 estSaoDist(Int64 count, Int64 offset, Int64 diffSum, Int shift);
   inline Int estIterOffset(Int typeIdx, Double lambda, Int offsetInput, Int64 count, Int64 diffSum, Int shift, Int bitIncrease, Int64& bestDist, Double& bestCost, Int offsetTh );
   Void addPreDBFStatistics(SAOStatData*** blkStats);
+  /// edge offset statistics of the samples [startX, endX) x [startY, endY) of a block, nothing for an empty range
+  Void xEdgeStatisticsRect(const Pel* srcBlk, const Pel* orgBlk, Int srcStride, Int orgStride, Int startX, Int startY, Int endX, Int endY, Int neighborA, Int neighborB, SAOStatData& statsData)
+  {
+    if (endX > startX && endY > startY)
+    {
+      m_fpEdgeStatistics(srcBlk + startY*srcStride + startX, orgBlk + startY*orgStride + startX, srcStride, orgStride, endX - startX, endY - startY, neighborA, neighborB, statsData.diff, statsData.count);
+    }
+  }
+  static Void xEdgeStatistics(const Pel* srcBlk, const Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height, Int neighborA, Int neighborB, Int64* diff, Int64* count);
+#if SAO_SIMD && SIMD_X86
+  static Void xSetSimdEdgeStatistics  (FpSaoEdgeStatistics& fpEdgeStatistics, SimdExtension eExtension);
+  Bool        xCheckSimdEdgeStatistics() const;
+#endif
 private: //members
   //for RDO
   TEncSbac**             m_pppcRDSbacCoder;
@@ -134,6 +162,21 @@ private: //members
   Double                 m_saoDisabledRate[MAX_NUM_COMPONENT][MAX_TLAYER];
   Int                    m_skipLinesR[MAX_NUM_COMPONENT][NUM_SAO_NEW_TYPES];
   Int                    m_skipLinesB[MAX_NUM_COMPONENT][NUM_SAO_NEW_TYPES];
+
+  FpSaoEdgeStatistics    m_fpEdgeStatistics;
+#if SAO_PARALLEL
+  struct StatisticsRowJob
+  {
+    TEncSampleAdaptiveOffset* pcEncSAO;
+    SAOStatData***            pppcBlkStats;
+    TComPicYuv*               pcOrgYuv;
+    TComPicYuv*               pcSrcYuv;
+    TComPic*                  pcPic;
+    Int                       ctuRow;
+    Bool                      isCalculatePreDeblockSamples;
+  };
+  std::vector<StatisticsRowJob> m_acStatisticsRowJobs;
+#endif
 };
 
 
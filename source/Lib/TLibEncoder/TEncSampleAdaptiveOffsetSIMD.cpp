@@ -0,0 +1,302 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncSampleAdaptiveOffsetSIMD.cpp
+    \brief    SSE4.1 and AVX2 implementations of the SAO edge offset statistics of the encoder
+
+    The edge class of 8 (16) samples is computed like in TComSampleAdaptiveOffsetSIMD.cpp. For each class the
+    differences org - src of the samples of the class are summed with a multiply-add by one into 32 bit lanes, and
+    the samples are counted the same way from the comparison masks. Rows which are not a multiple of the vector width
+    are finished with an overlapping last vector whose lanes of already counted samples are masked out.
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "TEncSampleAdaptiveOffset.h"
+
+#if SAO_SIMD && SIMD_X86
+
+#include <immintrin.h>
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Helpers
+// ====================================================================================================================
+
+/// the 8 lanes loaded from s_aiTailMask + 8 + n (the 16 lanes loaded from s_aiTailMask + n) select the last n lanes of a vector
+static const Short s_aiTailMask[32] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                       -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+
+/// edge class + 2 (0..4) of the samples vCur, sgn( cur - n ) is ( n > cur ) - ( cur > n ) with the masks of the comparisons
+static inline SIMD_TARGET_SSE41 __m128i xEdgeIdxSse41( __m128i vCur, const Pel* neighborA, const Pel* neighborB )
+{
+  const __m128i vA = _mm_loadu_si128( (const __m128i*)neighborA );
+  const __m128i vB = _mm_loadu_si128( (const __m128i*)neighborB );
+  const __m128i vSignA = _mm_sub_epi16( _mm_cmpgt_epi16( vA, vCur ), _mm_cmpgt_epi16( vCur, vA ) );
+  const __m128i vSignB = _mm_sub_epi16( _mm_cmpgt_epi16( vB, vCur ), _mm_cmpgt_epi16( vCur, vB ) );
+  return _mm_add_epi16( _mm_add_epi16( vSignA, vSignB ), _mm_set1_epi16( 2 ) );
+}
+
+static inline SIMD_TARGET_AVX2 __m256i xEdgeIdxAvx2( __m256i vCur, const Pel* neighborA, const Pel* neighborB )
+{
+  const __m256i vA = _mm256_loadu_si256( (const __m256i*)neighborA );
+  const __m256i vB = _mm256_loadu_si256( (const __m256i*)neighborB );
+  const __m256i vSignA = _mm256_sub_epi16( _mm256_cmpgt_epi16( vA, vCur ), _mm256_cmpgt_epi16( vCur, vA ) );
+  const __m256i vSignB = _mm256_sub_epi16( _mm256_cmpgt_epi16( vB, vCur ), _mm256_cmpgt_epi16( vCur, vB ) );
+  return _mm256_add_epi16( _mm256_add_epi16( vSignA, vSignB ), _mm256_set1_epi16( 2 ) );
+}
+
+/// adds the 8 samples at src of the lanes selected by vMask to the sums of their classes
+static inline SIMD_TARGET_SSE41 Void xAddEdgeStatisticsSse41( const Pel* src, const Pel* org, Int neighborA, Int neighborB, __m128i vMask, __m128i* vDiff, __m128i* vCount )
+{
+  const __m128i vOne   = _mm_set1_epi16( 1 );
+  const __m128i vCur   = _mm_loadu_si128( (const __m128i*)src );
+  const __m128i vIdx   = xEdgeIdxSse41( vCur, src + neighborA, src + neighborB );
+  const __m128i vDelta = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)org ), vCur );
+
+  for ( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    const __m128i vIsClass = _mm_and_si128( _mm_cmpeq_epi16( vIdx, _mm_set1_epi16( k ) ), vMask );
+    vDiff [k] = _mm_add_epi32( vDiff [k], _mm_madd_epi16( _mm_and_si128( vIsClass, vDelta ), vOne ) );
+    vCount[k] = _mm_sub_epi32( vCount[k], _mm_madd_epi16( vIsClass, vOne ) );
+  }
+}
+
+static inline SIMD_TARGET_AVX2 Void xAddEdgeStatisticsAvx2( const Pel* src, const Pel* org, Int neighborA, Int neighborB, __m256i vMask, __m256i* vDiff, __m256i* vCount )
+{
+  const __m256i vOne   = _mm256_set1_epi16( 1 );
+  const __m256i vCur   = _mm256_loadu_si256( (const __m256i*)src );
+  const __m256i vIdx   = xEdgeIdxAvx2( vCur, src + neighborA, src + neighborB );
+  const __m256i vDelta = _mm256_sub_epi16( _mm256_loadu_si256( (const __m256i*)org ), vCur );
+
+  for ( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    const __m256i vIsClass = _mm256_and_si256( _mm256_cmpeq_epi16( vIdx, _mm256_set1_epi16( k ) ), vMask );
+    vDiff [k] = _mm256_add_epi32( vDiff [k], _mm256_madd_epi16( _mm256_and_si256( vIsClass, vDelta ), vOne ) );
+    vCount[k] = _mm256_sub_epi32( vCount[k], _mm256_madd_epi16( vIsClass, vOne ) );
+  }
+}
+
+static inline SIMD_TARGET_SSE41 Int64 xHorizontalSumSse41( __m128i vSum )
+{
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0x4e ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0xb1 ) );
+  return _mm_cvtsi128_si32( vSum );
+}
+
+// ====================================================================================================================
+// Edge offset statistics
+// ====================================================================================================================
+
+/// counterpart of TEncSampleAdaptiveOffset::xEdgeStatistics(), the 32 bit sums are exact for blocks of up to 2^20 samples
+static SIMD_TARGET_SSE41 Void xEdgeStatisticsSse41( const Pel* srcBlk, const Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height, Int neighborA, Int neighborB, Int64* diff, Int64* count )
+{
+  assert( width * height <= ( 1 << 20 ) );
+
+  if ( width < 8 )
+  {
+    for ( Int y = 0; y < height; y++, srcBlk += srcStride, orgBlk += orgStride )
+    {
+      for ( Int x = 0; x < width; x++ )
+      {
+        const Int edgeType = sgn( srcBlk[x] - srcBlk[x + neighborA] ) + sgn( srcBlk[x] - srcBlk[x + neighborB] );
+        diff [edgeType + 2] += orgBlk[x] - srcBlk[x];
+        count[edgeType + 2] ++;
+      }
+    }
+    return;
+  }
+
+  const Int     widthVec  = width & ~7;
+  const Int     tail      = width & 7;
+  const __m128i vAll      = _mm_set1_epi16( -1 );
+  const __m128i vTailMask = _mm_loadu_si128( (const __m128i*)( s_aiTailMask + 8 + tail ) );
+  __m128i       vDiff [NUM_SAO_EO_CLASSES];
+  __m128i       vCount[NUM_SAO_EO_CLASSES];
+  for ( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    vDiff[k] = vCount[k] = _mm_setzero_si128();
+  }
+
+  for ( Int y = 0; y < height; y++ )
+  {
+    for ( Int x = 0; x < widthVec; x += 8 )
+    {
+      xAddEdgeStatisticsSse41( srcBlk + x, orgBlk + x, neighborA, neighborB, vAll, vDiff, vCount );
+    }
+    if ( tail )
+    {
+      xAddEdgeStatisticsSse41( srcBlk + width - 8, orgBlk + width - 8, neighborA, neighborB, vTailMask, vDiff, vCount );
+    }
+    srcBlk += srcStride;
+    orgBlk += orgStride;
+  }
+
+  for ( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    diff [k] += xHorizontalSumSse41( vDiff [k] );
+    count[k] += xHorizontalSumSse41( vCount[k] );
+  }
+}
+
+static SIMD_TARGET_AVX2 Void xEdgeStatisticsAvx2( const Pel* srcBlk, const Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height, Int neighborA, Int neighborB, Int64* diff, Int64* count )
+{
+  if ( width < 16 )
+  {
+    xEdgeStatisticsSse41( srcBlk, orgBlk, srcStride, orgStride, width, height, neighborA, neighborB, diff, count );
+    return;
+  }
+  assert( width * height <= ( 1 << 20 ) );
+
+  const Int     widthVec  = width & ~15;
+  const Int     tail      = width & 15;
+  const __m256i vAll      = _mm256_set1_epi16( -1 );
+  const __m256i vTailMask = _mm256_loadu_si256( (const __m256i*)( s_aiTailMask + tail ) );
+  __m256i       vDiff [NUM_SAO_EO_CLASSES];
+  __m256i       vCount[NUM_SAO_EO_CLASSES];
+  for ( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    vDiff[k] = vCount[k] = _mm256_setzero_si256();
+  }
+
+  for ( Int y = 0; y < height; y++ )
+  {
+    for ( Int x = 0; x < widthVec; x += 16 )
+    {
+      xAddEdgeStatisticsAvx2( srcBlk + x, orgBlk + x, neighborA, neighborB, vAll, vDiff, vCount );
+    }
+    if ( tail )
+    {
+      xAddEdgeStatisticsAvx2( srcBlk + width - 16, orgBlk + width - 16, neighborA, neighborB, vTailMask, vDiff, vCount );
+    }
+    srcBlk += srcStride;
+    orgBlk += orgStride;
+  }
+
+  for ( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    diff [k] += xHorizontalSumSse41( _mm_add_epi32( _mm256_castsi256_si128( vDiff [k] ), _mm256_extracti128_si256( vDiff [k], 1 ) ) );
+    count[k] += xHorizontalSumSse41( _mm_add_epi32( _mm256_castsi256_si128( vCount[k] ), _mm256_extracti128_si256( vCount[k], 1 ) ) );
+  }
+}
+
+// ====================================================================================================================
+// Selection and test
+// ====================================================================================================================
+
+/**
+ * \brief Select the edge offset statistics function of a SIMD extension
+ *
+ * \param fpEdgeStatistics  statistics function, kept for SIMD_NONE
+ * \param eExtension        SIMD extension, at most the one returned by getSimdExtension()
+ */
+Void TEncSampleAdaptiveOffset::xSetSimdEdgeStatistics( FpSaoEdgeStatistics& fpEdgeStatistics, SimdExtension eExtension )
+{
+  if ( eExtension >= SIMD_AVX2 )
+  {
+    fpEdgeStatistics = xEdgeStatisticsAvx2;
+  }
+  else if ( eExtension >= SIMD_SSE41 )
+  {
+    fpEdgeStatistics = xEdgeStatisticsSse41;
+  }
+}
+
+static UInt xGetTestRand(UInt& ruiSeed)
+{
+  ruiSeed = ruiSeed * 1103515245 + 12345;
+  return ( ruiSeed >> 8 );
+}
+
+/**
+ * \brief Compare the vectorized edge offset statistics of all extensions supported by the CPU with the scalar ones
+ *
+ * The blocks have random sizes, original samples and reconstructed samples around a random level, and the
+ * neighbours of all four edge offset directions. Returns true if all sums and counts are identical.
+ */
+Bool TEncSampleAdaptiveOffset::xCheckSimdEdgeStatistics() const
+{
+  const Int stride = MAX_CU_SIZE + 16;
+  const Int margin = stride + 8;
+  const Int size   = stride * ( MAX_CU_SIZE + 2 );
+  static Pel src[ size ];
+  static Pel org[ size ];
+  UInt seed = 1;
+
+  for ( Int extension = SIMD_SSE41; extension <= getSimdExtension(); extension++ )
+  {
+    FpSaoEdgeStatistics fpEdgeStatistics = xEdgeStatistics;
+    xSetSimdEdgeStatistics( fpEdgeStatistics, SimdExtension( extension ) );
+
+    for ( Int test = 0; test < 256; test++ )
+    {
+      const Int  bitDepth = ( test & 1 ) ? 10 : 8;
+      const Int  width    = 1 + xGetTestRand( seed ) % MAX_CU_SIZE;
+      const Int  height   = 1 + xGetTestRand( seed ) % MAX_CU_SIZE;
+      const Int  maxVal   = ( 1 << bitDepth ) - 1;
+      const Int  level    = xGetTestRand( seed ) % ( 1 << bitDepth );
+      const Int  range    = 1 + xGetTestRand( seed ) % ( ( test & 2 ) ? ( 1 << bitDepth ) : 8 );
+      const Int  neighbors[4][2] = { { -1, 1 }, { -stride, stride }, { -stride - 1, stride + 1 }, { -stride + 1, stride - 1 } };
+      const Int* neighbor = neighbors[( test >> 2 ) & 3];
+      Int64      diffRef [NUM_SAO_EO_CLASSES] = { 0 };
+      Int64      countRef[NUM_SAO_EO_CLASSES] = { 0 };
+      Int64      diffVec [NUM_SAO_EO_CLASSES] = { 0 };
+      Int64      countVec[NUM_SAO_EO_CLASSES] = { 0 };
+
+      for ( Int i = 0; i < size; i++ )
+      {
+        src[i] = Pel( Clip3<Int>( 0, maxVal, level + Int( xGetTestRand( seed ) % range ) - range / 2 ) );
+        org[i] = Pel( xGetTestRand( seed ) % ( 1 << bitDepth ) );
+      }
+
+      xEdgeStatistics ( src + margin, org + margin, stride, stride, width, height, neighbor[0], neighbor[1], diffRef, countRef );
+      fpEdgeStatistics( src + margin, org + margin, stride, stride, width, height, neighbor[0], neighbor[1], diffVec, countVec );
+
+      if ( memcmp( diffRef, diffVec, sizeof( diffRef ) ) || memcmp( countRef, countVec, sizeof( countRef ) ) )
+      {
+        printf( "\nWarning: vectorized SAO edge offset statistics differ from the scalar ones (%dx%d), the scalar statistics are used\n", width, height );
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+//! \}
+
+#endif // SAO_SIMD && SIMD_X86
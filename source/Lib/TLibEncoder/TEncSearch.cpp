@@ -7878,6 +7878,146 @@ Void TEncSearch::xSearchDmmDeltaDCs( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piO
 #endif
 }
 
+#if NH_3D_DMM_PACKED_PATTERNS
+/** Distortion of the prediction of a block by the mean values of its samples in the two segments of a wedgelet.
+ * The segment sums are taken from the row prefix sums at the boundaries of the runs of set pattern bits,
+ * without the SAD the prediction block is not built.
+ * \param puiRefRowSums prefix sums of the rows of piRef, uiWidth+1 per row
+ * \param uiRefSum      sum of all samples of piRef
+ */
+Dist TEncSearch::xGetDmm1WedgeDist( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piRef, UInt uiRefStride, UInt uiWidth, TComWedgelet* pcWedgelet, const UInt* puiRefRowSums, UInt uiRefSum )
+{
+  const Int bitDepthY = pcCU->getSlice()->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA);
+  UInt64    auiRows[DMM_MAX_PACKED_SIZE];
+  pcWedgelet->getPackedPatternScaled( uiWidth, auiRows );
+
+  // a run of set bits starts at a set bit following a cleared one and ends at a cleared bit following a set one
+  const UInt64 uiRowMask   = ( uiWidth < 64 ) ? ( ( UInt64( 1 ) << uiWidth ) - 1 ) : ~UInt64( 0 );
+  UInt         uiDC2       = 0;
+  UInt         uiNumPixDC2 = 0;
+  for( UInt uiY = 0; uiY < uiWidth; uiY++ )
+  {
+    const UInt64 uiRow   = auiRows[uiY];
+    const UInt*  puiSums = puiRefRowSums + uiY * ( uiWidth + 1 );
+    UInt64       uiEdges = ( uiRow ^ ( uiRow << 1 ) ) & uiRowMask;
+    while( uiEdges != 0 )
+    {
+      const Int iX = getPatternRowFirstBit( uiEdges );
+      if( ( uiRow >> iX ) & 1 ) { uiDC2 -= puiSums[iX]; }
+      else                      { uiDC2 += puiSums[iX]; }
+      uiEdges &= uiEdges - 1;
+    }
+    if( ( uiRow >> ( uiWidth - 1 ) ) & 1 )
+    {
+      uiDC2 += puiSums[uiWidth];
+    }
+    uiNumPixDC2 += countPatternRowBits( uiRow );
+  }
+  const UInt uiDC1       = uiRefSum - uiDC2;
+  const UInt uiNumPixDC1 = uiWidth * uiWidth - uiNumPixDC2;
+
+  // as xCalcBiSegDCs()
+  Pel refDC1 = (1<<(bitDepthY-1));
+  Pel refDC2 = (1<<(bitDepthY-1));
+  if( uiNumPixDC1 > 0 ) { refDC1 = uiDC1 / uiNumPixDC1; }
+  if( uiNumPixDC2 > 0 ) { refDC2 = uiDC2 / uiNumPixDC2; }
+
+#if NH_3D_VSO
+  if( m_pcRdCost->getUseVSO() )
+  {
+    Pel  aiPred[DMM_MAX_SIZE * DMM_MAX_SIZE];
+    UInt uiPredStride = uiWidth;
+    for( UInt uiY = 0; uiY < uiWidth; uiY++ )
+    {
+      for( UInt uiX = 0; uiX < uiWidth; uiX++ )
+      {
+        aiPred[uiY * uiPredStride + uiX] = ( ( auiRows[uiY] >> uiX ) & 1 ) ? refDC2 : refDC1;
+      }
+    }
+    if( m_pcRdCost->getUseEstimatedVSD() )
+    {
+      return m_pcRdCost->getDistPartVSD( pcCU, uiAbsPtIdx, bitDepthY, aiPred, uiPredStride, piRef, uiRefStride, uiWidth, uiWidth, false );
+    }
+    else
+    {
+      return m_pcRdCost->getDistPartVSO( pcCU, uiAbsPtIdx, bitDepthY, aiPred, uiPredStride, piRef, uiRefStride, uiWidth, uiWidth, false );
+    }
+  }
+#endif
+
+  // getDistPart( DF_SAD ) of the prediction
+  Distortion uiSum = 0;
+  for( UInt uiY = 0; uiY < uiWidth; uiY++ )
+  {
+    const UInt64 uiRow  = auiRows[uiY];
+    const Pel*   piOrg  = piRef + uiY * uiRefStride;
+    for( UInt uiX = 0; uiX < uiWidth; uiX++ )
+    {
+      uiSum += abs( piOrg[uiX] - ( ( ( uiRow >> uiX ) & 1 ) ? refDC2 : refDC1 ) );
+    }
+  }
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(bitDepthY-8);
+}
+
+Void TEncSearch::xSearchDmm1Wedge( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piRef, UInt uiRefStride, UInt uiWidth, UInt uiHeight, UInt& ruiTabIdx )
+{
+  assert( uiWidth == uiHeight && uiWidth <= DMM_MAX_SIZE );
+  ruiTabIdx = 0;
+
+  // row prefix sums of the reference block, shared by all wedgelets
+  UInt auiRefRowSums[DMM_MAX_SIZE * (DMM_MAX_SIZE + 1)];
+  UInt uiRefSum = 0;
+  for( UInt uiY = 0; uiY < uiHeight; uiY++ )
+  {
+    UInt*      puiSums = auiRefRowSums + uiY * ( uiWidth + 1 );
+    const Pel* piRow   = piRef + uiY * uiRefStride;
+    puiSums[0] = 0;
+    for( UInt uiX = 0; uiX < uiWidth; uiX++ )
+    {
+      puiSums[uiX + 1] = puiSums[uiX] + piRow[uiX];
+    }
+    uiRefSum += puiSums[uiWidth];
+  }
+
+  WedgeList*     pacWedgeList     = getWedgeListScaled    ( uiWidth );
+  WedgeNodeList* pacWedgeNodeList = getWedgeNodeListScaled( uiWidth );
+
+  // coarse wedge search
+  Dist uiBestDist   = RDO_DIST_MAX;
+  UInt uiBestNodeId = 0;
+  for( UInt uiNodeId = 0; uiNodeId < pacWedgeNodeList->size(); uiNodeId++ )
+  {
+    TComWedgelet* pcWedgelet = &(pacWedgeList->at(pacWedgeNodeList->at(uiNodeId).getPatternIdx()));
+    Dist uiActDist = xGetDmm1WedgeDist( pcCU, uiAbsPtIdx, piRef, uiRefStride, uiWidth, pcWedgelet, auiRefRowSums, uiRefSum );
+
+    if( uiActDist < uiBestDist || uiBestDist == RDO_DIST_MAX )
+    {
+      uiBestDist   = uiActDist;
+      uiBestNodeId = uiNodeId;
+    }
+  }
+
+  // refinement
+  Dist uiBestDistRef = uiBestDist;
+  UInt uiBestTabIdxRef  = pacWedgeNodeList->at(uiBestNodeId).getPatternIdx();
+  for( UInt uiRefId = 0; uiRefId < DMM_NUM_WEDGE_REFINES; uiRefId++ )
+  {
+    if( pacWedgeNodeList->at(uiBestNodeId).getRefineIdx( uiRefId ) != DMM_NO_WEDGE_IDX )
+    {
+      TComWedgelet* pcWedgelet = &(pacWedgeList->at(pacWedgeNodeList->at(uiBestNodeId).getRefineIdx( uiRefId )));
+      Dist uiActDist = xGetDmm1WedgeDist( pcCU, uiAbsPtIdx, piRef, uiRefStride, uiWidth, pcWedgelet, auiRefRowSums, uiRefSum );
+
+      if( uiActDist < uiBestDistRef || uiBestDistRef == RDO_DIST_MAX )
+      {
+        uiBestDistRef   = uiActDist;
+        uiBestTabIdxRef = pacWedgeNodeList->at(uiBestNodeId).getRefineIdx( uiRefId );
+      }
+    }
+  }
+
+  ruiTabIdx = uiBestTabIdxRef;
+}
+#else
 Void TEncSearch::xSearchDmm1Wedge( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piRef, UInt uiRefStride, UInt uiWidth, UInt uiHeight, UInt& ruiTabIdx )
 {
   ruiTabIdx = 0;
@@ -7895,6 +8035,7 @@ Void TEncSearch::xSearchDmm1Wedge( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piRef
 
   WedgeList*     pacWedgeList     = getWedgeListScaled    ( uiWidth );
   WedgeNodeList* pacWedgeNodeList = getWedgeNodeListScaled( uiWidth );
+  Bool           abScaledPattern[32*32];
 
   // coarse wedge search
   Dist uiBestDist   = RDO_DIST_MAX;
@@ -7902,7 +8043,7 @@ Void TEncSearch::xSearchDmm1Wedge( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piRef
   for( UInt uiNodeId = 0; uiNodeId < pacWedgeNodeList->size(); uiNodeId++ )
   {
     TComWedgelet* pcWedgelet = &(pacWedgeList->at(pacWedgeNodeList->at(uiNodeId).getPatternIdx()));
-    Bool *pbPattern = pcWedgelet->getPatternScaled(uiWidth);
+    Bool *pbPattern = pcWedgelet->getPatternScaled(uiWidth, abScaledPattern);
     UInt uiStride   = uiWidth;
     xCalcBiSegDCs  ( piRef,  uiRefStride,  pbPattern, uiStride, refDC1, refDC2, (1<<(bitDepthY-1)) );
     assignBiSegDCs( piPred, uiPredStride, pbPattern, uiStride, refDC1, refDC2 );
@@ -7941,7 +8082,7 @@ Void TEncSearch::xSearchDmm1Wedge( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piRef
     if( pacWedgeNodeList->at(uiBestNodeId).getRefineIdx( uiRefId ) != DMM_NO_WEDGE_IDX )
     {
       TComWedgelet* pcWedgelet = &(pacWedgeList->at(pacWedgeNodeList->at(uiBestNodeId).getRefineIdx( uiRefId )));
-      Bool *pbPattern = pcWedgelet->getPatternScaled(uiWidth);
+      Bool *pbPattern = pcWedgelet->getPatternScaled(uiWidth, abScaledPattern);
       UInt uiStride   = uiWidth;
       xCalcBiSegDCs  ( piRef,  uiRefStride,  pbPattern, uiStride, refDC1, refDC2, (1<<(bitDepthY-1)) );
       assignBiSegDCs( piPred, uiPredStride, pbPattern, uiStride, refDC1, refDC2 );
@@ -7977,6 +8118,7 @@ Void TEncSearch::xSearchDmm1Wedge( TComDataCU* pcCU, UInt uiAbsPtIdx, Pel* piRef
   cPredYuv.destroy();
   return;
 }
+#endif
 
 #endif
 #if NH_3D_SDC_INTRA
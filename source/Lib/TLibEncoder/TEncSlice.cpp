@@ -45,6 +45,112 @@
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
+#if WPP_PARALLEL_ENC
+TEncCtuRowEncoder::TEncCtuRowEncoder()
+: m_pppcRDSbacCoder  ( NULL )
+, m_pppcBinCoderCABAC( NULL )
+, m_uiTotalDepth     ( 0 )
+{
+  m_cRDGoOnSbacCoder.init( &m_cRDGoOnBinCoderCABAC );
+}
+
+TEncCtuRowEncoder::~TEncCtuRowEncoder()
+{
+}
+
+/** create the coding classes of a wavefront worker thread, configured like the ones of the encoder
+ * \param pcEncTop encoder class
+ */
+Void TEncCtuRowEncoder::create( TEncTop* pcEncTop )
+{
+  m_uiTotalDepth = pcEncTop->getMaxTotalCUDepth();
+
+  m_cCuEncoder.create( m_uiTotalDepth, pcEncTop->getMaxCUWidth(), pcEncTop->getMaxCUHeight(), pcEncTop->getChromaFormatIdc() );
+
+  m_pppcRDSbacCoder = new TEncSbac** [m_uiTotalDepth+1];
+#if FAST_BIT_EST
+  m_pppcBinCoderCABAC = new TEncBinCABACCounter** [m_uiTotalDepth+1];
+#else
+  m_pppcBinCoderCABAC = new TEncBinCABAC** [m_uiTotalDepth+1];
+#endif
+
+  for ( UInt uiDepth = 0; uiDepth < m_uiTotalDepth+1; uiDepth++ )
+  {
+    m_pppcRDSbacCoder[uiDepth] = new TEncSbac* [CI_NUM];
+#if FAST_BIT_EST
+    m_pppcBinCoderCABAC[uiDepth] = new TEncBinCABACCounter* [CI_NUM];
+#else
+    m_pppcBinCoderCABAC[uiDepth] = new TEncBinCABAC* [CI_NUM];
+#endif
+
+    for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+    {
+      m_pppcRDSbacCoder[uiDepth][iCIIdx] = new TEncSbac;
+#if FAST_BIT_EST
+      m_pppcBinCoderCABAC [uiDepth][iCIIdx] = new TEncBinCABACCounter;
+#else
+      m_pppcBinCoderCABAC [uiDepth][iCIIdx] = new TEncBinCABAC;
+#endif
+      m_pppcRDSbacCoder   [uiDepth][iCIIdx]->init( m_pppcBinCoderCABAC [uiDepth][iCIIdx] );
+    }
+  }
+
+  pcEncTop->initTrQuant( &m_cTrQuant );
+#if NH_3D_IC
+  m_cEntropyCoder.setICStatisticsMutex( pcEncTop->getICStatisticsMutex() );
+#endif
+  m_cSearch.init( pcEncTop, &m_cTrQuant, pcEncTop->getSearchRange(), pcEncTop->getBipredSearchRange(), pcEncTop->getMotionEstimationSearchMethod(),
+                  pcEncTop->getMaxCUWidth(), pcEncTop->getMaxCUHeight(), m_uiTotalDepth, &m_cEntropyCoder, &m_cRdCost, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder );
+  m_cCuEncoder.init( pcEncTop, &m_cSearch, &m_cTrQuant, &m_cRdCost, &m_cEntropyCoder, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder );
+}
+
+Void TEncCtuRowEncoder::destroy()
+{
+  m_cCuEncoder.destroy();
+  m_cSearch.destroy();
+
+  for ( UInt uiDepth = 0; uiDepth < m_uiTotalDepth+1; uiDepth++ )
+  {
+    for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+    {
+      delete m_pppcRDSbacCoder[uiDepth][iCIIdx];
+      delete m_pppcBinCoderCABAC[uiDepth][iCIIdx];
+    }
+    delete [] m_pppcRDSbacCoder[uiDepth];
+    delete [] m_pppcBinCoderCABAC[uiDepth];
+  }
+
+  delete [] m_pppcRDSbacCoder;
+  delete [] m_pppcBinCoderCABAC;
+  m_pppcRDSbacCoder   = NULL;
+  m_pppcBinCoderCABAC = NULL;
+}
+
+/** take over the state that the slice encoder sets up per slice on the main coding classes
+ * \param pcRdCost     RD cost class of the encoder (lambdas, distortion weights, VSO setup)
+ * \param pcTrQuant    transform & quantization class of the encoder (RDOQ lambdas)
+ * \param pcPredSearch encoder search class of the encoder (adaptive search ranges)
+ * \param bFastDeltaQP fast delta QP decision of the slice
+ */
+Void TEncCtuRowEncoder::initSlice( TComRdCost* pcRdCost, TComTrQuant* pcTrQuant, TEncSearch* pcPredSearch, const Bool bFastDeltaQP )
+{
+  m_cRdCost = *pcRdCost;
+#if RDOQ_CHROMA_LAMBDA
+  m_cTrQuant.setLambdas( pcTrQuant->getLambdas() );
+#else
+  m_cTrQuant.setLambda( pcTrQuant->getLambda() );
+#endif
+  for ( Int iDir = 0; iDir < MAX_NUM_REF_LIST_ADAPT_SR; iDir++ )
+  {
+    for ( Int iRefIdx = 0; iRefIdx < MAX_IDX_ADAPT_SR; iRefIdx++ )
+    {
+      m_cSearch.setAdaptiveSearchRange( iDir, iRefIdx, pcPredSearch->getAdaptiveSearchRange( iDir, iRefIdx ) );
+    }
+  }
+  m_cCuEncoder.setFastDeltaQp( bFastDeltaQP );
+}
+#endif
+
 TEncSlice::TEncSlice()
  : m_encCABACTableIdx(I_SLICE)
 {
@@ -54,6 +160,11 @@ TEncSlice::TEncSlice()
   m_pdRdPicLambda = NULL;
   m_pdRdPicQp     = NULL;
   m_piRdPicQp     = NULL;
+#if WPP_PARALLEL_ENC
+  m_pcCtuRowSyncContextStates = NULL;
+  m_pcCtuRowProgress          = NULL;
+  m_uiNumCtuRows              = 0;
+#endif
 }
 
 TEncSlice::~TEncSlice()
@@ -111,6 +222,27 @@ Void TEncSlice::destroy()
     xFree( m_piRdPicQp );
     m_piRdPicQp = NULL;
   }
+
+#if WPP_PARALLEL_ENC
+  // stop the wavefront worker threads and free their coding classes
+  m_cCtuRowThreadPool.destroy();
+  for ( UInt i = 0; i < m_apcCtuRowEncoders.size(); i++ )
+  {
+    m_apcCtuRowEncoders[i]->destroy();
+    delete m_apcCtuRowEncoders[i];
+  }
+  m_apcCtuRowEncoders.clear();
+  if ( m_pcCtuRowSyncContextStates )
+  {
+    delete [] m_pcCtuRowSyncContextStates;
+    m_pcCtuRowSyncContextStates = NULL;
+  }
+  if ( m_pcCtuRowProgress )
+  {
+    delete [] m_pcCtuRowProgress;
+    m_pcCtuRowProgress = NULL;
+  }
+#endif
 }
 
 Void TEncSlice::init( TEncTop* pcEncTop )
@@ -150,6 +282,34 @@ Void TEncSlice::init( TEncTop* pcEncTop )
 
 }
 
+#if WPP_PARALLEL_ENC
+/** Create the worker threads and their coding classes used to compress the CTU rows of wavefront slices in parallel.
+ * Must be called after the transform & quantization class of the encoder is initialised.
+ * \param pcEncTop encoder class
+ */
+Void TEncSlice::createCtuRowEncoders( TEncTop* pcEncTop )
+{
+  m_uiNumCtuRows = ( m_pcCfg->getSourceHeight() + m_pcCfg->getMaxCUHeight() - 1 ) / m_pcCfg->getMaxCUHeight();
+
+  // tracing requires the CTUs to be processed in coding order
+  const Int numThreads = ( ENC_DEC_TRACE || !m_pcCfg->getEntropyCodingSyncEnabledFlag() ) ? 1 : std::min( m_pcCfg->getNumWppThreads(), (Int)m_uiNumCtuRows );
+  if ( numThreads <= 1 )
+  {
+    return;
+  }
+
+  for ( Int i = 0; i < numThreads; i++ )
+  {
+    TEncCtuRowEncoder* pcRowEncoder = new TEncCtuRowEncoder;
+    pcRowEncoder->create( pcEncTop );
+    m_apcCtuRowEncoders.push_back( pcRowEncoder );
+  }
+  m_pcCtuRowSyncContextStates = new TEncSbac    [ m_uiNumCtuRows ];
+  m_pcCtuRowProgress          = new TComProgress[ m_uiNumCtuRows ];
+  m_cCtuRowThreadPool.create( numThreads );
+}
+#endif
+
 
 
 Void
@@ -876,12 +1036,25 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     }
   }
 
+#if WPP_PARALLEL_ENC
+  // compress the CTU rows in parallel threads, keeping the wavefront dependencies
+  const Bool bCtuRowThreads = xUseCtuRowThreads( pcPic, bCompressEntireSlice );
+  if ( bCtuRowThreads )
+  {
+    xCompressSliceCtuRows( pcPic, startCtuTsAddr, boundingCtuTsAddr, bFastDeltaQP );
+  }
+#endif
+
   // for every CTU in the slice segment (may terminate sooner if there is a byte limit on the slice-segment)
 #if NH_3D_VSO
   Int iLastPosY = -1;
 #endif
 
+#if WPP_PARALLEL_ENC
+  for( UInt ctuTsAddr = startCtuTsAddr; !bCtuRowThreads && ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+#else
   for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+#endif
   {
     const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
     // initialize CTU encoder
@@ -1120,6 +1293,215 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
   //}
 }
 
+#if WPP_PARALLEL_ENC
+/** Check whether the CTU rows of the current slice segment can be compressed in parallel.
+ * Rate control, byte limited slices and adaptive QP selection update state after every CTU, the VSO renderer model
+ * is set up per CTU row and shared, and tiles are not supported: these fall back to the sequential loop.
+ */
+Bool TEncSlice::xUseCtuRowThreads( TComPic* pcPic, const Bool bCompressEntireSlice )
+{
+  const TComSlice* pcSlice = pcPic->getSlice(getSliceIdx());
+
+  return !m_apcCtuRowEncoders.empty()
+      && pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag()
+      && pcPic->getPicSym()->getNumTiles() == 1
+      && pcPic->getFrameHeightInCtus() <= m_uiNumCtuRows
+      && !m_pcCfg->getUseRateCtrl()
+#if ADAPTIVE_QP_SELECTION
+      && !m_pcCfg->getUseAdaptQpSelect()
+#endif
+#if NH_3D_VSO
+      && !m_pcRdCost->getUseRenModel()
+#endif
+      && pcSlice->getSliceMode() != FIXED_NUMBER_OF_BYTES
+      && ( bCompressEntireSlice || pcSlice->getSliceSegmentMode() != FIXED_NUMBER_OF_BYTES );
+}
+
+/** Compress the CTUs of a slice segment with one job per CTU row.
+ * A CTU is compressed when the CTU above-right is finished, which also provides the WPP context state of the
+ * row above. The jobs are queued in row order, and each one uses the coding classes of worker (row % threads):
+ * rows finish in order, so a set of coding classes is free again when its next row is started.
+ */
+Void TEncSlice::xCompressSliceCtuRows( TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, const Bool bFastDeltaQP )
+{
+  TComSlice* const pcSlice          = pcPic->getSlice(getSliceIdx());
+  const UInt       frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+  // there is a single tile, so tile scan and raster scan are identical
+  const UInt       firstCtuRow      = startCtuTsAddr / frameWidthInCtus;
+  const UInt       lastCtuRow       = ( boundingCtuTsAddr - 1 ) / frameWidthInCtus;
+
+  for ( UInt i = 0; i < m_apcCtuRowEncoders.size(); i++ )
+  {
+    m_apcCtuRowEncoders[i]->initSlice( m_pcRdCost, m_pcTrQuant, m_pcPredSearch, bFastDeltaQP );
+  }
+
+  m_cCtuRowJobs.resize( lastCtuRow - firstCtuRow + 1 );
+  for ( UInt ctuRow = firstCtuRow; ctuRow <= lastCtuRow; ctuRow++ )
+  {
+    CtuRowJob& rcJob          = m_cCtuRowJobs[ ctuRow - firstCtuRow ];
+    rcJob.pcSliceEncoder      = this;
+    rcJob.pcRowEncoder        = m_apcCtuRowEncoders[ ( ctuRow - firstCtuRow ) % m_apcCtuRowEncoders.size() ];
+    rcJob.pcPic               = pcPic;
+    rcJob.uiCtuRow            = ctuRow;
+    rcJob.uiStartCtuRsAddr    = std::max( startCtuTsAddr,    ctuRow      * frameWidthInCtus );
+    rcJob.uiBoundingCtuRsAddr = std::min( boundingCtuTsAddr, (ctuRow+1) * frameWidthInCtus );
+    rcJob.bRowAboveInSliceSegment = ( ctuRow > firstCtuRow );
+    rcJob.bLastRowOfSliceSegment  = ( ctuRow == lastCtuRow );
+    rcJob.uiWrittenBits       = 0;
+    rcJob.uiBits              = 0;
+    rcJob.uiDist              = 0;
+    rcJob.dRdCost             = 0;
+    rcJob.bSyncStateStored    = false;
+
+    // CTUs left of the slice segment start are finished
+    m_pcCtuRowProgress[ ctuRow ].reset( rcJob.uiStartCtuRsAddr % frameWidthInCtus );
+  }
+
+  for ( UInt i = 0; i < m_cCtuRowJobs.size(); i++ )
+  {
+    m_cCtuRowThreadPool.addJob( xCompressCtuRowJob, &m_cCtuRowJobs[i] );
+  }
+  m_cCtuRowThreadPool.waitAll();
+
+  // collect the results in coding order
+  for ( UInt i = 0; i < m_cCtuRowJobs.size(); i++ )
+  {
+    const CtuRowJob& rcJob = m_cCtuRowJobs[i];
+
+    pcSlice->setSliceBits( (UInt)(pcSlice->getSliceBits() + rcJob.uiWrittenBits) );
+    pcSlice->setSliceSegmentBits(pcSlice->getSliceSegmentBits()+rcJob.uiWrittenBits);
+
+    if ( rcJob.bSyncStateStored )
+    {
+      m_entropyCodingSyncContextState.loadContexts( &m_pcCtuRowSyncContextStates[ rcJob.uiCtuRow ] );
+    }
+
+    m_uiPicTotalBits += rcJob.uiBits;
+    m_dPicRdCost     += rcJob.dRdCost;
+    m_uiPicDist      += rcJob.uiDist;
+  }
+}
+
+Void TEncSlice::xCompressCtuRowJob( Void* pParam )
+{
+  CtuRowJob* pcJob = (CtuRowJob*)pParam;
+  pcJob->pcSliceEncoder->xCompressCtuRow( *pcJob );
+}
+
+/** Compress the CTUs of one CTU row of the slice segment, equivalent to the loop in compressSlice().
+ * \param rcJob CTU row job
+ */
+Void TEncSlice::xCompressCtuRow( CtuRowJob& rcJob )
+{
+  TComPic* const      pcPic             = rcJob.pcPic;
+  TComSlice* const    pcSlice           = pcPic->getSlice(getSliceIdx());
+  const UInt          frameWidthInCtus  = pcPic->getPicSym()->getFrameWidthInCtus();
+  TEncCu*             pcCuEncoder       = rcJob.pcRowEncoder->getCuEncoder();
+  TEncEntropy*        pcEntropyCoder    = rcJob.pcRowEncoder->getEntropyCoder();
+  TEncSbac*           pcRDSbacCoder     = rcJob.pcRowEncoder->getRDSbacCoder()[0][CI_CURR_BEST];
+  TEncSbac*           pcRDGoOnSbacCoder = rcJob.pcRowEncoder->getRDGoOnSbacCoder();
+  TEncBinCABAC*       pRDSbacCoder      = (TEncBinCABAC *) pcRDSbacCoder->getEncBinIf();
+  TComBitCounter      tempBitCounter;
+
+  // the first row of the slice segment may start within the picture width and then continues with the initial state
+  if ( !rcJob.bRowAboveInSliceSegment )
+  {
+    pcRDSbacCoder->load( m_pppcRDSbacCoder[0][CI_CURR_BEST] );
+  }
+  pRDSbacCoder->setBinCountingEnableFlag( false );
+  pRDSbacCoder->setBinsCoded( 0 );
+
+  for( UInt ctuRsAddr = rcJob.uiStartCtuRsAddr; ctuRsAddr < rcJob.uiBoundingCtuRsAddr; ++ctuRsAddr )
+  {
+    const UInt ctuXPosInCtus = ctuRsAddr % frameWidthInCtus;
+
+    // wait for the CTU above-right
+    if ( rcJob.bRowAboveInSliceSegment )
+    {
+      m_pcCtuRowProgress[ rcJob.uiCtuRow - 1 ].waitFor( std::min( ctuXPosInCtus + 2, frameWidthInCtus ) );
+    }
+
+    // initialize CTU encoder
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+    pCtu->initCtu( pcPic, ctuRsAddr );
+
+    // update CABAC state
+    if ( ctuRsAddr == 0 )
+    {
+      pcRDSbacCoder->resetEntropy(pcSlice);
+    }
+    else if ( ctuXPosInCtus == 0 )
+    {
+      // reset and then update contexts to the state at the end of the top-right CTU (if within current slice).
+      pcRDSbacCoder->resetEntropy(pcSlice);
+      TComDataCU *pCtuUp = pCtu->getCtuAbove();
+      if ( pCtuUp && ( ctuXPosInCtus + 1 < frameWidthInCtus ) )
+      {
+        TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+        if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+        {
+          // Top-Right is available, we use it. Its state is still in the member storage, if it precedes the slice segment.
+          pcRDSbacCoder->loadContexts( rcJob.bRowAboveInSliceSegment ? &m_pcCtuRowSyncContextStates[ rcJob.uiCtuRow - 1 ] : &m_entropyCodingSyncContextState );
+        }
+      }
+    }
+
+    // set go-on entropy coder
+    pcEntropyCoder->setEntropyCoder ( pcRDGoOnSbacCoder );
+    pcEntropyCoder->setBitstream( &tempBitCounter );
+    tempBitCounter.resetBits();
+    pcRDGoOnSbacCoder->load( pcRDSbacCoder );
+
+    ((TEncBinCABAC*)pcRDGoOnSbacCoder->getEncBinIf())->setBinCountingEnableFlag(true);
+
+    // run CTU trial encoder
+    pcCuEncoder->compressCtu( pCtu );
+
+    // restore entropy coder to the initial stage and make the true encode to update the contexts and count the bits
+    pcEntropyCoder->setEntropyCoder ( pcRDSbacCoder );
+    pcEntropyCoder->setBitstream( &tempBitCounter );
+    pRDSbacCoder->setBinCountingEnableFlag( true );
+    pcRDSbacCoder->resetBits();
+    pRDSbacCoder->setBinsCoded( 0 );
+
+    pcCuEncoder->encodeCtu( pCtu );
+
+    pRDSbacCoder->setBinCountingEnableFlag( false );
+
+    rcJob.uiWrittenBits += pcEntropyCoder->getNumberOfWrittenBits();
+
+    // Store probabilities of second CTU in line into buffer
+    if ( ctuXPosInCtus == 1 )
+    {
+      m_pcCtuRowSyncContextStates[ rcJob.uiCtuRow ].loadContexts( pcRDSbacCoder );
+      rcJob.bSyncStateStored = true;
+    }
+
+    rcJob.uiBits  += pCtu->getTotalBits();
+    rcJob.dRdCost += pCtu->getTotalCost();
+    rcJob.uiDist  += pCtu->getTotalDistortion();
+
+    // the coding classes must not be used any more once the last CTU of the row is signalled (see xCompressSliceCtuRows)
+    if ( ctuRsAddr + 1 < rcJob.uiBoundingCtuRsAddr )
+    {
+      m_pcCtuRowProgress[ rcJob.uiCtuRow ].set( ctuXPosInCtus + 1 );
+    }
+  }
+
+  if ( rcJob.bLastRowOfSliceSegment )
+  {
+    // continue with the state at the end of the slice segment, e.g. for a following dependent slice segment
+    m_pppcRDSbacCoder[0][CI_CURR_BEST]->load( pcRDSbacCoder );
+  }
+
+  // stop use of temporary bit counter object.
+  pcRDSbacCoder->setBitstream(NULL);
+  pcRDGoOnSbacCoder->setBitstream(NULL);
+
+  m_pcCtuRowProgress[ rcJob.uiCtuRow ].set( ( rcJob.uiBoundingCtuRsAddr - 1 ) % frameWidthInCtus + 1 );
+}
+#endif
+
 Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded )
 {
   TComSlice *const pcSlice           = pcPic->getSlice(getSliceIdx());
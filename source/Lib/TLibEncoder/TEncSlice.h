@@ -46,6 +46,9 @@
 #include "TEncCu.h"
 #include "WeightPredAnalysis.h"
 #include "TEncRateCtrl.h"
+#if WPP_PARALLEL_ENC
+#include "TLibCommon/TComThreadPool.h"
+#endif
 
 //! \ingroup TLibEncoder
 //! \{
@@ -57,6 +60,45 @@ class TEncGOP;
 // Class definition
 // ====================================================================================================================
 
+#if WPP_PARALLEL_ENC
+/// CTU coding classes of one wavefront worker thread (own CU encoder, search, transform, RD cost and RD SBAC coders)
+class TEncCtuRowEncoder
+{
+private:
+  TEncCu                  m_cCuEncoder;                         ///< CU encoder
+  TEncSearch              m_cSearch;                            ///< encoder search class
+  TComTrQuant             m_cTrQuant;                           ///< transform & quantization class
+  TComRdCost              m_cRdCost;                            ///< RD cost computation class
+  TEncEntropy             m_cEntropyCoder;                      ///< entropy encoder
+  TEncSbac***             m_pppcRDSbacCoder;                    ///< temporal storage for RD computation
+  TEncSbac                m_cRDGoOnSbacCoder;                   ///< going on SBAC model for RD stage
+#if FAST_BIT_EST
+  TEncBinCABACCounter***  m_pppcBinCoderCABAC;                  ///< temporal CABAC state storage for RD computation
+  TEncBinCABACCounter     m_cRDGoOnBinCoderCABAC;               ///< going on bin coder CABAC for RD stage
+#else
+  TEncBinCABAC***         m_pppcBinCoderCABAC;                  ///< temporal CABAC state storage for RD computation
+  TEncBinCABAC            m_cRDGoOnBinCoderCABAC;               ///< going on bin coder CABAC for RD stage
+#endif
+  UInt                    m_uiTotalDepth;
+
+public:
+  TEncCtuRowEncoder();
+  virtual ~TEncCtuRowEncoder();
+
+  Void    create              ( TEncTop* pcEncTop );
+  Void    destroy             ();
+
+  /// take over the slice level state (lambdas, search ranges, RD cost setup) of the main coding classes
+  Void    initSlice           ( TComRdCost* pcRdCost, TComTrQuant* pcTrQuant, TEncSearch* pcPredSearch, const Bool bFastDeltaQP );
+
+  TEncCu*                 getCuEncoder          () { return  &m_cCuEncoder;         }
+  TComRdCost*             getRdCost             () { return  &m_cRdCost;            }
+  TEncEntropy*            getEntropyCoder       () { return  &m_cEntropyCoder;      }
+  TEncSbac***             getRDSbacCoder        () { return  m_pppcRDSbacCoder;     }
+  TEncSbac*               getRDGoOnSbacCoder    () { return  &m_cRDGoOnSbacCoder;   }
+};
+#endif
+
 /// slice encoder class
 class TEncSlice
   : public WeightPredAnalysis
@@ -102,6 +144,41 @@ private:
   TEncSbac                m_lastSliceSegmentEndContextState;    ///< context storage for state at the end of the previous slice-segment (used for dependent slices only).
   TEncSbac                m_entropyCodingSyncContextState;      ///< context storate for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
   SliceType               m_encCABACTableIdx;
+#if WPP_PARALLEL_ENC
+  /// CTU row of a wavefront slice segment, compressed by one job of the thread pool
+  struct CtuRowJob
+  {
+    TEncSlice*            pcSliceEncoder;
+    TEncCtuRowEncoder*    pcRowEncoder;
+    TComPic*              pcPic;
+    UInt                  uiCtuRow;
+    UInt                  uiStartCtuRsAddr;                     ///< first CTU of the row within the slice segment
+    UInt                  uiBoundingCtuRsAddr;                  ///< CTU following the last one of the row within the slice segment
+    Bool                  bRowAboveInSliceSegment;              ///< the row above is compressed by another job of the slice segment
+    Bool                  bLastRowOfSliceSegment;
+    UInt                  uiWrittenBits;                        ///< bits written by the final encoding of the CTUs
+    UInt64                uiBits;                               ///< total bits of the CTUs
+#if NH_3D_VSO
+    Dist64                uiDist;                               ///< total distortion of the CTUs
+#else
+    UInt64                uiDist;                               ///< total distortion of the CTUs
+#endif
+    Double                dRdCost;                              ///< total RD cost of the CTUs
+    Bool                  bSyncStateStored;                     ///< contexts after the second CTU have been stored
+  };
+
+  std::vector<TEncCtuRowEncoder*> m_apcCtuRowEncoders;          ///< coding classes of the worker threads
+  std::vector<CtuRowJob>  m_cCtuRowJobs;
+  TEncSbac*               m_pcCtuRowSyncContextStates;          ///< WPP context states after the second CTU of each CTU row
+  TComProgress*           m_pcCtuRowProgress;                   ///< number of compressed CTUs of each CTU row
+  UInt                    m_uiNumCtuRows;
+  TComThreadPool          m_cCtuRowThreadPool;
+
+  Bool     xUseCtuRowThreads       ( TComPic* pcPic, const Bool bCompressEntireSlice );
+  Void     xCompressSliceCtuRows   ( TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, const Bool bFastDeltaQP );
+  Void     xCompressCtuRow         ( CtuRowJob& rcJob );
+  static Void xCompressCtuRowJob   ( Void* pParam );
+#endif
 
   Void     setUpLambda(TComSlice* slice, const Double dLambda, Int iQP);
   Void     calculateBoundingCtuTsAddrForSlice(UInt &startCtuTSAddrSlice, UInt &boundingCtuTSAddrSlice, Bool &haveReachedTileBoundary, TComPic* pcPic, const Int sliceMode, const Int sliceArgument);
@@ -113,6 +190,9 @@ public:
   Void    create              ( Int iWidth, Int iHeight, ChromaFormat chromaFormat, UInt iMaxCUWidth, UInt iMaxCUHeight, UChar uhTotalDepth );
   Void    destroy             ();
   Void    init                ( TEncTop* pcEncTop );
+#if WPP_PARALLEL_ENC
+  Void    createCtuRowEncoders( TEncTop* pcEncTop );                                   ///< create the worker threads of wavefront slices
+#endif
 
   /// preparation of slice encoding (reference marking, QP and lambda)
 #if NH_MV
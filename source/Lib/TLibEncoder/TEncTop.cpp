@@ -78,6 +78,15 @@ TEncTop::TEncTop()
 #if NH_MV
   m_ivPicLists = NULL;
 #endif
+#if NH_MV_LAYER_PARALLEL_ENC
+  m_pcLayerOutputMutex = NULL;
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+  m_pcRefMarkingMutex = NULL;
+#endif
+#if PIC_METRICS_PARALLEL_ENC
+  m_pcPicMetricsPool = NULL;
+#endif
 #if NH_3D_IC
   m_aICEnableCandidate = NULL;
   m_aICEnableNum = NULL;
@@ -122,6 +131,12 @@ Void TEncTop::create ()
 #endif
 
   m_cLoopFilter.create( m_maxTotalCUDepth );
+#if DEBLOCKING_PARALLEL
+  m_cLoopFilter.createThreads( m_numLoopFilterThreads );
+#endif
+#if SAO_PARALLEL
+  m_cEncSAO.createThreads( m_numLoopFilterThreads );
+#endif
 
   if ( m_RCEnableRateControl )
   {
@@ -242,6 +257,9 @@ Void TEncTop::init(Bool isFieldCoding)
     m_aICEnableCandidate[i]=0;
     m_aICEnableNum[i]=0;
   }
+#if WPP_PARALLEL_ENC
+  m_cEntropyCoder.setICStatisticsMutex( &m_cICStatisticsMutex );
+#endif
 #endif
 
   // initialize processing unit classes
@@ -255,7 +273,33 @@ Void TEncTop::init(Bool isFieldCoding)
   // initialize transform & quantization class
   m_pcCavlcCoder = getCavlcCoder();
 
-  m_cTrQuant.init( 1 << m_uiQuadtreeTULog2MaxSize,
+  xInitTrQuant( &m_cTrQuant );
+
+  // initialize encoder search class
+  m_cSearch.init( this, &m_cTrQuant, m_iSearchRange, m_bipredSearchRange, m_motionEstimationSearchMethod, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth, &m_cEntropyCoder, &m_cRdCost, getRDSbacCoder(), getRDGoOnSbacCoder() );
+
+  m_iMaxRefPicNum = 0;
+
+  xInitScalingLists();
+#if WPP_PARALLEL_ENC
+  m_cSliceEncoder.createCtuRowEncoders( this );
+#endif
+}
+
+#if WPP_PARALLEL_ENC
+/** Initialise a further transform & quantization instance identically to the one of the encoder.
+ * \param pcTrQuant transform & quantization class to be initialised (used by the wavefront row encoders)
+ */
+Void TEncTop::initTrQuant( TComTrQuant* pcTrQuant )
+{
+  xInitTrQuant( pcTrQuant );
+  xSetTrQuantScalingList( pcTrQuant );
+}
+#endif
+
+Void TEncTop::xInitTrQuant( TComTrQuant* pcTrQuant )
+{
+  pcTrQuant->init( 1 << m_uiQuadtreeTULog2MaxSize,
                    m_useRDOQ,
                    m_useRDOQTS,
 #if T0196_SELECTIVE_RDOQ
@@ -267,19 +311,10 @@ Void TEncTop::init(Bool isFieldCoding)
                   ,m_bUseAdaptQpSelect
 #endif
                   );
-
-  // initialize encoder search class
-  m_cSearch.init( this, &m_cTrQuant, m_iSearchRange, m_bipredSearchRange, m_motionEstimationSearchMethod, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth, &m_cEntropyCoder, &m_cRdCost, getRDSbacCoder(), getRDGoOnSbacCoder() );
-
-  m_iMaxRefPicNum = 0;
-
-  xInitScalingLists();
 }
 
-Void TEncTop::xInitScalingLists()
+Void TEncTop::xSetTrQuantScalingList( TComTrQuant* pcTrQuant )
 {
-  // Initialise scaling lists
-  // The encoder will only use the SPS scaling lists. The PPS will never be marked present.
   const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE] =
   {
       m_cSPS.getMaxLog2TrDynamicRange(CHANNEL_TYPE_LUMA),
@@ -287,8 +322,22 @@ Void TEncTop::xInitScalingLists()
   };
   if(getUseScalingListId() == SCALING_LIST_OFF)
   {
-    getTrQuant()->setFlatScalingList(maxLog2TrDynamicRange, m_cSPS.getBitDepths());
-    getTrQuant()->setUseScalingList(false);
+    pcTrQuant->setFlatScalingList(maxLog2TrDynamicRange, m_cSPS.getBitDepths());
+    pcTrQuant->setUseScalingList(false);
+  }
+  else
+  {
+    pcTrQuant->setScalingList(&(m_cSPS.getScalingList()), maxLog2TrDynamicRange, m_cSPS.getBitDepths());
+    pcTrQuant->setUseScalingList(true);
+  }
+}
+
+Void TEncTop::xInitScalingLists()
+{
+  // Initialise scaling lists
+  // The encoder will only use the SPS scaling lists. The PPS will never be marked present.
+  if(getUseScalingListId() == SCALING_LIST_OFF)
+  {
     m_cSPS.setScalingListPresentFlag(false);
     m_cPPS.setScalingListPresentFlag(false);
   }
@@ -297,9 +346,6 @@ Void TEncTop::xInitScalingLists()
     m_cSPS.getScalingList().setDefaultScalingList ();
     m_cSPS.setScalingListPresentFlag(false);
     m_cPPS.setScalingListPresentFlag(false);
-
-    getTrQuant()->setScalingList(&(m_cSPS.getScalingList()), maxLog2TrDynamicRange, m_cSPS.getBitDepths());
-    getTrQuant()->setUseScalingList(true);
   }
   else if(getUseScalingListId() == SCALING_LIST_FILE_READ)
   {
@@ -313,14 +359,13 @@ Void TEncTop::xInitScalingLists()
     m_cSPS.getScalingList().checkDcOfMatrix();
     m_cSPS.setScalingListPresentFlag(m_cSPS.getScalingList().checkDefaultScalingList());
     m_cPPS.setScalingListPresentFlag(false);
-    getTrQuant()->setScalingList(&(m_cSPS.getScalingList()), maxLog2TrDynamicRange, m_cSPS.getBitDepths());
-    getTrQuant()->setUseScalingList(true);
   }
   else
   {
     printf("error : ScalingList == %d not supported\n",getUseScalingListId());
     assert(0);
   }
+  xSetTrQuantScalingList( getTrQuant() );
 
   if (getUseScalingListId() != SCALING_LIST_OFF)
   {  
@@ -401,7 +446,12 @@ Void TEncTop::encode( Bool flush, TComPicYuv* pcPicYuvOrg, TComPicYuv* pcPicYuvT
 #endif
 #if NH_3D
   TComPic* picLastCoded = getPic( getGOPEncoder()->getPocLastCoded() );
+#if NH_MV_FRAME_PARALLEL_ENC
+  // with overlapped access units the motion is compressed when all pictures of the access unit are coded
+  if( picLastCoded && m_pcRefMarkingMutex == NULL )
+#else
   if( picLastCoded )
+#endif
   {
     picLastCoded->compressMotion(1); 
   }
@@ -597,6 +647,10 @@ Void TEncTop::xGetNewPicBuffer ( TComPic*& rpcPic )
   {
     TComList<TComPic*>::iterator iterPic  = m_cListPic.begin();
     Int iSize = Int( m_cListPic.size() );
+#endif
+#if PIC_METRICS_PARALLEL_ENC
+    // the metrics threads may still read pictures that are no longer referenced
+    m_cGOPEncoder.waitPicMetrics();
 #endif
     for ( Int i = 0; i < iSize; i++ )
     {
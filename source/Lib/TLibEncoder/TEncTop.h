@@ -44,6 +44,9 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/AccessUnit.h"
+#if NH_MV_LAYER_PARALLEL_ENC
+#include "TLibCommon/TComThreadPool.h"
+#endif
 
 #include "TLibVideoIO/TVideoIOYuv.h"
 
@@ -82,9 +85,21 @@ private:
 #if NH_MV
   TComPicLists*           m_ivPicLists;                   ///< access to picture lists of other layers 
 #endif
+#if NH_MV_LAYER_PARALLEL_ENC
+  std::mutex*             m_pcLayerOutputMutex;           ///< serializes picture logging of layers coded in parallel, NULL for sequential coding
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+  std::mutex*             m_pcRefMarkingMutex;            ///< serializes the reference picture marking of access units coded in parallel, NULL when access units are coded one after the other
+#endif
+#if PIC_METRICS_PARALLEL_ENC
+  TEncPicMetricsPool*     m_pcPicMetricsPool;             ///< threads computing PSNR and picture hash, shared by all layers, NULL for none
+#endif
 #if NH_3D_IC
   Int *m_aICEnableCandidate;
   Int *m_aICEnableNum;
+#if WPP_PARALLEL_ENC
+  std::mutex              m_cICStatisticsMutex;           ///< guards the IC flag statistics, updated by the CTU rows compressed in parallel
+#endif
 #endif
   // encoder search
   TEncSearch              m_cSearch;                      ///< encoder search class
@@ -140,6 +155,8 @@ protected:
   Void  xInitSPS          ();                             ///< initialize SPS from encoder options
   Void  xInitPPS          ();                             ///< initialize PPS from encoder options
   Void  xInitScalingLists();                              ///< initialize scaling lists
+  Void  xInitTrQuant      ( TComTrQuant* pcTrQuant );     ///< initialize transform & quantization class from encoder options
+  Void  xSetTrQuantScalingList( TComTrQuant* pcTrQuant ); ///< set quantization matrices from the SPS scaling lists
   Void  xInitHrdParameters();                             ///< initialize HRD parameters
 
   Void  xInitPPSforTiles  ();
@@ -156,12 +173,18 @@ public:
 #else
   Void      init            (Bool isFieldCoding);
 #endif
+#if WPP_PARALLEL_ENC
+  Void      initTrQuant     ( TComTrQuant* pcTrQuant );
+#endif
 #if NH_MV  
   TComPicLists* getIvPicLists() { return m_ivPicLists; }
 #endif
 #if NH_3D_IC
   Int*      getICEnableCandidate() { return m_aICEnableCandidate; }
   Int*      getICEnableNum() { return m_aICEnableNum; }
+#if WPP_PARALLEL_ENC
+  std::mutex* getICStatisticsMutex() { return &m_cICStatisticsMutex; }
+#endif
 #endif
   Void      deletePicBuffer ();
 #if NH_MV
@@ -210,6 +233,18 @@ public:
   TComPic*                getPic                ( Int poc );
   Void                    setIvPicLists         ( TComPicLists* picLists) { m_ivPicLists = picLists; }
 #endif
+#if NH_MV_LAYER_PARALLEL_ENC
+  Void                    setLayerOutputMutex   ( std::mutex* outputMutex ) { m_pcLayerOutputMutex = outputMutex; }
+  std::mutex*             getLayerOutputMutex   () { return m_pcLayerOutputMutex; }
+#endif
+#if NH_MV_FRAME_PARALLEL_ENC
+  Void                    setRefMarkingMutex    ( std::mutex* refMarkingMutex ) { m_pcRefMarkingMutex = refMarkingMutex; }
+  std::mutex*             getRefMarkingMutex    () { return m_pcRefMarkingMutex; }
+#endif
+#if PIC_METRICS_PARALLEL_ENC
+  Void                    setPicMetricsPool     ( TEncPicMetricsPool* pcPool ) { m_pcPicMetricsPool = pcPool; }
+  TEncPicMetricsPool*     getPicMetricsPool     () { return m_pcPicMetricsPool; }
+#endif
 #if NH_3D
   Void                    setSps3dExtension     ( TComSps3dExtension sps3dExtension ) { m_cSPS.setSps3dExtension( sps3dExtension );  };
 #endif
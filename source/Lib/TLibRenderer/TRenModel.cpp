@@ -62,6 +62,21 @@ TRenModel::TRenModel()
   m_apcCurRenModels    = NULL;
   m_aiCurPosInModels   = NULL;
 
+  // Arguments of the current call ///
+  m_iCurStartPosX      = -1;
+  m_iCurStartPosY      = -1;
+  m_iCurWidth          = -1;
+  m_iCurHeight         = -1;
+  m_iCurStride         = -1;
+  m_piCurNewData       = NULL;
+#if H_3D_VSO_EARLY_SKIP
+  m_piCurOrgData       = NULL;
+  m_iCurOrgStride      = -1;
+#endif
+#if H_3D_VSO_PARALLEL_MODELS
+  m_pcModelJobs        = NULL;
+#endif
+
   // Array of Models ///
   m_iNumOfRenModels    = -1;
   m_apcRenModels       = NULL;
@@ -97,6 +112,11 @@ TRenModel::TRenModel()
 
 TRenModel::~TRenModel()
 {
+#if H_3D_VSO_PARALLEL_MODELS
+  m_cThreadPool.destroy();
+  if ( m_pcModelJobs ) delete[] m_pcModelJobs;
+#endif
+
   if ( m_apcRenModels )
   {
     for (Int iNumModel = 0; iNumModel < m_iNumOfRenModels; iNumModel++)
@@ -553,6 +573,93 @@ TRenModel::setupPart ( UInt uiHorOff, Int iUsedHeight )
   m_iUsedHeight = iUsedHeight; 
 }
 
+#if H_3D_VSO_PARALLEL_MODELS
+Void
+TRenModel::createThreadPool( Int iNumThreads )
+{
+  AOT( m_iNumOfRenModels < 0 );
+
+  m_cThreadPool.create( iNumThreads );
+
+  m_pcModelJobs = new ModelJob[ m_iNumOfRenModels ];
+  for (Int iModelNum = 0; iModelNum < m_iNumOfRenModels; iModelNum++ )
+  {
+    m_pcModelJobs[iModelNum].pcRenModel = this;
+    m_pcModelJobs[iModelNum].iModelNum  = iModelNum;
+    m_pcModelJobs[iModelNum].iDist      = 0;
+  }
+}
+
+Void
+TRenModel::xGetDistJob( Void* pParam )
+{
+  ModelJob* pcJob = (ModelJob*) pParam;
+  pcJob->iDist    = pcJob->pcRenModel->xGetDistModel( pcJob->iModelNum );
+}
+
+Void
+TRenModel::xSetDataJob( Void* pParam )
+{
+  ModelJob* pcJob = (ModelJob*) pParam;
+  pcJob->pcRenModel->xSetDataModel( pcJob->iModelNum );
+}
+
+Bool
+TRenModel::xUseThreadPool( Int iWidth, Int iHeight )
+{
+  // Small blocks are rendered faster than a job is handed over to another thread
+  return m_cThreadPool.isParallel() && ( m_iNumOfCurRenModels > 1 ) && ( iWidth * iHeight >= REN_MIN_PARALLEL_BLOCK_SIZE );
+}
+
+Void
+TRenModel::xRunModelJobs( FpJobFunc pfJobFunc )
+{
+  for (Int iModelNum = 1; iModelNum < m_iNumOfCurRenModels; iModelNum++ )
+  {
+    m_cThreadPool.addJob( pfJobFunc, &m_pcModelJobs[iModelNum] );
+  }
+
+  // The first model is processed by the calling thread
+  pfJobFunc( &m_pcModelJobs[0] );
+  m_cThreadPool.waitAll();
+}
+#endif
+
+RMDist
+TRenModel::xGetDistModel( Int iModelNum )
+{
+  if (m_iCurrentContent == 1)
+  {
+#if H_3D_VSO_EARLY_SKIP
+    return m_apcCurRenModels[iModelNum]->getDistDepth  ( m_aiCurPosInModels[iModelNum], m_iCurStartPosX, m_iCurStartPosY, m_iCurWidth, m_iCurHeight, m_iCurStride, m_piCurNewData, m_piCurOrgData, m_iCurOrgStride );
+#else
+    return m_apcCurRenModels[iModelNum]->getDistDepth  ( m_aiCurPosInModels[iModelNum], m_iCurStartPosX, m_iCurStartPosY, m_iCurWidth, m_iCurHeight, m_iCurStride, m_piCurNewData );
+#endif
+  }
+  else
+  {
+    return m_apcCurRenModels[iModelNum]->getDistVideo  ( m_aiCurPosInModels[iModelNum], m_iCurrentPlane, m_iCurStartPosX, m_iCurStartPosY, m_iCurWidth, m_iCurHeight, m_iCurStride, m_piCurNewData );
+  }
+}
+
+Void
+TRenModel::xSetDataModel( Int iModelNum )
+{
+  if (m_iCurrentContent == 1)
+  {
+#if H_3D_VSO_EARLY_SKIP
+    Int iTargetStride = m_aiCurDepthStrides[ m_iCurrentView ];
+    m_apcCurRenModels[iModelNum]->setDepth  ( m_aiCurPosInModels[iModelNum], m_iCurStartPosX, m_iCurStartPosY, m_iCurWidth, m_iCurHeight, m_iCurStride, m_piCurNewData, m_apiCurDepthPel[ m_iCurrentView ] + m_iCurStartPosY * iTargetStride + m_iCurStartPosX, iTargetStride );
+#else
+    m_apcCurRenModels[iModelNum]->setDepth  ( m_aiCurPosInModels[iModelNum], m_iCurStartPosX, m_iCurStartPosY, m_iCurWidth, m_iCurHeight, m_iCurStride, m_piCurNewData );
+#endif
+  }
+  else
+  {
+    m_apcCurRenModels[iModelNum]->setVideo  ( m_aiCurPosInModels[iModelNum], m_iCurrentPlane, m_iCurStartPosX, m_iCurStartPosY, m_iCurWidth, m_iCurHeight, m_iCurStride, m_piCurNewData );
+  }
+}
+
 #if H_3D_VSO_EARLY_SKIP
 RMDist
 TRenModel::getDist( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, Int iStride, Pel* piNewData, Pel * piOrgData, Int iOrgStride)
@@ -571,21 +678,35 @@ TRenModel::getDist( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, Int
   AOT( iWidth     < 0);
   AOT( iHeight    < 0);
 
+  m_iCurStartPosX = iStartPosX;
+  m_iCurStartPosY = iStartPosY;
+  m_iCurWidth     = iWidth;
+  m_iCurHeight    = iHeight;
+  m_iCurStride    = iStride;
+  m_piCurNewData  = piNewData;
+#if H_3D_VSO_EARLY_SKIP
+  m_piCurOrgData  = piOrgData;
+  m_iCurOrgStride = iOrgStride;
+#endif
+
   RMDist iDist = 0;
 
-  for (Int iModelNum = 0; iModelNum < m_iNumOfCurRenModels; iModelNum++ )
+#if H_3D_VSO_PARALLEL_MODELS
+  if ( xUseThreadPool( iWidth, iHeight ) )
   {
-    if (m_iCurrentContent == 1)
+    xRunModelJobs( xGetDistJob );
+
+    for (Int iModelNum = 0; iModelNum < m_iNumOfCurRenModels; iModelNum++ )
     {
-#if H_3D_VSO_EARLY_SKIP
-      iDist +=  m_apcCurRenModels[iModelNum]->getDistDepth  ( m_aiCurPosInModels[iModelNum], iStartPosX, iStartPosY,  iWidth,  iHeight,  iStride,  piNewData , piOrgData, iOrgStride);
-#else
-      iDist +=  m_apcCurRenModels[iModelNum]->getDistDepth  ( m_aiCurPosInModels[iModelNum], iStartPosX, iStartPosY,  iWidth,  iHeight,  iStride,  piNewData );
-#endif
+      iDist += m_pcModelJobs[iModelNum].iDist;
     }
-    else
+  }
+  else
+#endif
+  {
+    for (Int iModelNum = 0; iModelNum < m_iNumOfCurRenModels; iModelNum++ )
     {
-      iDist +=  m_apcCurRenModels[iModelNum]->getDistVideo  ( m_aiCurPosInModels[iModelNum], m_iCurrentPlane ,iStartPosX, iStartPosY, iWidth, iHeight, iStride, piNewData );
+      iDist += xGetDistModel( iModelNum );
     }
   }
 
@@ -605,20 +726,24 @@ TRenModel::setData( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, Int
   AOT( iWidth     < 0);
   AOT( iHeight    < 0);
 
-  for (Int iModelNum = 0; iModelNum < m_iNumOfCurRenModels; iModelNum++ )
+  m_iCurStartPosX = iStartPosX;
+  m_iCurStartPosY = iStartPosY;
+  m_iCurWidth     = iWidth;
+  m_iCurHeight    = iHeight;
+  m_iCurStride    = iStride;
+  m_piCurNewData  = piNewData;
+
+#if H_3D_VSO_PARALLEL_MODELS
+  if ( xUseThreadPool( iWidth, iHeight ) )
   {
-    if (m_iCurrentContent == 1)
-    {
-#if H_3D_VSO_EARLY_SKIP
-      Int iTargetStride = m_aiCurDepthStrides[ m_iCurrentView ];
-      m_apcCurRenModels[iModelNum]->setDepth  ( m_aiCurPosInModels[iModelNum], iStartPosX, iStartPosY, iWidth, iHeight, iStride, piNewData,m_apiCurDepthPel[ m_iCurrentView ] + iStartPosY * iTargetStride + iStartPosX ,iTargetStride );
-#else
-      m_apcCurRenModels[iModelNum]->setDepth  ( m_aiCurPosInModels[iModelNum], iStartPosX, iStartPosY, iWidth, iHeight, iStride, piNewData );
+    xRunModelJobs( xSetDataJob );
+  }
+  else
 #endif
-    }
-    else
+  {
+    for (Int iModelNum = 0; iModelNum < m_iNumOfCurRenModels; iModelNum++ )
     {
-      m_apcCurRenModels[iModelNum]->setVideo  ( m_aiCurPosInModels[iModelNum], m_iCurrentPlane ,iStartPosX, iStartPosY,  iWidth,  iHeight,  iStride, piNewData );
+      xSetDataModel( iModelNum );
     }
   }
 
@@ -40,6 +40,9 @@
 #include "../TLibCommon/CommonDef.h"
 #include "../TLibCommon/TComPicYuv.h"
 #include "../TLibCommon/TypeDef.h"
+#if H_3D_VSO_PARALLEL_MODELS
+#include "../TLibCommon/TComThreadPool.h"
+#endif
 
 #if NH_3D_VSO
 
@@ -57,6 +60,9 @@ public:
   Void  create           ( Int iNumOfBaseViews, Int iNumOfModels, Int iWidth, Int iHeight, Int iShiftPrec, Int iHoleMargin );
 #endif
   Void  createSingleModel( Int iBaseViewNum, Int iContent, Int iModelNum, Int iLeftViewNum, Int iRightViewNum, Bool bUseOrgRef, Int iBlendMode );
+#if H_3D_VSO_PARALLEL_MODELS
+  Void  createThreadPool ( Int iNumThreads );
+#endif
 
   // Set new Frame
   Void  setBaseView      ( Int iViewNum, TComPicYuv* pcPicYuvVideoData, TComPicYuv* pcPicYuvDepthData, TComPicYuv* pcPicYuvOrgVideoData, TComPicYuv* pcPicYuvOrgDepthData  );
@@ -88,6 +94,25 @@ private:
   // helpers
   Void xSetLRViewAndAddModel( Int iModelNum, Int iBaseViewNum, Int iContent, Int iViewPos, Bool bAdd );
 
+  // Distortion and data of a single current model
+  RMDist xGetDistModel      ( Int iModelNum );
+  Void   xSetDataModel      ( Int iModelNum );
+
+#if H_3D_VSO_PARALLEL_MODELS
+  // Parallel evaluation of the current models, one job per model
+  struct ModelJob
+  {
+    TRenModel* pcRenModel;
+    Int        iModelNum;
+    RMDist     iDist;
+  };
+
+  static Void xGetDistJob   ( Void* pParam );
+  static Void xSetDataJob   ( Void* pParam );
+  Bool        xUseThreadPool( Int iWidth, Int iHeight );
+  Void        xRunModelJobs ( FpJobFunc pfJobFunc );
+#endif
+
   // Settings
   Int    m_iShiftPrec;
   Int**  m_aaaiSubPelShiftLut[2];
@@ -119,6 +144,23 @@ private:
   TRenSingleModel**  m_apcCurRenModels;   // Array of pointers used for determination of current error
   Int*               m_aiCurPosInModels;  // Position of Current View in Model
 
+  /// Arguments of the current getDist or setData call ///
+  Int                m_iCurStartPosX;
+  Int                m_iCurStartPosY;
+  Int                m_iCurWidth;
+  Int                m_iCurHeight;
+  Int                m_iCurStride;
+  const Pel*         m_piCurNewData;
+#if H_3D_VSO_EARLY_SKIP
+  const Pel*         m_piCurOrgData;
+  Int                m_iCurOrgStride;
+#endif
+
+#if H_3D_VSO_PARALLEL_MODELS
+  TComThreadPool     m_cThreadPool;
+  ModelJob*          m_pcModelJobs;       // Dim1: current model number
+#endif
+
   /// Array of Models ///
   Int                m_iNumOfRenModels;
   TRenSingleModel**  m_apcRenModels;   // Array of pointers to all created models
@@ -51,11 +51,12 @@ TRenSingleModelC<iBM,bBitInc>::TRenSingleModelC()
   m_iPad    = PICYUV_PAD;
   m_iGapTolerance = -1;
   m_bUseOrgRef = false;
+  m_bSkipUnchangedDepth = false;
 
   m_pcPicYuvRef          = NULL;
 
-  m_pcOutputSamples      = NULL; 
-  m_pcOutputSamplesRow   = NULL;   
+  m_cOutputSamples       = RenModelOutPels();
+  m_cOutputSamplesRow    = RenModelOutPels();
   m_iOutputSamplesStride = -1; 
 
   m_ppiCurLUT            = NULL;
@@ -76,8 +77,10 @@ TRenSingleModelC<iBM,bBitInc>::TRenSingleModelC()
     // LUT
     m_appiShiftLut[uiViewNum] = NULL;
 
-    m_pcInputSamples[uiViewNum] = NULL; 
-    m_iInputSamplesStride       = -1; 
+    m_acInputSamples   [uiViewNum] = RenModelInPels();
+    m_acInputSamplesRow[uiViewNum] = RenModelInPels();
+    m_iInputSamplesStride          = -1; 
+    m_iInputSubSamplesStride       = -1; 
 
     m_ppiCurLUT               = NULL;
     m_piInvZLUTLeft           = NULL;
@@ -100,10 +103,7 @@ TRenSingleModelC<iBM,bBitInc>::~TRenSingleModelC()
   }
 #endif
 
-  if ( m_pcInputSamples [0] ) delete[] m_pcInputSamples [0];
-  if ( m_pcInputSamples [1] ) delete[] m_pcInputSamples [1];
-
-  if ( m_pcOutputSamples    ) delete[] m_pcOutputSamples   ;
+  xDestroySamplePlanes();
 
   if ( m_piInvZLUTLeft  ) delete[] m_piInvZLUTLeft ;
   if ( m_piInvZLUTRight ) delete[] m_piInvZLUTRight;
@@ -164,13 +164,102 @@ TRenSingleModelC<iBM,bBitInc>::create( Int iMode, Int iWidth, Int iHeight, Int i
   m_aapiRefVideoPel  [1] += m_aiRefVideoStrides[1] * m_iPad + m_iPad;
   m_aapiRefVideoPel  [2] += m_aiRefVideoStrides[2] * m_iPad + m_iPad;
 
-  m_iInputSamplesStride  = m_iWidth+1;
-  m_iOutputSamplesStride = m_iWidth;
+  m_iInputSamplesStride    = m_iWidth;
+  m_iInputSubSamplesStride = ( ( m_iWidth + 1 ) << m_iShiftPrec ) + 1;
+  m_iOutputSamplesStride   = m_iWidth;
+
+  xCreateSamplePlanes();
+}
+
+template <BlenMod iBM, Bool bBitInc> Void
+TRenSingleModelC<iBM,bBitInc>::xCreateSamplePlanes()
+{
+  for ( Int iViewPos = 0; iViewPos < 2; iViewPos++ )
+  {
+    RenModelInPels& rcInput = m_acInputSamples[iViewPos];
+
+    // the upsampled video of the right view is stored shifted by one sample, so the first sample stays unset
+    rcInput.piY        = new Pel [ m_iInputSubSamplesStride * m_iHeight ];
+#if H_3D_VSO_COLOR_PLANES
+    rcInput.piU        = new Pel [ m_iInputSubSamplesStride * m_iHeight ];
+    rcInput.piV        = new Pel [ m_iInputSubSamplesStride * m_iHeight ];
+#endif
+    rcInput.piD        = new Pel [ m_iInputSamplesStride    * m_iHeight ];
+    rcInput.pbOccluded = new Bool[ m_iInputSamplesStride    * m_iHeight ];
+
+    xSetPels( rcInput.piY, m_iInputSubSamplesStride, m_iInputSubSamplesStride, m_iHeight, 0 );
+#if H_3D_VSO_COLOR_PLANES
+    xSetPels( rcInput.piU, m_iInputSubSamplesStride, m_iInputSubSamplesStride, m_iHeight, 0 );
+    xSetPels( rcInput.piV, m_iInputSubSamplesStride, m_iInputSubSamplesStride, m_iHeight, 0 );
+#endif
+  }
+
+  Int iOutputSize = m_iOutputSamplesStride * m_iHeight;
+
+  for ( Int iViewPos = 0; iViewPos < 3; iViewPos++ )
+  {
+    m_cOutputSamples.apiY[iViewPos] = new Pel[ iOutputSize ];
+#if H_3D_VSO_COLOR_PLANES
+    m_cOutputSamples.apiU[iViewPos] = new Pel[ iOutputSize ];
+    m_cOutputSamples.apiV[iViewPos] = new Pel[ iOutputSize ];
+#endif
+  }
+
+  for ( Int iViewPos = 0; iViewPos < 2; iViewPos++ )
+  {
+    m_cOutputSamples.apiD     [iViewPos] = new Pel[ iOutputSize ];
+    m_cOutputSamples.apiFilled[iViewPos] = new Int[ iOutputSize ];
+  }
+
+  m_cOutputSamples.piError = new Int[ iOutputSize ];
+  m_cOutputSamples.piYRef  = new Pel[ iOutputSize ];
+#if H_3D_VSO_COLOR_PLANES
+  m_cOutputSamples.piURef  = new Pel[ iOutputSize ];
+  m_cOutputSamples.piVRef  = new Pel[ iOutputSize ];
+#endif
+}
+
+template <BlenMod iBM, Bool bBitInc> Void
+TRenSingleModelC<iBM,bBitInc>::xDestroySamplePlanes()
+{
+  for ( Int iViewPos = 0; iViewPos < 2; iViewPos++ )
+  {
+    RenModelInPels& rcInput = m_acInputSamples[iViewPos];
+
+    if ( rcInput.piY        ) delete[] rcInput.piY       ;
+#if H_3D_VSO_COLOR_PLANES
+    if ( rcInput.piU        ) delete[] rcInput.piU       ;
+    if ( rcInput.piV        ) delete[] rcInput.piV       ;
+#endif
+    if ( rcInput.piD        ) delete[] rcInput.piD       ;
+    if ( rcInput.pbOccluded ) delete[] rcInput.pbOccluded;
 
-  m_pcInputSamples[0]     = new RenModelInPels[m_iInputSamplesStride*m_iHeight];
-  m_pcInputSamples[1]     = new RenModelInPels[m_iInputSamplesStride*m_iHeight];
+    rcInput = RenModelInPels();
+  }
+
+  for ( Int iViewPos = 0; iViewPos < 3; iViewPos++ )
+  {
+    if ( m_cOutputSamples.apiY[iViewPos] ) delete[] m_cOutputSamples.apiY[iViewPos];
+#if H_3D_VSO_COLOR_PLANES
+    if ( m_cOutputSamples.apiU[iViewPos] ) delete[] m_cOutputSamples.apiU[iViewPos];
+    if ( m_cOutputSamples.apiV[iViewPos] ) delete[] m_cOutputSamples.apiV[iViewPos];
+#endif
+  }
+
+  for ( Int iViewPos = 0; iViewPos < 2; iViewPos++ )
+  {
+    if ( m_cOutputSamples.apiD     [iViewPos] ) delete[] m_cOutputSamples.apiD     [iViewPos];
+    if ( m_cOutputSamples.apiFilled[iViewPos] ) delete[] m_cOutputSamples.apiFilled[iViewPos];
+  }
+
+  if ( m_cOutputSamples.piError ) delete[] m_cOutputSamples.piError;
+  if ( m_cOutputSamples.piYRef  ) delete[] m_cOutputSamples.piYRef ;
+#if H_3D_VSO_COLOR_PLANES
+  if ( m_cOutputSamples.piURef  ) delete[] m_cOutputSamples.piURef ;
+  if ( m_cOutputSamples.piVRef  ) delete[] m_cOutputSamples.piVRef ;
+#endif
 
-  m_pcOutputSamples       = new RenModelOutPels[m_iOutputSamplesStride*m_iHeight];  
+  m_cOutputSamples = RenModelOutPels();
 }
 
 template <BlenMod iBM, Bool bBitInc> Void
@@ -178,8 +267,8 @@ TRenSingleModelC<iBM,bBitInc>::setLRView( Int iViewPos, Pel** apiCurVideoPel, In
 {
   AOF(( iViewPos == 0) || (iViewPos == 1) );
 
-  RenModelInPels* pcCurInputSampleRow = m_pcInputSamples[iViewPos];
-  
+  const RenModelInPels& rcInput = m_acInputSamples[iViewPos];
+
   Pel* piDRow = piCurDepthPel;
   Pel* piYRow = apiCurVideoPel[0];
 #if H_3D_VSO_COLOR_PLANES
@@ -187,37 +276,18 @@ TRenSingleModelC<iBM,bBitInc>::setLRView( Int iViewPos, Pel** apiCurVideoPel, In
   Pel* piVRow = apiCurVideoPel[2];
 #endif  
 
-
-  Int iOffsetX = ( iViewPos == VIEWPOS_RIGHT ) ? 1 : 0;
+  // the upsampled video of the right view is stored shifted by one sample
+  Int iOffset        = ( iViewPos == VIEWPOS_RIGHT ) ? ( 1 << m_iShiftPrec ) : 0;
+  Int iNumSubSamples = ( m_iWidth << m_iShiftPrec ) + 1;
 
   for ( Int iPosY = 0; iPosY < m_iUsedHeight; iPosY++ )
   {
-    if ( iViewPos == VIEWPOS_RIGHT )
-    {
-      Int iSubPosX = (1 << m_iShiftPrec); 
-      pcCurInputSampleRow[0].aiY[iSubPosX] = piYRow[0];
-#if H_3D_VSO_COLOR_PLANES 
-      pcCurInputSampleRow[0].aiU[iSubPosX] = piURow[0];
-      pcCurInputSampleRow[0].aiV[iSubPosX] = piVRow[0];
-#endif
-    }
-
-    for ( Int iPosX = 0; iPosX < m_iWidth; iPosX++ )
-    {
-      pcCurInputSampleRow[iPosX].iD = piDRow[iPosX];
-
-      for (Int iSubPosX = 0; iSubPosX < (1 << m_iShiftPrec)+1; iSubPosX++ )
-      { 
-        Int iShift = (iPosX << m_iShiftPrec) + iSubPosX;
-        pcCurInputSampleRow[iPosX+iOffsetX].aiY[iSubPosX] = piYRow[iShift];
-#if H_3D_VSO_COLOR_PLANES 
-        pcCurInputSampleRow[iPosX+iOffsetX].aiU[iSubPosX] = piURow[iShift];
-        pcCurInputSampleRow[iPosX+iOffsetX].aiV[iSubPosX] = piVRow[iShift];
+    memcpy( rcInput.piD + iPosY * m_iInputSamplesStride              , piDRow, m_iWidth       * sizeof( Pel ) );
+    memcpy( rcInput.piY + iPosY * m_iInputSubSamplesStride + iOffset , piYRow, iNumSubSamples * sizeof( Pel ) );
+#if H_3D_VSO_COLOR_PLANES
+    memcpy( rcInput.piU + iPosY * m_iInputSubSamplesStride + iOffset , piURow, iNumSubSamples * sizeof( Pel ) );
+    memcpy( rcInput.piV + iPosY * m_iInputSubSamplesStride + iOffset , piVRow, iNumSubSamples * sizeof( Pel ) );
 #endif
-      }
-    } 
-
-    pcCurInputSampleRow += m_iInputSamplesStride; 
 
     piDRow += iCurDepthStride;
     piYRow += aiCurVideoStride[0];
@@ -266,7 +336,8 @@ TRenSingleModelC<iBM,bBitInc>::setup( TComPicYuv* pcOrgVideo, Int** ppiShiftLutL
     xSetStructRefView();
   }
 
-  // Initial Rendering
+  // Initial Rendering, the rendered depth equals the new one
+  m_bSkipUnchangedDepth = false;
   xResetStructError();
   xInitSampleStructs();
   switch ( m_iMode )
@@ -298,6 +369,7 @@ TRenSingleModelC<iBM,bBitInc>::setup( TComPicYuv* pcOrgVideo, Int** ppiShiftLutL
   default:
     AOT(true);
   }
+  m_bSkipUnchangedDepth = true;
 
   // Get Rendered View as Reference
   if ( !pcOrgVideo && !bKeepReference )
@@ -307,76 +379,17 @@ TRenSingleModelC<iBM,bBitInc>::setup( TComPicYuv* pcOrgVideo, Int** ppiShiftLutL
   }
 }
 
-template <BlenMod iBM, Bool bBitInc> Void
-#if H_3D_VSO_COLOR_PLANES
-TRenSingleModelC<iBM,bBitInc>::xGetSampleStrTextPtrs( Int iViewNum, Pel RenModelOutPels::*& rpiSrcY, Pel RenModelOutPels::*& rpiSrcU, Pel RenModelOutPels::*& rpiSrcV )
-#else
-TRenSingleModelC<iBM,bBitInc>::xGetSampleStrTextPtrs( Int iViewNum, Pel RenModelOutPels::*& rpiSrcY )
-#endif
-{
-  switch ( iViewNum )
-  {
-  case 0:
-    rpiSrcY = &RenModelOutPels::iYLeft;
-#if H_3D_VSO_COLOR_PLANES  
-    rpiSrcU = &RenModelOutPels::iULeft;
-    rpiSrcV = &RenModelOutPels::iVLeft;
-#endif
-    break;
-  case 1:
-    rpiSrcY = &RenModelOutPels::iYRight;
-#if H_3D_VSO_COLOR_PLANES  
-    rpiSrcU = &RenModelOutPels::iURight;
-    rpiSrcV = &RenModelOutPels::iVRight;
-#endif
-    break;
-  case 2:
-    rpiSrcY = &RenModelOutPels::iYBlended;
-#if H_3D_VSO_COLOR_PLANES  
-    rpiSrcU = &RenModelOutPels::iUBlended;
-    rpiSrcV = &RenModelOutPels::iVBlended;
-#endif
-    break;
-  }
-}
-
-
-template <BlenMod iBM, Bool bBitInc> Void
-TRenSingleModelC<iBM,bBitInc>::xGetSampleStrDepthPtrs( Int iViewNum, Pel RenModelOutPels::*& rpiSrcD )
-{
-  AOT(iViewNum != 0 && iViewNum != 1);  
-  rpiSrcD = (iViewNum == 1) ? &RenModelOutPels::iDRight : &RenModelOutPels::iDLeft; 
-}
-
-
 template <BlenMod iBM, Bool bBitInc> Void
 TRenSingleModelC<iBM,bBitInc>::xSetStructRefView( )
 {
-  RenModelOutPels* pcCurOutSampleRow = m_pcOutputSamples;
-  
-  Pel* piYRow = m_aapiRefVideoPel[0];
-#if H_3D_VSO_COLOR_PLANES
-  Pel* piURow = m_aapiRefVideoPel[1];
-  Pel* piVRow = m_aapiRefVideoPel[2];
-#endif  
-
   for ( Int iPosY = 0; iPosY < m_iUsedHeight; iPosY++ )
   {
-    for ( Int iPosX = 0; iPosX < m_iWidth; iPosX++ )
-    {      
-      pcCurOutSampleRow[iPosX].iYRef = piYRow[iPosX];
-#if H_3D_VSO_COLOR_PLANES
-      pcCurOutSampleRow[iPosX].iURef = piURow[iPosX];
-      pcCurOutSampleRow[iPosX].iVRef = piVRow[iPosX];
-#endif
-    } 
+    Int iOutOffset = iPosY * m_iOutputSamplesStride;
 
-    pcCurOutSampleRow += m_iOutputSamplesStride; 
-    
-    piYRow += m_aiRefVideoStrides[0];
+    memcpy( m_cOutputSamples.piYRef + iOutOffset, m_aapiRefVideoPel[0] + iPosY * m_aiRefVideoStrides[0], m_iWidth * sizeof( Pel ) );
 #if H_3D_VSO_COLOR_PLANES
-    piURow += m_aiRefVideoStrides[1];
-    piVRow += m_aiRefVideoStrides[2];
+    memcpy( m_cOutputSamples.piURef + iOutOffset, m_aapiRefVideoPel[1] + iPosY * m_aiRefVideoStrides[1], m_iWidth * sizeof( Pel ) );
+    memcpy( m_cOutputSamples.piVRef + iOutOffset, m_aapiRefVideoPel[2] + iPosY * m_aiRefVideoStrides[2], m_iWidth * sizeof( Pel ) );
 #endif
   }
 }
@@ -384,16 +397,7 @@ TRenSingleModelC<iBM,bBitInc>::xSetStructRefView( )
 template <BlenMod iBM, Bool bBitInc> Void
 TRenSingleModelC<iBM,bBitInc>::xResetStructError( )
 {
-  RenModelOutPels* pcCurOutSampleRow = m_pcOutputSamples;
-
-  for ( Int iPosY = 0; iPosY < m_iHeight; iPosY++ )
-  {
-    for ( Int iPosX = 0; iPosX < m_iWidth; iPosX++ )
-    {      
-      pcCurOutSampleRow[iPosX].iError = 0;
-    } 
-    pcCurOutSampleRow += m_iOutputSamplesStride; 
-  }
+  xSetInts( m_cOutputSamples.piError, m_iOutputSamplesStride, m_iWidth, m_iHeight, 0 );
 }
 
 template <BlenMod iBM, Bool bBitInc> Void
@@ -401,76 +405,39 @@ TRenSingleModelC<iBM,bBitInc>::xSetStructSynthViewAsRefView( )
 {
   AOT( m_iMode < 0 || m_iMode > 2);
 
-  RenModelOutPels* pcCurOutSampleRow = m_pcOutputSamples;
-
-  Pel RenModelOutPels::* piSrcY = NULL;
-
-#if H_3D_VSO_COLOR_PLANES  
-  Pel RenModelOutPels::* piSrcU = NULL;
-  Pel RenModelOutPels::* piSrcV = NULL;
-  xGetSampleStrTextPtrs( m_iMode, piSrcY, piSrcU, piSrcV );
-#else
-  xGetSampleStrTextPtrs( m_iMode, piSrcY );
-#endif
-
   for ( Int iPosY = 0; iPosY < m_iUsedHeight; iPosY++ )
   {
-    for ( Int iPosX = 0; iPosX < m_iWidth; iPosX++ )
-    {      
-      pcCurOutSampleRow[iPosX].iYRef = pcCurOutSampleRow[iPosX].*piSrcY;
+    Int iOutOffset = iPosY * m_iOutputSamplesStride;
+
+    memcpy( m_cOutputSamples.piYRef + iOutOffset, m_cOutputSamples.apiY[m_iMode] + iOutOffset, m_iWidth * sizeof( Pel ) );
 #if H_3D_VSO_COLOR_PLANES
-      pcCurOutSampleRow[iPosX].iURef = pcCurOutSampleRow[iPosX].*piSrcU;
-      pcCurOutSampleRow[iPosX].iVRef = pcCurOutSampleRow[iPosX].*piSrcV;
+    memcpy( m_cOutputSamples.piURef + iOutOffset, m_cOutputSamples.apiU[m_iMode] + iOutOffset, m_iWidth * sizeof( Pel ) );
+    memcpy( m_cOutputSamples.piVRef + iOutOffset, m_cOutputSamples.apiV[m_iMode] + iOutOffset, m_iWidth * sizeof( Pel ) );
 #endif
-    } 
-    pcCurOutSampleRow += m_iOutputSamplesStride; 
   }
 }
 
 template <BlenMod iBM, Bool bBitInc> Void
 TRenSingleModelC<iBM,bBitInc>::xInitSampleStructs()
 {
-  RenModelOutPels* pcOutSampleRow      = m_pcOutputSamples;
-  RenModelInPels * pcLeftInSampleRow   = m_pcInputSamples[0];
-  RenModelInPels * pcRightInSampleRow  = m_pcInputSamples[1];
+  for ( Int iViewPos = 0; iViewPos < 2; iViewPos++ )
+  {
+    //// Output Samples
+    xSetInts ( m_cOutputSamples.apiFilled[iViewPos], m_iOutputSamplesStride, m_iWidth, m_iHeight, REN_IS_HOLE );
+    xSetPels ( m_cOutputSamples.apiD     [iViewPos], m_iOutputSamplesStride, m_iWidth, m_iHeight, 0           );
 
+    //// Input Samples
+    xSetBools( m_acInputSamples[iViewPos].pbOccluded, m_iInputSamplesStride, m_iWidth, m_iHeight, false       );
+  }
 
-  for (Int iPosY = 0; iPosY < m_iHeight; iPosY++)
+  for ( Int iViewPos = 0; iViewPos < 3; iViewPos++ )
   {
-    for (Int iPosX = 0; iPosX < m_iWidth; iPosX++)
-    {
-      //// Output Samples
-      pcOutSampleRow[iPosX].iFilledLeft   = REN_IS_HOLE;
-      pcOutSampleRow[iPosX].iFilledRight  = REN_IS_HOLE;
-
-      pcOutSampleRow[iPosX].iDLeft        = 0;
-      pcOutSampleRow[iPosX].iDRight       = 0;
-      pcOutSampleRow[iPosX].iDBlended     = 0;      
-                                     
-      // Y Planes                    
-      pcOutSampleRow[iPosX].iYLeft        = 0;
-      pcOutSampleRow[iPosX].iYRight       = 0;
-      pcOutSampleRow[iPosX].iYBlended     = 0;
-#if H_3D_VSO_COLOR_PLANES             
-      // U Planes                    
-      pcOutSampleRow[iPosX].iULeft        = 1 << (REN_BIT_DEPTH  - 1);
-      pcOutSampleRow[iPosX].iURight       = 1 << (REN_BIT_DEPTH  - 1);
-      pcOutSampleRow[iPosX].iUBlended     = 1 << (REN_BIT_DEPTH  - 1);
-                                                  
-      // V Planes                                  
-      pcOutSampleRow[iPosX].iVLeft        = 1 << (REN_BIT_DEPTH  - 1);
-      pcOutSampleRow[iPosX].iVRight       = 1 << (REN_BIT_DEPTH  - 1);
-      pcOutSampleRow[iPosX].iVBlended     = 1 << (REN_BIT_DEPTH  - 1);
-#endif
-      //// Input Samples
-      pcLeftInSampleRow [iPosX].bOccluded = false;
-      pcRightInSampleRow[iPosX].bOccluded = false;
-    }
-
-    pcOutSampleRow     += m_iOutputSamplesStride;
-    pcLeftInSampleRow  += m_iInputSamplesStride;
-    pcRightInSampleRow += m_iInputSamplesStride;
-  }  
+    xSetPels( m_cOutputSamples.apiY[iViewPos], m_iOutputSamplesStride, m_iWidth, m_iHeight, 0 );
+#if H_3D_VSO_COLOR_PLANES
+    xSetPels( m_cOutputSamples.apiU[iViewPos], m_iOutputSamplesStride, m_iWidth, m_iHeight, 1 << (REN_BIT_DEPTH  - 1) );
+    xSetPels( m_cOutputSamples.apiV[iViewPos], m_iOutputSamplesStride, m_iWidth, m_iHeight, 1 << (REN_BIT_DEPTH  - 1) );
+#endif
+  }
 }
 
 
@@ -565,8 +532,7 @@ TRenSingleModelC<iBM,bBitInc>::getSynthVideo( Int iViewPos, TComPicYuv* pcPicYuv
   AOT( pcPicYuv->getHeight( COMPONENT_Y ) < m_iUsedHeight + m_iHorOffset );
 
 #if H_3D_VSO_COLOR_PLANES
-  Pel RenModelOutPels::* piText[3] = { NULL, NULL, NULL };
-  xGetSampleStrTextPtrs(iViewPos, piText[0], piText[1], piText[2]); 
+  Pel* piText[3] = { m_cOutputSamples.apiY[iViewPos], m_cOutputSamples.apiU[iViewPos], m_cOutputSamples.apiV[iViewPos] };
 
   // Temp image for chroma down sampling
   PelImage cTempImage( m_iWidth, m_iUsedHeight, 3, 0);
@@ -578,13 +544,11 @@ TRenSingleModelC<iBM,bBitInc>::getSynthVideo( Int iViewPos, TComPicYuv* pcPicYuv
 
   for (UInt uiCurPlane = 0; uiCurPlane < 3; uiCurPlane++ )
   {
-    xCopyFromSampleStruct( m_pcOutputSamples, m_iOutputSamplesStride, piText[uiCurPlane], apiData[uiCurPlane], aiStrides[uiCurPlane] , m_iWidth, m_iUsedHeight);
+    TRenFilter<REN_BIT_DEPTH>::copy( piText[uiCurPlane], m_iOutputSamplesStride, m_iWidth, m_iUsedHeight, apiData[uiCurPlane], aiStrides[uiCurPlane] );
   }  
   xCopy2PicYuv( apiData, aiStrides, pcPicYuv );
 #else
-  Pel RenModelOutPels::* piY;
-  xGetSampleStrTextPtrs(iViewPos, piY); 
-  xCopyFromSampleStruct( m_pcOutputSamples, m_iOutputSamplesStride, piY, pcPicYuv->getLumaAddr() + m_iHorOffset * pcPicYuv->getStride(), pcPicYuv->getStride(), m_iWidth, m_iUsedHeight );
+  TRenFilter<REN_BIT_DEPTH>::copy( m_cOutputSamples.apiY[iViewPos], m_iOutputSamplesStride, m_iWidth, m_iUsedHeight, pcPicYuv->getLumaAddr() + m_iHorOffset * pcPicYuv->getStride(), pcPicYuv->getStride() );
   pcPicYuv->setChromaTo( 1 << (g_bitDepthC - 1) );   
 #endif  
 }
@@ -597,9 +561,7 @@ TRenSingleModelC<iBM,bBitInc>::getSynthDepth( Int iViewPos, TComPicYuv* pcPicYuv
   AOT( pcPicYuv->getChromaFormat( )  != CHROMA_420 );
   AOT( pcPicYuv->getHeight( COMPONENT_Y ) < m_iUsedHeight + m_iHorOffset );
 
-  Pel RenModelOutPels::* piD = 0;
-  xGetSampleStrDepthPtrs(iViewPos, piD); 
-  xCopyFromSampleStruct( m_pcOutputSamples, m_iOutputSamplesStride, piD, pcPicYuv->getAddr( COMPONENT_Y ) + pcPicYuv->getStride( COMPONENT_Y ) * m_iHorOffset, pcPicYuv->getStride( COMPONENT_Y ), m_iWidth, m_iUsedHeight );
+  TRenFilter<REN_BIT_DEPTH>::copy( m_cOutputSamples.apiD[iViewPos], m_iOutputSamplesStride, m_iWidth, m_iUsedHeight, pcPicYuv->getAddr( COMPONENT_Y ) + pcPicYuv->getStride( COMPONENT_Y ) * m_iHorOffset, pcPicYuv->getStride( COMPONENT_Y ) );
   pcPicYuv->setChromaTo( 1 << (REN_BIT_DEPTH - 1) );   
 }
 
@@ -612,10 +574,7 @@ TRenSingleModelC<iBM,bBitInc>::getRefVideo ( Int iViewPos, TComPicYuv* pcPicYuv
   AOT( pcPicYuv->getHeight( COMPONENT_Y ) <  m_iUsedHeight + m_iHorOffset);
 
 #if H_3D_VSO_COLOR_PLANES
-  Pel RenModelOutPels::* piText[3];
-  piText[0] = &RenModelOutPels::iYRef;
-  piText[1] = &RenModelOutPels::iURef;
-  piText[2] = &RenModelOutPels::iVRef;
+  Pel* piText[3] = { m_cOutputSamples.piYRef, m_cOutputSamples.piURef, m_cOutputSamples.piVRef };
 
   // Temp image for chroma down sampling
 
@@ -627,12 +586,12 @@ TRenSingleModelC<iBM,bBitInc>::getRefVideo ( Int iViewPos, TComPicYuv* pcPicYuv
 
   for (UInt uiCurPlane = 0; uiCurPlane < 3; uiCurPlane++ )
   {
-    xCopyFromSampleStruct( m_pcOutputSamples, m_iOutputSamplesStride, piText[uiCurPlane], apiData[uiCurPlane], aiStrides[uiCurPlane] , m_iWidth, m_iUsedHeight);
+    TRenFilter<REN_BIT_DEPTH>::copy( piText[uiCurPlane], m_iOutputSamplesStride, m_iWidth, m_iUsedHeight, apiData[uiCurPlane], aiStrides[uiCurPlane] );
   }  
 
   xCopy2PicYuv( apiData, aiStrides, pcPicYuv );
 #else
-  xCopyFromSampleStruct( m_pcOutputSamples, m_iOutputSamplesStride, &RenModelOutPels::iYRef, pcPicYuv->getLumaAddr() *  pcPicYuv->getStride() + m_iHorOffset, pcPicYuv->getStride(), m_iWidth, m_iUsedHeight );
+  TRenFilter<REN_BIT_DEPTH>::copy( m_cOutputSamples.piYRef, m_iOutputSamplesStride, m_iWidth, m_iUsedHeight, pcPicYuv->getLumaAddr() *  pcPicYuv->getStride() + m_iHorOffset, pcPicYuv->getStride() );
   pcPicYuv->setChromaTo( 1 << ( g_bitDepthC - 1 ) );   
 #endif  
 }
@@ -655,19 +614,84 @@ TRenSingleModelC<iBM,bBitInc>::setVideo( Int iViewPos, Int iPlane, Int iStartPos
 template <BlenMod iBM, Bool bBitInc> __inline Void
 TRenSingleModelC<iBM,bBitInc>::xSetViewRow( Int iPosY )
 {
-  m_pcInputSamplesRow[0] = m_pcInputSamples[0] + m_iInputSamplesStride  * iPosY;
-  m_pcInputSamplesRow[1] = m_pcInputSamples[1] + m_iInputSamplesStride  * iPosY;
-  m_pcOutputSamplesRow   = m_pcOutputSamples   + m_iOutputSamplesStride * iPosY;  
+  for ( Int iViewPos = 0; iViewPos < 2; iViewPos++ )
+  {
+    const RenModelInPels& rcInput    = m_acInputSamples   [iViewPos];
+    RenModelInPels&       rcInputRow = m_acInputSamplesRow[iViewPos];
+
+    rcInputRow.piY        = rcInput.piY        + m_iInputSubSamplesStride * iPosY;
+#if H_3D_VSO_COLOR_PLANES
+    rcInputRow.piU        = rcInput.piU        + m_iInputSubSamplesStride * iPosY;
+    rcInputRow.piV        = rcInput.piV        + m_iInputSubSamplesStride * iPosY;
+#endif
+    rcInputRow.piD        = rcInput.piD        + m_iInputSamplesStride    * iPosY;
+    rcInputRow.pbOccluded = rcInput.pbOccluded + m_iInputSamplesStride    * iPosY;
+  }
+
+  Int iOutOffset = m_iOutputSamplesStride * iPosY;
+
+  for ( Int iViewPos = 0; iViewPos < 3; iViewPos++ )
+  {
+    m_cOutputSamplesRow.apiY[iViewPos] = m_cOutputSamples.apiY[iViewPos] + iOutOffset;
+#if H_3D_VSO_COLOR_PLANES
+    m_cOutputSamplesRow.apiU[iViewPos] = m_cOutputSamples.apiU[iViewPos] + iOutOffset;
+    m_cOutputSamplesRow.apiV[iViewPos] = m_cOutputSamples.apiV[iViewPos] + iOutOffset;
+#endif
+  }
+
+  for ( Int iViewPos = 0; iViewPos < 2; iViewPos++ )
+  {
+    m_cOutputSamplesRow.apiD     [iViewPos] = m_cOutputSamples.apiD     [iViewPos] + iOutOffset;
+    m_cOutputSamplesRow.apiFilled[iViewPos] = m_cOutputSamples.apiFilled[iViewPos] + iOutOffset;
+  }
 
+  m_cOutputSamplesRow.piError = m_cOutputSamples.piError + iOutOffset;
+  m_cOutputSamplesRow.piYRef  = m_cOutputSamples.piYRef  + iOutOffset;
+#if H_3D_VSO_COLOR_PLANES
+  m_cOutputSamplesRow.piURef  = m_cOutputSamples.piURef  + iOutOffset;
+  m_cOutputSamplesRow.piVRef  = m_cOutputSamples.piVRef  + iOutOffset;
+#endif
 }
 
 template <BlenMod iBM, Bool bBitInc> __inline Void
 TRenSingleModelC<iBM,bBitInc>::xIncViewRow( )
 {
-  m_pcInputSamplesRow[0] += m_iInputSamplesStride ;
-  m_pcInputSamplesRow[1] += m_iInputSamplesStride ;
-  m_pcOutputSamplesRow   += m_iOutputSamplesStride;  
+  for ( Int iViewPos = 0; iViewPos < 2; iViewPos++ )
+  {
+    RenModelInPels& rcInputRow = m_acInputSamplesRow[iViewPos];
+
+    rcInputRow.piY        += m_iInputSubSamplesStride;
+#if H_3D_VSO_COLOR_PLANES
+    rcInputRow.piU        += m_iInputSubSamplesStride;
+    rcInputRow.piV        += m_iInputSubSamplesStride;
+#endif
+    rcInputRow.piD        += m_iInputSamplesStride;
+    rcInputRow.pbOccluded += m_iInputSamplesStride;
+  }
+
+  for ( Int iViewPos = 0; iViewPos < 3; iViewPos++ )
+  {
+    m_cOutputSamplesRow.apiY[iViewPos] += m_iOutputSamplesStride;
+#if H_3D_VSO_COLOR_PLANES
+    m_cOutputSamplesRow.apiU[iViewPos] += m_iOutputSamplesStride;
+    m_cOutputSamplesRow.apiV[iViewPos] += m_iOutputSamplesStride;
+#endif
+  }
+
+  for ( Int iViewPos = 0; iViewPos < 2; iViewPos++ )
+  {
+    m_cOutputSamplesRow.apiD     [iViewPos] += m_iOutputSamplesStride;
+    m_cOutputSamplesRow.apiFilled[iViewPos] += m_iOutputSamplesStride;
+  }
+
+  m_cOutputSamplesRow.piError += m_iOutputSamplesStride;
+  m_cOutputSamplesRow.piYRef  += m_iOutputSamplesStride;
+#if H_3D_VSO_COLOR_PLANES
+  m_cOutputSamplesRow.piURef  += m_iOutputSamplesStride;
+  m_cOutputSamplesRow.piVRef  += m_iOutputSamplesStride;
+#endif
 }
+
 #if H_3D_VSO_EARLY_SKIP
 template <BlenMod iBM, Bool bBitInc> template<Bool bSet> __inline RMDist 
 TRenSingleModelC<iBM,bBitInc>::xRenderL( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, Int iStride, const Pel* piNewData, Bool bFast)
@@ -695,9 +719,6 @@ TRenSingleModelC<iBM,bBitInc>::xRenderL( Int iStartPosX, Int iStartPosY, Int iWi
 
   // Init Start
   RMDist iError = 0;
-  Int   iStartChangePos;
-
-  iStartChangePos = m_iStartChangePosX;
 
   for (Int iPosY = iStartPosY; iPosY < iStartPosY + iHeight; iPosY++ )
   {
@@ -712,11 +733,20 @@ TRenSingleModelC<iBM,bBitInc>::xRenderL( Int iStartPosX, Int iStartPosY, Int iWi
       }
     }
 #endif
+    Int iStartChangePos       = m_iStartChangePosX;
+    Int iEndChangePos         = m_iStartChangePosX + iWidth - 1;
+
+    if ( m_bSkipUnchangedDepth && !xGetDirtyInterval( iCurViewPos, iStartChangePos, iEndChangePos ) )
+    {
+      xIncViewRow();
+      m_piNewDepthData += iStride;
+      continue;
+    }
+
     m_bInOcclusion = false;
 
     Int iLastSPos;
-    Int iEndChangePos         = m_iStartChangePosX + iWidth - 1;
-    Int iPosXinNewData        = iWidth - 1;
+    Int iPosXinNewData        = iEndChangePos - m_iStartChangePosX;
     Int iMinChangedSPos       = m_iSampledWidth;
 
     if ( iEndChangePos == ( m_iWidth -1 )) // Special processing for rightmost depth sample
@@ -727,13 +757,13 @@ TRenSingleModelC<iBM,bBitInc>::xRenderL( Int iStartPosX, Int iStartPosY, Int iWi
       m_iLastOccludedSPosFP = xRangeLeftL( m_iLastOccludedSPos );
       xExtrapolateMarginL<bSet>  ( iCurSPos, iEndChangePos, iError );
 
-      iMinChangedSPos       = std::min( iMinChangedSPos, (iEndChangePos << m_iShiftPrec) - m_ppiCurLUT[0][ RenModRemoveBitInc( std::max(m_pcInputSamplesRow[iCurViewPos][iEndChangePos].iD, m_piNewDepthData[iPosXinNewData] )) ]);
+      iMinChangedSPos       = std::min( iMinChangedSPos, (iEndChangePos << m_iShiftPrec) - m_ppiCurLUT[0][ RenModRemoveBitInc( std::max(m_acInputSamplesRow[iCurViewPos].piD[iEndChangePos], m_piNewDepthData[iPosXinNewData] )) ]);
       iLastSPos             = iCurSPos;
       m_iLastDepth          = m_iCurDepth;
 
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][iEndChangePos].iD = m_piNewDepthData[iPosXinNewData];
+        m_acInputSamplesRow[iCurViewPos].piD[iEndChangePos] = m_piNewDepthData[iPosXinNewData];
       }
 
       iPosXinNewData--;
@@ -742,7 +772,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderL( Int iStartPosX, Int iStartPosY, Int iWi
     else
     {
       iLastSPos    = xShift(iEndChangePos+1);
-      m_iLastDepth = m_pcInputSamplesRow [iCurViewPos][iEndChangePos+1].iD;
+      m_iLastDepth = m_acInputSamplesRow[iCurViewPos].piD[iEndChangePos+1];
       xInitRenderPartL( iEndChangePos, iLastSPos );
     }
 
@@ -752,7 +782,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderL( Int iStartPosX, Int iStartPosY, Int iWi
     {
       // Get minimal changed sample position
 
-      iMinChangedSPos = std::min( iMinChangedSPos, (iCurPosX << m_iShiftPrec) - m_ppiCurLUT[0][ RenModRemoveBitInc( std::max(m_pcInputSamplesRow[iCurViewPos][iCurPosX].iD, m_piNewDepthData[iPosXinNewData] )) ]);
+      iMinChangedSPos = std::min( iMinChangedSPos, (iCurPosX << m_iShiftPrec) - m_ppiCurLUT[0][ RenModRemoveBitInc( std::max(m_acInputSamplesRow[iCurViewPos].piD[iCurPosX], m_piNewDepthData[iPosXinNewData] )) ]);
       Int iCurSPos    = xShiftNewData(iCurPosX,iPosXinNewData);
       m_iCurDepth     = m_piNewDepthData[iPosXinNewData];
       xRenderRangeL<bSet>(iCurSPos, iLastSPos, iCurPosX, iError );
@@ -761,7 +791,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderL( Int iStartPosX, Int iStartPosY, Int iWi
 
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][iCurPosX].iD = m_piNewDepthData[iPosXinNewData];
+        m_acInputSamplesRow[iCurViewPos].piD[iCurPosX] = m_piNewDepthData[iPosXinNewData];
       }
 
       iPosXinNewData--;
@@ -772,7 +802,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderL( Int iStartPosX, Int iStartPosY, Int iWi
     {
       Int iCurSPos = xShift(iCurPosX);
 
-      m_iCurDepth  = m_pcInputSamplesRow[iCurViewPos][iCurPosX].iD;
+      m_iCurDepth  = m_acInputSamplesRow[iCurViewPos].piD[iCurPosX];
       xRenderRangeL<bSet>( iCurSPos, iLastSPos, iCurPosX, iError );
 
       if ( iCurSPos < iMinChangedSPos )
@@ -820,9 +850,6 @@ TRenSingleModelC<iBM,bBitInc>::xRenderR( Int iStartPosX, Int iStartPosY, Int iWi
 
   // Init Start
   RMDist iError = 0;
-  Int   iEndChangePos;
-
-  iEndChangePos = m_iStartChangePosX + iWidth - 1;
 
   for (Int iPosY = iStartPosY; iPosY < iStartPosY + iHeight; iPosY++ )
   {
@@ -837,11 +864,20 @@ TRenSingleModelC<iBM,bBitInc>::xRenderR( Int iStartPosX, Int iStartPosY, Int iWi
       }
     }
 #endif
+    Int iStartChangePos       = m_iStartChangePosX;
+    Int iEndChangePos         = m_iStartChangePosX + iWidth - 1;
+
+    if ( m_bSkipUnchangedDepth && !xGetDirtyInterval( iCurViewPos, iStartChangePos, iEndChangePos ) )
+    {
+      xIncViewRow();
+      m_piNewDepthData += iStride;
+      continue;
+    }
+
     m_bInOcclusion = false;
 
     Int iLastSPos;
-    Int iStartChangePos       = m_iStartChangePosX;
-    Int iPosXinNewData        = 0;
+    Int iPosXinNewData        = iStartChangePos - m_iStartChangePosX;
     Int iMaxChangedSPos = -1;
 
     if ( iStartChangePos == 0 ) // Special processing for leftmost depth sample
@@ -852,12 +888,12 @@ TRenSingleModelC<iBM,bBitInc>::xRenderR( Int iStartPosX, Int iStartPosY, Int iWi
       m_iLastOccludedSPosFP = xRangeRightR( m_iLastOccludedSPos );
       xExtrapolateMarginR<bSet>     ( iCurSPos, iStartChangePos, iError );
 
-      iMaxChangedSPos       = std::max( iMaxChangedSPos, (iStartChangePos << m_iShiftPrec) - m_ppiCurLUT[0][ RenModRemoveBitInc( std::max(m_pcInputSamplesRow[iCurViewPos][iStartChangePos].iD, m_piNewDepthData[iPosXinNewData] )) ]);
+      iMaxChangedSPos       = std::max( iMaxChangedSPos, (iStartChangePos << m_iShiftPrec) - m_ppiCurLUT[0][ RenModRemoveBitInc( std::max(m_acInputSamplesRow[iCurViewPos].piD[iStartChangePos], m_piNewDepthData[iPosXinNewData] )) ]);
       iLastSPos             = iCurSPos;
       m_iLastDepth          = m_iCurDepth;
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][iStartChangePos].iD = m_piNewDepthData[iPosXinNewData];
+        m_acInputSamplesRow[iCurViewPos].piD[iStartChangePos] = m_piNewDepthData[iPosXinNewData];
       }
 
 
@@ -868,7 +904,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderR( Int iStartPosX, Int iStartPosY, Int iWi
     {
       iLastSPos   = xShift(iStartChangePos-1);
 
-      m_iLastDepth = m_pcInputSamplesRow[iCurViewPos][iStartChangePos-1].iD;
+      m_iLastDepth = m_acInputSamplesRow[iCurViewPos].piD[iStartChangePos-1];
       xInitRenderPartR( iStartChangePos, iLastSPos );
     }
 
@@ -878,7 +914,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderR( Int iStartPosX, Int iStartPosY, Int iWi
     {
       // Get minimal changed sample position
 
-      iMaxChangedSPos = std::max( iMaxChangedSPos, (iCurPosX << m_iShiftPrec) - m_ppiCurLUT[0][ RenModRemoveBitInc( std::max(m_pcInputSamplesRow[iCurViewPos][iCurPosX].iD, m_piNewDepthData[iPosXinNewData] )) ]);
+      iMaxChangedSPos = std::max( iMaxChangedSPos, (iCurPosX << m_iShiftPrec) - m_ppiCurLUT[0][ RenModRemoveBitInc( std::max(m_acInputSamplesRow[iCurViewPos].piD[iCurPosX], m_piNewDepthData[iPosXinNewData] )) ]);
       Int iCurSPos    = xShiftNewData(iCurPosX,iPosXinNewData);
       m_iCurDepth     = m_piNewDepthData[iPosXinNewData];
       xRenderRangeR<bSet>(iCurSPos, iLastSPos, iCurPosX, iError );
@@ -887,7 +923,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderR( Int iStartPosX, Int iStartPosY, Int iWi
 
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][iCurPosX].iD = m_piNewDepthData[iPosXinNewData];
+        m_acInputSamplesRow[iCurViewPos].piD[iCurPosX] = m_piNewDepthData[iPosXinNewData];
       }
 
       iPosXinNewData++;
@@ -898,7 +934,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderR( Int iStartPosX, Int iStartPosY, Int iWi
     {
       Int iCurSPos = xShift(iCurPosX);
 
-      m_iCurDepth  = m_pcInputSamplesRow[iCurViewPos][iCurPosX].iD;
+      m_iCurDepth  = m_acInputSamplesRow[iCurViewPos].piD[iCurPosX];
       xRenderRangeR<bSet>( iCurSPos, iLastSPos, iCurPosX, iError );
 
       if ( iCurSPos > iMaxChangedSPos )
@@ -917,6 +953,27 @@ TRenSingleModelC<iBM,bBitInc>::xRenderR( Int iStartPosX, Int iStartPosY, Int iWi
 }
 
 
+template <BlenMod iBM, Bool bBitInc> __inline Bool
+TRenSingleModelC<iBM,bBitInc>::xGetDirtyInterval( Int iCurViewPos, Int& riStartChangePos, Int& riEndChangePos )
+{
+  // Shrink the changed interval of the current row to the samples whose new depth differs from the rendered one.
+  // Samples outside of it render to the same values as before, and need to be re-rendered only when they are
+  // affected by a changed sample.
+  const Pel* piCurDepth = m_acInputSamplesRow[iCurViewPos].piD;
+
+  while ( ( riStartChangePos <= riEndChangePos ) && ( m_piNewDepthData[riStartChangePos - m_iStartChangePosX] == piCurDepth[riStartChangePos] ) )
+  {
+    riStartChangePos++;
+  }
+
+  while ( ( riEndChangePos > riStartChangePos ) && ( m_piNewDepthData[riEndChangePos - m_iStartChangePosX] == piCurDepth[riEndChangePos] ) )
+  {
+    riEndChangePos--;
+  }
+
+  return ( riStartChangePos <= riEndChangePos );
+}
+
 template <BlenMod iBM, Bool bBitInc> __inline Void
 TRenSingleModelC<iBM,bBitInc>::xInitRenderPartL(  Int iEndChangePos, Int iLastSPos )
 {
@@ -925,11 +982,11 @@ TRenSingleModelC<iBM,bBitInc>::xInitRenderPartL(  Int iEndChangePos, Int iLastSP
   Int iCurPosX           = iEndChangePos;
 
 
-  if ( ( iCurPosX + 1 < m_iWidth ) && (m_pcInputSamplesRow[iCurViewPos][ iCurPosX + 1].bOccluded ) )
+  if ( ( iCurPosX + 1 < m_iWidth ) && (m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPosX + 1] ) )
   {
     iCurPosX++;
 
-    while ( (iCurPosX + 1 < m_iWidth) &&  (m_pcInputSamplesRow[iCurViewPos][ iCurPosX + 1].bOccluded  )  )
+    while ( (iCurPosX + 1 < m_iWidth) &&  (m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPosX + 1]  )  )
 
       iCurPosX++;
 
@@ -961,11 +1018,11 @@ TRenSingleModelC<iBM,bBitInc>::xInitRenderPartR(  Int iStartChangePos, Int iLast
   // GET MINIMAL OCCLUDED SAMPLE POSITION
   Int iCurPosX           = iStartChangePos;
 
-  if ( ( iCurPosX - 1 > -1 ) && (m_pcInputSamplesRow[iCurViewPos][ iCurPosX - 1].bOccluded  ) )
+  if ( ( iCurPosX - 1 > -1 ) && (m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPosX - 1]  ) )
   {
     iCurPosX--;
 
-    while ( (iCurPosX - 1 > -1 ) &&  (m_pcInputSamplesRow[iCurViewPos][ iCurPosX - 1].bOccluded  )  )
+    while ( (iCurPosX - 1 > -1 ) &&  (m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPosX - 1]  )  )
       iCurPosX--;
 
     if ( iCurPosX - 1 > -1 )
@@ -1076,14 +1133,14 @@ TRenSingleModelC<iBM,bBitInc>::xRenderRangeL(Int iCurSPos, Int iLastSPos, Int iC
 
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][ iCurPos ].bOccluded  = true;
+        m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPos]  = true;
       }
     }
     else
     {
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][ iCurPos ].bOccluded  = false;
+        m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPos]  = false;
       }
 
       xRenderShiftedRangeL<bSet>(iCurSPos, iLastSPos, iCurPos, riError );
@@ -1096,7 +1153,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderRangeL(Int iCurSPos, Int iLastSPos, Int iC
       m_bInOcclusion = false;
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][ iCurPos ].bOccluded  = false;
+        m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPos]  = false;
       }
 
       xRenderShiftedRangeL<bSet>(iCurSPos, iLastSPos, iCurPos, riError );
@@ -1105,7 +1162,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderRangeL(Int iCurSPos, Int iLastSPos, Int iC
     {
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][ iCurPos ].bOccluded  = true;
+        m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPos]  = true;
       }
     }
   }
@@ -1134,14 +1191,14 @@ TRenSingleModelC<iBM,bBitInc>::xRenderRangeR(Int iCurSPos, Int iLastSPos, Int iC
 
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][ iCurPos ].bOccluded  = true;
+        m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPos]  = true;
       }
     }
     else
     {
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][ iCurPos ].bOccluded  = false;
+        m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPos]  = false;
       }
 
       xRenderShiftedRangeR<bSet>(iCurSPos, iLastSPos, iCurPos, riError );
@@ -1154,7 +1211,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderRangeR(Int iCurSPos, Int iLastSPos, Int iC
       m_bInOcclusion = false;
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][ iCurPos ].bOccluded  = false;
+        m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPos]  = false;
       }
 
       xRenderShiftedRangeR<bSet>(iCurSPos, iLastSPos, iCurPos, riError );
@@ -1163,7 +1220,7 @@ TRenSingleModelC<iBM,bBitInc>::xRenderRangeR(Int iCurSPos, Int iLastSPos, Int iC
     {
       if ( bSet )
       {
-        m_pcInputSamplesRow[iCurViewPos][ iCurPos ].bOccluded  = true;
+        m_acInputSamplesRow[iCurViewPos].pbOccluded[iCurPos]  = true;
       }
     }
   }
@@ -1288,7 +1345,7 @@ TRenSingleModelC<iBM,bBitInc>::xShift( Int iPosX )
  RM_AOT( iPosX <        0);
  RM_AOF( iPosX < m_iWidth);
 
- return (iPosX  << m_iShiftPrec) - m_ppiCurLUT[0][ RenModRemoveBitInc( m_pcInputSamplesRow[m_iCurViewPos][iPosX].iD )];
+ return (iPosX  << m_iShiftPrec) - m_ppiCurLUT[0][ RenModRemoveBitInc( m_acInputSamplesRow[m_iCurViewPos].piD[iPosX] )];
 }
 
 
@@ -1396,60 +1453,65 @@ TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelL(Int iSourcePos, Int iSubSourcePos
   RM_AOT( iTargetSPos   < 0                    );
   RM_AOT( iTargetSPos   >= m_iWidth            );  
 
-  RenModelOutPels* pcOutSample = m_pcOutputSamplesRow              + iTargetSPos;
-  RenModelInPels * pcInSample  = m_pcInputSamplesRow[VIEWPOS_LEFT] + iSourcePos ;
+  Int iSourceSubPos = ( iSourcePos << m_iShiftPrec ) + iSubSourcePos;
 
   if ( iBM != BLEND_NONE )
   {
-    xSetShiftedPelBlendL<bSet>  (pcInSample, iSubSourcePos, pcOutSample, iFilled, riError);
+    xSetShiftedPelBlendL<bSet>  (iSourceSubPos, iTargetSPos, iFilled, riError);
   }
   else
   {
-    xSetShiftedPelNoBlendL<bSet>(pcInSample, iSubSourcePos, pcOutSample, iFilled, riError);
+    xSetShiftedPelNoBlendL<bSet>(iSourceSubPos, iTargetSPos, iFilled, riError);
   }
 }
 
 template <BlenMod iBM, Bool bBitInc> template<Bool bSet> __inline Void
-TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelNoBlendL(RenModelInPels* pcInSample, Int iSubSourcePos, RenModelOutPels* pcOutSample, Pel iFilled, RMDist& riError )
+TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelNoBlendL(Int iSourceSubPos, Int iTargetSPos, Pel iFilled, RMDist& riError )
 {
+  const RenModelInPels&  rcIn  = m_acInputSamplesRow[VIEWPOS_LEFT];
+  const RenModelOutPels& rcOut = m_cOutputSamplesRow;
+
   if ( bSet )
   { 
     // Filled
-    pcOutSample->iFilledLeft = iFilled;
+    rcOut.apiFilled[VIEWPOS_LEFT][iTargetSPos] = iFilled;
 
     // Yuv
-    pcOutSample->iYLeft  = pcInSample->aiY[iSubSourcePos];
+    rcOut.apiY[VIEWPOS_LEFT][iTargetSPos]  = rcIn.piY[iSourceSubPos];
 #if H_3D_VSO_COLOR_PLANES
-    pcOutSample->iULeft  = pcInSample->aiU[iSubSourcePos];
-    pcOutSample->iVLeft  = pcInSample->aiV[iSubSourcePos];
+    rcOut.apiU[VIEWPOS_LEFT][iTargetSPos]  = rcIn.piU[iSourceSubPos];
+    rcOut.apiV[VIEWPOS_LEFT][iTargetSPos]  = rcIn.piV[iSourceSubPos];
 
-    pcOutSample->iError = xGetDist( pcOutSample->iYLeft - pcOutSample->iYRef,
-                                    pcOutSample->iULeft - pcOutSample->iURef,    
-                                    pcOutSample->iVLeft - pcOutSample->iVRef
-                                  );    
+    rcOut.piError[iTargetSPos] = xGetDist( rcOut.apiY[VIEWPOS_LEFT][iTargetSPos] - rcOut.piYRef[iTargetSPos],
+                                           rcOut.apiU[VIEWPOS_LEFT][iTargetSPos] - rcOut.piURef[iTargetSPos],    
+                                           rcOut.apiV[VIEWPOS_LEFT][iTargetSPos] - rcOut.piVRef[iTargetSPos]
+                                         );    
 #else
-    pcOutSample->iError = xGetDist( pcOutSample->iYLeft - pcOutSample->iYRef );    
+    rcOut.piError[iTargetSPos] = xGetDist( rcOut.apiY[VIEWPOS_LEFT][iTargetSPos] - rcOut.piYRef[iTargetSPos] );    
 #endif    
     
   }
   else
   { 
 #if H_3D_VSO_COLOR_PLANES
-    riError += xGetDist( pcInSample->aiY[iSubSourcePos] - pcOutSample->iYRef,
-                         pcInSample->aiU[iSubSourcePos] - pcOutSample->iURef,
-                         pcInSample->aiV[iSubSourcePos] - pcOutSample->iVRef
+    riError += xGetDist( rcIn.piY[iSourceSubPos] - rcOut.piYRef[iTargetSPos],
+                         rcIn.piU[iSourceSubPos] - rcOut.piURef[iTargetSPos],
+                         rcIn.piV[iSourceSubPos] - rcOut.piVRef[iTargetSPos]
                        );
 #else               
-    riError += xGetDist( pcInSample->aiY[iSubSourcePos] - pcOutSample->iYRef );
+    riError += xGetDist( rcIn.piY[iSourceSubPos] - rcOut.piYRef[iTargetSPos] );
 #endif
 
-    riError -= pcOutSample->iError;
+    riError -= rcOut.piError[iTargetSPos];
   }
 }
 
 template <BlenMod iBM, Bool bBitInc> template<Bool bSet> __inline Void
-TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelBlendL(RenModelInPels* pcInSample, Int iSubSourcePos, RenModelOutPels* pcOutSample, Pel iFilled, RMDist& riError )
+TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelBlendL(Int iSourceSubPos, Int iTargetSPos, Pel iFilled, RMDist& riError )
 {
+  const RenModelInPels&  rcIn  = m_acInputSamplesRow[VIEWPOS_LEFT];
+  const RenModelOutPels& rcOut = m_cOutputSamplesRow;
+
   Pel piBlendedValueY;
 #if H_3D_VSO_COLOR_PLANES
   Pel piBlendedValueU;
@@ -1457,18 +1519,18 @@ TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelBlendL(RenModelInPels* pcInSample,
 #endif
 
   xGetBlendedValue (
-    pcInSample ->aiY[iSubSourcePos],
-    pcOutSample->iYRight,    
+    rcIn .piY[iSourceSubPos],
+    rcOut.apiY[VIEWPOS_RIGHT][iTargetSPos],    
 #if H_3D_VSO_COLOR_PLANES
-    pcInSample ->aiU[iSubSourcePos],
-    pcOutSample->iURight,    
-    pcInSample ->aiV[iSubSourcePos],
-    pcOutSample->iVRight,    
+    rcIn .piU[iSourceSubPos],
+    rcOut.apiU[VIEWPOS_RIGHT][iTargetSPos],    
+    rcIn .piV[iSourceSubPos],
+    rcOut.apiV[VIEWPOS_RIGHT][iTargetSPos],    
 #endif
-    m_piInvZLUTLeft [RenModRemoveBitInc(m_iThisDepth)        ],
-    m_piInvZLUTRight[RenModRemoveBitInc(pcOutSample->iDRight)],
+    m_piInvZLUTLeft [RenModRemoveBitInc(m_iThisDepth)                      ],
+    m_piInvZLUTRight[RenModRemoveBitInc(rcOut.apiD[VIEWPOS_RIGHT][iTargetSPos])],
     iFilled,
-    pcOutSample->iFilledRight  ,
+    rcOut.apiFilled[VIEWPOS_RIGHT][iTargetSPos],
     piBlendedValueY
 #if H_3D_VSO_COLOR_PLANES
     , piBlendedValueU,
@@ -1479,37 +1541,37 @@ TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelBlendL(RenModelInPels* pcInSample,
   if ( bSet )
   {    
     // Set values
-    pcOutSample->iDLeft      = m_iThisDepth;
-    pcOutSample->iYLeft      = pcInSample ->aiY[iSubSourcePos];
-    pcOutSample->iYBlended   = piBlendedValueY;    
+    rcOut.apiD[VIEWPOS_LEFT  ][iTargetSPos] = m_iThisDepth;
+    rcOut.apiY[VIEWPOS_LEFT  ][iTargetSPos] = rcIn.piY[iSourceSubPos];
+    rcOut.apiY[VIEWPOS_MERGED][iTargetSPos] = piBlendedValueY;    
 #if H_3D_VSO_COLOR_PLANES  
-    pcOutSample->iULeft      = pcInSample ->aiU[iSubSourcePos];
-    pcOutSample->iUBlended   = piBlendedValueU;    
-    pcOutSample->iVLeft      = pcInSample ->aiV[iSubSourcePos];
-    pcOutSample->iVBlended   = piBlendedValueV;    
+    rcOut.apiU[VIEWPOS_LEFT  ][iTargetSPos] = rcIn.piU[iSourceSubPos];
+    rcOut.apiU[VIEWPOS_MERGED][iTargetSPos] = piBlendedValueU;    
+    rcOut.apiV[VIEWPOS_LEFT  ][iTargetSPos] = rcIn.piV[iSourceSubPos];
+    rcOut.apiV[VIEWPOS_MERGED][iTargetSPos] = piBlendedValueV;    
 #endif
-    pcOutSample->iFilledLeft = iFilled;
+    rcOut.apiFilled[VIEWPOS_LEFT][iTargetSPos] = iFilled;
 
     // Get Error
-    Int iDiffY = pcOutSample->iYRef - piBlendedValueY;
+    Int iDiffY = rcOut.piYRef[iTargetSPos] - piBlendedValueY;
 #if H_3D_VSO_COLOR_PLANES
-    Int iDiffU = pcOutSample->iURef - piBlendedValueU;
-    Int iDiffV = pcOutSample->iVRef - piBlendedValueV;
-    pcOutSample->iError  = xGetDist(iDiffY, iDiffU, iDiffV );
+    Int iDiffU = rcOut.piURef[iTargetSPos] - piBlendedValueU;
+    Int iDiffV = rcOut.piVRef[iTargetSPos] - piBlendedValueV;
+    rcOut.piError[iTargetSPos] = xGetDist(iDiffY, iDiffU, iDiffV );
 #else
-    pcOutSample->iError  = xGetDist(iDiffY );
+    rcOut.piError[iTargetSPos] = xGetDist(iDiffY );
 #endif
   }
   else
   {
-    Int iDiffY = pcOutSample->iYRef - piBlendedValueY;
+    Int iDiffY = rcOut.piYRef[iTargetSPos] - piBlendedValueY;
 #if H_3D_VSO_COLOR_PLANES
-    Int iDiffU = pcOutSample->iURef - piBlendedValueU;
-    Int iDiffV = pcOutSample->iVRef - piBlendedValueV;
-    riError   += ( xGetDist( iDiffY, iDiffU, iDiffV ) - pcOutSample->iError );
+    Int iDiffU = rcOut.piURef[iTargetSPos] - piBlendedValueU;
+    Int iDiffV = rcOut.piVRef[iTargetSPos] - piBlendedValueV;
+    riError   += ( xGetDist( iDiffY, iDiffU, iDiffV ) - rcOut.piError[iTargetSPos] );
 
 #else
-    riError   += ( xGetDist( iDiffY ) - pcOutSample->iError  );
+    riError   += ( xGetDist( iDiffY ) - rcOut.piError[iTargetSPos] );
 #endif
 
   }
@@ -1526,61 +1588,65 @@ TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelR(Int iSourcePos, Int iSubSourcePos
   RM_AOT( iTargetSPos   < 0                      );
   RM_AOT( iTargetSPos   >= m_iWidth              );  
 
-  RenModelOutPels* pcOutSample = m_pcOutputSamplesRow               + iTargetSPos;
-  RenModelInPels * pcInSample  = m_pcInputSamplesRow[VIEWPOS_RIGHT] + iSourcePos ;
+  Int iSourceSubPos = ( iSourcePos << m_iShiftPrec ) + iSubSourcePos;
 
   if ( iBM != BLEND_NONE )
   {
-    xSetShiftedPelBlendR<bSet>   (pcInSample, iSubSourcePos, pcOutSample, iFilled, riError);
+    xSetShiftedPelBlendR<bSet>  (iSourceSubPos, iTargetSPos, iFilled, riError);
   }
   else
   {
-    xSetShiftedPelNoBlendR<bSet> (pcInSample, iSubSourcePos, pcOutSample, iFilled, riError);
+    xSetShiftedPelNoBlendR<bSet>(iSourceSubPos, iTargetSPos, iFilled, riError);
   }
 }
 
 template <BlenMod iBM, Bool bBitInc> template<Bool bSet> __inline Void
-TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelNoBlendR(RenModelInPels* pcInSample, Int iSubSourcePos, RenModelOutPels* pcOutSample, Pel iFilled, RMDist& riError )
+TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelNoBlendR(Int iSourceSubPos, Int iTargetSPos, Pel iFilled, RMDist& riError )
 {
+  const RenModelInPels&  rcIn  = m_acInputSamplesRow[VIEWPOS_RIGHT];
+  const RenModelOutPels& rcOut = m_cOutputSamplesRow;
+
   if ( bSet )
   { 
     // Filled
-    pcOutSample->iFilledRight = iFilled;
+    rcOut.apiFilled[VIEWPOS_RIGHT][iTargetSPos] = iFilled;
 
     // Yuv
-    pcOutSample->iYRight  = pcInSample->aiY[iSubSourcePos];
+    rcOut.apiY[VIEWPOS_RIGHT][iTargetSPos] = rcIn.piY[iSourceSubPos];
 #if H_3D_VSO_COLOR_PLANES
-    pcOutSample->iURight  = pcInSample->aiU[iSubSourcePos];
-    pcOutSample->iVRight  = pcInSample->aiV[iSubSourcePos];
-
-    pcOutSample->iError = xGetDist( 
-      pcOutSample->iYRight - pcOutSample->iYRef,
-      pcOutSample->iURight - pcOutSample->iURef,    
-      pcOutSample->iVRight - pcOutSample->iVRef
-      );    
+    rcOut.apiU[VIEWPOS_RIGHT][iTargetSPos] = rcIn.piU[iSourceSubPos];
+    rcOut.apiV[VIEWPOS_RIGHT][iTargetSPos] = rcIn.piV[iSourceSubPos];
+
+    rcOut.piError[iTargetSPos] = xGetDist( rcOut.apiY[VIEWPOS_RIGHT][iTargetSPos] - rcOut.piYRef[iTargetSPos],
+                                           rcOut.apiU[VIEWPOS_RIGHT][iTargetSPos] - rcOut.piURef[iTargetSPos],    
+                                           rcOut.apiV[VIEWPOS_RIGHT][iTargetSPos] - rcOut.piVRef[iTargetSPos]
+                                         );    
 #else
-    pcOutSample->iError = xGetDist( pcOutSample->iYRight - pcOutSample->iYRef );    
+    rcOut.piError[iTargetSPos] = xGetDist( rcOut.apiY[VIEWPOS_RIGHT][iTargetSPos] - rcOut.piYRef[iTargetSPos] );    
 #endif    
-
+    
   }
   else
   { 
 #if H_3D_VSO_COLOR_PLANES
-    riError += xGetDist( pcInSample->aiY[iSubSourcePos] - pcOutSample->iYRef,
-      pcInSample->aiU[iSubSourcePos] - pcOutSample->iURef,
-      pcInSample->aiV[iSubSourcePos] - pcOutSample->iVRef
-      );
+    riError += xGetDist( rcIn.piY[iSourceSubPos] - rcOut.piYRef[iTargetSPos],
+                         rcIn.piU[iSourceSubPos] - rcOut.piURef[iTargetSPos],
+                         rcIn.piV[iSourceSubPos] - rcOut.piVRef[iTargetSPos]
+                       );
 #else               
-    riError += xGetDist( pcInSample->aiY[iSubSourcePos] - pcOutSample->iYRef );
+    riError += xGetDist( rcIn.piY[iSourceSubPos] - rcOut.piYRef[iTargetSPos] );
 #endif
 
-    riError -= pcOutSample->iError;
+    riError -= rcOut.piError[iTargetSPos];
   }
 }
 
 template <BlenMod iBM, Bool bBitInc> template<Bool bSet> __inline Void
-TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelBlendR(RenModelInPels* pcInSample, Int iSubSourcePos, RenModelOutPels* pcOutSample, Pel iFilled, RMDist& riError )
+TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelBlendR(Int iSourceSubPos, Int iTargetSPos, Pel iFilled, RMDist& riError )
 {
+  const RenModelInPels&  rcIn  = m_acInputSamplesRow[VIEWPOS_RIGHT];
+  const RenModelOutPels& rcOut = m_cOutputSamplesRow;
+
   Pel piBlendedValueY;
 #if H_3D_VSO_COLOR_PLANES
   Pel piBlendedValueU;
@@ -1588,17 +1654,17 @@ TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelBlendR(RenModelInPels* pcInSample,
 #endif
 
   xGetBlendedValue (
-    pcOutSample->iYLeft, 
-    pcInSample ->aiY[iSubSourcePos],        
+    rcOut.apiY[VIEWPOS_LEFT][iTargetSPos],
+    rcIn .piY[iSourceSubPos],        
 #if H_3D_VSO_COLOR_PLANES
-    pcOutSample->iULeft,    
-    pcInSample ->aiU[iSubSourcePos],
-    pcOutSample->iVLeft,    
-    pcInSample ->aiV[iSubSourcePos],
-#endif
-    m_piInvZLUTLeft  [RenModRemoveBitInc(pcOutSample->iDLeft)],
-    m_piInvZLUTRight [RenModRemoveBitInc(m_iThisDepth)       ],
-    pcOutSample->iFilledLeft,
+    rcOut.apiU[VIEWPOS_LEFT][iTargetSPos],    
+    rcIn .piU[iSourceSubPos],
+    rcOut.apiV[VIEWPOS_LEFT][iTargetSPos],    
+    rcIn .piV[iSourceSubPos],
+#endif
+    m_piInvZLUTLeft  [RenModRemoveBitInc(rcOut.apiD[VIEWPOS_LEFT][iTargetSPos])],
+    m_piInvZLUTRight [RenModRemoveBitInc(m_iThisDepth)                     ],
+    rcOut.apiFilled[VIEWPOS_LEFT][iTargetSPos],
     iFilled,
     piBlendedValueY
 #if H_3D_VSO_COLOR_PLANES
@@ -1610,40 +1676,43 @@ TRenSingleModelC<iBM,bBitInc>::xSetShiftedPelBlendR(RenModelInPels* pcInSample,
   if ( bSet )
   {    
     // Set values
-    pcOutSample->iDRight     = m_iThisDepth;
-    pcOutSample->iYRight     = pcInSample ->aiY[iSubSourcePos];
-    pcOutSample->iYBlended   = piBlendedValueY;    
+    rcOut.apiD[VIEWPOS_RIGHT ][iTargetSPos] = m_iThisDepth;
+    rcOut.apiY[VIEWPOS_RIGHT ][iTargetSPos] = rcIn.piY[iSourceSubPos];
+    rcOut.apiY[VIEWPOS_MERGED][iTargetSPos] = piBlendedValueY;    
 #if H_3D_VSO_COLOR_PLANES  
-    pcOutSample->iURight     = pcInSample ->aiU[iSubSourcePos];
-    pcOutSample->iUBlended   = piBlendedValueU;    
-    pcOutSample->iVRight     = pcInSample ->aiV[iSubSourcePos];
-    pcOutSample->iVBlended   = piBlendedValueV;    
+    rcOut.apiU[VIEWPOS_RIGHT ][iTargetSPos] = rcIn.piU[iSourceSubPos];
+    rcOut.apiU[VIEWPOS_MERGED][iTargetSPos] = piBlendedValueU;    
+    rcOut.apiV[VIEWPOS_RIGHT ][iTargetSPos] = rcIn.piV[iSourceSubPos];
+    rcOut.apiV[VIEWPOS_MERGED][iTargetSPos] = piBlendedValueV;    
 #endif
-    pcOutSample->iFilledRight = iFilled;
+    rcOut.apiFilled[VIEWPOS_RIGHT][iTargetSPos] = iFilled;
 
     // Get Error
-    Int iDiffY = pcOutSample->iYRef - piBlendedValueY;
+    Int iDiffY = rcOut.piYRef[iTargetSPos] - piBlendedValueY;
 #if H_3D_VSO_COLOR_PLANES
-    Int iDiffU = pcOutSample->iURef - piBlendedValueU;
-    Int iDiffV = pcOutSample->iVRef - piBlendedValueV;
-    pcOutSample->iError  = xGetDist(iDiffY, iDiffU, iDiffV );
+    Int iDiffU = rcOut.piURef[iTargetSPos] - piBlendedValueU;
+    Int iDiffV = rcOut.piVRef[iTargetSPos] - piBlendedValueV;
+    rcOut.piError[iTargetSPos] = xGetDist(iDiffY, iDiffU, iDiffV );
 #else
-    pcOutSample->iError  = xGetDist(iDiffY );
+    rcOut.piError[iTargetSPos] = xGetDist(iDiffY );
 #endif
   }
   else
   {
-    Int iDiffY = pcOutSample->iYRef - piBlendedValueY;
+    Int iDiffY = rcOut.piYRef[iTargetSPos] - piBlendedValueY;
 #if H_3D_VSO_COLOR_PLANES
-    Int iDiffU = pcOutSample->iURef - piBlendedValueU;
-    Int iDiffV = pcOutSample->iVRef - piBlendedValueV;
-    riError   += ( xGetDist( iDiffY, iDiffU, iDiffV ) - pcOutSample->iError );
+    Int iDiffU = rcOut.piURef[iTargetSPos] - piBlendedValueU;
+    Int iDiffV = rcOut.piVRef[iTargetSPos] - piBlendedValueV;
+    riError   += ( xGetDist( iDiffY, iDiffU, iDiffV ) - rcOut.piError[iTargetSPos] );
+
 #else
-    riError   += ( xGetDist( iDiffY ) -  pcOutSample->iError  );
+    riError   += ( xGetDist( iDiffY ) - rcOut.piError[iTargetSPos] );
 #endif
+
   }
 }
 
+
 template <BlenMod iBM, Bool bBitInc> __inline Int
 TRenSingleModelC<iBM,bBitInc>::xGetDist( Int iDiffY, Int iDiffU, Int iDiffV )
 {
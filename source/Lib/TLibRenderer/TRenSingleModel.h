@@ -103,57 +103,51 @@ public:
 template < BlenMod iBM, Bool bBitInc >
 class TRenSingleModelC : public TRenSingleModel
 {
+  // The samples are kept as structure of arrays: each element has its own plane, so that a loop over a row only
+  // touches the elements it uses and can be vectorized.
+
+  // Planes of the input samples of a view, or pointers to a row of them
   struct RenModelInPels
   {
-    // video
-    Pel aiY[5]    ; // y-value
+    // video, upsampled: the value of sample iPosX at sub-sample position iSubPos is at (iPosX << m_iShiftPrec) + iSubPos
+    Pel*  piY      ; // y-value
 #if H_3D_VSO_COLOR_PLANES
-    Pel aiU[5]    ; // u-value
-    Pel aiV[5]    ; // v-value
+    Pel*  piU      ; // u-value
+    Pel*  piV      ; // v-value
 #endif
     // depth
-    Pel iD        ; // depth
+    Pel*  piD      ; // depth
 
     // state
-    Bool bOccluded; // Occluded
+    Bool* pbOccluded; // Occluded
   };
 
+  // Planes of the output samples, or pointers to a row of them
   struct RenModelOutPels
   {
-    // video
-    Pel iYLeft    ; 
-    Pel iYRight   ; 
-    Pel iYBlended ; 
+    // video, Dim1: 0->Left, 1->Right, 2->Blended
+    Pel*  apiY[3]  ;
 #if H_3D_VSO_COLOR_PLANES
-    Pel iULeft    ; 
-    Pel iURight   ; 
-    Pel iUBlended ; 
-    Pel iVLeft    ; 
-    Pel iVRight   ; 
-    Pel iVBlended ; 
+    Pel*  apiU[3]  ;
+    Pel*  apiV[3]  ;
 #endif
-    // depth
-    Pel iDLeft    ;
-    Pel iDRight   ; 
-    Pel iDBlended ; 
+    // depth, Dim1: 0->Left, 1->Right
+    Pel*  apiD[2]  ;
 
-    // state
-    Int iFilledLeft ; 
-    Int iFilledRight; 
+    // state, Dim1: 0->Left, 1->Right
+    Int*  apiFilled[2];
 
     // error
-    Int  iError   ;
+    Int*  piError  ;
 
     // reference
-    Pel iYRef    ; 
+    Pel*  piYRef   ;
 #if H_3D_VSO_COLOR_PLANES
-    Pel iURef    ; 
-    Pel iVRef    ; 
-#endif        
+    Pel*  piURef   ;
+    Pel*  piVRef   ;
+#endif
   };
 
-
-
 public:
   TRenSingleModelC();
   ~TRenSingleModelC();
@@ -205,6 +199,7 @@ private:
   template<Bool bSet> __inline RMDist xRenderR            ( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, Int iStride, const Pel* piNewData );
   template<Bool bSet> __inline RMDist xRenderL            ( Int iStartPosX, Int iStartPosY, Int iWidth, Int iHeight, Int iStride, const Pel* piNewData );
 #endif
+                      __inline Bool   xGetDirtyInterval   ( Int iCurViewPos, Int& riStartChangePos, Int& riEndChangePos );
                       __inline Void   xInitRenderPartL    ( Int iEndChangePos, Int iLastSPos  );
   template<Bool bSet> __inline Void   xRenderRangeL       ( Int iCurSPos, Int iLastSPos, Int iCurPos, RMDist& riError );
   template<Bool bSet> __inline Void   xRenderShiftedRangeL( Int iCurSPos, Int iLastSPos, Int iCurPos, RMDist& riError );
@@ -224,8 +219,6 @@ private:
                       __inline Int    xRangeRightR        ( Int iPos );
                       __inline Int    xRoundR             ( Int iPos );
 
-  // Blending
-  template<Bool bSet> __inline Void   xSetShiftedPelBlend ( Int iSourcePos, Int iTargetSPos, Pel iFilled, RMDist& riError );
 
 #if H_3D_VSO_COLOR_PLANES
   __inline Void   xGetBlendedValue    ( Pel iYL, Pel iYR, Pel iUL, Pel iUR, Pel iVL, Pel iVR, Pel iDepthL, Pel iDepthR, Int iFilledL, Int iFilledR, Pel& riY, Pel& riU, Pel&riV );
@@ -239,13 +232,14 @@ private:
   __inline Pel    xBlend              ( Pel pVal1, Pel pVal2, Int iWeightVal2 );
 
   // General
+  // the input sample is given by its position in the upsampled plane, (iSourcePos << m_iShiftPrec) + iSubSourcePos
   template<Bool bSet> __inline Void xSetShiftedPelL       (Int iSourcePos,             Int iSubSourcePos, Int iTargetSPos,              Pel iFilled, RMDist& riError );
-  template<Bool bSet> __inline Void xSetShiftedPelBlendL  (RenModelInPels* pcInSample, Int iSubSourcePos, RenModelOutPels* pcOutSample, Pel iFilled, RMDist& riError );
-  template<Bool bSet> __inline Void xSetShiftedPelNoBlendL(RenModelInPels* pcInSample, Int iSubSourcePos, RenModelOutPels* pcOutSample, Pel iFilled, RMDist& riError );
+  template<Bool bSet> __inline Void xSetShiftedPelBlendL  (Int iSourceSubPos,                             Int iTargetSPos,              Pel iFilled, RMDist& riError );
+  template<Bool bSet> __inline Void xSetShiftedPelNoBlendL(Int iSourceSubPos,                             Int iTargetSPos,              Pel iFilled, RMDist& riError );
 
   template<Bool bSet> __inline Void xSetShiftedPelR       (Int iSourcePos,             Int iSubSourcePos, Int iTargetSPos,              Pel iFilled, RMDist& riError );
-  template<Bool bSet> __inline Void xSetShiftedPelBlendR  (RenModelInPels* pcInSample, Int iSubSourcePos, RenModelOutPels* pcOutSample, Pel iFilled, RMDist& riError );
-  template<Bool bSet> __inline Void xSetShiftedPelNoBlendR(RenModelInPels* pcInSample, Int iSubSourcePos, RenModelOutPels* pcOutSample, Pel iFilled, RMDist& riError );
+  template<Bool bSet> __inline Void xSetShiftedPelBlendR  (Int iSourceSubPos,                             Int iTargetSPos,              Pel iFilled, RMDist& riError );
+  template<Bool bSet> __inline Void xSetShiftedPelNoBlendR(Int iSourceSubPos,                             Int iTargetSPos,              Pel iFilled, RMDist& riError );
 
   __inline Int    xShiftNewData      ( Int iPos, Int iPosInNewData );
   __inline Int    xShift             ( Int iPos );
@@ -258,49 +252,14 @@ private:
   __inline Void   xSetBools  ( Bool* pbSource    , Int iSourceStride, Int iWidth, Int iHeight, Bool bVal );
   __inline Void   xSetInts   ( Int*  piPelSource , Int iSourceStride, Int iWidth, Int iHeight, Int iVal );
 
-#if H_3D_VSO_COLOR_PLANES
-  Void            xGetSampleStrTextPtrs ( Int iViewNum, Pel RenModelOutPels::*& rpiSrcY, Pel RenModelOutPels::*& rpiSrcU, Pel RenModelOutPels::*& rpiSrcV );
-#else  
-  Void            xGetSampleStrTextPtrs ( Int iViewNum, Pel RenModelOutPels::*& rpiSrcY );
-#endif 
-  Void            xGetSampleStrDepthPtrs( Int iViewNum, Pel RenModelOutPels::*& rpiSrcD );
-       
+  Void            xCreateSamplePlanes          ();
+  Void            xDestroySamplePlanes         ();
   Void            xSetStructRefView            ();
   Void            xResetStructError            ();
   Void            xInitSampleStructs           ();
   Void            xSetStructSynthViewAsRefView ();
   Void            xCopy2PicYuv                ( Pel** ppiSrcVideoPel, Int* piStrides, TComPicYuv* rpcPicYuvTarget );
 
-  template< typename S, typename T> 
-  Void   xCopyFromSampleStruct ( S* ptSource , Int iSourceStride, T S::* ptSourceElement, T* ptTarget, Int iTargetStride, Int iWidth, Int iHeight )
-  {
-    AOT( iWidth != m_iWidth ); 
-    for (Int iPosY = 0; iPosY < iHeight; iPosY++)
-    {
-      for (Int iPosX = 0; iPosX < m_iWidth; iPosX++)
-      {
-        ptTarget[iPosX] = ptSource[iPosX].*ptSourceElement;
-      }
-      ptSource += iSourceStride;
-      ptTarget += iTargetStride;
-    }    
-  }  
-
-  template< typename S, typename T> 
-  Void   xCopyToSampleStruct ( T* ptSource , Int iSourceStride, S* ptTarget, Int iTargetStride, T S::* ptSourceElement, Int iWidth, Int iHeight )
-  {
-    AOT( iWidth != m_iWidth ); 
-    for (Int iPosY = 0; iPosY < iHeight; iPosY++)
-    {
-      for (Int iPosX = 0; iPosX < m_iWidth; iPosX++)
-      {
-        ptTarget[iPosX] = ptSource[iPosX].*ptSourceElement;
-      }
-      ptSource += iSourceStride;
-      ptTarget += iTargetStride;
-    }    
-  }   
-
 private:
 
   // Image sizes
@@ -314,8 +273,9 @@ private:
   Int   m_iSampledWidth;
   Int   m_iSampledStride;
 
-  RenModelInPels* m_pcInputSamples[2];
-  Int             m_iInputSamplesStride;
+  RenModelInPels  m_acInputSamples[2];
+  Int             m_iInputSamplesStride;        // stride of the depth and state planes
+  Int             m_iInputSubSamplesStride;     // stride of the upsampled video planes
 
   // Base
   Pel** m_aapiBaseVideoPel     [2]; // Dim1: ViewPosition 0->Left, 1->Right; Dim2: Plane  0-> Y, 1->U, 2->V
@@ -339,8 +299,8 @@ private:
   TComPicYuv* m_pcPicYuvRef       ;    // Reference PIcYuv
 
   //// Output Samples
-  RenModelOutPels* m_pcOutputSamples;
-  Int                   m_iOutputSamplesStride;
+  RenModelOutPels  m_cOutputSamples;
+  Int              m_iOutputSamplesStride;
 
   Pel*  m_aapiRefVideoPel      [3];    // Dim1: Plane  0-> Y, 1->U, 2->V
   Int   m_aiRefVideoStrides    [3];    // Dim1: Plane  0-> Y, 1->U, 2->V
@@ -355,6 +315,7 @@ private:
   const Pel*  m_piNewDepthData;              // Pointer to new depth data
   Int   m_iStartChangePosX;            // Start Position of new data
   Int   m_iNewDataWidth;               // Width of new data
+  Bool  m_bSkipUnchangedDepth;         // Render only the samples of a row whose depth differs from the rendered one
   Pel   m_iCurDepth;                   // Current Depth Value
   Pel   m_iLastDepth;                  // Last Depth Value
   Pel   m_iThisDepth;                  // Depth value to use for setting
@@ -376,8 +337,8 @@ private:
 
   //// Current Pointers ////
 
-  RenModelInPels*  m_pcInputSamplesRow [2];
-  RenModelOutPels* m_pcOutputSamplesRow;
+  RenModelInPels   m_acInputSamplesRow[2];
+  RenModelOutPels  m_cOutputSamplesRow;
 
   //// MISC ////
   const Int m_iDistShift;                  // Shift in Distortion computation
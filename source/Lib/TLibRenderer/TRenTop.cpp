@@ -113,7 +113,7 @@ Void TRenTop::xConvertInputVideo( PelImage* pcOrgInputImage, PelImage* pcConvInp
 
     if (uiPlane == 0)
     {
-      TRenFilter<REN_BIT_DEPTH>::sampleHorUp    ( iLog2SamplingFactor, pcOrgPlane->getPlaneData(), pcOrgPlane->getStride(), pcOrgPlane->getWidth(), pcOrgPlane->getHeight(), pcConvPlane->getPlaneData(), pcConvPlane->getStride());
+      m_fpSampleHorUp                           ( iLog2SamplingFactor, pcOrgPlane->getPlaneData(), pcOrgPlane->getStride(), pcOrgPlane->getWidth(), pcOrgPlane->getHeight(), pcConvPlane->getPlaneData(), pcConvPlane->getStride());
     }
     else
     {
@@ -146,7 +146,7 @@ Void TRenTop::xConvertInputDepth( PelImage* pcOrgInputImage, PelImage* pcConvInp
   }
   AOT( iLog2SamplingFactor > 2);
 
-  TRenFilter<REN_BIT_DEPTH>::sampleHorUp(iLog2SamplingFactor, pcOrgPlane->getPlaneData(), pcOrgPlane->getStride(), pcOrgPlane->getWidth(), pcOrgPlane->getHeight(), pcConvPlane->getPlaneData(), pcConvPlane->getStride());
+  m_fpSampleHorUp(iLog2SamplingFactor, pcOrgPlane->getPlaneData(), pcOrgPlane->getStride(), pcOrgPlane->getWidth(), pcOrgPlane->getHeight(), pcConvPlane->getPlaneData(), pcConvPlane->getStride());
 
   if ( !m_bUVUp ) //GT: depth down
   {
@@ -162,7 +162,7 @@ Void TRenTop::xConvertInputDepth( PelImage* pcOrgInputImage, PelImage* pcConvInp
     }
     else
     {
-      TRenFilter<REN_BIT_DEPTH>::sampleHorUp    ( iLog2SamplingFactor - 1, pcTempPlane->getPlaneData(), pcTempPlane->getStride(), pcTempPlane->getWidth(), pcTempPlane->getHeight(), pcConvPlane->getPlaneData(), pcConvPlane->getStride());
+      m_fpSampleHorUp                           ( iLog2SamplingFactor - 1, pcTempPlane->getPlaneData(), pcTempPlane->getStride(), pcTempPlane->getWidth(), pcTempPlane->getHeight(), pcConvPlane->getPlaneData(), pcConvPlane->getStride());
     }
     delete pcTempPlane;
   }
@@ -464,12 +464,14 @@ Void TRenTop::xShiftPlanePixelsLinInt( PelImagePlane** apcInputPlanes, PelImageP
     Int iPrevShiftedPos = -1;
     Int iShiftedPos = -1;
 
+    // compute disparities and shifts of the row
+    m_fpShiftRow( pcDepthData, 1, m_aiShiftLUTCur, 1 << m_iRelShiftLUTPrec, iWidth, m_piShiftedPos );
+
     for(Int iPosX = 0; iPosX < iWidth; iPosX ++ )
     {
       Bool bExtrapolate = false;
 
-      // compute disparity and shift
-      iShiftedPos  = ( iPosX << m_iRelShiftLUTPrec ) - m_aiShiftLUTCur[RemoveBitIncrement( pcDepthData[iPosX])];
+      iShiftedPos  = m_piShiftedPos[iPosX];
 
       if (iPosX == 0)
       {
@@ -802,10 +804,12 @@ Void TRenTop::xShiftPlanePixelsFullPel( PelImagePlane** apcInputPlanes, PelImage
   {
     Int iPrevShiftedPos = -1;
 
+    m_fpShiftRow( pcDepthData, 1, m_aiShiftLUTCur, 1, iWidth, m_piShiftedPos );
+
     for(Int iPosX = 0; iPosX < iWidth; iPosX++)
     {
       assert( RemoveBitIncrement(pcDepthData[iPosX]) >= 0 && RemoveBitIncrement(pcDepthData[iPosX]) <= 256 );
-      Int iShiftedPos = iPosX - m_aiShiftLUTCur[ RemoveBitIncrement(pcDepthData[iPosX])] ;
+      Int iShiftedPos = m_piShiftedPos[iPosX];
       if (iShiftedPos < iWidth && iShiftedPos >= 0)
       {
         Int iDiff = iShiftedPos - iPrevShiftedPos;
@@ -877,24 +881,18 @@ Void TRenTop::xBackShiftPlanePixels( PelImagePlane** apcInputPlanes, PelImagePla
 
   for(Int iPosY = 0; iPosY < iHeight; iPosY++)
   {
+    m_fpShiftRow( pcDepthData, 1, m_aiShiftLUTCur, 1 << m_iRelShiftLUTPrec, iOutputWidth, m_piShiftedPos );
+
+    // samples outside the input or at positions not filled are set to zero and marked as holes
+    for( UInt uiCurPlane = 0; uiCurPlane < uiNumberOfPlanes; uiCurPlane++)
+    {
+      m_fpBackShiftRow( apcInputData[uiCurPlane], iInputWidth, m_piShiftedPos, pcFilledData, iOutputWidth, apcOutputData[uiCurPlane] );
+    }
+
     for(Int iPosX = 0; iPosX < iOutputWidth; iPosX ++)
     {
-      Int iBackShiftedPos = (iPosX << m_iRelShiftLUTPrec) - m_aiShiftLUTCur[ RemoveBitIncrement( pcDepthData[iPosX] )];
-      if( ( pcFilledData[iPosX] == REN_IS_FILLED )  && (iBackShiftedPos >= 0 ) && ( iBackShiftedPos < iInputWidth ) )
-      {
-        for( UInt uiCurPlane = 0; uiCurPlane < uiNumberOfPlanes; uiCurPlane++)
-        {
-          apcOutputData[uiCurPlane][iPosX] = apcInputData[uiCurPlane][iBackShiftedPos];
-        }
-      }
-      else
-      {
-        for( UInt uiCurPlane = 0; uiCurPlane < uiNumberOfPlanes; uiCurPlane++)
-        {
-          apcOutputData[uiCurPlane][iPosX] = 0;
-        }
-        pcFilledData[iPosX] = REN_IS_HOLE;
-      }
+      Int iBackShiftedPos = m_piShiftedPos[iPosX];
+      pcFilledData[iPosX] = ( pcFilledData[iPosX] == REN_IS_FILLED && iBackShiftedPos >= 0 && iBackShiftedPos < iInputWidth ) ? REN_IS_FILLED : REN_IS_HOLE;
     }
 
     for( UInt uiCurPlane = 0; uiCurPlane < uiNumberOfPlanes; uiCurPlane++)
@@ -949,10 +947,12 @@ Void TRenTop::xShiftPlanePixels8Tap( PelImagePlane** apcInputPlanes, PelImagePla
     Int iPrevShiftedPos = -1;
     Int iShiftedPos     = -1;
 
+    // compute disparities and shifts of the full sample positions of the row
+    m_fpShiftRow( pcDepthData, iStep, m_aiShiftLUTCur, iStep, iOutputWidth, m_piShiftedPos );
+
     for(Int iPosX = 0; iPosX < iInputWidth; iPosX += iStep )
     {
-      // compute disparity and shift
-      iShiftedPos  =  iPosX - m_aiShiftLUTCur[RemoveBitIncrement(pcDepthData[iPosX])];
+      iShiftedPos  = m_piShiftedPos[ iPosX >> m_iRelShiftLUTPrec ];
 
       if ( iPosX == 0 )
       {
@@ -968,15 +968,10 @@ Void TRenTop::xShiftPlanePixels8Tap( PelImagePlane** apcInputPlanes, PelImagePla
 
       Int iInterPolPos;
       if ( !bDisocclusion && !bOcclusion )
-      {  // Interpolate between previous shifted pos and shifted pos
-        for (iInterPolPos = xCeil( iPrevShiftedPos ); iInterPolPos <= xCeil (iShiftedPos ) -1 ; iInterPolPos++)
+      {  // Interpolate between previous shifted pos and shifted pos, positions outside the frame are skipped
+        Int iInterPolEnd = std::min( xCeil( iShiftedPos ) - 1, iOutputWidth - 1 );
+        for (iInterPolPos = std::max( xCeil( iPrevShiftedPos ), 0 ); iInterPolPos <= iInterPolEnd; iInterPolPos++)
         {
-          if ( (iInterPolPos < (Int) 0) || (iInterPolPos >= iOutputWidth))
-          {
-            // skip Interpolation if Interpolation position is outside frame
-            continue;
-          };
-
           // Interpolate
           Int iDeltaCurPos  = (iInterPolPos << m_iRelShiftLUTPrec) - iPrevShiftedPos;
 
@@ -2076,6 +2071,65 @@ TRenTop::TRenTop()
 
   //Temporal Filter
   m_aiBlkMoving        = 0;
+
+  // Row kernels
+  m_piShiftedPos       = 0;
+  xInitKernels();
+#if RENDERER_SIMD && SIMD_X86
+  // the vectorized kernels are only used if they give the same results as the scalar ones
+  static const Bool bSimdChecked = xCheckSimdKernels();
+  if ( bSimdChecked )
+  {
+    xGetSimdKernels( getSimdExtension(), m_fpShiftRow, m_fpBackShiftRow, m_fpSampleHorUp );
+  }
+#endif
+}
+
+#if RENDERER_SIMD && SIMD_X86
+/**
+ * \brief Use the row kernels of a SIMD extension
+ *
+ * \param eExtension  SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE selects the scalar kernels
+ */
+Void TRenTop::setSimdExtension( SimdExtension eExtension )
+{
+  xInitKernels();
+  xGetSimdKernels( eExtension, m_fpShiftRow, m_fpBackShiftRow, m_fpSampleHorUp );
+}
+#endif
+
+Void TRenTop::xInitKernels()
+{
+  m_fpShiftRow     = xShiftRow;
+  m_fpBackShiftRow = xBackShiftRow;
+  m_fpSampleHorUp  = TRenFilter<REN_BIT_DEPTH>::sampleHorUp;
+}
+
+/**
+ * \brief Shifted positions of the samples of a row
+ *
+ * piShiftedPos[i] = i * iPosStep - piShiftLUT[ depth of sample i * iDepthStep ]
+ */
+Void TRenTop::xShiftRow( const Pel* piDepth, Int iDepthStep, const Int* piShiftLUT, Int iPosStep, Int iNum, Int* piShiftedPos )
+{
+  for ( Int i = 0; i < iNum; i++ )
+  {
+    piShiftedPos[i] = i * iPosStep - piShiftLUT[ RemoveBitIncrement( piDepth[ i * iDepthStep ] ) ];
+  }
+}
+
+/**
+ * \brief Fetch a row of samples from back shifted positions
+ *
+ * Samples not filled or shifted outside [0, iSrcWidth) are set to zero.
+ */
+Void TRenTop::xBackShiftRow( const Pel* piSrc, Int iSrcWidth, const Int* piPos, const Pel* piFilled, Int iWidth, Pel* piDst )
+{
+  for ( Int iPosX = 0; iPosX < iWidth; iPosX++ )
+  {
+    Int iPos = piPos[iPosX];
+    piDst[iPosX] = ( piFilled[iPosX] == REN_IS_FILLED && iPos >= 0 && iPos < iSrcWidth ) ? piSrc[iPos] : 0;
+  }
 }
 
 
@@ -2141,6 +2195,9 @@ Void TRenTop::init(UInt uiImageWidth,
   m_auiInputResolution[0] = uiImageWidth;
   m_auiInputResolution[1] = uiImageHeight;
 
+  // rows of the shifted planes have at most the width of the up sampled image
+  m_piShiftedPos = new Int[ m_auiInputResolution[0] << m_iLog2SamplingFactor ];
+
   if ( m_bExtrapolate )
   {
     PelImage*    pcDump        = 0;
@@ -2231,6 +2288,8 @@ TRenTop::~TRenTop()
 
   // Zheijang temporal filter
   if(m_aiBlkMoving         != NULL ) delete[] m_aiBlkMoving;
+
+  if(m_piShiftedPos        != NULL ) delete[] m_piShiftedPos;
 }
 #endif // NH_3D
 
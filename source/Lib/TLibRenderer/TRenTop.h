@@ -37,6 +37,9 @@
 #include "TRenImage.h"
 #include "../TLibCommon/CommonDef.h"
 #include "../TLibCommon/TComPicYuv.h"
+#if RENDERER_SIMD && SIMD_X86
+#include "../TLibCommon/TComSimd.h"
+#endif
 
 #if NH_3D_VSO
 #include <list>
@@ -120,7 +123,25 @@ public:
                            TComPicYuv* pcPicYuvDepthLast,
                            Bool bFirstFrame );
 
+#if RENDERER_SIMD && SIMD_X86
+  Void setSimdExtension  ( SimdExtension eExtension ); ///< use the row kernels of an extension, SIMD_NONE for the scalar ones
+#endif
+
 private:
+  // Row kernels
+  typedef Void (*FpShiftRow)     ( const Pel* piDepth, Int iDepthStep, const Int* piShiftLUT, Int iPosStep, Int iNum, Int* piShiftedPos );
+  typedef Void (*FpBackShiftRow) ( const Pel* piSrc, Int iSrcWidth, const Int* piPos, const Pel* piFilled, Int iWidth, Pel* piDst );
+  typedef Void (*FpSampleHorUp)  ( Int iLog2HorSampFac, Pel* pcInputPlaneData, Int iInputStride, Int iInputWidth, Int iHeight, Pel* pcOutputPlaneData, Int iOutputStride );
+
+  static Void xShiftRow          ( const Pel* piDepth, Int iDepthStep, const Int* piShiftLUT, Int iPosStep, Int iNum, Int* piShiftedPos );
+  static Void xBackShiftRow      ( const Pel* piSrc, Int iSrcWidth, const Int* piPos, const Pel* piFilled, Int iWidth, Pel* piDst );
+
+  Void xInitKernels              ();
+#if RENDERER_SIMD && SIMD_X86
+  static Void xGetSimdKernels    ( SimdExtension eExtension, FpShiftRow& rpfShiftRow, FpBackShiftRow& rpfBackShiftRow, FpSampleHorUp& rpfSampleHorUp );
+  static Bool xCheckSimdKernels  ();
+#endif
+
   // Depth PreProcessing
   Void xPreProcessDepth(PelImage* pcInImage, PelImage* pcOutImage);
 
@@ -238,6 +259,12 @@ private:
   // Look up tables sub pel shift
   Int**    m_aaiSubPelShift;
 
+  // Row kernels, scalar or vectorized
+  FpShiftRow     m_fpShiftRow;       // shifted positions of the samples of a row
+  FpBackShiftRow m_fpBackShiftRow;   // samples of a plane row fetched from back shifted positions
+  FpSampleHorUp  m_fpSampleHorUp;    // horizontal up sampling of luma and depth
+  Int*           m_piShiftedPos;     // shifted positions of the current row
+
    // Zhejiang Temporal Improvement
   Int*    m_aiBlkMoving;
 
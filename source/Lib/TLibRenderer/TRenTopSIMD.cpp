@@ -0,0 +1,460 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TRenTopSIMD.cpp
+    \brief    SSE4.1 and AVX2 implementations of the row kernels of TRenTop
+
+    The shifted positions of a row are computed with gathers from the depth row and the shift LUT, the back shift
+    fetches the samples of a row with a masked gather. Both need AVX2. The horizontal up sampling computes the
+    quarter and half sample positions of 8 (SSE4.1) or 16 (AVX2) full sample positions with the 8 tap filters of
+    TRenInterpFilter and interleaves them with the full samples. All results are identical to the scalar kernels.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "TRenTop.h"
+#include "TRenFilter.h"
+
+#if RENDERER_SIMD && SIMD_X86
+
+#include <immintrin.h>
+
+//! \ingroup TLibRenderer
+//! \{
+
+// ====================================================================================================================
+// Horizontal up sampling
+// ====================================================================================================================
+
+// 8 tap filters of the quarter, half and three quarter positions, as in TRenInterpFilter
+static const Short s_aaiUpFilter[3][8] =
+{
+  { -1, 4, -10, 57, 19,  -7, 3, -1 },
+  { -1, 4, -11, 40, 40, -11, 4, -1 },
+  { -1, 3,  -7, 19, 57, -10, 4, -1 }
+};
+
+/// filtered sample between pcSrc[0] and pcSrc[1], clipped like TRenInterpFilter::xClipY
+static inline Pel xFiltUp( const Pel* pcSrc, const Short* piCoeff )
+{
+  Int iSum = 0;
+  for ( Int k = 0; k < 8; k++ )
+  {
+    iSum += piCoeff[k] * pcSrc[k - 3];
+  }
+  Pel cVal = (Pel) ( ( iSum + 32 ) >> 6 );
+  return std::min<Pel>( Pel( ( 1 << REN_BIT_DEPTH ) - 1 ), std::max<Pel>( Pel( 0 ), cVal ) );
+}
+
+/// scalar up sampling of the positions iStart to iWidth - 1 of a row
+static inline Void xSampleHorUpRow( Int iLog2HorSampFac, const Pel* pcSrc, Int iStart, Int iWidth, Pel* pcDst )
+{
+  for ( Int x = iStart; x < iWidth; x++ )
+  {
+    if ( iLog2HorSampFac == 1 )
+    {
+      pcDst[2 * x    ] = pcSrc[x];
+      pcDst[2 * x + 1] = xFiltUp( pcSrc + x, s_aaiUpFilter[1] );
+    }
+    else
+    {
+      pcDst[4 * x    ] = pcSrc[x];
+      pcDst[4 * x + 1] = xFiltUp( pcSrc + x, s_aaiUpFilter[0] );
+      pcDst[4 * x + 2] = xFiltUp( pcSrc + x, s_aaiUpFilter[1] );
+      pcDst[4 * x + 3] = xFiltUp( pcSrc + x, s_aaiUpFilter[2] );
+    }
+  }
+}
+
+/// tap pair ( k, k + 1 ) of a filter, for madd with interleaved samples
+static inline Int xTapPair( const Short* piCoeff, Int k )
+{
+  return ( piCoeff[k] & 0xffff ) | ( piCoeff[k + 1] << 16 );
+}
+
+static inline SIMD_TARGET_SSE41 __m128i xFiltUpSse41( const __m128i* pvLo, const __m128i* pvHi, const Short* piCoeff )
+{
+  __m128i vSumLo = _mm_set1_epi32( 32 );
+  __m128i vSumHi = vSumLo;
+  for ( Int k = 0; k < 4; k++ )
+  {
+    __m128i vTaps = _mm_set1_epi32( xTapPair( piCoeff, 2 * k ) );
+    vSumLo = _mm_add_epi32( vSumLo, _mm_madd_epi16( pvLo[k], vTaps ) );
+    vSumHi = _mm_add_epi32( vSumHi, _mm_madd_epi16( pvHi[k], vTaps ) );
+  }
+  // truncate to Pel before the clipping, like the scalar filter
+  vSumLo = _mm_srai_epi32( _mm_slli_epi32( _mm_srai_epi32( vSumLo, 6 ), 16 ), 16 );
+  vSumHi = _mm_srai_epi32( _mm_slli_epi32( _mm_srai_epi32( vSumHi, 6 ), 16 ), 16 );
+  __m128i vVal = _mm_packs_epi32( vSumLo, vSumHi );
+  return _mm_min_epi16( _mm_max_epi16( vVal, _mm_setzero_si128() ), _mm_set1_epi16( ( 1 << REN_BIT_DEPTH ) - 1 ) );
+}
+
+static SIMD_TARGET_SSE41 Void xSampleHorUpSse41( Int iLog2HorSampFac, Pel* pcInputPlaneData, Int iInputStride, Int iInputWidth, Int iHeight, Pel* pcOutputPlaneData, Int iOutputStride )
+{
+  if ( iLog2HorSampFac != 1 && iLog2HorSampFac != 2 )
+  {
+    TRenFilter<REN_BIT_DEPTH>::sampleHorUp( iLog2HorSampFac, pcInputPlaneData, iInputStride, iInputWidth, iHeight, pcOutputPlaneData, iOutputStride );
+    return;
+  }
+
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    const Pel* pcSrc = pcInputPlaneData + y * iInputStride;
+    Pel*       pcDst = pcOutputPlaneData + y * iOutputStride;
+    Int        x     = 0;
+
+    // the scalar filters read 3 samples left and 4 samples right of a row, so do the vectors
+    for ( ; x + 8 <= iInputWidth; x += 8 )
+    {
+      __m128i avSrc[8];
+      for ( Int k = 0; k < 8; k++ )
+      {
+        avSrc[k] = _mm_loadu_si128( (const __m128i*) ( pcSrc + x - 3 + k ) );
+      }
+      __m128i avLo[4], avHi[4];
+      for ( Int k = 0; k < 4; k++ )
+      {
+        avLo[k] = _mm_unpacklo_epi16( avSrc[2 * k], avSrc[2 * k + 1] );
+        avHi[k] = _mm_unpackhi_epi16( avSrc[2 * k], avSrc[2 * k + 1] );
+      }
+
+      __m128i vFull = avSrc[3];
+      __m128i vHalf = xFiltUpSse41( avLo, avHi, s_aaiUpFilter[1] );
+
+      if ( iLog2HorSampFac == 1 )
+      {
+        _mm_storeu_si128( (__m128i*) ( pcDst + 2 * x     ), _mm_unpacklo_epi16( vFull, vHalf ) );
+        _mm_storeu_si128( (__m128i*) ( pcDst + 2 * x + 8 ), _mm_unpackhi_epi16( vFull, vHalf ) );
+      }
+      else
+      {
+        __m128i vQuarter0 = xFiltUpSse41( avLo, avHi, s_aaiUpFilter[0] );
+        __m128i vQuarter1 = xFiltUpSse41( avLo, avHi, s_aaiUpFilter[2] );
+        __m128i vFQLo     = _mm_unpacklo_epi16( vFull, vQuarter0 );
+        __m128i vFQHi     = _mm_unpackhi_epi16( vFull, vQuarter0 );
+        __m128i vHQLo     = _mm_unpacklo_epi16( vHalf, vQuarter1 );
+        __m128i vHQHi     = _mm_unpackhi_epi16( vHalf, vQuarter1 );
+        _mm_storeu_si128( (__m128i*) ( pcDst + 4 * x      ), _mm_unpacklo_epi32( vFQLo, vHQLo ) );
+        _mm_storeu_si128( (__m128i*) ( pcDst + 4 * x +  8 ), _mm_unpackhi_epi32( vFQLo, vHQLo ) );
+        _mm_storeu_si128( (__m128i*) ( pcDst + 4 * x + 16 ), _mm_unpacklo_epi32( vFQHi, vHQHi ) );
+        _mm_storeu_si128( (__m128i*) ( pcDst + 4 * x + 24 ), _mm_unpackhi_epi32( vFQHi, vHQHi ) );
+      }
+    }
+    xSampleHorUpRow( iLog2HorSampFac, pcSrc, x, iInputWidth, pcDst );
+  }
+}
+
+static inline SIMD_TARGET_AVX2 __m256i xFiltUpAvx2( const __m256i* pvLo, const __m256i* pvHi, const Short* piCoeff )
+{
+  __m256i vSumLo = _mm256_set1_epi32( 32 );
+  __m256i vSumHi = vSumLo;
+  for ( Int k = 0; k < 4; k++ )
+  {
+    __m256i vTaps = _mm256_set1_epi32( xTapPair( piCoeff, 2 * k ) );
+    vSumLo = _mm256_add_epi32( vSumLo, _mm256_madd_epi16( pvLo[k], vTaps ) );
+    vSumHi = _mm256_add_epi32( vSumHi, _mm256_madd_epi16( pvHi[k], vTaps ) );
+  }
+  vSumLo = _mm256_srai_epi32( _mm256_slli_epi32( _mm256_srai_epi32( vSumLo, 6 ), 16 ), 16 );
+  vSumHi = _mm256_srai_epi32( _mm256_slli_epi32( _mm256_srai_epi32( vSumHi, 6 ), 16 ), 16 );
+  // unpacking and packing within the 128 bit lanes keeps the order of the samples
+  __m256i vVal = _mm256_packs_epi32( vSumLo, vSumHi );
+  return _mm256_min_epi16( _mm256_max_epi16( vVal, _mm256_setzero_si256() ), _mm256_set1_epi16( ( 1 << REN_BIT_DEPTH ) - 1 ) );
+}
+
+static SIMD_TARGET_AVX2 Void xSampleHorUpAvx2( Int iLog2HorSampFac, Pel* pcInputPlaneData, Int iInputStride, Int iInputWidth, Int iHeight, Pel* pcOutputPlaneData, Int iOutputStride )
+{
+  if ( iLog2HorSampFac != 1 && iLog2HorSampFac != 2 )
+  {
+    TRenFilter<REN_BIT_DEPTH>::sampleHorUp( iLog2HorSampFac, pcInputPlaneData, iInputStride, iInputWidth, iHeight, pcOutputPlaneData, iOutputStride );
+    return;
+  }
+
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    const Pel* pcSrc = pcInputPlaneData + y * iInputStride;
+    Pel*       pcDst = pcOutputPlaneData + y * iOutputStride;
+    Int        x     = 0;
+
+    for ( ; x + 16 <= iInputWidth; x += 16 )
+    {
+      __m256i avSrc[8];
+      for ( Int k = 0; k < 8; k++ )
+      {
+        avSrc[k] = _mm256_loadu_si256( (const __m256i*) ( pcSrc + x - 3 + k ) );
+      }
+      __m256i avLo[4], avHi[4];
+      for ( Int k = 0; k < 4; k++ )
+      {
+        avLo[k] = _mm256_unpacklo_epi16( avSrc[2 * k], avSrc[2 * k + 1] );
+        avHi[k] = _mm256_unpackhi_epi16( avSrc[2 * k], avSrc[2 * k + 1] );
+      }
+
+      __m256i vFull = avSrc[3];
+      __m256i vHalf = xFiltUpAvx2( avLo, avHi, s_aaiUpFilter[1] );
+
+      if ( iLog2HorSampFac == 1 )
+      {
+        // lanes hold positions x..x+3 | x+8..x+11 (lo) and x+4..x+7 | x+12..x+15 (hi)
+        __m256i vLo = _mm256_unpacklo_epi16( vFull, vHalf );
+        __m256i vHi = _mm256_unpackhi_epi16( vFull, vHalf );
+        _mm256_storeu_si256( (__m256i*) ( pcDst + 2 * x      ), _mm256_permute2x128_si256( vLo, vHi, 0x20 ) );
+        _mm256_storeu_si256( (__m256i*) ( pcDst + 2 * x + 16 ), _mm256_permute2x128_si256( vLo, vHi, 0x31 ) );
+      }
+      else
+      {
+        __m256i vQuarter0 = xFiltUpAvx2( avLo, avHi, s_aaiUpFilter[0] );
+        __m256i vQuarter1 = xFiltUpAvx2( avLo, avHi, s_aaiUpFilter[2] );
+        __m256i vFQLo     = _mm256_unpacklo_epi16( vFull, vQuarter0 );
+        __m256i vFQHi     = _mm256_unpackhi_epi16( vFull, vQuarter0 );
+        __m256i vHQLo     = _mm256_unpacklo_epi16( vHalf, vQuarter1 );
+        __m256i vHQHi     = _mm256_unpackhi_epi16( vHalf, vQuarter1 );
+        // each lane holds two positions: x, x+1 | x+8, x+9 and so on
+        __m256i vOut0     = _mm256_unpacklo_epi32( vFQLo, vHQLo );
+        __m256i vOut1     = _mm256_unpackhi_epi32( vFQLo, vHQLo );
+        __m256i vOut2     = _mm256_unpacklo_epi32( vFQHi, vHQHi );
+        __m256i vOut3     = _mm256_unpackhi_epi32( vFQHi, vHQHi );
+        _mm256_storeu_si256( (__m256i*) ( pcDst + 4 * x      ), _mm256_permute2x128_si256( vOut0, vOut1, 0x20 ) );
+        _mm256_storeu_si256( (__m256i*) ( pcDst + 4 * x + 16 ), _mm256_permute2x128_si256( vOut2, vOut3, 0x20 ) );
+        _mm256_storeu_si256( (__m256i*) ( pcDst + 4 * x + 32 ), _mm256_permute2x128_si256( vOut0, vOut1, 0x31 ) );
+        _mm256_storeu_si256( (__m256i*) ( pcDst + 4 * x + 48 ), _mm256_permute2x128_si256( vOut2, vOut3, 0x31 ) );
+      }
+    }
+    xSampleHorUpRow( iLog2HorSampFac, pcSrc, x, iInputWidth, pcDst );
+  }
+}
+
+// ====================================================================================================================
+// Shifted positions and back shift
+// ====================================================================================================================
+
+static SIMD_TARGET_AVX2 Void xShiftRowAvx2( const Pel* piDepth, Int iDepthStep, const Int* piShiftLUT, Int iPosStep, Int iNum, Int* piShiftedPos )
+{
+  const __m256i vIdx     = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+  const __m256i vDepthOf = _mm256_mullo_epi32( vIdx, _mm256_set1_epi32( iDepthStep ) );
+  const __m256i vPosInc  = _mm256_set1_epi32( 8 * iPosStep );
+  __m256i       vPos     = _mm256_mullo_epi32( vIdx, _mm256_set1_epi32( iPosStep ) );
+  Int           i        = 0;
+
+  for ( ; i + 8 <= iNum; i += 8 )
+  {
+    const Pel* piDepthCur = piDepth + i * iDepthStep;
+    __m256i    vDepth;
+    if ( iDepthStep == 1 )
+    {
+      vDepth = _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i*) piDepthCur ) );
+    }
+    else
+    {
+      // the gather reads the depth sample and the next one of the row, the upper one is discarded
+      vDepth = _mm256_i32gather_epi32( (const int*) piDepthCur, vDepthOf, 2 );
+      vDepth = _mm256_srai_epi32( _mm256_slli_epi32( vDepth, 16 ), 16 );
+    }
+    vDepth = _mm256_srai_epi32( vDepth, REN_BIT_DEPTH - 8 );
+
+    __m256i vShift = _mm256_i32gather_epi32( (const int*) piShiftLUT, vDepth, 4 );
+    _mm256_storeu_si256( (__m256i*) ( piShiftedPos + i ), _mm256_sub_epi32( vPos, vShift ) );
+    vPos = _mm256_add_epi32( vPos, vPosInc );
+  }
+
+  for ( ; i < iNum; i++ )
+  {
+    piShiftedPos[i] = i * iPosStep - piShiftLUT[ RemoveBitIncrement( piDepth[ i * iDepthStep ] ) ];
+  }
+}
+
+static SIMD_TARGET_AVX2 Void xBackShiftRowAvx2( const Pel* piSrc, Int iSrcWidth, const Int* piPos, const Pel* piFilled, Int iWidth, Pel* piDst )
+{
+  const __m256i vFilled  = _mm256_set1_epi32( REN_IS_FILLED );
+  const __m256i vMinus1  = _mm256_set1_epi32( -1 );
+  const __m256i vWidth   = _mm256_set1_epi32( iSrcWidth );
+  const __m256i vLast    = _mm256_set1_epi32( iSrcWidth - 1 );
+  Int           x        = 0;
+
+  for ( ; x + 8 <= iWidth; x += 8 )
+  {
+    __m256i vPos   = _mm256_loadu_si256( (const __m256i*) ( piPos + x ) );
+    __m256i vFill  = _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i*) ( piFilled + x ) ) );
+    __m256i vValid = _mm256_and_si256( _mm256_cmpeq_epi32( vFill, vFilled ),
+                     _mm256_and_si256( _mm256_cmpgt_epi32( vPos, vMinus1 ), _mm256_cmpgt_epi32( vWidth, vPos ) ) );
+
+    // a gather reads two samples, the one at the last position of the row is fetched as the upper one of its left pair
+    __m256i vAtLast = _mm256_cmpeq_epi32( vPos, vLast );
+    __m256i vIdx    = _mm256_add_epi32( vPos, vAtLast );
+    __m256i vPair   = _mm256_mask_i32gather_epi32( _mm256_setzero_si256(), (const int*) piSrc, vIdx, vValid, 2 );
+    __m256i vVal    = _mm256_blendv_epi8( _mm256_srai_epi32( _mm256_slli_epi32( vPair, 16 ), 16 ), _mm256_srai_epi32( vPair, 16 ), vAtLast );
+
+    vVal = _mm256_permute4x64_epi64( _mm256_packs_epi32( vVal, vVal ), 0x08 );
+    _mm_storeu_si128( (__m128i*) ( piDst + x ), _mm256_castsi256_si128( vVal ) );
+  }
+
+  for ( ; x < iWidth; x++ )
+  {
+    Int iPos = piPos[x];
+    piDst[x] = ( piFilled[x] == REN_IS_FILLED && iPos >= 0 && iPos < iSrcWidth ) ? piSrc[iPos] : 0;
+  }
+}
+
+// ====================================================================================================================
+// Dispatch and self test
+// ====================================================================================================================
+
+/**
+ * \brief Replace the scalar row kernels by the vectorized ones of an extension
+ *
+ * \param eExtension       SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE keeps the current functions
+ * \param rpfShiftRow      shifted positions of a row, vectorized with AVX2
+ * \param rpfBackShiftRow  back shift of a row, vectorized with AVX2
+ * \param rpfSampleHorUp   horizontal up sampling, vectorized with SSE4.1 and AVX2
+ */
+Void TRenTop::xGetSimdKernels( SimdExtension eExtension, FpShiftRow& rpfShiftRow, FpBackShiftRow& rpfBackShiftRow, FpSampleHorUp& rpfSampleHorUp )
+{
+  if ( eExtension >= SIMD_SSE41 )
+  {
+    rpfSampleHorUp  = xSampleHorUpSse41;
+  }
+  // the position kernels are gathers, SSE4.1 has none
+  if ( eExtension >= SIMD_AVX2 )
+  {
+    rpfShiftRow     = xShiftRowAvx2;
+    rpfBackShiftRow = xBackShiftRowAvx2;
+    rpfSampleHorUp  = xSampleHorUpAvx2;
+  }
+}
+
+static UInt xGetTestRand(UInt& ruiSeed)
+{
+  ruiSeed = ruiSeed * 1103515245 + 12345;
+  return ( ruiSeed >> 8 );
+}
+
+/**
+ * \brief Compare the vectorized row kernels of all extensions supported by the CPU with the scalar ones
+ *
+ * Rows of random length are tested with random depths, shifts and fill states. The back shifted positions include
+ * the first and the last sample of the source row and positions just outside of it, the source rows are allocated
+ * without margin. Returns true if all outputs are identical.
+ */
+Bool TRenTop::xCheckSimdKernels()
+{
+  const Int iMaxWidth = 100;
+  const Int iMargin   = 4;
+  const Int iHeight   = 2;
+
+  Int  aiShiftLUT  [ 256 ];
+  Pel  acDepth     [ iMaxWidth * 4 ];
+  Int  aiPosRef    [ iMaxWidth ];
+  Int  aiPosVec    [ iMaxWidth ];
+  Pel  acFilled    [ iMaxWidth ];
+  Pel  acDstRef    [ iMaxWidth ];
+  Pel  acDstVec    [ iMaxWidth ];
+  Pel  acUpSrc     [ ( iMaxWidth + 2 * iMargin ) * iHeight ];
+  Pel  acUpDstRef  [ iMaxWidth * 4 * iHeight ];
+  Pel  acUpDstVec  [ iMaxWidth * 4 * iHeight ];
+  UInt uiSeed = 1;
+
+  for ( Int iExtension = SIMD_SSE41; iExtension <= getSimdExtension(); iExtension++ )
+  {
+    FpShiftRow     pfShiftRow     = xShiftRow;
+    FpBackShiftRow pfBackShiftRow = xBackShiftRow;
+    FpSampleHorUp  pfSampleHorUp  = TRenFilter<REN_BIT_DEPTH>::sampleHorUp;
+    xGetSimdKernels( SimdExtension( iExtension ), pfShiftRow, pfBackShiftRow, pfSampleHorUp );
+
+    for ( Int iTest = 0; iTest < 256; iTest++ )
+    {
+      const Int iWidth     = 1 + xGetTestRand( uiSeed ) % iMaxWidth;
+      const Int iStep      = 1 << ( iTest & 3 ) % 3;
+      const Int iNum       = std::max( 1, iWidth / iStep );
+
+      for ( Int i = 0; i < 256; i++ )
+      {
+        aiShiftLUT[i] = Int( xGetTestRand( uiSeed ) % 1024 ) - 512;
+      }
+      for ( Int i = 0; i < iMaxWidth * 4; i++ )
+      {
+        acDepth[i] = Pel( xGetTestRand( uiSeed ) & 255 );
+      }
+
+      xShiftRow ( acDepth, iStep, aiShiftLUT, iStep, iNum, aiPosRef );
+      pfShiftRow( acDepth, iStep, aiShiftLUT, iStep, iNum, aiPosVec );
+      if ( memcmp( aiPosRef, aiPosVec, iNum * sizeof( Int ) ) )
+      {
+        printf( "\nWarning: vectorized shifted positions of the renderer differ from the scalar ones, the scalar row kernels are used\n" );
+        return false;
+      }
+
+      // exact size source row to catch reads beyond its end
+      Pel* pcSrc = new Pel[ iWidth ];
+      for ( Int i = 0; i < iWidth; i++ )
+      {
+        pcSrc[i] = Pel( xGetTestRand( uiSeed ) & 255 );
+      }
+      for ( Int i = 0; i < iMaxWidth; i++ )
+      {
+        const Int aiEdgePos[4] = { -1, 0, iWidth - 1, iWidth };
+        UInt uiRand = xGetTestRand( uiSeed );
+        aiPosRef[i] = ( uiRand & 1 ) ? aiEdgePos[ ( uiRand >> 1 ) & 3 ] : Int( ( uiRand >> 3 ) % ( iWidth + 4 ) ) - 2;
+        acFilled[i] = ( uiRand & 0x400 ) ? REN_IS_HOLE : REN_IS_FILLED;
+      }
+      xBackShiftRow ( pcSrc, iWidth, aiPosRef, acFilled, iMaxWidth, acDstRef );
+      pfBackShiftRow( pcSrc, iWidth, aiPosRef, acFilled, iMaxWidth, acDstVec );
+      delete[] pcSrc;
+      if ( memcmp( acDstRef, acDstVec, sizeof( acDstRef ) ) )
+      {
+        printf( "\nWarning: vectorized back shift of the renderer differs from the scalar one, the scalar row kernels are used\n" );
+        return false;
+      }
+
+      const Int iLog2HorSampFac = 1 + ( iTest & 1 );
+      const Int iUpStride       = iWidth + 2 * iMargin;
+      for ( Int i = 0; i < iUpStride * iHeight; i++ )
+      {
+        acUpSrc[i] = Pel( xGetTestRand( uiSeed ) & 255 );
+      }
+      memset( acUpDstRef, 0, sizeof( acUpDstRef ) );
+      memset( acUpDstVec, 0, sizeof( acUpDstVec ) );
+      TRenFilter<REN_BIT_DEPTH>::sampleHorUp( iLog2HorSampFac, acUpSrc + iMargin, iUpStride, iWidth, iHeight, acUpDstRef, iWidth * 4 );
+      pfSampleHorUp                         ( iLog2HorSampFac, acUpSrc + iMargin, iUpStride, iWidth, iHeight, acUpDstVec, iWidth * 4 );
+      if ( memcmp( acUpDstRef, acUpDstVec, sizeof( acUpDstRef ) ) )
+      {
+        printf( "\nWarning: vectorized horizontal up sampling of the renderer differs from the scalar one, the scalar row kernels are used\n" );
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+//! \}
+
+#endif // RENDERER_SIMD && SIMD_X86
@@ -45,6 +45,10 @@
 
 #include "TLibCommon/TComRom.h"
 #include "TVideoIOYuv.h"
+#if YUV_INPUT_MMAP && !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -52,6 +56,79 @@ using namespace std;
 // Local Functions
 // ====================================================================================================================
 
+static Void
+copyPlane(const TComPicYuv &src, const ComponentID srcPlane, TComPicYuv &dest, const ComponentID destPlane);
+
+#if YUV_INPUT_MMAP && !defined(_WIN32)
+/**
+ * Map a regular file to memory for reading.
+ *
+ * @param fileName  file name
+ * @param rSize     size of the file
+ * @return start of the mapping, NULL if the file cannot be mapped (e.g. a pipe or an empty file)
+ */
+static const UChar* mapFile(const std::string &fileName, size_t &rSize)
+{
+  const Int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return NULL;
+  }
+
+  struct stat fileStat;
+  Void* pMapped = MAP_FAILED;
+  if (fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0 && (unsigned long long)fileStat.st_size <= (unsigned long long)(size_t)-1)
+  {
+    rSize   = (size_t)fileStat.st_size;
+    pMapped = mmap(NULL, rSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (pMapped != MAP_FAILED)
+    {
+      madvise(pMapped, rSize, MADV_SEQUENTIAL);
+    }
+  }
+  ::close(fd);
+
+  return pMapped == MAP_FAILED ? NULL : (const UChar*)pMapped;
+}
+#endif
+
+// ====================================================================================================================
+// Row kernels
+// ====================================================================================================================
+
+Void TVideoIOYuv::xReadLine8(const UChar* src, Pel* dst, Int width)
+{
+  for (Int x = 0; x < width; x++)
+  {
+    dst[x] = src[x];
+  }
+}
+
+Void TVideoIOYuv::xReadLine16(const UChar* src, Pel* dst, Int width)
+{
+  for (Int x = 0; x < width; x++)
+  {
+    dst[x] = Pel(src[2*x+0]) | (Pel(src[2*x+1])<<8);
+  }
+}
+
+Void TVideoIOYuv::xScaleLineUp(Pel* img, Int width, Int shiftbits, Pel minval, Pel maxval)
+{
+  for (Int x = 0; x < width; x++)
+  {
+    img[x] <<= shiftbits;
+  }
+}
+
+Void TVideoIOYuv::xScaleLineDown(Pel* img, Int width, Int shiftbits, Pel minval, Pel maxval)
+{
+  Pel rounding = 1 << (shiftbits-1);
+  for (Int x = 0; x < width; x++)
+  {
+    img[x] = Clip3(minval, maxval, Pel((img[x] + rounding) >> shiftbits));
+  }
+}
+
 /**
  * Scale all pixels in img depending upon sign of shiftbits by a factor of
  * 2<sup>shiftbits</sup>.
@@ -61,41 +138,92 @@ using namespace std;
  * @param width   width of active area in img.
  * @param height  height of active area in img.
  * @param shiftbits if zero, no operation performed
- *                  if > 0, multiply by 2<sup>shiftbits</sup>, see scalePlane()
+ *                  if > 0, multiply by 2<sup>shiftbits</sup>, see xScaleLineUp()
  *                  if < 0, divide and round by 2<sup>shiftbits</sup> and clip,
- *                          see invScalePlane().
+ *                          see xScaleLineDown().
  * @param minval  minimum clipping value when dividing.
  * @param maxval  maximum clipping value when dividing.
  */
-static Void scalePlane(Pel* img, const UInt stride, const UInt width, const UInt height, Int shiftbits, Pel minval, Pel maxval)
+Void TVideoIOYuv::xScalePlane(Pel* img, const UInt stride, const UInt width, const UInt height, Int shiftbits, Pel minval, Pel maxval)
 {
   if (shiftbits > 0)
   {
     for (UInt y = 0; y < height; y++, img+=stride)
     {
-      for (UInt x = 0; x < width; x++)
-      {
-        img[x] <<= shiftbits;
-      }
+      m_fpScaleLineUp(img, width, shiftbits, minval, maxval);
     }
   }
   else if (shiftbits < 0)
   {
-    shiftbits=-shiftbits;
-
-    Pel rounding = 1 << (shiftbits-1);
     for (UInt y = 0; y < height; y++, img+=stride)
     {
-      for (UInt x = 0; x < width; x++)
-      {
-        img[x] = Clip3(minval, maxval, Pel((img[x] + rounding) >> shiftbits));
-      }
+      m_fpScaleLineDown(img, width, -shiftbits, minval, maxval);
     }
   }
 }
 
-static Void
-copyPlane(const TComPicYuv &src, const ComponentID srcPlane, TComPicYuv &dest, const ComponentID destPlane);
+
+// ====================================================================================================================
+// Constructor / destructor
+// ====================================================================================================================
+
+TVideoIOYuv::TVideoIOYuv()
+#if YUV_INPUT_PREFETCH
+: m_prefetchHead( 0 )
+, m_prefetchCount( 0 )
+, m_prefetchRemaining( 0 )
+, m_prefetchStop( false )
+, m_prefetchEof( false )
+#endif
+{
+#if YUV_INPUT_MMAP
+  m_mappedFile      = NULL;
+  m_mappedSize      = 0;
+  m_mappedPos       = 0;
+  m_mappedEof       = false;
+#endif
+  m_fpReadLine8     = xReadLine8;
+  m_fpReadLine16    = xReadLine16;
+  m_fpScaleLineUp   = xScaleLineUp;
+  m_fpScaleLineDown = xScaleLineDown;
+#if YUV_IO_SIMD && SIMD_X86
+  // the vectorized kernels are only used if they give the same results as the scalar ones
+  static const Bool bSimdChecked = xCheckSimdKernels();
+  if ( bSimdChecked )
+  {
+    xGetSimdKernels( getSimdExtension(), m_fpReadLine8, m_fpReadLine16, m_fpScaleLineUp, m_fpScaleLineDown );
+  }
+#endif
+}
+
+TVideoIOYuv::~TVideoIOYuv()
+{
+#if YUV_INPUT_PREFETCH
+  xStopPrefetch();
+#endif
+#if YUV_INPUT_MMAP && !defined(_WIN32)
+  if (m_mappedFile)
+  {
+    munmap((Void*)m_mappedFile, m_mappedSize);
+  }
+#endif
+}
+
+#if YUV_IO_SIMD && SIMD_X86
+/**
+ * Use the row kernels of a SIMD extension.
+ *
+ * \param eExtension  SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE selects the scalar kernels
+ */
+Void TVideoIOYuv::setSimdExtension( SimdExtension eExtension )
+{
+  m_fpReadLine8     = xReadLine8;
+  m_fpReadLine16    = xReadLine16;
+  m_fpScaleLineUp   = xScaleLineUp;
+  m_fpScaleLineDown = xScaleLineDown;
+  xGetSimdKernels( eExtension, m_fpReadLine8, m_fpReadLine16, m_fpScaleLineUp, m_fpScaleLineDown );
+}
+#endif
 
 // ====================================================================================================================
 // Public member functions
@@ -108,7 +236,7 @@ copyPlane(const TComPicYuv &src, const ComponentID srcPlane, TComPicYuv &dest, c
  * formatted as 8 or 16 bit word values (see TVideoIOYuv::write()).
  *
  * Image data read or written is converted to/from internalBitDepth
- * (See scalePlane(), TVideoIOYuv::read() and TVideoIOYuv::write() for
+ * (See xScalePlane(), TVideoIOYuv::read() and TVideoIOYuv::write() for
  * further details).
  *
  * \param pchFile          file name string
@@ -159,6 +287,12 @@ Void TVideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int
       printf("\nfailed to open Input YUV file\n");
       exit(0);
     }
+#if YUV_INPUT_MMAP && !defined(_WIN32)
+    // regular files are read from a mapping, other inputs through m_cHandle
+    m_mappedFile = mapFile(fileName, m_mappedSize);
+    m_mappedPos  = 0;
+    m_mappedEof  = false;
+#endif
   }
 
   return;
@@ -166,19 +300,102 @@ Void TVideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int
 
 Void TVideoIOYuv::close()
 {
+#if YUV_INPUT_PREFETCH
+  xStopPrefetch();
+#endif
+#if YUV_INPUT_MMAP && !defined(_WIN32)
+  if (m_mappedFile)
+  {
+    munmap((Void*)m_mappedFile, m_mappedSize);
+    m_mappedFile = NULL;
+  }
+#endif
   m_cHandle.close();
 }
 
 Bool TVideoIOYuv::isEof()
 {
-  return m_cHandle.eof();
+#if YUV_INPUT_PREFETCH
+  // the file handle belongs to the prefetch thread while it runs
+  if ( !m_prefetchFrames.empty() )
+  {
+    return m_prefetchEof;
+  }
+#endif
+  return xIsFileEof();
 }
 
 Bool TVideoIOYuv::isFail()
 {
+#if YUV_INPUT_MMAP
+  if (m_mappedFile)
+  {
+    return m_mappedEof;
+  }
+#endif
   return m_cHandle.fail();
 }
 
+Bool TVideoIOYuv::xIsFileEof()
+{
+#if YUV_INPUT_MMAP
+  if (m_mappedFile)
+  {
+    return m_mappedEof;
+  }
+#endif
+  return m_cHandle.eof();
+}
+
+/**
+ * Get the next line of the input file.
+ *
+ * A mapped file is read without copy, otherwise the line is read into m_lineBuf.
+ *
+ * @param size  number of bytes of the line
+ * @return start of the line, NULL if the file has less than size bytes left
+ */
+const UChar* TVideoIOYuv::xGetFileLine(UInt size)
+{
+#if YUV_INPUT_MMAP
+  if (m_mappedFile)
+  {
+    if (size > m_mappedSize - m_mappedPos)
+    {
+      m_mappedPos = m_mappedSize;
+      m_mappedEof = true;
+      return NULL;
+    }
+    const UChar* line = m_mappedFile + m_mappedPos;
+    m_mappedPos += size;
+    return line;
+  }
+#endif
+  if (m_lineBuf.size() < size)
+  {
+    m_lineBuf.resize(size);
+  }
+  m_cHandle.read(reinterpret_cast<TChar*>(&m_lineBuf[0]), size);
+  if (m_cHandle.eof() || m_cHandle.fail() )
+  {
+    return NULL;
+  }
+  return &m_lineBuf[0];
+}
+
+/// skip bytes of the input file, a mapped file is not read beyond its end (like seekg)
+Void TVideoIOYuv::xSkipFileBytes(streamoff size)
+{
+#if YUV_INPUT_MMAP
+  if (m_mappedFile)
+  {
+    m_mappedPos = (streamoff)(m_mappedSize - m_mappedPos) < size ? m_mappedSize : m_mappedPos + (size_t)size;
+    return;
+  }
+#endif
+  m_cHandle.seekg(size, ios::cur);
+}
+
 /**
  * Skip numFrames in input.
  *
@@ -210,6 +427,15 @@ Void TVideoIOYuv::skipFrames(UInt numFrames, UInt width, UInt height, ChromaForm
 
   const streamoff offset = frameSize * numFrames;
 
+#if YUV_INPUT_MMAP
+  /* a mapped file is skipped by moving the read position */
+  if (m_mappedFile)
+  {
+    xSkipFileBytes(offset);
+    return;
+  }
+#endif
+
   /* attempt to seek */
   if (!!m_cHandle.seekg(offset, ios::cur))
   {
@@ -228,12 +454,11 @@ Void TVideoIOYuv::skipFrames(UInt numFrames, UInt width, UInt height, ChromaForm
 }
 
 /**
- * Read width*height pixels from fd into dst, optionally
+ * Read width*height pixels from the input file into dst, optionally
  * padding the left and right edges by edge-extension.  Input may be
  * either 8bit or 16bit little-endian lsb-aligned words.
  *
  * @param dst          destination image plane
- * @param fd           input file stream
  * @param is16bit      true if input file carries > 8bit data, false otherwise.
  * @param stride444    distance between vertically adjacent pixels of dst.
  * @param width444     width of active area in dst.
@@ -246,18 +471,17 @@ Void TVideoIOYuv::skipFrames(UInt numFrames, UInt width, UInt height, ChromaForm
  * @param fileBitDepth component bit depth in file
  * @return true for success, false in case of error
  */
-static Bool readPlane(Pel* dst,
-                      istream& fd,
-                      Bool is16bit,
-                      UInt stride444,
-                      UInt width444,
-                      UInt height444,
-                      UInt pad_x444,
-                      UInt pad_y444,
-                      const ComponentID compID,
-                      const ChromaFormat destFormat,
-                      const ChromaFormat fileFormat,
-                      const UInt fileBitDepth)
+Bool TVideoIOYuv::xReadPlane(Pel* dst,
+                             Bool is16bit,
+                             UInt stride444,
+                             UInt width444,
+                             UInt height444,
+                             UInt pad_x444,
+                             UInt pad_y444,
+                             const ComponentID compID,
+                             const ChromaFormat destFormat,
+                             const ChromaFormat fileFormat,
+                             const UInt fileBitDepth)
 {
   const UInt csx_file =getComponentScaleX(compID, fileFormat);
   const UInt csy_file =getComponentScaleY(compID, fileFormat);
@@ -275,8 +499,7 @@ static Bool readPlane(Pel* dst,
 
   const UInt stride_file      = (width444 * (is16bit ? 2 : 1)) >> csx_file;
 
-  std::vector<UChar> bufVec(stride_file);
-  UChar *buf=&(bufVec[0]);
+  const UChar *buf = NULL;
 
   if (compID!=COMPONENT_Y && (fileFormat==CHROMA_400 || destFormat==CHROMA_400))
   {
@@ -296,8 +519,8 @@ static Bool readPlane(Pel* dst,
     if (fileFormat!=CHROMA_400)
     {
       const UInt height_file      = height444>>csy_file;
-      fd.seekg(height_file*stride_file, ios::cur);
-      if (fd.eof() || fd.fail() )
+      xSkipFileBytes(streamoff(height_file)*stride_file);
+      if (xIsFileEof() || isFail() )
       {
         return false;
       }
@@ -312,8 +535,8 @@ static Bool readPlane(Pel* dst,
       if ((y444&mask_y_file)==0)
       {
         // read a new line
-        fd.read(reinterpret_cast<TChar*>(buf), stride_file);
-        if (fd.eof() || fd.fail() )
+        buf = xGetFileLine(stride_file);
+        if (buf == NULL)
         {
           return false;
         }
@@ -345,7 +568,19 @@ static Bool readPlane(Pel* dst,
         {
           // eg file is 422, dest is 444.
           const UInt sx=csx_file-csx_dest;
-          if (!is16bit)
+          if (sx == 0)
+          {
+            // same sampling, converted by the row kernels
+            if (!is16bit)
+            {
+              m_fpReadLine8(buf, dst, width_dest);
+            }
+            else
+            {
+              m_fpReadLine16(buf, dst, width_dest);
+            }
+          }
+          else if (!is16bit)
           {
             for (UInt x = 0; x < width_dest; x++)
             {
@@ -674,9 +909,52 @@ static Bool writeField(ostream& fd, Pel* top, Pel* bottom, Bool is16bit,
  * @return true for success, false in case of error
  */
 Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, const InputColourSpaceConversion ipcsc, Int aiPad[2], ChromaFormat format, const Bool bClipToRec709 )
+{
+#if YUV_INPUT_PREFETCH
+  if ( !m_prefetchFrames.empty() )
+  {
+    std::unique_lock<std::mutex> lock( m_prefetchMutex );
+    while ( m_prefetchCount == 0 && m_prefetchRemaining > 0 )
+    {
+      m_prefetchCond.wait( lock );
+    }
+
+    if ( m_prefetchCount > 0 )
+    {
+      // the prefetch thread does not write the frame at the head while it is counted
+      PrefetchFrame& rcFrame = m_prefetchFrames[ m_prefetchHead ];
+      lock.unlock();
+
+      Bool bRead = rcFrame.bRead;
+      if ( bRead )
+      {
+        rcFrame.pPicYuv       ->copyToPic( pPicYuvUser    );
+        rcFrame.pPicYuvTrueOrg->copyToPic( pPicYuvTrueOrg );
+      }
+      else
+      {
+        m_prefetchEof = true;
+      }
+
+      lock.lock();
+      m_prefetchHead = ( m_prefetchHead + 1 ) % (Int)m_prefetchFrames.size();
+      m_prefetchCount--;
+      m_prefetchCond.notify_all();
+      return bRead;
+    }
+
+    // all frames requested by startPrefetch() are returned, continue reading synchronously
+    lock.unlock();
+    xStopPrefetch();
+  }
+#endif
+  return xRead( pPicYuvUser, pPicYuvTrueOrg, ipcsc, aiPad, format, bClipToRec709 );
+}
+
+Bool TVideoIOYuv::xRead ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, const InputColourSpaceConversion ipcsc, Int aiPad[2], ChromaFormat format, const Bool bClipToRec709 )
 {
   // check end-of-file
-  if ( isEof() )
+  if ( xIsFileEof() )
   {
     return false;
   }
@@ -719,7 +997,7 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
     const Pel minval = b709Compliance? ((   1 << (desired_bitdepth - 8))   ) : 0;
     const Pel maxval = b709Compliance? ((0xff << (desired_bitdepth - 8)) -1) : (1 << desired_bitdepth) - 1;
 
-    if (! readPlane(pPicYuv->getAddr(compID), m_cHandle, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, pPicYuv->getChromaFormat(), format, m_fileBitdepth[chType]))
+    if (! xReadPlane(pPicYuv->getAddr(compID), is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, pPicYuv->getChromaFormat(), format, m_fileBitdepth[chType]))
     {
       return false;
     }
@@ -728,7 +1006,7 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
     {
       const UInt csx=getComponentScaleX(compID, pPicYuv->getChromaFormat());
       const UInt csy=getComponentScaleY(compID, pPicYuv->getChromaFormat());
-      scalePlane(pPicYuv->getAddr(compID), stride444>>csx, width_full444>>csx, height_full444>>csy, m_bitdepthShift[chType], minval, maxval);
+      xScalePlane(pPicYuv->getAddr(compID), stride444>>csx, width_full444>>csx, height_full444>>csy, m_bitdepthShift[chType], minval, maxval);
     }
   }
 
@@ -737,6 +1015,111 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
   return true;
 }
 
+#if YUV_INPUT_PREFETCH
+/**
+ * Start reading frames ahead in a separate thread.
+ *
+ * The frames are read with the same padding, bit depth scaling and colour space conversion as by read(), into
+ * numBuffers pictures of the size and format of pPicYuv. read() copies them to its buffers in file order. After
+ * numFrames frames or the end of the file, the reading continues synchronously. The file must have been opened
+ * for reading and the frames to skip must have been skipped before.
+ *
+ * @param numBuffers       number of frames read ahead, 0 keeps reading synchronously
+ * @param numFrames        number of frames to read ahead in total
+ * @param pPicYuv          picture passed to read(), defines size and chroma format of the buffers
+ * @param maxCUWidth       maximum CU width used to create pPicYuv
+ * @param maxCUHeight      maximum CU height used to create pPicYuv
+ * @param maxCUDepth       maximum CU depth used to create pPicYuv
+ * @param ipcsc            input colour space conversion, as passed to read()
+ * @param aiPad            source padding size, as passed to read()
+ * @param fileFormat       chroma format of the file, as passed to read()
+ * @param bClipToRec709    clipping to the Rec. 709 range, as passed to read()
+ */
+Void TVideoIOYuv::startPrefetch( Int numBuffers, Int numFrames, const TComPicYuv* pPicYuv, UInt maxCUWidth, UInt maxCUHeight, UInt maxCUDepth, const InputColourSpaceConversion ipcsc, Int aiPad[2], ChromaFormat fileFormat, const Bool bClipToRec709 )
+{
+  xStopPrefetch();
+  if ( numBuffers <= 0 || numFrames <= 0 )
+  {
+    return;
+  }
+
+  m_prefetchFrames.resize( numBuffers );
+  for ( Int i = 0; i < numBuffers; i++ )
+  {
+    m_prefetchFrames[i].pPicYuv        = new TComPicYuv;
+    m_prefetchFrames[i].pPicYuvTrueOrg = new TComPicYuv;
+    m_prefetchFrames[i].pPicYuv       ->create( pPicYuv->getWidth( COMPONENT_Y ), pPicYuv->getHeight( COMPONENT_Y ), pPicYuv->getChromaFormat(), maxCUWidth, maxCUHeight, maxCUDepth, true );
+    m_prefetchFrames[i].pPicYuvTrueOrg->create( pPicYuv->getWidth( COMPONENT_Y ), pPicYuv->getHeight( COMPONENT_Y ), pPicYuv->getChromaFormat(), maxCUWidth, maxCUHeight, maxCUDepth, true );
+    m_prefetchFrames[i].bRead          = false;
+  }
+
+  m_prefetchHead         = 0;
+  m_prefetchCount        = 0;
+  m_prefetchRemaining    = numFrames;
+  m_prefetchStop         = false;
+  m_prefetchEof          = false;
+  m_prefetchCSC          = ipcsc;
+  m_prefetchPad[0]       = aiPad[0];
+  m_prefetchPad[1]       = aiPad[1];
+  m_prefetchFileFormat   = fileFormat;
+  m_prefetchClipToRec709 = bClipToRec709;
+
+  m_prefetchThread = std::thread( xPrefetchMain, this );
+}
+
+/// prefetch thread: read frames while a buffer is free, stop at the end of the file
+Void TVideoIOYuv::xPrefetchMain( TVideoIOYuv* pcVideoIOYuv )
+{
+  const Int numBuffers = (Int)pcVideoIOYuv->m_prefetchFrames.size();
+  std::unique_lock<std::mutex> lock( pcVideoIOYuv->m_prefetchMutex );
+
+  while ( true )
+  {
+    while ( !pcVideoIOYuv->m_prefetchStop && pcVideoIOYuv->m_prefetchCount == numBuffers )
+    {
+      pcVideoIOYuv->m_prefetchCond.wait( lock );
+    }
+    if ( pcVideoIOYuv->m_prefetchStop || pcVideoIOYuv->m_prefetchRemaining == 0 )
+    {
+      break;
+    }
+
+    PrefetchFrame& rcFrame = pcVideoIOYuv->m_prefetchFrames[ ( pcVideoIOYuv->m_prefetchHead + pcVideoIOYuv->m_prefetchCount ) % numBuffers ];
+    lock.unlock();
+
+    rcFrame.bRead = pcVideoIOYuv->xRead( rcFrame.pPicYuv, rcFrame.pPicYuvTrueOrg, pcVideoIOYuv->m_prefetchCSC, pcVideoIOYuv->m_prefetchPad, pcVideoIOYuv->m_prefetchFileFormat, pcVideoIOYuv->m_prefetchClipToRec709 );
+
+    lock.lock();
+    pcVideoIOYuv->m_prefetchCount++;
+    pcVideoIOYuv->m_prefetchRemaining = rcFrame.bRead ? pcVideoIOYuv->m_prefetchRemaining - 1 : 0;
+    pcVideoIOYuv->m_prefetchCond.notify_all();
+  }
+}
+
+/// stop and join the prefetch thread, frames read ahead and not yet returned are dropped
+Void TVideoIOYuv::xStopPrefetch()
+{
+  if ( m_prefetchThread.joinable() )
+  {
+    {
+      std::lock_guard<std::mutex> lock( m_prefetchMutex );
+      m_prefetchStop = true;
+    }
+    m_prefetchCond.notify_all();
+    m_prefetchThread.join();
+  }
+
+  for ( Int i = 0; i < (Int)m_prefetchFrames.size(); i++ )
+  {
+    m_prefetchFrames[i].pPicYuv       ->destroy();
+    m_prefetchFrames[i].pPicYuvTrueOrg->destroy();
+    delete m_prefetchFrames[i].pPicYuv;
+    delete m_prefetchFrames[i].pPicYuvTrueOrg;
+  }
+  m_prefetchFrames.clear();
+}
+#endif
+
 /**
  * Write one Y'CbCr frame. No bit-depth conversion is performed, pcPicYuv is
  * assumed to be at TVideoIO::m_fileBitdepth depth.
@@ -797,7 +1180,7 @@ Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUser, const InputColourSpaceConversi
       const Pel maxval = b709Compliance? ((0xff << (m_MSBExtendedBitDepth[ch] - 8)) -1) : (1 << m_MSBExtendedBitDepth[ch]) - 1;
 
       copyPlane(*pPicYuv, compID, *dstPicYuv, compID);
-      scalePlane(dstPicYuv->getAddr(compID), dstPicYuv->getStride(compID), dstPicYuv->getWidth(compID), dstPicYuv->getHeight(compID), -m_bitdepthShift[ch], minval, maxval);
+      xScalePlane(dstPicYuv->getAddr(compID), dstPicYuv->getStride(compID), dstPicYuv->getWidth(compID), dstPicYuv->getHeight(compID), -m_bitdepthShift[ch], minval, maxval);
     }
   }
   else
@@ -900,7 +1283,7 @@ Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUserTop, TComPicYuv* pPicYuvUserBott
         const Pel maxval = b709Compliance? ((0xff << (m_MSBExtendedBitDepth[ch] - 8)) -1) : (1 << m_MSBExtendedBitDepth[ch]) - 1;
 
         copyPlane(*pPicYuv, compID, *dstPicYuv, compID);
-        scalePlane(dstPicYuv->getAddr(compID), dstPicYuv->getStride(compID), dstPicYuv->getWidth(compID), dstPicYuv->getHeight(compID), -m_bitdepthShift[ch], minval, maxval);
+        xScalePlane(dstPicYuv->getAddr(compID), dstPicYuv->getStride(compID), dstPicYuv->getWidth(compID), dstPicYuv->getHeight(compID), -m_bitdepthShift[ch], minval, maxval);
       }
     }
     else
@@ -43,6 +43,15 @@
 #include <iostream>
 #include "TLibCommon/CommonDef.h"
 #include "TLibCommon/TComPicYuv.h"
+#include <vector>
+#if YUV_IO_SIMD && SIMD_X86
+#include "TLibCommon/TComSimd.h"
+#endif
+#if YUV_INPUT_PREFETCH
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
 
 using namespace std;
 
@@ -53,15 +62,81 @@ using namespace std;
 /// YUV file I/O class
 class TVideoIOYuv
 {
+public:
+  // row kernels of the sample conversion, scalar or vectorized
+  typedef Void (*FpReadLine)  ( const UChar* src, Pel* dst, Int width );
+  typedef Void (*FpScaleLine) ( Pel* img, Int width, Int shiftbits, Pel minval, Pel maxval );
+
 private:
   fstream   m_cHandle;                                      ///< file handle
   Int       m_fileBitdepth[MAX_NUM_CHANNEL_TYPE]; ///< bitdepth of input/output video file
   Int       m_MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE];  ///< bitdepth after addition of MSBs (with value 0)
   Int       m_bitdepthShift[MAX_NUM_CHANNEL_TYPE];  ///< number of bits to increase or decrease image by before/after write/read
 
+#if YUV_INPUT_MMAP
+  const UChar*        m_mappedFile;                         ///< input file mapped to memory, NULL if it is read through m_cHandle
+  size_t              m_mappedSize;
+  size_t              m_mappedPos;                          ///< read position in m_mappedFile
+  Bool                m_mappedEof;                          ///< a read beyond the end of m_mappedFile failed
+#endif
+  std::vector<UChar>  m_lineBuf;                            ///< line of the input file read through m_cHandle
+
+  FpReadLine          m_fpReadLine8;                        ///< 8 bit file samples to Pel
+  FpReadLine          m_fpReadLine16;                       ///< 16 bit little-endian file samples to Pel
+  FpScaleLine         m_fpScaleLineUp;                      ///< multiplication by 2^shiftbits
+  FpScaleLine         m_fpScaleLineDown;                    ///< rounded division by 2^shiftbits and clipping
+
+  static Void   xReadLine8     ( const UChar* src, Pel* dst, Int width );
+  static Void   xReadLine16    ( const UChar* src, Pel* dst, Int width );
+  static Void   xScaleLineUp   ( Pel* img, Int width, Int shiftbits, Pel minval, Pel maxval );
+  static Void   xScaleLineDown ( Pel* img, Int width, Int shiftbits, Pel minval, Pel maxval );
+#if YUV_IO_SIMD && SIMD_X86
+  static Void   xGetSimdKernels  ( SimdExtension eExtension, FpReadLine& rpfReadLine8, FpReadLine& rpfReadLine16, FpScaleLine& rpfScaleLineUp, FpScaleLine& rpfScaleLineDown );
+  static Bool   xCheckSimdKernels();
+#endif
+
+  const UChar*  xGetFileLine   ( UInt size );               ///< next size bytes of the input file, NULL at the end of the file
+  Void          xSkipFileBytes ( streamoff size );
+  Bool          xIsFileEof     ();
+  Bool          xReadPlane     ( Pel* dst, Bool is16bit, UInt stride444, UInt width444, UInt height444, UInt pad_x444, UInt pad_y444, const ComponentID compID, const ChromaFormat destFormat, const ChromaFormat fileFormat, const UInt fileBitDepth );
+  Void          xScalePlane    ( Pel* img, const UInt stride, const UInt width, const UInt height, Int shiftbits, Pel minval, Pel maxval );
+
+#if YUV_INPUT_PREFETCH
+  // read-ahead of the input frames, filled by the prefetch thread in ring buffer order
+  struct PrefetchFrame
+  {
+    TComPicYuv* pPicYuv;
+    TComPicYuv* pPicYuvTrueOrg;
+    Bool        bRead;                                      ///< false if the read failed (end of file)
+  };
+
+  std::vector<PrefetchFrame>  m_prefetchFrames;
+  Int                         m_prefetchHead;               ///< next frame returned by read()
+  Int                         m_prefetchCount;              ///< number of frames read ahead and not yet returned
+  Int                         m_prefetchRemaining;          ///< number of frames the prefetch thread still has to read
+  Bool                        m_prefetchStop;
+  Bool                        m_prefetchEof;                ///< end of file returned by read()
+  InputColourSpaceConversion  m_prefetchCSC;
+  Int                         m_prefetchPad[2];
+  ChromaFormat                m_prefetchFileFormat;
+  Bool                        m_prefetchClipToRec709;
+  std::thread                 m_prefetchThread;
+  std::mutex                  m_prefetchMutex;
+  std::condition_variable     m_prefetchCond;
+
+  static Void xPrefetchMain( TVideoIOYuv* pcVideoIOYuv );
+  Void  xStopPrefetch ();
+#endif
+
+  Bool  xRead ( TComPicYuv* pPicYuv, TComPicYuv* pPicYuvTrueOrg, const InputColourSpaceConversion ipcsc, Int aiPad[2], ChromaFormat fileFormat, const Bool bClipToRec709 );
+
 public:
-  TVideoIOYuv()           {}
-  virtual ~TVideoIOYuv()  {}
+  TVideoIOYuv();
+  virtual ~TVideoIOYuv();
+
+#if YUV_IO_SIMD && SIMD_X86
+  Void  setSimdExtension ( SimdExtension eExtension );      ///< use the row kernels of an extension, SIMD_NONE for the scalar ones
+#endif
 
   Void  open  ( const std::string &fileName, Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] ); ///< open or create file
   Void  close ();                                           ///< close file
@@ -74,6 +149,12 @@ public:
   // If fileFormat=NUM_CHROMA_FORMAT, use the format defined by pPicYuvTrueOrg
   Bool  read  ( TComPicYuv* pPicYuv, TComPicYuv* pPicYuvTrueOrg, const InputColourSpaceConversion ipcsc, Int aiPad[2], ChromaFormat fileFormat=NUM_CHROMA_FORMAT, const Bool bClipToRec709=false );     ///< read one frame with padding parameter
 
+#if YUV_INPUT_PREFETCH
+  // Read up to numFrames frames ahead in a separate thread, into numBuffers pictures created like pPicYuv.
+  // read() then returns these frames, its conversion parameters must be the ones given here.
+  Void  startPrefetch ( Int numBuffers, Int numFrames, const TComPicYuv* pPicYuv, UInt maxCUWidth, UInt maxCUHeight, UInt maxCUDepth, const InputColourSpaceConversion ipcsc, Int aiPad[2], ChromaFormat fileFormat=NUM_CHROMA_FORMAT, const Bool bClipToRec709=false );
+#endif
+
   // If fileFormat=NUM_CHROMA_FORMAT, use the format defined by pPicYuv
   Bool  write ( TComPicYuv* pPicYuv, const InputColourSpaceConversion ipCSC, Int confLeft=0, Int confRight=0, Int confTop=0, Int confBottom=0, ChromaFormat fileFormat=NUM_CHROMA_FORMAT, const Bool bClipToRec709=false );     ///< write one YUV frame with padding parameter
 
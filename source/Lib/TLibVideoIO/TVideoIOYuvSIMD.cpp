@@ -0,0 +1,279 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TVideoIOYuvSIMD.cpp
+    \brief    SSE4.1 and AVX2 implementations of the row kernels of TVideoIOYuv
+
+    8 bit file samples are zero extended to Pel, 16 bit little-endian file samples are copied. The bit depth scaling
+    shifts 16 bit samples left or rounds, shifts and clips them in 32 bit like the scalar code. All results are
+    identical to the scalar kernels.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "TVideoIOYuv.h"
+
+#if YUV_IO_SIMD && SIMD_X86
+
+#include <immintrin.h>
+
+// ====================================================================================================================
+// SSE4.1
+// ====================================================================================================================
+
+static SIMD_TARGET_SSE41 Void xReadLine8Sse41( const UChar* src, Pel* dst, Int width )
+{
+  Int x = 0;
+  for ( ; x + 8 <= width; x += 8 )
+  {
+    _mm_storeu_si128( (__m128i*) ( dst + x ), _mm_cvtepu8_epi16( _mm_loadl_epi64( (const __m128i*) ( src + x ) ) ) );
+  }
+  for ( ; x < width; x++ )
+  {
+    dst[x] = src[x];
+  }
+}
+
+static SIMD_TARGET_SSE41 Void xReadLine16Sse41( const UChar* src, Pel* dst, Int width )
+{
+  Int x = 0;
+  for ( ; x + 8 <= width; x += 8 )
+  {
+    _mm_storeu_si128( (__m128i*) ( dst + x ), _mm_loadu_si128( (const __m128i*) ( src + 2 * x ) ) );
+  }
+  for ( ; x < width; x++ )
+  {
+    dst[x] = Pel( src[2 * x + 0] ) | ( Pel( src[2 * x + 1] ) << 8 );
+  }
+}
+
+static SIMD_TARGET_SSE41 Void xScaleLineUpSse41( Pel* img, Int width, Int shiftbits, Pel minval, Pel maxval )
+{
+  const __m128i vShift = _mm_cvtsi32_si128( shiftbits );
+  Int x = 0;
+  for ( ; x + 8 <= width; x += 8 )
+  {
+    __m128i v = _mm_loadu_si128( (const __m128i*) ( img + x ) );
+    _mm_storeu_si128( (__m128i*) ( img + x ), _mm_sll_epi16( v, vShift ) );
+  }
+  for ( ; x < width; x++ )
+  {
+    img[x] <<= shiftbits;
+  }
+}
+
+static SIMD_TARGET_SSE41 Void xScaleLineDownSse41( Pel* img, Int width, Int shiftbits, Pel minval, Pel maxval )
+{
+  const Pel     rounding  = 1 << ( shiftbits - 1 );
+  const __m128i vShift    = _mm_cvtsi32_si128( shiftbits );
+  const __m128i vRounding = _mm_set1_epi32( rounding );
+  const __m128i vMin      = _mm_set1_epi16( minval );
+  const __m128i vMax      = _mm_set1_epi16( maxval );
+  Int x = 0;
+  for ( ; x + 8 <= width; x += 8 )
+  {
+    __m128i v   = _mm_loadu_si128( (const __m128i*) ( img + x ) );
+    __m128i vLo = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( v ), vRounding ), vShift );
+    __m128i vHi = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( _mm_srli_si128( v, 8 ) ), vRounding ), vShift );
+    // truncate to Pel before the clipping, like the scalar kernel
+    vLo = _mm_srai_epi32( _mm_slli_epi32( vLo, 16 ), 16 );
+    vHi = _mm_srai_epi32( _mm_slli_epi32( vHi, 16 ), 16 );
+    v   = _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( vLo, vHi ), vMin ), vMax );
+    _mm_storeu_si128( (__m128i*) ( img + x ), v );
+  }
+  for ( ; x < width; x++ )
+  {
+    img[x] = Clip3( minval, maxval, Pel( ( img[x] + rounding ) >> shiftbits ) );
+  }
+}
+
+// ====================================================================================================================
+// AVX2
+// ====================================================================================================================
+
+static SIMD_TARGET_AVX2 Void xReadLine8Avx2( const UChar* src, Pel* dst, Int width )
+{
+  Int x = 0;
+  for ( ; x + 16 <= width; x += 16 )
+  {
+    _mm256_storeu_si256( (__m256i*) ( dst + x ), _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i*) ( src + x ) ) ) );
+  }
+  xReadLine8Sse41( src + x, dst + x, width - x );
+}
+
+static SIMD_TARGET_AVX2 Void xReadLine16Avx2( const UChar* src, Pel* dst, Int width )
+{
+  Int x = 0;
+  for ( ; x + 16 <= width; x += 16 )
+  {
+    _mm256_storeu_si256( (__m256i*) ( dst + x ), _mm256_loadu_si256( (const __m256i*) ( src + 2 * x ) ) );
+  }
+  xReadLine16Sse41( src + 2 * x, dst + x, width - x );
+}
+
+static SIMD_TARGET_AVX2 Void xScaleLineUpAvx2( Pel* img, Int width, Int shiftbits, Pel minval, Pel maxval )
+{
+  const __m128i vShift = _mm_cvtsi32_si128( shiftbits );
+  Int x = 0;
+  for ( ; x + 16 <= width; x += 16 )
+  {
+    __m256i v = _mm256_loadu_si256( (const __m256i*) ( img + x ) );
+    _mm256_storeu_si256( (__m256i*) ( img + x ), _mm256_sll_epi16( v, vShift ) );
+  }
+  xScaleLineUpSse41( img + x, width - x, shiftbits, minval, maxval );
+}
+
+static SIMD_TARGET_AVX2 Void xScaleLineDownAvx2( Pel* img, Int width, Int shiftbits, Pel minval, Pel maxval )
+{
+  const __m128i vShift    = _mm_cvtsi32_si128( shiftbits );
+  const __m256i vRounding = _mm256_set1_epi32( 1 << ( shiftbits - 1 ) );
+  const __m256i vMin      = _mm256_set1_epi16( minval );
+  const __m256i vMax      = _mm256_set1_epi16( maxval );
+  Int x = 0;
+  for ( ; x + 16 <= width; x += 16 )
+  {
+    __m256i v   = _mm256_loadu_si256( (const __m256i*) ( img + x ) );
+    __m256i vLo = _mm256_sra_epi32( _mm256_add_epi32( _mm256_cvtepi16_epi32( _mm256_castsi256_si128( v ) ), vRounding ), vShift );
+    __m256i vHi = _mm256_sra_epi32( _mm256_add_epi32( _mm256_cvtepi16_epi32( _mm256_extracti128_si256( v, 1 ) ), vRounding ), vShift );
+    vLo = _mm256_srai_epi32( _mm256_slli_epi32( vLo, 16 ), 16 );
+    vHi = _mm256_srai_epi32( _mm256_slli_epi32( vHi, 16 ), 16 );
+    // packing works within the 128 bit lanes, the permutation restores the sample order
+    v   = _mm256_permute4x64_epi64( _mm256_packs_epi32( vLo, vHi ), 0xd8 );
+    v   = _mm256_min_epi16( _mm256_max_epi16( v, vMin ), vMax );
+    _mm256_storeu_si256( (__m256i*) ( img + x ), v );
+  }
+  xScaleLineDownSse41( img + x, width - x, shiftbits, minval, maxval );
+}
+
+// ====================================================================================================================
+// Dispatch and self test
+// ====================================================================================================================
+
+/**
+ * Replace the scalar row kernels by the vectorized ones of an extension.
+ *
+ * \param eExtension        SIMD extension, at most the one returned by getSimdExtension(); SIMD_NONE keeps the current functions
+ * \param rpfReadLine8      conversion of 8 bit file samples
+ * \param rpfReadLine16     conversion of 16 bit file samples
+ * \param rpfScaleLineUp    bit depth increase
+ * \param rpfScaleLineDown  bit depth decrease with rounding and clipping
+ */
+Void TVideoIOYuv::xGetSimdKernels( SimdExtension eExtension, FpReadLine& rpfReadLine8, FpReadLine& rpfReadLine16, FpScaleLine& rpfScaleLineUp, FpScaleLine& rpfScaleLineDown )
+{
+  if ( eExtension >= SIMD_SSE41 )
+  {
+    rpfReadLine8     = xReadLine8Sse41;
+    rpfReadLine16    = xReadLine16Sse41;
+    rpfScaleLineUp   = xScaleLineUpSse41;
+    rpfScaleLineDown = xScaleLineDownSse41;
+  }
+  if ( eExtension >= SIMD_AVX2 )
+  {
+    rpfReadLine8     = xReadLine8Avx2;
+    rpfReadLine16    = xReadLine16Avx2;
+    rpfScaleLineUp   = xScaleLineUpAvx2;
+    rpfScaleLineDown = xScaleLineDownAvx2;
+  }
+}
+
+static UInt xGetTestRand(UInt& ruiSeed)
+{
+  ruiSeed = ruiSeed * 1103515245 + 12345;
+  return ( ruiSeed >> 8 );
+}
+
+/**
+ * Compare the vectorized row kernels of all extensions supported by the CPU with the scalar ones.
+ *
+ * Lines of random length and content are converted and scaled with shifts of 1 to 8 and clipping ranges narrower
+ * than the results. Returns true if all outputs are identical.
+ */
+Bool TVideoIOYuv::xCheckSimdKernels()
+{
+  const Int maxWidth = 100;
+  UChar     src   [ 2 * maxWidth ];
+  Pel       dstRef[ maxWidth ];
+  Pel       dstVec[ maxWidth ];
+  UInt      seed = 1;
+
+  for ( Int extension = SIMD_SSE41; extension <= getSimdExtension(); extension++ )
+  {
+    FpReadLine  pfReadLine8     = xReadLine8;
+    FpReadLine  pfReadLine16    = xReadLine16;
+    FpScaleLine pfScaleLineUp   = xScaleLineUp;
+    FpScaleLine pfScaleLineDown = xScaleLineDown;
+    xGetSimdKernels( SimdExtension( extension ), pfReadLine8, pfReadLine16, pfScaleLineUp, pfScaleLineDown );
+
+    for ( Int test = 0; test < 256; test++ )
+    {
+      const Int  width     = 1 + xGetTestRand( seed ) % maxWidth;
+      const Int  shiftbits = 1 + xGetTestRand( seed ) % 8;
+      const Pel  minval    = Pel( xGetTestRand( seed ) % 64 );
+      const Pel  maxval    = Pel( minval + xGetTestRand( seed ) % 1024 );
+      const Bool b16bit    = ( test & 1 ) != 0;
+
+      for ( Int i = 0; i < 2 * maxWidth; i++ )
+      {
+        src[i] = UChar( xGetTestRand( seed ) );
+      }
+      memset( dstRef, 0, sizeof( dstRef ) );
+      memset( dstVec, 0, sizeof( dstVec ) );
+
+      ( b16bit ? xReadLine16 : xReadLine8 )( src, dstRef, width );
+      ( b16bit ? pfReadLine16 : pfReadLine8 )( src, dstVec, width );
+      Bool bSame = !memcmp( dstRef, dstVec, sizeof( dstRef ) );
+
+      if ( test & 2 )
+      {
+        xScaleLineDown ( dstRef, width, shiftbits, minval, maxval );
+        pfScaleLineDown( dstVec, width, shiftbits, minval, maxval );
+      }
+      else
+      {
+        xScaleLineUp   ( dstRef, width, shiftbits, minval, maxval );
+        pfScaleLineUp  ( dstVec, width, shiftbits, minval, maxval );
+      }
+      bSame = bSame && !memcmp( dstRef, dstVec, sizeof( dstRef ) );
+
+      if ( !bSame )
+      {
+        printf( "\nWarning: vectorized YUV file sample conversion differs from the scalar one, the scalar conversion is used\n" );
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+#endif // YUV_IO_SIMD && SIMD_X86